@@ -47,6 +47,7 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/math/real_valued_fast_fourier_transform.h"
 #include "SPTK/math/real_valued_inverse_fast_fourier_transform.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -99,6 +100,8 @@ class FastFourierTransformCepstralAnalysis {
    private:
     std::vector<double> real_part_;
     std::vector<double> imag_part_;
+    Matrix real_parts_;
+    Matrix imag_parts_;
 
     RealValuedFastFourierTransform::Buffer buffer_for_fast_fourier_transform_;
     RealValuedInverseFastFourierTransform::Buffer
@@ -167,6 +170,18 @@ class FastFourierTransformCepstralAnalysis {
            std::vector<double>* cepstrum,
            FastFourierTransformCepstralAnalysis::Buffer* buffer) const;
 
+  /**
+   * Analyze each row of input matrix. The result of each frame is identical to
+   * that of the single-frame version.
+   *
+   * @param[in] power_spectra \f$(N/2+1)\f$-length power spectra.
+   * @param[out] cepstra \f$M\f$-th order cepstral coefficients.
+   * @param[out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const Matrix& power_spectra, Matrix* cepstra,
+           FastFourierTransformCepstralAnalysis::Buffer* buffer) const;
+
  private:
   const int num_order_;
   const int num_iteration_;
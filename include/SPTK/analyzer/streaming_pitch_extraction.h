@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_H_
+#define SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_H_
+
+#include <vector>  // std::vector
+
+#include "SPTK/analyzer/pitch_extraction.h"
+#include "SPTK/analyzer/pitch_extraction_interface.h"
+#include "SPTK/analyzer/streaming_pitch_extraction_interface.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Extract pitch (fundamental frequency) from waveform given chunk by chunk.
+ *
+ * The input is a chunk of waveform and the output is the sequence of the
+ * fundamental frequency which is determined by the chunk. The remaining
+ * fundamental frequency is output at the end of the waveform. The concatenated
+ * output has the same length as that of PitchExtraction.
+ *
+ * The supported algorithms are RAPT and DIO. RAPT runs incrementally and gives
+ * the same result as PitchExtraction with the latency of about 1.4 seconds.
+ * DIO is applied to overlapping segments of 0.5 seconds with 0.25 seconds of
+ * context on each side, i.e., the latency is about 0.75 seconds. The result
+ * of DIO is almost the same as that of PitchExtraction.
+ */
+class StreamingPitchExtraction {
+ public:
+  /**
+   * @param[in] frame_shift Frame shift in point.
+   * @param[in] sampling_rate Sampling rate in Hz.
+   * @param[in] lower_f0 Lower bound of F0 in Hz.
+   * @param[in] upper_f0 Upper bound of F0 in Hz.
+   * @param[in] voicing_threshold Threshold for determining voiced/unvoiced.
+   * @param[in] algorithm Algorithm used for pitch extraction.
+   */
+  StreamingPitchExtraction(int frame_shift, double sampling_rate,
+                           double lower_f0, double upper_f0,
+                           double voicing_threshold,
+                           PitchExtraction::Algorithms algorithm);
+
+  virtual ~StreamingPitchExtraction() {
+    delete streaming_pitch_extraction_;
+    delete pitch_extraction_;
+  }
+
+  /**
+   * @return True if this obejct is valid.
+   */
+  bool IsValid() const {
+    return (NULL != streaming_pitch_extraction_ &&
+            streaming_pitch_extraction_->IsValid());
+  }
+
+  /**
+   * @return Maximum delay in point from the input of a sample to the output of
+   *         the frame centered at the sample.
+   */
+  int GetLatency() const {
+    return (NULL != streaming_pitch_extraction_
+                ? streaming_pitch_extraction_->GetLatency()
+                : 0);
+  }
+
+  /**
+   * @param[in] waveform Next chunk of waveform.
+   * @param[out] f0 F0 in Hz determined by the chunk (may be empty).
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<double>& waveform, std::vector<double>* f0) {
+    return (NULL != streaming_pitch_extraction_ &&
+            streaming_pitch_extraction_->Get(waveform, f0));
+  }
+
+  /**
+   * Output the remaining F0 and get ready for the next waveform.
+   *
+   * @param[out] f0 Remaining F0 in Hz.
+   * @return True on success, false on failure.
+   */
+  bool Finish(std::vector<double>* f0) {
+    return (NULL != streaming_pitch_extraction_ &&
+            streaming_pitch_extraction_->Finish(f0));
+  }
+
+ private:
+  PitchExtractionInterface* pitch_extraction_;
+  StreamingPitchExtractionInterface* streaming_pitch_extraction_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingPitchExtraction);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_H_
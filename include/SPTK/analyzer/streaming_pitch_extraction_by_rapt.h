@@ -0,0 +1,170 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_BY_RAPT_H_
+#define SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_BY_RAPT_H_
+
+#include <cstdint>  // std::int64_t
+#include <vector>   // std::vector
+
+#include "SPTK/analyzer/streaming_pitch_extraction_interface.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+namespace snack {
+struct f0_stream;
+}  // namespace snack
+
+/**
+ * Extract pitch from waveform given chunk by chunk using RAPT.
+ *
+ * The DP of RAPT is run incrementally, so the concatenated output is identical
+ * to that of PitchExtractionByRapt. A frame is output when the best path up to
+ * the frame is determined, which takes about 1.4 seconds at most.
+ */
+class StreamingPitchExtractionByRapt
+    : public StreamingPitchExtractionInterface {
+ public:
+  /**
+   * @param[in] frame_shift Frame shift in point.
+   * @param[in] sampling_rate Sampling rate in Hz.
+   * @param[in] lower_f0 Lower bound of F0 in Hz.
+   * @param[in] upper_f0 Upper bound of F0 in Hz.
+   * @param[in] voicing_threshold Threshold for determining voiced/unvoiced.
+   */
+  StreamingPitchExtractionByRapt(int frame_shift, double sampling_rate,
+                                 double lower_f0, double upper_f0,
+                                 double voicing_threshold);
+
+  virtual ~StreamingPitchExtractionByRapt();
+
+  /**
+   * @return Frame shift.
+   */
+  int GetFrameShift() const {
+    return frame_shift_;
+  }
+
+  /**
+   * @return Sampling rate.
+   */
+  double GetSamplingRate() const {
+    return sampling_rate_;
+  }
+
+  /**
+   * @return Minimum fundamental frequency to search for.
+   */
+  double GetLowerF0() const {
+    return lower_f0_;
+  }
+
+  /**
+   * @return Maximum fundamental frequency to search for.
+   */
+  double GetUpperF0() const {
+    return upper_f0_;
+  }
+
+  /**
+   * @return Voicing threshold.
+   */
+  double GetVoicingThreshold() const {
+    return voicing_threshold_;
+  }
+
+  /**
+   * @return True if this obejct is valid.
+   */
+  virtual bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * @return Latency in point.
+   */
+  virtual int GetLatency() const {
+    return latency_;
+  }
+
+  /**
+   * @param[in] waveform Next chunk of waveform.
+   * @param[out] f0 F0 in Hz determined by the chunk.
+   * @return True on success, false on failure.
+   */
+  virtual bool Get(const std::vector<double>& waveform,
+                   std::vector<double>* f0);
+
+  /**
+   * @param[out] f0 Remaining F0 in Hz.
+   * @return True on success, false on failure.
+   */
+  virtual bool Finish(std::vector<double>* f0);
+
+ private:
+  void Start();
+
+  const int frame_shift_;
+  const double sampling_rate_;
+  const double lower_f0_;
+  const double upper_f0_;
+  const double voicing_threshold_;
+
+  bool is_valid_;
+
+  snack::f0_stream* stream_;
+  int latency_;
+
+  std::int64_t num_input_sample_;
+  std::int64_t num_output_frame_;
+  double last_f0_;
+  std::vector<float> pending_f0_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingPitchExtractionByRapt);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_BY_RAPT_H_
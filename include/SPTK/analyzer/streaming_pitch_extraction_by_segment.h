@@ -0,0 +1,158 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_BY_SEGMENT_H_
+#define SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_BY_SEGMENT_H_
+
+#include <cstdint>  // std::int64_t
+#include <vector>   // std::vector
+
+#include "SPTK/analyzer/pitch_extraction_interface.h"
+#include "SPTK/analyzer/streaming_pitch_extraction_interface.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Extract pitch from waveform given chunk by chunk using a non-streaming
+ * algorithm.
+ *
+ * F0 is extracted from every overlapping segment of waveform, and only the
+ * frames in the middle of the segment are output. The segment consists of
+ * \f$C\f$ frames of left context, \f$B\f$ frames to be output, and \f$C\f$
+ * frames of lookahead. Therefore, the latency is \f$(B+C)\f$ frames and the
+ * computational cost is about \f$(B+2C)/B\f$ times as much as that of the
+ * whole utterance processing. The output may differ from that of the whole
+ * utterance processing around the boundaries of the segments.
+ */
+class StreamingPitchExtractionBySegment
+    : public StreamingPitchExtractionInterface {
+ public:
+  /**
+   * @param[in] pitch_extraction Pitch extraction applied to each segment.
+   * @param[in] frame_shift Frame shift in point.
+   * @param[in] segment_length Number of output frames per segment, \f$B\f$.
+   * @param[in] context_length Number of context frames, \f$C\f$.
+   */
+  StreamingPitchExtractionBySegment(
+      const PitchExtractionInterface* pitch_extraction, int frame_shift,
+      int segment_length, int context_length);
+
+  virtual ~StreamingPitchExtractionBySegment() {
+  }
+
+  /**
+   * @return Frame shift.
+   */
+  int GetFrameShift() const {
+    return frame_shift_;
+  }
+
+  /**
+   * @return Segment length.
+   */
+  int GetSegmentLength() const {
+    return segment_length_;
+  }
+
+  /**
+   * @return Context length.
+   */
+  int GetContextLength() const {
+    return context_length_;
+  }
+
+  /**
+   * @return True if this obejct is valid.
+   */
+  virtual bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * @return Latency in point.
+   */
+  virtual int GetLatency() const {
+    return (segment_length_ + context_length_) * frame_shift_;
+  }
+
+  /**
+   * @param[in] waveform Next chunk of waveform.
+   * @param[out] f0 F0 in Hz determined by the chunk.
+   * @return True on success, false on failure.
+   */
+  virtual bool Get(const std::vector<double>& waveform,
+                   std::vector<double>* f0);
+
+  /**
+   * @param[out] f0 Remaining F0 in Hz.
+   * @return True on success, false on failure.
+   */
+  virtual bool Finish(std::vector<double>* f0);
+
+ private:
+  bool Extract(std::int64_t end_sample, int num_frame,
+               std::vector<double>* f0);
+
+  const PitchExtractionInterface* pitch_extraction_;
+  const int frame_shift_;
+  const int segment_length_;
+  const int context_length_;
+
+  bool is_valid_;
+
+  std::vector<double> waveform_;
+  std::int64_t first_sample_;
+  std::int64_t num_input_sample_;
+  std::int64_t num_output_frame_;
+
+  std::vector<double> segment_;
+  std::vector<double> segment_f0_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingPitchExtractionBySegment);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_BY_SEGMENT_H_
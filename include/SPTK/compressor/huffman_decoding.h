@@ -45,8 +45,12 @@
 #ifndef SPTK_COMPRESSOR_HUFFMAN_DECODING_H_
 #define SPTK_COMPRESSOR_HUFFMAN_DECODING_H_
 
+#include <cstdint>  // std::uint32_t
 #include <fstream>  // std::ifstream
+#include <string>   // std::string
+#include <vector>   // std::vector
 
+#include "SPTK/utils/bit_stream.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -69,7 +73,55 @@ class HuffmanDecoding {
   //
   bool Get(bool input, double* output, bool* is_leaf);
 
+  // Reads a codeword from the bit stream and decodes it. If the stream ends
+  // before a complete codeword, is_decoded is set to false.
+  bool Run(BitStreamReader* input, double* output, bool* is_decoded) const {
+    if (!is_valid_ || NULL == input || NULL == output || NULL == is_decoded) {
+      return false;
+    }
+    int offset(0);
+    int width(root_table_width_);
+    for (;;) {
+      std::uint32_t bits;
+      const int num_available_bits(input->Peek(width, &bits));
+      const Entry& entry(tables_[offset + bits]);
+      if (0 < entry.length && entry.length <= num_available_bits) {
+        input->Skip(entry.length);
+        *output = symbols_[entry.value];
+        *is_decoded = true;
+        return true;
+      }
+      if (num_available_bits < width) {
+        input->Skip(num_available_bits);
+        *is_decoded = false;
+        return true;
+      }
+      if (0 == entry.length) {
+        return false;
+      }
+      input->Skip(width);
+      offset = entry.value;
+      width = -entry.length;
+    }
+  }
+
  private:
+  // Entry of the lookup tables. If length is positive, value is the index of
+  // the symbol whose codeword has the length in the table. If length is
+  // negative, value is the offset of the next table whose width is -length.
+  // Otherwise, the entry is not a prefix of any codeword.
+  struct Entry {
+    Entry() : value(0), length(0) {
+    }
+    int value;
+    int length;
+  };
+
+  //
+  bool BuildTable(const std::vector<std::string>& codewords,
+                  const std::vector<int>& indices, int depth, int* offset,
+                  int* width);
+
   //
   struct Node {
     Node* left;
@@ -94,6 +146,15 @@ class HuffmanDecoding {
   //
   Node* curr_node_;
 
+  //
+  std::vector<double> symbols_;
+
+  // Multi-level lookup tables. The first one begins at zero.
+  std::vector<Entry> tables_;
+
+  //
+  int root_table_width_;
+
   //
   DISALLOW_COPY_AND_ASSIGN(HuffmanDecoding);
 };
@@ -45,10 +45,12 @@
 #ifndef SPTK_COMPRESSOR_HUFFMAN_ENCODING_H_
 #define SPTK_COMPRESSOR_HUFFMAN_ENCODING_H_
 
+#include <cstdint>        // std::uint32_t
 #include <fstream>        // std::ifstream
 #include <unordered_map>  // std::unordered_map
 #include <vector>         // std::vector
 
+#include "SPTK/utils/bit_stream.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -70,9 +72,51 @@ class HuffmanEncoding {
   //
   bool Run(double input, std::vector<bool>* output) const;
 
+  // Writes the codeword of the input symbol to the bit stream.
+  bool Run(double input, BitStreamWriter* output) const {
+    const int index(GetSymbolIndex(input));
+    if (index < 0 || NULL == output) {
+      return false;
+    }
+    const std::uint32_t* chunk(&(codeword_chunks_[codeword_offsets_[index]]));
+    int length(codeword_lengths_[index]);
+    for (; 32 < length; length -= 32) {
+      if (!output->Put(*chunk++, 32)) {
+        return false;
+      }
+    }
+    return output->Put(*chunk, length);
+  }
+
  private:
   //
-  std::unordered_map<double, std::vector<bool> > codebook_;
+  int GetSymbolIndex(double symbol) const {
+    if (!integer_symbol_indices_.empty()) {
+      const double index(symbol - minimum_integer_symbol_);
+      if (0.0 <= index && index < integer_symbol_indices_.size() &&
+          static_cast<int>(index) == index) {
+        return integer_symbol_indices_[static_cast<int>(index)];
+      }
+      return -1;
+    }
+    std::unordered_map<double, int>::const_iterator itr(
+        symbol_indices_.find(symbol));
+    return (symbol_indices_.end() == itr) ? -1 : itr->second;
+  }
+
+  // Dense index of each symbol.
+  std::unordered_map<double, int> symbol_indices_;
+
+  // If all symbols are integers in a small range, the dense index is directly
+  // looked up from the value.
+  double minimum_integer_symbol_;
+  std::vector<int> integer_symbol_indices_;
+
+  // Codeword of each symbol, stored in 32-bit chunks from the most significant
+  // bit. The last chunk holds the remaining bits in its lowest bits.
+  std::vector<std::uint32_t> codeword_chunks_;
+  std::vector<int> codeword_offsets_;
+  std::vector<int> codeword_lengths_;
 
   //
   bool is_valid_;
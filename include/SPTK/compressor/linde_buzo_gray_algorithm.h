@@ -60,7 +60,8 @@ class LindeBuzoGrayAlgorithm {
   LindeBuzoGrayAlgorithm(int num_order, int seed, int initial_codebook_size,
                          int target_codebook_size,
                          int minimum_num_vector_in_cluster, int num_iteration,
-                         double convergence_threshold, double splitting_factor);
+                         double convergence_threshold, double splitting_factor,
+                         bool fast_search_flag, int num_thread);
 
   //
   virtual ~LindeBuzoGrayAlgorithm() {
@@ -106,6 +107,16 @@ class LindeBuzoGrayAlgorithm {
     return splitting_factor_;
   }
 
+  //
+  bool GetFastSearchFlag() const {
+    return fast_search_flag_;
+  }
+
+  //
+  int GetNumThread() const {
+    return num_thread_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
@@ -141,6 +152,12 @@ class LindeBuzoGrayAlgorithm {
   //
   const double splitting_factor_;
 
+  //
+  const bool fast_search_flag_;
+
+  //
+  const int num_thread_;
+
   //
   const DistanceCalculator distance_calculator_;
 
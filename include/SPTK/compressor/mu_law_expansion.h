@@ -45,6 +45,8 @@
 #ifndef SPTK_COMPRESSOR_MU_LAW_EXPANSION_H_
 #define SPTK_COMPRESSOR_MU_LAW_EXPANSION_H_
 
+#include <vector>  // std::vector
+
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -105,6 +107,21 @@ class MuLawExpansion {
    */
   bool Run(double* input_and_output) const;
 
+  /**
+   * Expands each of the given data. Integer inputs whose magnitudes are not
+   * greater than \f$\min(V, 32768)\f$ are looked up in a table prepared in
+   * the constructor, which gives the same results as the above functions.
+   *
+   * @param[in] num_data Number of data.
+   * @param[in] uses_fast_approximation If true, the other inputs are expanded
+   *            by vectorized polynomials. The error is less than
+   *            \f$10^{-9} V\f$.
+   * @param[in,out] input_and_output Input/output data.
+   * @return True on success, false on failure.
+   */
+  bool Run(int num_data, bool uses_fast_approximation,
+           double* input_and_output) const;
+
  private:
   const double abs_max_value_;
   const double compression_factor_;
@@ -112,6 +129,9 @@ class MuLawExpansion {
 
   bool is_valid_;
 
+  int max_table_index_;
+  std::vector<double> outputs_for_integer_inputs_;
+
   DISALLOW_COPY_AND_ASSIGN(MuLawExpansion);
 };
 
@@ -47,6 +47,7 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/math/real_valued_fast_fourier_transform.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -77,6 +78,9 @@ class FilterCoefficientsToSpectrum {
     std::vector<double> fast_fourier_transform_imaginary_output_;
     std::vector<double> numerator_of_transfer_function_;
     std::vector<double> denominator_of_transfer_function_;
+    Matrix fast_fourier_transform_inputs_;
+    Matrix fast_fourier_transform_real_outputs_;
+    Matrix fast_fourier_transform_imaginary_outputs_;
     friend class FilterCoefficientsToSpectrum;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -133,7 +137,17 @@ class FilterCoefficientsToSpectrum {
            std::vector<double>* spectrum,
            FilterCoefficientsToSpectrum::Buffer* buffer) const;
 
+  // Calculates the spectrum of each row of numerator coefficients with common
+  // denominator coefficients. The storage of the output is reused if the size
+  // matches.
+  bool Run(const Matrix& numerator_coefficients,
+           const std::vector<double>& denominator_coefficients,
+           Matrix* spectra, FilterCoefficientsToSpectrum::Buffer* buffer) const;
+
  private:
+  //
+  bool ConvertPowerSpectrum(double* spectrum) const;
+
   //
   const int num_numerator_order_;
 
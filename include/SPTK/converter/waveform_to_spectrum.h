@@ -48,6 +48,7 @@
 #include <vector>  // std::vector
 
 #include "SPTK/converter/filter_coefficients_to_spectrum.h"
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -112,6 +113,11 @@ class WaveformToSpectrum {
   bool Run(const std::vector<double>& waveform, std::vector<double>* spectrum,
            WaveformToSpectrum::Buffer* buffer) const;
 
+  // Calculates the spectrum of each row of waveforms. The storage of the output
+  // is reused if the size matches.
+  bool Run(const Matrix& waveforms, Matrix* spectra,
+           WaveformToSpectrum::Buffer* buffer) const;
+
  private:
   //
   const FilterCoefficientsToSpectrum filter_coefficients_to_spectrum_;
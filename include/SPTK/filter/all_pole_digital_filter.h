@@ -68,11 +68,14 @@ namespace sptk {
  * \f]
  * an output signal is obtained by applying \f$H(z)\f$ to a input signal in time
  * domain.
+ *
+ * @tparam T Sample type, float or double.
  */
-class AllPoleDigitalFilter {
+template <typename T>
+class AllPoleDigitalFilterBase {
  public:
   /**
-   * Buffer for AllPoleDigitalFilter class.
+   * Buffer for AllPoleDigitalFilterBase class.
    */
   class Buffer {
    public:
@@ -83,9 +86,10 @@ class AllPoleDigitalFilter {
     }
 
    private:
-    std::vector<double> d_;
+    std::vector<T> d_;
+    std::vector<T> interpolated_filter_coefficients_;
 
-    friend class AllPoleDigitalFilter;
+    friend class AllPoleDigitalFilterBase;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
@@ -93,9 +97,9 @@ class AllPoleDigitalFilter {
    * @param[in] num_filter_order Order of filter coefficients, \f$M\f$.
    * @param[in] transposition If true, use transposed form filter.
    */
-  AllPoleDigitalFilter(int num_filter_order, bool transposition);
+  AllPoleDigitalFilterBase(int num_filter_order, bool transposition);
 
-  virtual ~AllPoleDigitalFilter() {
+  virtual ~AllPoleDigitalFilterBase() {
   }
 
   /**
@@ -126,8 +130,8 @@ class AllPoleDigitalFilter {
    * @param[in,out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& filter_coefficients, double filter_input,
-           double* filter_output, AllPoleDigitalFilter::Buffer* buffer) const;
+  bool Run(const std::vector<T>& filter_coefficients, T filter_input,
+           T* filter_output, AllPoleDigitalFilterBase::Buffer* buffer) const;
 
   /**
    * @param[in] filter_coefficients \f$M\f$-th order LPC coefficients.
@@ -135,19 +139,58 @@ class AllPoleDigitalFilter {
    * @param[in,out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& filter_coefficients,
-           double* input_and_output,
-           AllPoleDigitalFilter::Buffer* buffer) const;
+  bool Run(const std::vector<T>& filter_coefficients, T* input_and_output,
+           AllPoleDigitalFilterBase::Buffer* buffer) const;
+
+  /**
+   * Filter a block of signals with fixed filter coefficients.
+   *
+   * @param[in] filter_coefficients \f$M\f$-th order LPC coefficients.
+   * @param[in] filter_input Input signals.
+   * @param[out] filter_output Output signals.
+   * @param[in,out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<T>& filter_coefficients,
+           const std::vector<T>& filter_input, std::vector<T>* filter_output,
+           AllPoleDigitalFilterBase::Buffer* buffer) const;
+
+  /**
+   * Filter a block of signals with linearly interpolated filter coefficients.
+   * The \f$n\f$-th sample in the block of length \f$N\f$ is filtered by
+   * \f$a_0 + (a_1 - a_0) n / N\f$.
+   *
+   * @param[in] first_filter_coefficients Filter coefficients at the beginning
+   *            of the block, \f$a_0\f$.
+   * @param[in] next_filter_coefficients Filter coefficients at the beginning
+   *            of the next block, \f$a_1\f$.
+   * @param[in] filter_input Input signals.
+   * @param[out] filter_output Output signals.
+   * @param[in,out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<T>& first_filter_coefficients,
+           const std::vector<T>& next_filter_coefficients,
+           const std::vector<T>& filter_input, std::vector<T>* filter_output,
+           AllPoleDigitalFilterBase::Buffer* buffer) const;
 
  private:
+  void PrepareBuffer(AllPoleDigitalFilterBase::Buffer* buffer) const;
+
+  T ApplyFilter(const T* filter_coefficients, T filter_input,
+                AllPoleDigitalFilterBase::Buffer* buffer) const;
+
   const int num_filter_order_;
   const bool transposition_;
 
   bool is_valid_;
 
-  DISALLOW_COPY_AND_ASSIGN(AllPoleDigitalFilter);
+  DISALLOW_COPY_AND_ASSIGN(AllPoleDigitalFilterBase);
 };
 
+// Existing callers use the double-precision filter under the original name.
+typedef AllPoleDigitalFilterBase<double> AllPoleDigitalFilter;
+
 }  // namespace sptk
 
 #endif  // SPTK_FILTER_ALL_POLE_DIGITAL_FILTER_H_
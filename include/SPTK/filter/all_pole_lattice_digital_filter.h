@@ -67,6 +67,9 @@ class AllPoleLatticeDigitalFilter {
     //
     std::vector<double> signals_;
 
+    //
+    std::vector<double> interpolated_filter_coefficients_;
+
     //
     friend class AllPoleLatticeDigitalFilter;
 
@@ -101,7 +104,29 @@ class AllPoleLatticeDigitalFilter {
            double* filter_output,
            AllPoleLatticeDigitalFilter::Buffer* signals) const;
 
+  // Filter a block of signals with fixed filter coefficients.
+  bool Run(const std::vector<double>& filter_coefficients,
+           const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           AllPoleLatticeDigitalFilter::Buffer* buffer) const;
+
+  // Filter a block of signals with filter coefficients linearly interpolated
+  // from first_filter_coefficients to next_filter_coefficients, i.e., the n-th
+  // sample of N samples is filtered by c0 + (c1 - c0) * n / N.
+  bool Run(const std::vector<double>& first_filter_coefficients,
+           const std::vector<double>& next_filter_coefficients,
+           const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           AllPoleLatticeDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void PrepareBuffer(AllPoleLatticeDigitalFilter::Buffer* buffer) const;
+
+  //
+  double ApplyFilter(const double* filter_coefficients, double filter_input,
+                     AllPoleLatticeDigitalFilter::Buffer* buffer) const;
+
   //
   const int num_filter_order_;
 
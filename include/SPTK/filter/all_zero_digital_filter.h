@@ -47,6 +47,9 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/math/inverse_fast_fourier_transform.h"
+#include "SPTK/math/real_valued_fast_fourier_transform.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -68,24 +71,43 @@ namespace sptk {
  * \f]
  * an output signal is obtained by applying \f$H(z)\f$ to a input signal in time
  * domain.
+ *
+ * If the filter is not transposed and its order is high, a block of signals
+ * with fixed filter coefficients is filtered in frequency domain by the
+ * overlap-save method when it is estimated to be faster. The results differ
+ * from those of the direct form by rounding errors.
+ *
+ * @tparam T Sample type, float or double.
  */
-class AllZeroDigitalFilter {
+template <typename T>
+class AllZeroDigitalFilterBase {
  public:
   /**
-   * Buffer for AllZeroDigitalFilter class.
+   * Buffer for AllZeroDigitalFilterBase class.
    */
   class Buffer {
    public:
-    Buffer() {
+    Buffer() : position_in_d_(0) {
     }
 
     virtual ~Buffer() {
     }
 
    private:
-    std::vector<double> d_;
-
-    friend class AllZeroDigitalFilter;
+    std::vector<T> d_;
+    int position_in_d_;
+    std::vector<T> interpolated_filter_coefficients_;
+
+    std::vector<T> cached_filter_coefficients_;
+    std::vector<T> real_part_of_filter_spectrum_;
+    std::vector<T> imag_part_of_filter_spectrum_;
+    std::vector<T> extended_signal_;
+    std::vector<T> real_part_;
+    std::vector<T> imag_part_;
+    typename RealValuedFastFourierTransformBase<T>::Buffer
+        fourier_transform_buffer_;
+
+    friend class AllZeroDigitalFilterBase;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
@@ -93,9 +115,9 @@ class AllZeroDigitalFilter {
    * @param[in] num_filter_order Order of filter coefficients, \f$M\f$.
    * @param[in] transposition If true, use transposed form filter.
    */
-  AllZeroDigitalFilter(int num_filter_order, bool transposition);
+  AllZeroDigitalFilterBase(int num_filter_order, bool transposition);
 
-  virtual ~AllZeroDigitalFilter() {
+  virtual ~AllZeroDigitalFilterBase() {
   }
 
   /**
@@ -126,8 +148,8 @@ class AllZeroDigitalFilter {
    * @param[in,out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& filter_coefficients, double filter_input,
-           double* filter_output, AllZeroDigitalFilter::Buffer* buffer) const;
+  bool Run(const std::vector<T>& filter_coefficients, T filter_input,
+           T* filter_output, AllZeroDigitalFilterBase::Buffer* buffer) const;
 
   /**
    * @param[in] filter_coefficients \f$M\f$-th order FIR filter coefficients.
@@ -135,19 +157,73 @@ class AllZeroDigitalFilter {
    * @param[in,out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& filter_coefficients,
-           double* input_and_output,
-           AllZeroDigitalFilter::Buffer* buffer) const;
+  bool Run(const std::vector<T>& filter_coefficients, T* input_and_output,
+           AllZeroDigitalFilterBase::Buffer* buffer) const;
+
+  /**
+   * Filter a block of signals with fixed filter coefficients. The overlap-save
+   * method is used if it is estimated to be faster than the direct form. The
+   * spectrum of the filter coefficients is cached in the buffer.
+   *
+   * @param[in] filter_coefficients \f$M\f$-th order FIR filter coefficients.
+   * @param[in] filter_input Input signals.
+   * @param[out] filter_output Output signals.
+   * @param[in,out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<T>& filter_coefficients,
+           const std::vector<T>& filter_input, std::vector<T>* filter_output,
+           AllZeroDigitalFilterBase::Buffer* buffer) const;
+
+  /**
+   * Filter a block of signals with linearly interpolated filter coefficients.
+   * The \f$n\f$-th sample in the block of length \f$N\f$ is filtered by
+   * \f$b_0 + (b_1 - b_0) n / N\f$.
+   *
+   * @param[in] first_filter_coefficients Filter coefficients at the beginning
+   *            of the block, \f$b_0\f$.
+   * @param[in] next_filter_coefficients Filter coefficients at the beginning
+   *            of the next block, \f$b_1\f$.
+   * @param[in] filter_input Input signals.
+   * @param[out] filter_output Output signals.
+   * @param[in,out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<T>& first_filter_coefficients,
+           const std::vector<T>& next_filter_coefficients,
+           const std::vector<T>& filter_input, std::vector<T>* filter_output,
+           AllZeroDigitalFilterBase::Buffer* buffer) const;
 
  private:
+  void PrepareBuffer(AllZeroDigitalFilterBase::Buffer* buffer) const;
+
+  T ApplyFilter(const T* filter_coefficients, T filter_input,
+                AllZeroDigitalFilterBase::Buffer* buffer) const;
+
+  bool UsesFastConvolution(int block_length) const;
+
+  bool ApplyFilterInFrequencyDomain(
+      const std::vector<T>& filter_coefficients,
+      const std::vector<T>& filter_input, std::vector<T>* filter_output,
+      AllZeroDigitalFilterBase::Buffer* buffer) const;
+
   const int num_filter_order_;
   const bool transposition_;
 
+  // FFT length of the overlap-save method, or zero if it is never used.
+  const int fft_length_;
+  const RealValuedFastFourierTransformBase<T> fourier_transform_for_filter_;
+  const FastFourierTransformBase<T> fourier_transform_;
+  const InverseFastFourierTransformBase<T> inverse_fourier_transform_;
+
   bool is_valid_;
 
-  DISALLOW_COPY_AND_ASSIGN(AllZeroDigitalFilter);
+  DISALLOW_COPY_AND_ASSIGN(AllZeroDigitalFilterBase);
 };
 
+// Keep the pre-template name for the double-precision filter.
+typedef AllZeroDigitalFilterBase<double> AllZeroDigitalFilter;
+
 }  // namespace sptk
 
 #endif  // SPTK_FILTER_ALL_ZERO_DIGITAL_FILTER_H_
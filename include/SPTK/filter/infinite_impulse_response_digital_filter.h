@@ -105,7 +105,21 @@ class InfiniteImpulseResponseDigitalFilter {
   bool Run(double filter_input, double* filter_output,
            InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const;
 
+  // Filter a block of signals.
+  bool Run(const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void PrepareBuffer(
+      InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const;
+
+  //
+  double ApplyFilter(
+      double filter_input,
+      InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const;
+
   //
   const std::vector<double> denominator_filter_coefficients_;
 
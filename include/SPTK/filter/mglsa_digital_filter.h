@@ -64,6 +64,7 @@ class MglsaDigitalFilter {
    private:
     std::vector<double> signals_;
     MlsaDigitalFilter::Buffer mlsa_digital_filter_buffer_;
+    std::vector<double> interpolated_filter_coefficients_;
     friend class MglsaDigitalFilter;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -110,7 +111,29 @@ class MglsaDigitalFilter {
   bool Run(const std::vector<double>& filter_coefficients, double filter_input,
            double* filter_output, MglsaDigitalFilter::Buffer* buffer) const;
 
+  // Filter a block of signals with fixed filter coefficients.
+  bool Run(const std::vector<double>& filter_coefficients,
+           const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           MglsaDigitalFilter::Buffer* buffer) const;
+
+  // Filter a block of signals with filter coefficients linearly interpolated
+  // from first_filter_coefficients to next_filter_coefficients, i.e., the n-th
+  // sample of N samples is filtered by c0 + (c1 - c0) * n / N.
+  bool Run(const std::vector<double>& first_filter_coefficients,
+           const std::vector<double>& next_filter_coefficients,
+           const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           MglsaDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void PrepareBuffer(MglsaDigitalFilter::Buffer* buffer) const;
+
+  //
+  double ApplyFilter(const double* filter_coefficients, double filter_input,
+                     MglsaDigitalFilter::Buffer* buffer) const;
+
   //
   const int num_filter_order_;
 
@@ -65,6 +65,7 @@ class MlsaDigitalFilter {
     std::vector<double> signals_for_basic_filter2_;
     std::vector<double> signals_for_exp_filter1_;
     std::vector<double> signals_for_exp_filter2_;
+    std::vector<double> interpolated_filter_coefficients_;
     friend class MlsaDigitalFilter;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -106,7 +107,29 @@ class MlsaDigitalFilter {
   bool Run(const std::vector<double>& filter_coefficients, double filter_input,
            double* filter_output, MlsaDigitalFilter::Buffer* buffer) const;
 
+  // Filter a block of signals with fixed filter coefficients.
+  bool Run(const std::vector<double>& filter_coefficients,
+           const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           MlsaDigitalFilter::Buffer* buffer) const;
+
+  // Filter a block of signals with filter coefficients linearly interpolated
+  // from first_filter_coefficients to next_filter_coefficients, i.e., the n-th
+  // sample of N samples is filtered by c0 + (c1 - c0) * n / N.
+  bool Run(const std::vector<double>& first_filter_coefficients,
+           const std::vector<double>& next_filter_coefficients,
+           const std::vector<double>& filter_input,
+           std::vector<double>* filter_output,
+           MlsaDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void PrepareBuffer(MlsaDigitalFilter::Buffer* buffer) const;
+
+  //
+  double ApplyFilter(const double* filter_coefficients, double filter_input,
+                     MlsaDigitalFilter::Buffer* buffer) const;
+
   //
   const int num_filter_order_;
 
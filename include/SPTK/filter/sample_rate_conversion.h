@@ -0,0 +1,199 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+
+#ifndef SPTK_FILTER_SAMPLE_RATE_CONVERSION_H_
+#define SPTK_FILTER_SAMPLE_RATE_CONVERSION_H_
+
+#include <cstdint>  // int64_t
+#include <vector>   // std::vector
+
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Change the sampling rate of signals by a rational factor \f$L/M\f$.
+ *
+ * The input signal is conceptually upsampled by inserting \f$L-1\f$ zeros
+ * between samples, lowpass filtered, and downsampled by keeping every
+ * \f$M\f$-th sample. The lowpass filter is a Kaiser-windowed sinc function
+ * whose stopband edge is \f$\pi/\max(L,M)\f$. The filter is split into \f$L\f$
+ * polyphase components in the constructor so that each output sample is
+ * calculated by an inner product of a component and the input signal, i.e.,
+ * the inserted zeros and the discarded samples are never computed.
+ *
+ * The delay of the filter is compensated, so the \f$n\f$-th output sample
+ * corresponds to the time \f$nM/L\f$ of the input signal, and
+ * \f$\lceil NL/M \rceil\f$ samples are output for \f$N\f$ input samples.
+ */
+class SampleRateConversion {
+ public:
+  /**
+   * Buffer for SampleRateConversion class.
+   */
+  class Buffer {
+   public:
+    Buffer() : is_initialized_(false) {
+    }
+
+    virtual ~Buffer() {
+    }
+
+   private:
+    std::vector<double> signal_;
+    int64_t first_input_index_;
+    int64_t num_input_;
+    int64_t num_output_;
+    bool is_initialized_;
+
+    friend class SampleRateConversion;
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  /**
+   * @param[in] upsampling_factor Upsampling factor, \f$L\f$.
+   * @param[in] downsampling_factor Downsampling factor, \f$M\f$.
+   * @param[in] stopband_attenuation Stopband attenuation of the lowpass
+   *            filter in dB.
+   * @param[in] transition_width Width of the transition band of the lowpass
+   *            filter relative to \f$\pi/\max(L,M)\f$.
+   */
+  SampleRateConversion(int upsampling_factor, int downsampling_factor,
+                       double stopband_attenuation, double transition_width);
+
+  virtual ~SampleRateConversion() {
+  }
+
+  /**
+   * @return Upsampling factor reduced to lowest terms.
+   */
+  int GetUpsamplingFactor() const {
+    return upsampling_factor_;
+  }
+
+  /**
+   * @return Downsampling factor reduced to lowest terms.
+   */
+  int GetDownsamplingFactor() const {
+    return downsampling_factor_;
+  }
+
+  /**
+   * @return Stopband attenuation.
+   */
+  double GetStopbandAttenuation() const {
+    return stopband_attenuation_;
+  }
+
+  /**
+   * @return Transition width.
+   */
+  double GetTransitionWidth() const {
+    return transition_width_;
+  }
+
+  /**
+   * @return Number of taps of each polyphase component.
+   */
+  int GetNumTapPerPhase() const {
+    return num_tap_per_phase_;
+  }
+
+  /**
+   * @return True if this object is valid.
+   */
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * Convert a block of signals. The output samples which depend on the future
+   * input samples are kept in the buffer and output in the following calls.
+   *
+   * @param[in] input Input signals.
+   * @param[out] output Output signals.
+   * @param[in,out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<double>& input, std::vector<double>* output,
+           SampleRateConversion::Buffer* buffer) const;
+
+  /**
+   * Output the remaining samples assuming that the input signal is followed by
+   * zeros. The buffer is then reset for a new signal.
+   *
+   * @param[out] output Output signals.
+   * @param[in,out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Flush(std::vector<double>* output,
+             SampleRateConversion::Buffer* buffer) const;
+
+ private:
+  void PrepareBuffer(SampleRateConversion::Buffer* buffer) const;
+
+  void Convert(int64_t num_output, std::vector<double>* output,
+               SampleRateConversion::Buffer* buffer) const;
+
+  int upsampling_factor_;
+  int downsampling_factor_;
+  const double stopband_attenuation_;
+  const double transition_width_;
+
+  int half_length_;
+  int num_tap_per_phase_;
+
+  bool is_valid_;
+
+  // The r-th tap of the p-th polyphase component is stored at
+  // polyphase_filters_[p * num_tap_per_phase_ + r] in reversed order.
+  std::vector<double> polyphase_filters_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleRateConversion);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_FILTER_SAMPLE_RATE_CONVERSION_H_
@@ -45,6 +45,8 @@
 #ifndef SPTK_GENERATOR_EXCITATION_GENERATION_H_
 #define SPTK_GENERATOR_EXCITATION_GENERATION_H_
 
+#include <vector>  // std::vector
+
 #include "SPTK/generator/random_generation_interface.h"
 #include "SPTK/input/input_source_interpolation_with_magic_number.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -69,7 +71,18 @@ class ExcitationGeneration {
   //
   bool Get(double* excitation, double* pulse, double* noise, double* pitch);
 
+  // Generates at most max_num_sample samples. Each output can be NULL;
+  // otherwise, it must have room for max_num_sample values. Fewer samples are
+  // generated only at the end of input or at an invalid pitch, in which case
+  // the generated samples are counted in num_sample and false is returned.
+  bool GetBlock(int max_num_sample, double* excitation, double* pulse,
+                double* noise, double* pitch, int* num_sample);
+
  private:
+  //
+  void Generate(double pitch_in_current_point, double noise_in_current_point,
+                double* excitation, double* pulse);
+
   //
   InputSourceInterpolationWithMagicNumber* input_source_;
 
@@ -82,6 +95,9 @@ class ExcitationGeneration {
   // from 0.0 to 1.0
   double phase_;
 
+  //
+  std::vector<double> pitch_buffer_;
+
   //
   DISALLOW_COPY_AND_ASSIGN(ExcitationGeneration);
 };
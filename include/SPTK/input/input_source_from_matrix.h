@@ -93,6 +93,9 @@ class InputSourceFromMatrix : public InputSourceInterface {
   //
   virtual bool Get(std::vector<double>* buffer);
 
+  //
+  virtual bool GetBlock(int max_num_frame, double* buffer, int* num_frame);
+
  private:
   //
   const int row_size_;
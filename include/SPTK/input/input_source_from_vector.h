@@ -92,6 +92,9 @@ class InputSourceFromVector : public InputSourceInterface {
   //
   virtual bool Get(std::vector<double>* buffer);
 
+  //
+  virtual bool GetBlock(int max_num_frame, double* buffer, int* num_frame);
+
  private:
   //
   const bool zero_padding_;
@@ -45,7 +45,9 @@
 #ifndef SPTK_INPUT_INPUT_SOURCE_INTERFACE_H_
 #define SPTK_INPUT_INPUT_SOURCE_INTERFACE_H_
 
-#include <vector>  // std::vector
+#include <algorithm>  // std::copy
+#include <cstddef>    // NULL
+#include <vector>     // std::vector
 
 namespace sptk {
 
@@ -63,6 +65,24 @@ class InputSourceInterface {
 
   //
   virtual bool Get(std::vector<double>* buffer) = 0;
+
+  // Gets at most max_num_frame frames and stores them contiguously in buffer,
+  // which must have room for max_num_frame * GetSize() values. Fewer frames are
+  // stored only at the end of input. Returns false if no frame is stored.
+  virtual bool GetBlock(int max_num_frame, double* buffer, int* num_frame) {
+    if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame) {
+      return false;
+    }
+    const int size(GetSize());
+    std::vector<double> frame;
+    int n(0);
+    while (n < max_num_frame && Get(&frame)) {
+      std::copy(frame.begin(), frame.begin() + size, buffer + n * size);
+      ++n;
+    }
+    *num_frame = n;
+    return 0 < n;
+  }
 };
 
 }  // namespace sptk
@@ -91,10 +91,16 @@ class InputSourceInterpolation : public InputSourceInterface {
   //
   virtual bool Get(std::vector<double>* buffer);
 
+  //
+  virtual bool GetBlock(int max_num_frame, double* buffer, int* num_frame);
+
  private:
   //
   void CalculateIncrement();
 
+  // Copies the current data to buffer and proceeds to the next point.
+  void Proceed(double* buffer);
+
   //
   const int frame_period_;
 
@@ -94,7 +94,13 @@ class InputSourcePreprocessingForFilterGain : public InputSourceInterface {
   //
   virtual bool Get(std::vector<double>* buffer);
 
+  //
+  virtual bool GetBlock(int max_num_frame, double* buffer, int* num_frame);
+
  private:
+  //
+  bool Preprocess(double* frame, int size) const;
+
   //
   const FilterGainType gain_type_;
 
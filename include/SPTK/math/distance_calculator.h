@@ -47,6 +47,7 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -88,6 +89,26 @@ class DistanceCalculator {
   bool Run(const std::vector<double>& vector1,
            const std::vector<double>& vector2, double* distance) const;
 
+  // Calculates the distance between float vectors. The distance is
+  // accumulated in double precision.
+  bool Run(const std::vector<float>& vector1, const std::vector<float>& vector2,
+           double* distance) const;
+
+  // Calculates the distances between a vector and each row of a matrix.
+  bool Run(const std::vector<double>& vector, const Matrix& matrix,
+           std::vector<double>* distances) const;
+
+  // Calculates the distances between a vector and num_row rows of a matrix
+  // starting from row_offset.
+  bool Run(const std::vector<double>& vector, const Matrix& matrix,
+           int row_offset, int num_row, std::vector<double>* distances) const;
+
+  // The (i, j)-th element of the output is the distance between the i-th row
+  // of the first matrix and the j-th row of the second matrix. The storage of
+  // the output is reused if the size matches.
+  bool Run(const Matrix& first_matrix, const Matrix& second_matrix,
+           Matrix* distances) const;
+
  private:
   //
   const int num_order_;
@@ -67,10 +67,26 @@ class DynamicTimeWarping {
     kNumTypes
   };
 
+  //
+  enum GlobalPathConstraints {
+    kNone = 0,
+    kSakoeChibaBand,
+    kItakuraParallelogram,
+    kNumGlobalPathConstraints
+  };
+
   //
   DynamicTimeWarping(int num_order, LocalPathConstraints local_path_constraint,
                      DistanceCalculator::DistanceMetrics distance_metric);
 
+  // The parameter of global path constraint is the half width of the band in
+  // frames for Sakoe-Chiba band or the maximum slope for Itakura
+  // parallelogram.
+  DynamicTimeWarping(int num_order, LocalPathConstraints local_path_constraint,
+                     DistanceCalculator::DistanceMetrics distance_metric,
+                     GlobalPathConstraints global_path_constraint,
+                     double global_path_constraint_parameter);
+
   //
   virtual ~DynamicTimeWarping() {
   }
@@ -90,6 +106,16 @@ class DynamicTimeWarping {
     return distance_calculator_.GetDistanceMetric();
   }
 
+  //
+  GlobalPathConstraints GetGlobalPathConstraint() const {
+    return global_path_constraint_;
+  }
+
+  //
+  double GetGlobalPathConstraintParameter() const {
+    return global_path_constraint_parameter_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
@@ -101,7 +127,26 @@ class DynamicTimeWarping {
            std::vector<std::pair<int, int> >* viterbi_path,
            double* total_score) const;
 
+  // Compute only total score. Memory usage is proportional to the length of
+  // reference vector sequence.
+  bool Run(const std::vector<std::vector<double> >& query_vector_sequence,
+           const std::vector<std::vector<double> >& reference_vector_sequence,
+           double* total_score) const;
+
+  // Align multiple pairs of sequences using threads. If viterbi_paths is NULL,
+  // only total scores are computed.
+  bool Run(const std::vector<std::vector<std::vector<double> > >&
+               query_vector_sequences,
+           const std::vector<std::vector<std::vector<double> > >&
+               reference_vector_sequences,
+           int num_thread,
+           std::vector<std::vector<std::pair<int, int> > >* viterbi_paths,
+           std::vector<double>* total_scores) const;
+
  private:
+  //
+  void Initialize();
+
   //
   const int num_order_;
 
@@ -111,6 +156,12 @@ class DynamicTimeWarping {
   //
   const DistanceCalculator distance_calculator_;
 
+  //
+  const GlobalPathConstraints global_path_constraint_;
+
+  //
+  const double global_path_constraint_parameter_;
+
   //
   bool is_valid_;
 
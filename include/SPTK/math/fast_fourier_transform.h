@@ -51,6 +51,9 @@
 
 namespace sptk {
 
+template <typename T>
+class RealValuedFastFourierTransformBase;
+
 /**
  * Calculate DFT of complex-valued input data.
  *
@@ -70,21 +73,24 @@ namespace sptk {
  * \f]
  * where \f$L\f$ is the FFT length and \f$X\f$ is the frequency representation
  * of \f$x\f$.
+ *
+ * @tparam T Sample type, float or double.
  */
-class FastFourierTransform {
+template <typename T>
+class FastFourierTransformBase {
  public:
   /**
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  explicit FastFourierTransform(int fft_length);
+  explicit FastFourierTransformBase(int fft_length);
 
   /**
    * @param[in] num_order Order of input, \f$M\f$.
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  FastFourierTransform(int num_order, int fft_length);
+  FastFourierTransformBase(int num_order, int fft_length);
 
-  virtual ~FastFourierTransform() {
+  virtual ~FastFourierTransformBase() {
   }
 
   /**
@@ -115,31 +121,42 @@ class FastFourierTransform {
    * @param[out] imag_part_output Imaginary part of output.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& real_part_input,
-           const std::vector<double>& imag_part_input,
-           std::vector<double>* real_part_output,
-           std::vector<double>* imag_part_output) const;
+  bool Run(const std::vector<T>& real_part_input,
+           const std::vector<T>& imag_part_input,
+           std::vector<T>* real_part_output,
+           std::vector<T>* imag_part_output) const;
 
   /**
    * @param[in,out] real_part Real part.
    * @param[in,out] imag_part Imaginary part.
    * @return True on success, false on failure.
    */
-  bool Run(std::vector<double>* real_part,
-           std::vector<double>* imag_part) const;
+  bool Run(std::vector<T>* real_part, std::vector<T>* imag_part) const;
 
  private:
+  // Transforms the data of FFT length in place.
+  void RunInPlace(T* x, T* y) const;
+
+  // Performs butterflies on the data in bit reversed order.
+  void RunButterflies(T* x, T* y) const;
+
   const int num_order_;
   const int fft_length_;
   const int half_fft_length_;
 
   bool is_valid_;
 
-  std::vector<double> sine_table_;
+  std::vector<int> bit_reversal_table_;
+  std::vector<T> twiddle_factor_;
 
-  DISALLOW_COPY_AND_ASSIGN(FastFourierTransform);
+  friend class RealValuedFastFourierTransformBase<T>;
+  DISALLOW_COPY_AND_ASSIGN(FastFourierTransformBase);
 };
 
+// FastFourierTransform is the double-precision FFT, as it was before the
+// class became a template.
+typedef FastFourierTransformBase<double> FastFourierTransform;
+
 }  // namespace sptk
 
 #endif  // SPTK_MATH_FAST_FOURIER_TRANSFORM_H_
@@ -94,11 +94,14 @@ namespace sptk {
  * [2] K. Tokuda, T. Kobayashi, T. Masuko, and S. Imai, &quot;Mel-generalized
  *     cepstral representation of speech - A unified approach to speech spectral
  *     estimation,&quot; Proc. of ICSLP 1994, pp. 1043-1046, 1994.
+ *
+ * @tparam T Sample type, float or double.
  */
-class FrequencyTransform {
+template <typename T>
+class FrequencyTransformBase {
  public:
   /**
-   * Buffer for FrequencyTransform class.
+   * Buffer for FrequencyTransformBase class.
    */
   class Buffer {
    public:
@@ -109,9 +112,9 @@ class FrequencyTransform {
     }
 
    private:
-    std::vector<double> d_;
+    std::vector<T> d_;
 
-    friend class FrequencyTransform;
+    friend class FrequencyTransformBase;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
@@ -120,9 +123,10 @@ class FrequencyTransform {
    * @param[in] num_output_order Order of output, \f$M_2\f$.
    * @param[in] alpha Frequency warping factor, \f$\alpha\f$.
    */
-  FrequencyTransform(int num_input_order, int num_output_order, double alpha);
+  FrequencyTransformBase(int num_input_order, int num_output_order,
+                         double alpha);
 
-  virtual ~FrequencyTransform() {
+  virtual ~FrequencyTransformBase() {
   }
 
   /**
@@ -159,9 +163,9 @@ class FrequencyTransform {
    * @param[out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& minimum_phase_sequence,
-           std::vector<double>* warped_sequence,
-           FrequencyTransform::Buffer* buffer) const;
+  bool Run(const std::vector<T>& minimum_phase_sequence,
+           std::vector<T>* warped_sequence,
+           FrequencyTransformBase::Buffer* buffer) const;
 
  private:
   const int num_input_order_;
@@ -170,9 +174,12 @@ class FrequencyTransform {
 
   bool is_valid_;
 
-  DISALLOW_COPY_AND_ASSIGN(FrequencyTransform);
+  DISALLOW_COPY_AND_ASSIGN(FrequencyTransformBase);
 };
 
+// Keep the pre-template name for the double-precision transform.
+typedef FrequencyTransformBase<double> FrequencyTransform;
+
 }  // namespace sptk
 
 #endif  // SPTK_MATH_FREQUENCY_TRANSFORM_H_
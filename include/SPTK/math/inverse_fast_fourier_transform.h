@@ -71,21 +71,24 @@ namespace sptk {
  * \f]
  * where \f$L\f$ is the FFT length and \f$X\f$ is the complex-valued inverse FFT
  * sequence of \f$x\f$.
+ *
+ * @tparam T Sample type, float or double.
  */
-class InverseFastFourierTransform {
+template <typename T>
+class InverseFastFourierTransformBase {
  public:
   /**
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  explicit InverseFastFourierTransform(int fft_length);
+  explicit InverseFastFourierTransformBase(int fft_length);
 
   /**
    * @param[in] num_order Order of input, \f$M\f$.
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  InverseFastFourierTransform(int num_order, int fft_length);
+  InverseFastFourierTransformBase(int num_order, int fft_length);
 
-  virtual ~InverseFastFourierTransform() {
+  virtual ~InverseFastFourierTransformBase() {
   }
 
   /**
@@ -116,25 +119,27 @@ class InverseFastFourierTransform {
    * @param[out] imag_part_output Imaginary part of output.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& real_part_input,
-           const std::vector<double>& imag_part_input,
-           std::vector<double>* real_part_output,
-           std::vector<double>* imag_part_output) const;
+  bool Run(const std::vector<T>& real_part_input,
+           const std::vector<T>& imag_part_input,
+           std::vector<T>* real_part_output,
+           std::vector<T>* imag_part_output) const;
 
   /**
    * @param[in,out] real_part Real part.
    * @param[in,out] imag_part Imaginary part.
    * @return True on success, false on failure.
    */
-  bool Run(std::vector<double>* real_part,
-           std::vector<double>* imag_part) const;
+  bool Run(std::vector<T>* real_part, std::vector<T>* imag_part) const;
 
  private:
-  const FastFourierTransform fast_fourier_transform_;
+  const FastFourierTransformBase<T> fast_fourier_transform_;
 
-  DISALLOW_COPY_AND_ASSIGN(InverseFastFourierTransform);
+  DISALLOW_COPY_AND_ASSIGN(InverseFastFourierTransformBase);
 };
 
+// Source-compatible name of the double-precision inverse FFT.
+typedef InverseFastFourierTransformBase<double> InverseFastFourierTransform;
+
 }  // namespace sptk
 
 #endif  // SPTK_MATH_INVERSE_FAST_FOURIER_TRANSFORM_H_
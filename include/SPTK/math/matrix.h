@@ -117,6 +117,18 @@ class Matrix {
   //
   Matrix operator-() const;
 
+  // Output may be the same object as an input.
+  static bool Add(const Matrix& first_matrix, const Matrix& second_matrix,
+                  Matrix* output);
+
+  // Output may be the same object as an input.
+  static bool Subtract(const Matrix& first_matrix, const Matrix& second_matrix,
+                       Matrix* output);
+
+  // Output must not be an input. Its storage is reused if the size matches.
+  static bool Multiply(const Matrix& first_matrix, const Matrix& second_matrix,
+                       Matrix* output);
+
   //
   void Fill(double value);
 
@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_MATH_MIXED_RADIX_FAST_FOURIER_TRANSFORM_H_
+#define SPTK_MATH_MIXED_RADIX_FAST_FOURIER_TRANSFORM_H_
+
+#include <vector>  // std::vector
+
+#include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Calculate DFT of complex-valued input data of arbitrary length.
+ *
+ * The input is \f$(L-1)\f$-th order complex-valued data:
+ * \f[
+ *   \begin{array}{cccc}
+ *   \mathrm{Re}(x(0)), & \mathrm{Re}(x(1)), & \ldots, & \mathrm{Re}(x(L-1)), \\
+ *   \mathrm{Im}(x(0)), & \mathrm{Im}(x(1)), & \ldots, & \mathrm{Im}(x(L-1)),
+ *   \end{array}
+ * \f]
+ * The outputs are
+ * \f[
+ *   \begin{array}{cccc}
+ *   \mathrm{Re}(X(0)), & \mathrm{Re}(X(1)), & \ldots, & \mathrm{Re}(X(L-1)), \\
+ *   \mathrm{Im}(X(0)), & \mathrm{Im}(X(1)), & \ldots, & \mathrm{Im}(X(L-1)),
+ *   \end{array}
+ * \f]
+ * where \f$L\f$ is the DFT length and \f$X\f$ is the frequency representation
+ * of \f$x\f$.
+ *
+ * If \f$L\f$ can be factorized into 2, 3, 4, and 5, the transform is computed
+ * by the decimation-in-time mixed-radix algorithm. Otherwise, Bluestein's
+ * algorithm is used, i.e., the DFT is rewritten as a circular convolution with
+ * a chirp sequence and computed by power-of-two FFTs. In both cases, the
+ * computational cost is \f$O(L \log L)\f$.
+ */
+class MixedRadixFastFourierTransform {
+ public:
+  /**
+   * @param[in] fft_length DFT length, \f$L\f$.
+   */
+  explicit MixedRadixFastFourierTransform(int fft_length);
+
+  virtual ~MixedRadixFastFourierTransform() {
+    delete fast_fourier_transform_;
+  }
+
+  /**
+   * @return DFT length.
+   */
+  int GetFftLength() const {
+    return fft_length_;
+  }
+
+  /**
+   * @return True if Bluestein's algorithm is used.
+   */
+  bool IsBluesteinUsed() const {
+    return NULL != fast_fourier_transform_;
+  }
+
+  /**
+   * @return True if this obejct is valid.
+   */
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * @param[in] real_part_input Real part of input.
+   * @param[in] imag_part_input Imaginary part of input.
+   * @param[out] real_part_output Real part of output.
+   * @param[out] imag_part_output Imaginary part of output.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<double>& real_part_input,
+           const std::vector<double>& imag_part_input,
+           std::vector<double>* real_part_output,
+           std::vector<double>* imag_part_output) const;
+
+ private:
+  bool RunMixedRadix(const std::vector<double>& real_part_input,
+                     const std::vector<double>& imag_part_input,
+                     std::vector<double>* real_part_output,
+                     std::vector<double>* imag_part_output) const;
+
+  bool RunBluestein(const std::vector<double>& real_part_input,
+                    const std::vector<double>& imag_part_input,
+                    std::vector<double>* real_part_output,
+                    std::vector<double>* imag_part_output) const;
+
+  const int fft_length_;
+
+  bool is_valid_;
+
+  // Radices of each stage for the mixed-radix algorithm.
+  std::vector<int> radices_;
+
+  // Input index reordered by the mixed-radix digit reversal.
+  std::vector<int> permutation_table_;
+
+  // Twiddle factors of all stages.
+  std::vector<double> cosine_table_;
+  std::vector<double> sine_table_;
+
+  // Power-of-two FFT for Bluestein's algorithm.
+  FastFourierTransform* fast_fourier_transform_;
+
+  // Chirp sequence and its spectrum for Bluestein's algorithm.
+  std::vector<double> chirp_real_part_;
+  std::vector<double> chirp_imag_part_;
+  std::vector<double> chirp_spectrum_real_part_;
+  std::vector<double> chirp_spectrum_imag_part_;
+
+  DISALLOW_COPY_AND_ASSIGN(MixedRadixFastFourierTransform);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_MATH_MIXED_RADIX_FAST_FOURIER_TRANSFORM_H_
@@ -56,6 +56,19 @@ namespace sptk {
 
 class PrincipalComponentAnalysis {
  public:
+  // Algorithms for diagonalizing the covariance matrix.
+  //   kJacobi: cyclic Jacobi method.
+  //   kHouseholderQr: Householder tridiagonalization followed by the implicit
+  //     QL method. All eigenpairs are calculated in O(D^3).
+  //   kSubspaceIteration: randomized subspace iteration. Only the leading
+  //     eigenpairs are calculated in O(D^2 k) per iteration.
+  enum Algorithms {
+    kJacobi = 0,
+    kHouseholderQr,
+    kSubspaceIteration,
+    kNumAlgorithms
+  };
+
   class Buffer {
    public:
     Buffer() {
@@ -65,15 +78,24 @@ class PrincipalComponentAnalysis {
 
    private:
     StatisticsAccumulator::Buffer accumulator_buffer_;
+    Matrix input_vectors_;
     SymmetricMatrix a_;
     std::vector<int> eigenvalue_order_;
+    Matrix covariance_;
+    Matrix basis_;
+    Matrix product_;
+    Matrix projected_covariance_;
+    Matrix rotation_;
+    std::vector<double> diagonal_elements_;
+    std::vector<double> off_diagonal_elements_;
     friend class PrincipalComponentAnalysis;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
-  //
+  // The number of principal components is used only in the subspace iteration.
   PrincipalComponentAnalysis(int num_order, int num_iteration,
-                             double convergence_threshold);
+                             double convergence_threshold,
+                             Algorithms algorithm, int num_principal_component);
 
   //
   virtual ~PrincipalComponentAnalysis() {
@@ -94,18 +116,45 @@ class PrincipalComponentAnalysis {
     return convergence_threshold_;
   }
 
+  //
+  Algorithms GetAlgorithm() const {
+    return algorithm_;
+  }
+
+  //
+  int GetNumPrincipalComponent() const {
+    return num_principal_component_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
   }
 
-  //
+  // Eigenvalues are sorted in descending order and the corresponding
+  // eigenvectors are stored in rows. In the subspace iteration, the eigenpairs
+  // other than the leading ones are not calculated: the eigenvalues are set to
+  // their mean, which is given by the trace, and the eigenvectors to zero.
   bool Run(const std::vector<std::vector<double> >& input_vectors,
            std::vector<double>* mean_vector, std::vector<double>* eigenvalues,
            Matrix* eigenvector_matrix,
            PrincipalComponentAnalysis::Buffer* buffer) const;
 
  private:
+  //
+  bool RunJacobi(std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+                 PrincipalComponentAnalysis::Buffer* buffer) const;
+
+  //
+  bool RunHouseholderQr(std::vector<double>* eigenvalues,
+                        Matrix* eigenvector_matrix,
+                        PrincipalComponentAnalysis::Buffer* buffer) const;
+
+  //
+  bool RunSubspaceIteration(std::vector<double>* eigenvalues,
+                            Matrix* eigenvector_matrix,
+                            PrincipalComponentAnalysis::Buffer* buffer) const;
+
   //
   const int num_order_;
 
@@ -115,6 +164,12 @@ class PrincipalComponentAnalysis {
   //
   const double convergence_threshold_;
 
+  //
+  const Algorithms algorithm_;
+
+  //
+  const int num_principal_component_;
+
   //
   const StatisticsAccumulator accumulator_;
 
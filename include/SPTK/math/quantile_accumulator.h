@@ -0,0 +1,159 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_MATH_QUANTILE_ACCUMULATOR_H_
+#define SPTK_MATH_QUANTILE_ACCUMULATOR_H_
+
+#include <utility>  // std::pair
+#include <vector>   // std::vector
+
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+// Estimates quantiles of each dimension of a stream of vectors in one pass
+// with bounded memory. Each dimension is summarized by a merging t-digest,
+// i.e., a sorted list of weighted centroids whose sizes are limited by the
+// arcsine scale function. Quantiles near 0 and 1 are therefore estimated
+// more accurately than those around the median. The estimate is exact while
+// the number of data is less than five times the compression.
+class QuantileAccumulator {
+ public:
+  class Buffer {
+   public:
+    Buffer() : num_data_(0) {
+    }
+    virtual ~Buffer() {
+    }
+
+   private:
+    void Clear() {
+      num_data_ = 0;
+      centroids_.clear();
+      unmerged_data_.clear();
+      minimum_.clear();
+      maximum_.clear();
+    }
+
+    // The centroids are held as pairs of mean and weight. The data which have
+    // not been merged into the centroids yet are held separately.
+    int num_data_;
+    std::vector<std::vector<std::pair<double, double> > > centroids_;
+    std::vector<std::vector<double> > unmerged_data_;
+    std::vector<double> minimum_;
+    std::vector<double> maximum_;
+    friend class QuantileAccumulator;
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  //
+  QuantileAccumulator(int num_order, int compression);
+
+  //
+  virtual ~QuantileAccumulator() {
+  }
+
+  //
+  int GetNumOrder() const {
+    return num_order_;
+  }
+
+  //
+  int GetCompression() const {
+    return compression_;
+  }
+
+  //
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  //
+  bool GetNumData(const QuantileAccumulator::Buffer& buffer,
+                  int* num_data) const;
+
+  // Calculates the quantile at the given probability in [0, 1]. Between data
+  // points, the quantile is linearly interpolated as in the exact calculation
+  // by the median command.
+  bool GetQuantile(const QuantileAccumulator::Buffer& buffer,
+                   double probability, std::vector<double>* quantile) const;
+
+  //
+  void Clear(QuantileAccumulator::Buffer* buffer) const;
+
+  //
+  bool Run(const std::vector<double>& data,
+           QuantileAccumulator::Buffer* buffer) const;
+
+  // Adds the digests in the first buffer to the second one. The merged digest
+  // stays exact while the total number of data is less than five times the
+  // compression.
+  bool Merge(const QuantileAccumulator::Buffer& buffer,
+             QuantileAccumulator::Buffer* merged_buffer) const;
+
+ private:
+  // Moves the unmerged data into the centroids and compresses them.
+  void MergeUnmergedData(
+      std::vector<double>* unmerged_data,
+      std::vector<std::pair<double, double> >* centroids) const;
+
+  //
+  void Compress(std::vector<std::pair<double, double> >* centroids) const;
+
+  //
+  const int num_order_;
+
+  //
+  const int compression_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(QuantileAccumulator);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_MATH_QUANTILE_ACCUMULATOR_H_
@@ -48,6 +48,7 @@
 #include <vector>  // std::vector
 
 #include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -70,11 +71,17 @@ namespace sptk {
  * \f]
  * where \f$L\f$ is the FFT length and \f$X\f$ is the frequency representation
  * of \f$x\f$.
+ *
+ * @tparam T Sample type, float or double.
  */
-class RealValuedFastFourierTransform {
+template <typename T>
+class RealValuedFastFourierTransformBase {
  public:
   /**
-   * Buffer for RealValuedFastFourierTransform class.
+   * Buffer for RealValuedFastFourierTransformBase class.
+   *
+   * The transform is performed in the output vectors, so this buffer holds no
+   * data. It is kept for interface compatibility.
    */
   class Buffer {
    public:
@@ -85,25 +92,22 @@ class RealValuedFastFourierTransform {
     }
 
    private:
-    std::vector<double> real_part_input_;
-    std::vector<double> imag_part_input_;
-
-    friend class RealValuedFastFourierTransform;
+    friend class RealValuedFastFourierTransformBase;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
   /**
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  explicit RealValuedFastFourierTransform(int fft_length);
+  explicit RealValuedFastFourierTransformBase(int fft_length);
 
   /**
    * @param[in] num_order Order of input, \f$M\f$.
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  RealValuedFastFourierTransform(int num_order, int fft_length);
+  RealValuedFastFourierTransformBase(int num_order, int fft_length);
 
-  virtual ~RealValuedFastFourierTransform() {
+  virtual ~RealValuedFastFourierTransformBase() {
   }
 
   /**
@@ -134,10 +138,9 @@ class RealValuedFastFourierTransform {
    * @param[out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& real_part_input,
-           std::vector<double>* real_part_output,
-           std::vector<double>* imag_part_output,
-           RealValuedFastFourierTransform::Buffer* buffer) const;
+  bool Run(const std::vector<T>& real_part_input,
+           std::vector<T>* real_part_output, std::vector<T>* imag_part_output,
+           RealValuedFastFourierTransformBase::Buffer* buffer) const;
 
   /**
    * @param[in,out] real_part Real part.
@@ -145,22 +148,53 @@ class RealValuedFastFourierTransform {
    * @param[out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(std::vector<double>* real_part, std::vector<double>* imag_part,
-           RealValuedFastFourierTransform::Buffer* buffer) const;
+  bool Run(std::vector<T>* real_part, std::vector<T>* imag_part,
+           RealValuedFastFourierTransformBase::Buffer* buffer) const;
+
+  /**
+   * Transform each row of input matrix. The inputs are validated once for all
+   * frames, and the result of each frame is identical to that of the
+   * single-frame version. This is available only if T is double.
+   *
+   * @param[in] real_part_input Real part of input. Each row is a frame of
+   *            \f$M\f$-th order.
+   * @param[out] real_part_output Real part of output. It may be the input if
+   *             \f$M=L-1\f$.
+   * @param[out] imag_part_output Imaginary part of output.
+   * @param[out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const Matrix& real_part_input, Matrix* real_part_output,
+           Matrix* imag_part_output,
+           RealValuedFastFourierTransformBase::Buffer* buffer) const;
 
  private:
+  // Packs an input frame into the first halves of x and y, and transforms it
+  // into the full spectrum of FFT length. The input may be x.
+  void Transform(const T* input, T* x, T* y) const;
+
   const int num_order_;
   const int fft_length_;
   const int half_fft_length_;
-  const FastFourierTransform fast_fourier_transform_;
+  const FastFourierTransformBase<T> fast_fourier_transform_;
 
   bool is_valid_;
 
-  std::vector<double> sine_table_;
+  std::vector<T> sine_table_;
 
-  DISALLOW_COPY_AND_ASSIGN(RealValuedFastFourierTransform);
+  DISALLOW_COPY_AND_ASSIGN(RealValuedFastFourierTransformBase);
 };
 
+template <>
+bool RealValuedFastFourierTransformBase<double>::Run(
+    const Matrix& real_part_input, Matrix* real_part_output,
+    Matrix* imag_part_output,
+    RealValuedFastFourierTransformBase<double>::Buffer* buffer) const;
+
+// Source-compatible name of the double-precision real-valued FFT.
+typedef RealValuedFastFourierTransformBase<double>
+    RealValuedFastFourierTransform;
+
 }  // namespace sptk
 
 #endif  // SPTK_MATH_REAL_VALUED_FAST_FOURIER_TRANSFORM_H_
@@ -47,6 +47,7 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/math/real_valued_fast_fourier_transform.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -57,11 +58,14 @@ namespace sptk {
  *
  * This is almost similar to RealValuedFastFourierTransform. The DFT results
  * are divided by FFT length \f$L\f$.
+ *
+ * @tparam T Sample type, float or double.
  */
-class RealValuedInverseFastFourierTransform {
+template <typename T>
+class RealValuedInverseFastFourierTransformBase {
  public:
   /**
-   * Buffer for RealValuedInverseFastFourierTransform class.
+   * Buffer for RealValuedInverseFastFourierTransformBase class.
    */
   class Buffer {
    public:
@@ -72,24 +76,25 @@ class RealValuedInverseFastFourierTransform {
     }
 
    private:
-    RealValuedFastFourierTransform::Buffer fast_fourier_transform_buffer_;
+    typename RealValuedFastFourierTransformBase<T>::Buffer
+        fast_fourier_transform_buffer_;
 
-    friend class RealValuedInverseFastFourierTransform;
+    friend class RealValuedInverseFastFourierTransformBase;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
   /**
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  explicit RealValuedInverseFastFourierTransform(int fft_length);
+  explicit RealValuedInverseFastFourierTransformBase(int fft_length);
 
   /**
    * @param[in] num_order Order of input, \f$M\f$.
    * @param[in] fft_length FFT length, \f$L\f$.
    */
-  RealValuedInverseFastFourierTransform(int num_order, int fft_length);
+  RealValuedInverseFastFourierTransformBase(int num_order, int fft_length);
 
-  virtual ~RealValuedInverseFastFourierTransform() {
+  virtual ~RealValuedInverseFastFourierTransformBase() {
   }
 
   /**
@@ -120,10 +125,9 @@ class RealValuedInverseFastFourierTransform {
    * @param[out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(const std::vector<double>& real_part_input,
-           std::vector<double>* real_part_output,
-           std::vector<double>* imag_part_output,
-           RealValuedInverseFastFourierTransform::Buffer* buffer) const;
+  bool Run(const std::vector<T>& real_part_input,
+           std::vector<T>* real_part_output, std::vector<T>* imag_part_output,
+           RealValuedInverseFastFourierTransformBase::Buffer* buffer) const;
 
   /**
    * @param[in,out] real_part Real part.
@@ -131,15 +135,40 @@ class RealValuedInverseFastFourierTransform {
    * @param[out] buffer Buffer.
    * @return True on success, false on failure.
    */
-  bool Run(std::vector<double>* real_part, std::vector<double>* imag_part,
-           RealValuedInverseFastFourierTransform::Buffer* buffer) const;
+  bool Run(std::vector<T>* real_part, std::vector<T>* imag_part,
+           RealValuedInverseFastFourierTransformBase::Buffer* buffer) const;
+
+  /**
+   * Transform each row of input matrix. The result of each frame is identical
+   * to that of the single-frame version. This is available only if T is
+   * double.
+   *
+   * @param[in] real_part_input Real part of input. Each row is a frame.
+   * @param[out] real_part_output Real part of output. It may be the input.
+   * @param[out] imag_part_output Imaginary part of output.
+   * @param[out] buffer Buffer.
+   * @return True on success, false on failure.
+   */
+  bool Run(const Matrix& real_part_input, Matrix* real_part_output,
+           Matrix* imag_part_output,
+           RealValuedInverseFastFourierTransformBase::Buffer* buffer) const;
 
  private:
-  const RealValuedFastFourierTransform fast_fourier_transform_;
+  const RealValuedFastFourierTransformBase<T> fast_fourier_transform_;
 
-  DISALLOW_COPY_AND_ASSIGN(RealValuedInverseFastFourierTransform);
+  DISALLOW_COPY_AND_ASSIGN(RealValuedInverseFastFourierTransformBase);
 };
 
+template <>
+bool RealValuedInverseFastFourierTransformBase<double>::Run(
+    const Matrix& real_part_input, Matrix* real_part_output,
+    Matrix* imag_part_output,
+    RealValuedInverseFastFourierTransformBase<double>::Buffer* buffer) const;
+
+// Source-compatible name of the double-precision real-valued inverse FFT.
+typedef RealValuedInverseFastFourierTransformBase<double>
+    RealValuedInverseFastFourierTransform;
+
 }  // namespace sptk
 
 #endif  // SPTK_MATH_REAL_VALUED_INVERSE_FAST_FOURIER_TRANSFORM_H_
@@ -60,6 +60,17 @@ class ScalarOperation {
     }
 
     virtual bool Run(double* number, bool* is_magic_number) const = 0;
+
+    // Applies the module to each of the given numbers.
+    virtual bool Run(int num_data, bool uses_fast_approximation,
+                     double* numbers, bool* is_magic_number) const {
+      for (int i(0); i < num_data; ++i) {
+        if (!Run(&numbers[i], &is_magic_number[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
   };
 
   //
@@ -165,6 +176,13 @@ class ScalarOperation {
   //
   bool Run(double* number, bool* is_magic_number) const;
 
+  // Applies the operations to each of the given numbers. This is much faster
+  // than the above function as the operations are vectorized. If
+  // uses_fast_approximation is true, logarithms, exponentials, sines, and
+  // cosines are approximated with an error of less than 1e-9.
+  bool Run(int num_data, bool uses_fast_approximation, double* numbers,
+           bool* is_magic_number) const;
+
  private:
   //
   bool use_magic_number_;
@@ -48,6 +48,7 @@
 #include <algorithm>  // std::fill
 #include <vector>     // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/math/symmetric_matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -70,9 +71,21 @@ class StatisticsAccumulator {
       second_order_statistics_.Fill(0.0);
     }
 
+    // The number of data, the sum of data, and the sum of squared deviations
+    // from the mean are held. The last one is updated by Welford's method so
+    // that the covariance does not suffer from cancellation.
     int zeroth_order_statistics_;
     std::vector<double> first_order_statistics_;
     SymmetricMatrix second_order_statistics_;
+    std::vector<double> deviation_;
+
+    // Statistics of a block of data in the batched update.
+    std::vector<double> block_sum_;
+    SymmetricMatrix block_second_order_statistics_;
+    std::vector<double> centered_data_;
+
+    // Float data converted to double precision.
+    std::vector<double> data_in_double_;
     friend class StatisticsAccumulator;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -134,7 +147,31 @@ class StatisticsAccumulator {
   bool Run(const std::vector<double>& data,
            StatisticsAccumulator::Buffer* buffer) const;
 
+  // Accumulates statistics of float data. The statistics are held in double
+  // precision.
+  bool Run(const std::vector<float>& data,
+           StatisticsAccumulator::Buffer* buffer) const;
+
+  // Accumulates statistics of each row of data. The covariance is updated by
+  // a blocked rank-k update, which is much faster than calling the above
+  // function for each vector. Since the summation order differs, the result
+  // is not bit-identical to that of the above function: the difference of
+  // each covariance element relative to the product of the standard
+  // deviations is about 1e-14, and grows by about 2e-16 times the ratio of
+  // the mean to the standard deviation, e.g., 2e-10 for a ratio of 1e6.
+  bool Run(const Matrix& data, StatisticsAccumulator::Buffer* buffer) const;
+
+  // Adds the statistics in the first buffer to the second one. The result is
+  // the same as that accumulated over the union of the data up to rounding.
+  bool Merge(const StatisticsAccumulator::Buffer& buffer,
+             StatisticsAccumulator::Buffer* merged_buffer) const;
+
  private:
+  //
+  bool Merge(int num_data, const std::vector<double>& sum,
+             const SymmetricMatrix& second_order_statistics,
+             StatisticsAccumulator::Buffer* merged_buffer) const;
+
   //
   const int num_order_;
 
@@ -47,6 +47,7 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/quantizer/nearest_codeword_search.h"
 #include "SPTK/quantizer/vector_quantization.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -63,6 +64,9 @@ class MultistageVectorQuantization {
 
    private:
     std::vector<double> quantization_error_;
+    std::vector<std::vector<double> > quantization_errors_;
+    std::vector<int> stage_codebook_indices_;
+    std::vector<double> distances_;
     friend class MultistageVectorQuantization;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -96,7 +100,33 @@ class MultistageVectorQuantization {
       std::vector<int>* codebook_index,
       MultistageVectorQuantization::Buffer* buffer) const;
 
+  // Same as above, but the nearest codewords are found by the searchers built
+  // from the codebooks in advance.
+  bool Run(
+      const std::vector<double>& input_vector,
+      const std::vector<std::vector<std::vector<double> > >& codebook_vectors,
+      const std::vector<const NearestCodewordSearch*>&
+          nearest_codeword_searches,
+      std::vector<int>* codebook_index,
+      MultistageVectorQuantization::Buffer* buffer) const;
+
+  // Quantize input vectors at once. Each stage is applied to all the vectors
+  // before the next stage.
+  bool Run(
+      const std::vector<std::vector<double> >& input_vectors,
+      const std::vector<std::vector<std::vector<double> > >& codebook_vectors,
+      const std::vector<const NearestCodewordSearch*>&
+          nearest_codeword_searches,
+      std::vector<std::vector<int> >* codebook_indices,
+      MultistageVectorQuantization::Buffer* buffer) const;
+
  private:
+  //
+  bool CheckSearches(
+      const std::vector<std::vector<std::vector<double> > >& codebook_vectors,
+      const std::vector<const NearestCodewordSearch*>&
+          nearest_codeword_searches) const;
+
   //
   const int num_order_;
 
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_QUANTIZER_NEAREST_CODEWORD_SEARCH_H_
+#define SPTK_QUANTIZER_NEAREST_CODEWORD_SEARCH_H_
+
+#include <vector>  // std::vector
+
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+// Exact nearest-codeword search in the squared Euclidean sense. The result is
+// the same as that of VectorQuantization including tie-breaking, i.e., the
+// smallest index among the nearest codewords is returned, but most of the
+// distance computations are skipped by using the triangle inequality and
+// partial distance elimination. The remaining distances are computed for
+// several codewords at once using SIMD instructions.
+class NearestCodewordSearch {
+ public:
+  //
+  explicit NearestCodewordSearch(int num_order);
+
+  //
+  virtual ~NearestCodewordSearch() {
+  }
+
+  //
+  int GetNumOrder() const {
+    return num_order_;
+  }
+
+  //
+  int GetCodebookSize() const {
+    return codebook_size_;
+  }
+
+  //
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  // Copy codebook and precompute the distances between codewords. This must be
+  // called again whenever the codebook is changed.
+  bool SetCodebook(const std::vector<std::vector<double> >& codebook_vectors);
+
+  // Find the nearest codeword. The initial index is a hint, e.g., the previous
+  // assignment of the input vector, and does not affect the result. This is
+  // thread-safe once the codebook is set.
+  bool Run(const std::vector<double>& input_vector, int initial_codebook_index,
+           int* codebook_index, double* distance) const;
+
+  // Find the nearest codewords of input vectors. The result of an input vector
+  // is used as a hint for the next one, which is effective for temporally
+  // correlated inputs.
+  bool Run(const std::vector<std::vector<double> >& input_vectors,
+           std::vector<int>* codebook_indices,
+           std::vector<double>* distances) const;
+
+ private:
+  //
+  double CalculateDistance(const double* input_vector,
+                           int codebook_index) const;
+
+  //
+  void Search(const double* input_vector, int* codebook_index,
+              double* distance) const;
+
+  //
+  const int num_order_;
+
+  //
+  int codebook_size_;
+
+  // Codewords stored contiguously.
+  std::vector<double> codebook_;
+
+  // Codewords interleaved by group for SIMD computation.
+  std::vector<double> grouped_codebook_;
+
+  // Half the distance from each codeword to its nearest other codeword.
+  std::vector<double> radius_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(NearestCodewordSearch);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_QUANTIZER_NEAREST_CODEWORD_SEARCH_H_
@@ -0,0 +1,158 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_UTILS_BINARY_STREAM_BUFFER_H_
+#define SPTK_UTILS_BINARY_STREAM_BUFFER_H_
+
+#include <iostream>   // std::istream, std::ostream
+#include <streambuf>  // std::streambuf
+#include <vector>     // std::vector
+
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Stream buffer for binary data on a file descriptor.
+ *
+ * Data is transferred between the file descriptor and the memory in large
+ * chunks, and reads or writes larger than the chunk bypass the internal
+ * buffer. Since all elements of an SPTK binary stream have the same type,
+ * the byte order can be converted on the fly by giving the size of the
+ * element.
+ */
+class BinaryStreamBuffer : public std::streambuf {
+ public:
+  /**
+   * Direction of data transfer.
+   */
+  enum OpenMode { kRead = 0, kWrite };
+
+  /**
+   * @param[in] file_descriptor File descriptor, e.g., 0 for standard input.
+   * @param[in] open_mode Direction of data transfer.
+   * @param[in] buffer_size Size of internal buffer in bytes.
+   * @param[in] byte_swap_size If positive, reverse byte order of each
+   *            element of this size.
+   */
+  BinaryStreamBuffer(int file_descriptor, OpenMode open_mode, int buffer_size,
+                     int byte_swap_size);
+
+  virtual ~BinaryStreamBuffer();
+
+  /**
+   * @return Size of internal buffer.
+   */
+  int GetBufferSize() const {
+    return buffer_size_;
+  }
+
+  /**
+   * @return Size of element whose byte order is reversed.
+   */
+  int GetByteSwapSize() const {
+    return byte_swap_size_;
+  }
+
+  /**
+   * @return True if this obejct is valid.
+   */
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+ protected:
+  virtual int_type underflow();
+  virtual std::streamsize xsgetn(char_type* s, std::streamsize n);
+  virtual int_type overflow(int_type c);
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize n);
+  virtual int sync();
+
+ private:
+  bool Flush();
+
+  const int file_descriptor_;
+  const OpenMode open_mode_;
+  const int buffer_size_;
+  const int byte_swap_size_;
+
+  bool is_valid_;
+
+  // Number of bytes read after the get area which do not form an element.
+  int num_pending_bytes_;
+
+  std::vector<char> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryStreamBuffer);
+};
+
+/**
+ * Replace the buffers of std::cin and std::cout with BinaryStreamBuffer during
+ * the lifetime of this object. std::cin is also untied from std::cout so that
+ * reading data does not flush the output.
+ *
+ * Byte order is out of scope: both streams are always read and written in the
+ * native byte order, and no command converts foreign-endian data by itself.
+ * Such data should be piped through swab.
+ */
+class BufferedStandardStreams {
+ public:
+  BufferedStandardStreams();
+
+  virtual ~BufferedStandardStreams();
+
+ private:
+  BinaryStreamBuffer input_buffer_;
+  BinaryStreamBuffer output_buffer_;
+
+  std::streambuf* original_input_buffer_;
+  std::streambuf* original_output_buffer_;
+  std::ostream* original_tie_;
+
+  DISALLOW_COPY_AND_ASSIGN(BufferedStandardStreams);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_BINARY_STREAM_BUFFER_H_
@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_UTILS_BIT_STREAM_H_
+#define SPTK_UTILS_BIT_STREAM_H_
+
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <iostream>  // std::istream, std::ostream
+#include <vector>    // std::vector
+
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Writer of a sequence of bits.
+ *
+ * In the packed format, eight bits are stored in a byte from the most
+ * significant bit, and the last byte is padded with a one followed by zeros.
+ * Otherwise, each bit is stored as a bool, which is the format of SPTK.
+ */
+class BitStreamWriter {
+ public:
+  /**
+   * @param[in] output_stream Stream to write bits.
+   * @param[in] is_packed If true, use the packed format.
+   */
+  BitStreamWriter(std::ostream* output_stream, bool is_packed);
+
+  virtual ~BitStreamWriter() {
+  }
+
+  /**
+   * @return True if this object is valid.
+   */
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * @param[in] bits Bits to be written from the most significant one.
+   * @param[in] num_bits Number of bits, which must be in [0, 32].
+   * @return True on success, false on failure.
+   */
+  bool Put(std::uint32_t bits, int num_bits) {
+    if (!is_valid_ || num_bits < 0 || 32 < num_bits) {
+      return false;
+    }
+    bits_ = (bits_ << num_bits) | (bits & ((1ULL << num_bits) - 1));
+    num_bits_ += num_bits;
+    return (num_bits_ < 8) ? true : Drain();
+  }
+
+  /**
+   * Write all remaining bits. This must be called once at the end.
+   *
+   * @return True on success, false on failure.
+   */
+  bool Finish();
+
+ private:
+  bool Drain();
+
+  std::ostream* output_stream_;
+  const bool is_packed_;
+
+  bool is_valid_;
+
+  // Bits not yet moved to the buffer. The valid bits are the lowest ones.
+  std::uint64_t bits_;
+  int num_bits_;
+
+  std::vector<char> buffer_;
+  int buffer_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(BitStreamWriter);
+};
+
+/**
+ * Reader of a sequence of bits written by BitStreamWriter.
+ */
+class BitStreamReader {
+ public:
+  /**
+   * @param[in] input_stream Stream to read bits.
+   * @param[in] is_packed If true, use the packed format.
+   */
+  BitStreamReader(std::istream* input_stream, bool is_packed);
+
+  virtual ~BitStreamReader() {
+  }
+
+  /**
+   * @return True if this object is valid.
+   */
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * Get next bits without consuming them. Missing bits at the end of the
+   * stream are filled with zeros.
+   *
+   * @param[in] num_bits Number of bits, which must be in [1, 32].
+   * @param[out] bits Bits whose most significant one is the next bit.
+   * @return Number of available bits, which is less than num_bits only at the
+   *         end of the stream.
+   */
+  int Peek(int num_bits, std::uint32_t* bits) {
+    if (num_bits_ < num_bits) Fill();
+    const std::uint64_t mask((1ULL << num_bits) - 1);
+    if (num_bits <= num_bits_) {
+      *bits = static_cast<std::uint32_t>((bits_ >> (num_bits_ - num_bits)) &
+                                         mask);
+      return num_bits;
+    }
+    *bits = static_cast<std::uint32_t>((bits_ << (num_bits - num_bits_)) &
+                                       mask);
+    return num_bits_;
+  }
+
+  /**
+   * @param[in] num_bits Number of bits to be consumed, which must not exceed
+   *            the number of bits returned by Peek.
+   */
+  void Skip(int num_bits) {
+    num_bits_ -= num_bits;
+  }
+
+ private:
+  void Fill();
+
+  std::istream* input_stream_;
+  const bool is_packed_;
+
+  bool is_valid_;
+
+  // Bits not yet consumed. The valid bits are the lowest ones.
+  std::uint64_t bits_;
+  int num_bits_;
+
+  std::vector<char> buffer_;
+  int buffer_size_;
+  int position_;
+  bool is_end_of_stream_;
+
+  DISALLOW_COPY_AND_ASSIGN(BitStreamReader);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_BIT_STREAM_H_
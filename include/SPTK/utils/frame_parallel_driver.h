@@ -0,0 +1,147 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_UTILS_FRAME_PARALLEL_DRIVER_H_
+#define SPTK_UTILS_FRAME_PARALLEL_DRIVER_H_
+
+#include <ostream>  // std::ostream
+#include <sstream>  // std::ostringstream
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+#include "SPTK/input/input_source_interface.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Run frame-wise processing on multiple threads.
+ *
+ * The calling thread reads frames from an input source in chunks and hands
+ * them to worker threads. Each worker thread has its own frame processor, which
+ * owns the Buffers of the algorithm classes. The calling thread writes the
+ * processed frames in the input order, so the output is identical to that of
+ * sequential processing. If only one frame processor is given, frames are
+ * processed one by one in the calling thread without creating any thread.
+ */
+class FrameParallelDriver {
+ public:
+  /**
+   * Frame-wise processing. An instance is used by only one thread at a time.
+   */
+  class FrameProcessorInterface {
+   public:
+    virtual ~FrameProcessorInterface() {
+    }
+
+    /**
+     * @param[in] frame_index Frame index starting from zero.
+     * @param[in] input Input frame.
+     * @param[out] output Data to be written.
+     * @param[out] message Message to be printed. If true is returned, the
+     *             message is treated as a warning.
+     * @return True on success, false on failure.
+     */
+    virtual bool Run(int frame_index, const std::vector<double>& input,
+                     std::vector<double>* output,
+                     std::ostringstream* message) = 0;
+
+    /**
+     * Process a chunk of frames at once, e.g., with a multi-frame algorithm.
+     * This is used only by worker threads. If false is returned, the frames
+     * are processed again one by one with Run(), so that a failure or a
+     * warning is reported for the exact frame.
+     *
+     * @param[in] inputs Input frames. Only the first num_frame are used.
+     * @param[in] num_frame Number of frames.
+     * @param[out] outputs Data to be written for each frame.
+     * @return True if all the frames are processed without any message.
+     */
+    virtual bool RunChunk(const std::vector<std::vector<double> >& inputs,
+                          int num_frame,
+                          std::vector<std::vector<double> >* outputs) {
+      return false;
+    }
+  };
+
+  /**
+   * @param[in] program_name Program name shown in messages.
+   * @param[in] write_error_message Message printed when output fails.
+   */
+  FrameParallelDriver(const std::string& program_name,
+                      const std::string& write_error_message)
+      : program_name_(program_name), write_error_message_(write_error_message) {
+  }
+
+  virtual ~FrameParallelDriver() {
+  }
+
+  /**
+   * @param[in] frame_processors Frame processors. One thread is used for each.
+   * @param[in,out] input_source Input source.
+   * @param[out] output_stream Output stream.
+   * @return True on success, false on failure.
+   */
+  bool Run(const std::vector<FrameProcessorInterface*>& frame_processors,
+           InputSourceInterface* input_source,
+           std::ostream* output_stream) const;
+
+ private:
+  bool RunSequentially(FrameProcessorInterface* frame_processor,
+                       InputSourceInterface* input_source,
+                       std::ostream* output_stream) const;
+
+  bool Write(const std::string& message, bool is_succeeded,
+             const std::vector<double>& output,
+             std::ostream* output_stream) const;
+
+  const std::string program_name_;
+  const std::string write_error_message_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameParallelDriver);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_FRAME_PARALLEL_DRIVER_H_
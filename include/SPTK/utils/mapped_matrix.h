@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_UTILS_MAPPED_MATRIX_H_
+#define SPTK_UTILS_MAPPED_MATRIX_H_
+
+#include <cstddef>  // std::size_t
+
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+/**
+ * Read-only view of a binary file of fixed-length vectors.
+ *
+ * The file is mapped into memory and each row is accessed without copying.
+ * Only the pages actually touched are loaded, so files larger than the
+ * physical memory can be handled. If the file size is not a multiple of the
+ * vector size, the trailing incomplete vector is not counted as a row but can
+ * be accessed via GetData() and GetNumElement().
+ *
+ * @tparam T Element type, float or double.
+ */
+template <typename T>
+class MappedMatrix {
+ public:
+  /**
+   * @param[in] file_name Name of binary file.
+   * @param[in] num_column Length of vector.
+   */
+  MappedMatrix(const char* file_name, int num_column);
+
+  virtual ~MappedMatrix();
+
+  /**
+   * @return Number of complete vectors.
+   */
+  int GetNumRow() const {
+    return num_row_;
+  }
+
+  /**
+   * @return Length of vector.
+   */
+  int GetNumColumn() const {
+    return num_column_;
+  }
+
+  /**
+   * @return Number of elements in file.
+   */
+  std::size_t GetNumElement() const {
+    return num_element_;
+  }
+
+  /**
+   * @return Pointer to the first element.
+   */
+  const T* GetData() const {
+    return data_;
+  }
+
+  /**
+   * @return True if this obejct is valid.
+   */
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  /**
+   * @param[in] row Row index.
+   * @return Pointer to the first element of the row.
+   */
+  const T* operator[](int row) const {
+    return data_ + static_cast<std::size_t>(row) * num_column_;
+  }
+
+ private:
+  const int num_column_;
+
+  int num_row_;
+
+  std::size_t num_element_;
+
+  void* mapped_address_;
+
+  std::size_t mapped_size_;
+
+  const T* data_;
+
+  bool is_valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedMatrix);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_MAPPED_MATRIX_H_
@@ -0,0 +1,413 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_UTILS_SIMD_H_
+#define SPTK_UTILS_SIMD_H_
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#include <cmath>    // std::fabs, std::sqrt
+#include <cstdint>  // std::uint64_t
+#include <cstring>  // std::memcpy
+#endif
+
+namespace sptk {
+
+// Thin wrappers of the SIMD instructions for double-precision arithmetic and
+// for basic single-precision arithmetic. The widest instruction set enabled at
+// compile time is used. Multiplication and addition are never fused, so the
+// results do not depend on the instruction set. Maximum(a, b) and Minimum(a, b)
+// return b if either is NaN. Gather(x, m) collects x[k][m] into the k-th lane,
+// and LessEqualMask(a, b) sets the k-th bit if a <= b holds in the k-th lane.
+// PowerOfTwo(n) assumes that n is an integer in [-1022, 1023], and
+// SplitExponent(x, e) assumes that x is a positive normal number; it returns
+// the mantissa in [1, 2) and stores the unbiased exponent to e.
+namespace simd {
+
+#if defined(__AVX__)
+typedef __m256d Vector;
+const int kVectorLength(4);
+inline Vector Load(const double* x) {
+  return _mm256_loadu_pd(x);
+}
+inline Vector Gather(const double* const* x, int m) {
+  return _mm256_set_pd(x[3][m], x[2][m], x[1][m], x[0][m]);
+}
+inline Vector Broadcast(double x) {
+  return _mm256_set1_pd(x);
+}
+inline void Store(Vector x, double* y) {
+  _mm256_storeu_pd(y, x);
+}
+inline Vector Add(Vector a, Vector b) {
+  return _mm256_add_pd(a, b);
+}
+inline Vector Subtract(Vector a, Vector b) {
+  return _mm256_sub_pd(a, b);
+}
+inline Vector Multiply(Vector a, Vector b) {
+  return _mm256_mul_pd(a, b);
+}
+inline Vector Divide(Vector a, Vector b) {
+  return _mm256_div_pd(a, b);
+}
+inline Vector Maximum(Vector a, Vector b) {
+  return _mm256_max_pd(a, b);
+}
+inline Vector Minimum(Vector a, Vector b) {
+  return _mm256_min_pd(a, b);
+}
+inline int LessEqualMask(Vector a, Vector b) {
+  return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ));
+}
+inline Vector Absolute(Vector x) {
+  return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+inline Vector SquareRoot(Vector x) {
+  return _mm256_sqrt_pd(x);
+}
+inline Vector PowerOfTwo(Vector n) {
+  // The biased exponent is placed in the lowest bits of the mantissa, and then
+  // shifted to the exponent field. AVX has no 256-bit integer shifts.
+  const __m256d t(_mm256_add_pd(n, _mm256_set1_pd(4503599627371519.0)));
+  const __m128i low(
+      _mm_slli_epi64(_mm_castpd_si128(_mm256_castpd256_pd128(t)), 52));
+  const __m128i high(
+      _mm_slli_epi64(_mm_castpd_si128(_mm256_extractf128_pd(t, 1)), 52));
+  return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_castsi128_pd(low)),
+                              _mm_castsi128_pd(high), 1);
+}
+inline Vector SplitExponent(Vector x, Vector* exponent) {
+  const __m128i low(
+      _mm_srli_epi64(_mm_castpd_si128(_mm256_castpd256_pd128(x)), 52));
+  const __m128i high(
+      _mm_srli_epi64(_mm_castpd_si128(_mm256_extractf128_pd(x, 1)), 52));
+  const __m256d biased(_mm256_insertf128_pd(
+      _mm256_castpd128_pd256(_mm_castsi128_pd(low)), _mm_castsi128_pd(high),
+      1));
+  *exponent = _mm256_sub_pd(
+      _mm256_or_pd(biased, _mm256_set1_pd(4503599627370496.0)),
+      _mm256_set1_pd(4503599627371519.0));
+  return _mm256_or_pd(
+      _mm256_and_pd(x, _mm256_castsi256_pd(
+                           _mm256_set1_epi64x(0x000fffffffffffffLL))),
+      _mm256_set1_pd(1.0));
+}
+typedef __m256 FloatVector;
+const int kFloatVectorLength(8);
+inline FloatVector Load(const float* x) {
+  return _mm256_loadu_ps(x);
+}
+inline FloatVector Broadcast(float x) {
+  return _mm256_set1_ps(x);
+}
+inline void Store(FloatVector x, float* y) {
+  _mm256_storeu_ps(y, x);
+}
+inline FloatVector Add(FloatVector a, FloatVector b) {
+  return _mm256_add_ps(a, b);
+}
+inline FloatVector Subtract(FloatVector a, FloatVector b) {
+  return _mm256_sub_ps(a, b);
+}
+inline FloatVector Multiply(FloatVector a, FloatVector b) {
+  return _mm256_mul_ps(a, b);
+}
+#elif defined(__SSE2__)
+typedef __m128d Vector;
+const int kVectorLength(2);
+inline Vector Load(const double* x) {
+  return _mm_loadu_pd(x);
+}
+inline Vector Gather(const double* const* x, int m) {
+  return _mm_set_pd(x[1][m], x[0][m]);
+}
+inline Vector Broadcast(double x) {
+  return _mm_set1_pd(x);
+}
+inline void Store(Vector x, double* y) {
+  _mm_storeu_pd(y, x);
+}
+inline Vector Add(Vector a, Vector b) {
+  return _mm_add_pd(a, b);
+}
+inline Vector Subtract(Vector a, Vector b) {
+  return _mm_sub_pd(a, b);
+}
+inline Vector Multiply(Vector a, Vector b) {
+  return _mm_mul_pd(a, b);
+}
+inline Vector Divide(Vector a, Vector b) {
+  return _mm_div_pd(a, b);
+}
+inline Vector Maximum(Vector a, Vector b) {
+  return _mm_max_pd(a, b);
+}
+inline Vector Minimum(Vector a, Vector b) {
+  return _mm_min_pd(a, b);
+}
+inline int LessEqualMask(Vector a, Vector b) {
+  return _mm_movemask_pd(_mm_cmple_pd(a, b));
+}
+inline Vector Absolute(Vector x) {
+  return _mm_andnot_pd(_mm_set1_pd(-0.0), x);
+}
+inline Vector SquareRoot(Vector x) {
+  return _mm_sqrt_pd(x);
+}
+inline Vector PowerOfTwo(Vector n) {
+  // The biased exponent is placed in the lowest bits of the mantissa, and then
+  // shifted to the exponent field.
+  const __m128d t(_mm_add_pd(n, _mm_set1_pd(4503599627371519.0)));
+  return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(t), 52));
+}
+inline Vector SplitExponent(Vector x, Vector* exponent) {
+  const __m128d biased(
+      _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(x), 52)));
+  *exponent = _mm_sub_pd(_mm_or_pd(biased, _mm_set1_pd(4503599627370496.0)),
+                         _mm_set1_pd(4503599627371519.0));
+  return _mm_or_pd(
+      _mm_and_pd(x, _mm_castsi128_pd(_mm_set1_epi64x(0x000fffffffffffffLL))),
+      _mm_set1_pd(1.0));
+}
+typedef __m128 FloatVector;
+const int kFloatVectorLength(4);
+inline FloatVector Load(const float* x) {
+  return _mm_loadu_ps(x);
+}
+inline FloatVector Broadcast(float x) {
+  return _mm_set1_ps(x);
+}
+inline void Store(FloatVector x, float* y) {
+  _mm_storeu_ps(y, x);
+}
+inline FloatVector Add(FloatVector a, FloatVector b) {
+  return _mm_add_ps(a, b);
+}
+inline FloatVector Subtract(FloatVector a, FloatVector b) {
+  return _mm_sub_ps(a, b);
+}
+inline FloatVector Multiply(FloatVector a, FloatVector b) {
+  return _mm_mul_ps(a, b);
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+typedef float64x2_t Vector;
+const int kVectorLength(2);
+inline Vector Load(const double* x) {
+  return vld1q_f64(x);
+}
+inline Vector Gather(const double* const* x, int m) {
+  return vsetq_lane_f64(x[1][m], vdupq_n_f64(x[0][m]), 1);
+}
+inline Vector Broadcast(double x) {
+  return vdupq_n_f64(x);
+}
+inline void Store(Vector x, double* y) {
+  vst1q_f64(y, x);
+}
+inline Vector Add(Vector a, Vector b) {
+  return vaddq_f64(a, b);
+}
+inline Vector Subtract(Vector a, Vector b) {
+  return vsubq_f64(a, b);
+}
+inline Vector Multiply(Vector a, Vector b) {
+  return vmulq_f64(a, b);
+}
+inline Vector Divide(Vector a, Vector b) {
+  return vdivq_f64(a, b);
+}
+inline Vector Maximum(Vector a, Vector b) {
+  return vbslq_f64(vcgtq_f64(a, b), a, b);
+}
+inline Vector Minimum(Vector a, Vector b) {
+  return vbslq_f64(vcltq_f64(a, b), a, b);
+}
+inline int LessEqualMask(Vector a, Vector b) {
+  const uint64x2_t mask(vshrq_n_u64(vcleq_f64(a, b), 63));
+  return static_cast<int>(vgetq_lane_u64(mask, 0) |
+                          (vgetq_lane_u64(mask, 1) << 1));
+}
+inline Vector Absolute(Vector x) {
+  return vabsq_f64(x);
+}
+inline Vector SquareRoot(Vector x) {
+  return vsqrtq_f64(x);
+}
+inline Vector PowerOfTwo(Vector n) {
+  return vreinterpretq_f64_s64(
+      vshlq_n_s64(vaddq_s64(vcvtq_s64_f64(n), vdupq_n_s64(1023)), 52));
+}
+inline Vector SplitExponent(Vector x, Vector* exponent) {
+  const uint64x2_t bits(vreinterpretq_u64_f64(x));
+  *exponent =
+      vsubq_f64(vcvtq_f64_u64(vshrq_n_u64(bits, 52)), vdupq_n_f64(1023.0));
+  return vreinterpretq_f64_u64(
+      vorrq_u64(vandq_u64(bits, vdupq_n_u64(0x000fffffffffffffULL)),
+                vdupq_n_u64(0x3ff0000000000000ULL)));
+}
+typedef float32x4_t FloatVector;
+const int kFloatVectorLength(4);
+inline FloatVector Load(const float* x) {
+  return vld1q_f32(x);
+}
+inline FloatVector Broadcast(float x) {
+  return vdupq_n_f32(x);
+}
+inline void Store(FloatVector x, float* y) {
+  vst1q_f32(y, x);
+}
+inline FloatVector Add(FloatVector a, FloatVector b) {
+  return vaddq_f32(a, b);
+}
+inline FloatVector Subtract(FloatVector a, FloatVector b) {
+  return vsubq_f32(a, b);
+}
+inline FloatVector Multiply(FloatVector a, FloatVector b) {
+  return vmulq_f32(a, b);
+}
+#else
+typedef double Vector;
+const int kVectorLength(1);
+inline Vector Load(const double* x) {
+  return *x;
+}
+inline Vector Gather(const double* const* x, int m) {
+  return x[0][m];
+}
+inline Vector Broadcast(double x) {
+  return x;
+}
+inline void Store(Vector x, double* y) {
+  *y = x;
+}
+inline Vector Add(Vector a, Vector b) {
+  return a + b;
+}
+inline Vector Subtract(Vector a, Vector b) {
+  return a - b;
+}
+inline Vector Multiply(Vector a, Vector b) {
+  return a * b;
+}
+inline Vector Divide(Vector a, Vector b) {
+  return a / b;
+}
+inline Vector Maximum(Vector a, Vector b) {
+  return (a > b) ? a : b;
+}
+inline Vector Minimum(Vector a, Vector b) {
+  return (a < b) ? a : b;
+}
+inline int LessEqualMask(Vector a, Vector b) {
+  return a <= b;
+}
+inline Vector Absolute(Vector x) {
+  return std::fabs(x);
+}
+inline Vector SquareRoot(Vector x) {
+  return std::sqrt(x);
+}
+inline Vector PowerOfTwo(Vector n) {
+  const std::uint64_t bits(static_cast<std::uint64_t>(n + 1023.0) << 52);
+  double y;
+  std::memcpy(&y, &bits, sizeof(y));
+  return y;
+}
+inline Vector SplitExponent(Vector x, Vector* exponent) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  *exponent = static_cast<double>(bits >> 52) - 1023.0;
+  bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+  double y;
+  std::memcpy(&y, &bits, sizeof(y));
+  return y;
+}
+typedef float FloatVector;
+const int kFloatVectorLength(1);
+inline FloatVector Load(const float* x) {
+  return *x;
+}
+inline FloatVector Broadcast(float x) {
+  return x;
+}
+inline void Store(FloatVector x, float* y) {
+  *y = x;
+}
+inline FloatVector Add(FloatVector a, FloatVector b) {
+  return a + b;
+}
+inline FloatVector Subtract(FloatVector a, FloatVector b) {
+  return a - b;
+}
+inline FloatVector Multiply(FloatVector a, FloatVector b) {
+  return a * b;
+}
+#endif
+
+// Vector type and its length for each element type. They are used by the
+// kernels templated on the sample type.
+template <typename T>
+struct VectorTraits;
+
+template <>
+struct VectorTraits<double> {
+  typedef Vector Type;
+  static const int kLength = kVectorLength;
+};
+
+template <>
+struct VectorTraits<float> {
+  typedef FloatVector Type;
+  static const int kLength = kFloatVectorLength;
+};
+
+}  // namespace simd
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_SIMD_H_
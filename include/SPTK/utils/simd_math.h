@@ -0,0 +1,190 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_UTILS_SIMD_MATH_H_
+#define SPTK_UTILS_SIMD_MATH_H_
+
+#include <algorithm>  // std::copy, std::fill, std::min
+
+#include "SPTK/utils/simd.h"
+
+namespace sptk {
+
+// Helpers to apply vector functions to arrays, and polynomial approximations of
+// elementary functions built on the wrappers in simd.h. The approximations do
+// not give the same results as the standard library.
+namespace simd {
+
+// Applies the given vector function to each of the numbers. The remainder is
+// padded with ones.
+template <typename Function>
+inline void ApplyToEachNumber(const Function& function, int num_data,
+                              double* numbers) {
+  int i(0);
+  for (; i + kVectorLength <= num_data; i += kVectorLength) {
+    Store(function(Load(numbers + i)), numbers + i);
+  }
+  if (i < num_data) {
+    double remainder[kVectorLength];
+    std::fill(remainder, remainder + kVectorLength, 1.0);
+    std::copy(numbers + i, numbers + num_data, remainder);
+    Store(function(Load(remainder)), remainder);
+    std::copy(remainder, remainder + (num_data - i), numbers + i);
+  }
+}
+
+// Applies the given approximation to the numbers in [lower_bound, upper_bound]
+// and the exact function to the others, e.g., NaN.
+template <typename Approximation, typename Function>
+inline void ApplyApproximation(const Approximation& approximation,
+                               const Function& function, double lower_bound,
+                               double upper_bound, int num_data,
+                               double* numbers) {
+  // In most cases, all numbers are in the domain. The distance from the domain
+  // is accumulated, which becomes NaN if any number is NaN.
+  const Vector lower_bounds(Broadcast(lower_bound));
+  const Vector upper_bounds(Broadcast(upper_bound));
+  Vector distance(Broadcast(0.0));
+  int i(0);
+  for (; i + kVectorLength <= num_data; i += kVectorLength) {
+    const Vector x(Load(numbers + i));
+    distance = Add(distance,
+                   Absolute(Subtract(
+                       x, Minimum(Maximum(x, lower_bounds), upper_bounds))));
+  }
+  double distances[kVectorLength];
+  Store(distance, distances);
+  bool is_in_domain(true);
+  for (int j(0); j < kVectorLength; ++j) {
+    if (!(0.0 == distances[j])) is_in_domain = false;
+  }
+  for (; i < num_data; ++i) {
+    if (!(lower_bound <= numbers[i] && numbers[i] <= upper_bound)) {
+      is_in_domain = false;
+    }
+  }
+  if (is_in_domain) {
+    ApplyToEachNumber(approximation, num_data, numbers);
+    return;
+  }
+
+  double original[kVectorLength];
+  for (int begin(0); begin < num_data; begin += kVectorLength) {
+    const int end(std::min(begin + kVectorLength, num_data));
+    if (end - begin == kVectorLength) {
+      const Vector x(Load(numbers + begin));
+      Store(x, original);
+      Store(approximation(x), numbers + begin);
+    } else {
+      std::copy(numbers + begin, numbers + end, original);
+      ApplyToEachNumber(approximation, end - begin, numbers + begin);
+    }
+    for (int i(begin); i < end; ++i) {
+      const double x(original[i - begin]);
+      if (!(lower_bound <= x && x <= upper_bound)) {
+        numbers[i] = function(x);
+      }
+    }
+  }
+}
+
+// Rounds to the nearest integer. The magnitude of x must be less than 2^51.
+inline Vector Round(Vector x) {
+  const Vector magic_number(Broadcast(6755399441055744.0));  // 1.5 * 2^52
+  return Subtract(Add(x, magic_number), magic_number);
+}
+
+// Approximates exp(x) for |x| <= 708. The relative error is less
+// than 1e-9.
+inline Vector ApproximateExponential(Vector x) {
+  // Split ln(2) into two parts so that n * ln(2) is calculated exactly.
+  const Vector n(Round(Multiply(x, Broadcast(1.4426950408889634))));
+  const Vector r(
+      Subtract(Subtract(x, Multiply(n, Broadcast(6.93147180369123816490e-01))),
+               Multiply(n, Broadcast(1.90821492927058770002e-10))));
+
+  // Taylor series of exp(r) for |r| <= ln(2) / 2.
+  Vector y(Broadcast(1.0 / 40320.0));
+  y = Add(Multiply(y, r), Broadcast(1.0 / 5040.0));
+  y = Add(Multiply(y, r), Broadcast(1.0 / 720.0));
+  y = Add(Multiply(y, r), Broadcast(1.0 / 120.0));
+  y = Add(Multiply(y, r), Broadcast(1.0 / 24.0));
+  y = Add(Multiply(y, r), Broadcast(1.0 / 6.0));
+  y = Add(Multiply(y, r), Broadcast(0.5));
+  y = Add(Multiply(y, r), Broadcast(1.0));
+  y = Add(Multiply(y, r), Broadcast(1.0));
+  return Multiply(y, PowerOfTwo(n));
+}
+
+// Approximates ln(x) for positive normal x. The relative error is less than
+// 1e-9.
+inline Vector ApproximateNaturalLogarithm(Vector x) {
+  // Normalize the mantissa to [1 / sqrt(2), sqrt(2)).
+  Vector e;
+  Vector m(SplitExponent(x, &e));
+  const Vector a(Round(
+      Subtract(Multiply(m, Broadcast(0.7071067811865476)), Broadcast(0.5))));
+  m = Multiply(m, Subtract(Broadcast(1.0), Multiply(a, Broadcast(0.5))));
+  e = Add(e, a);
+
+  // ln(m) = 2 * atanh(s), where s = (m - 1) / (m + 1) and |s| < 0.172.
+  const Vector s(Divide(Subtract(m, Broadcast(1.0)), Add(m, Broadcast(1.0))));
+  const Vector s2(Multiply(s, s));
+  Vector y(Broadcast(2.0 / 11.0));
+  y = Add(Multiply(y, s2), Broadcast(2.0 / 9.0));
+  y = Add(Multiply(y, s2), Broadcast(2.0 / 7.0));
+  y = Add(Multiply(y, s2), Broadcast(2.0 / 5.0));
+  y = Add(Multiply(y, s2), Broadcast(2.0 / 3.0));
+  y = Add(Add(s, s), Multiply(Multiply(y, s2), s));
+
+  // ln(x) = e * ln(2) + ln(m).
+  return Add(Multiply(e, Broadcast(6.93147180369123816490e-01)),
+             Add(Multiply(e, Broadcast(1.90821492927058770002e-10)), y));
+}
+
+}  // namespace simd
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_SIMD_MATH_H_
@@ -45,10 +45,11 @@
 #ifndef SPTK_UTILS_SPTK_UTILS_H_
 #define SPTK_UTILS_SPTK_UTILS_H_
 
-#include <iostream>  // std::istream, std::ostream
-#include <sstream>   // std::ostringstream
-#include <string>    // std::string
-#include <vector>    // std::vector
+#include <functional>  // std::function
+#include <iostream>    // std::istream, std::ostream
+#include <sstream>     // std::ostringstream
+#include <string>      // std::string
+#include <vector>      // std::vector
 
 #include "SPTK/math/matrix.h"
 
@@ -85,6 +86,12 @@ bool WriteStream(int write_point, int write_size,
                  const std::vector<T>& sequence_to_write,
                  std::ostream* output_stream, int* actual_write_size);
 template <typename T>
+bool ProcessStreamInBlocks(int block_size,
+                           const std::function<bool(std::vector<T>*)>& process,
+                           std::istream* input_stream,
+                           std::ostream* output_stream);
+bool IsExhaustedAfterFirstFrame(const std::istream& input_stream);
+template <typename T>
 bool SnPrintf(T data, const std::string& print_format, size_t buffer_size,
               char* buffer);
 const char* ConvertBooleanToString(bool input);
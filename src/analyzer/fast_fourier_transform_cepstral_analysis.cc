@@ -44,7 +44,7 @@
 
 #include "SPTK/analyzer/fast_fourier_transform_cepstral_analysis.h"
 
-#include <algorithm>  // std::transform
+#include <algorithm>  // std::reverse_copy, std::transform
 #include <cmath>      // std::log
 #include <cstddef>    // std::size_t
 
@@ -152,4 +152,107 @@ bool FastFourierTransformCepstralAnalysis::Run(
   return true;
 }
 
+bool FastFourierTransformCepstralAnalysis::Run(
+    const Matrix& power_spectra, Matrix* cepstra,
+    FastFourierTransformCepstralAnalysis::Buffer* buffer) const {
+  // Check inputs.
+  const int fft_length(fast_fourier_transform_.GetFftLength());
+  const int num_frame(power_spectra.GetNumRow());
+  if (!is_valid_ || power_spectra.GetNumColumn() != fft_length / 2 + 1 ||
+      NULL == cepstra || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  if (cepstra->GetNumRow() != num_frame ||
+      cepstra->GetNumColumn() != num_order_ + 1) {
+    cepstra->Resize(num_frame, num_order_ + 1);
+  }
+  if (buffer->real_parts_.GetNumRow() != num_frame ||
+      buffer->real_parts_.GetNumColumn() != fft_length) {
+    buffer->real_parts_.Resize(num_frame, fft_length);
+  }
+
+  // Make full log-power spectra.
+  const int half_length(fft_length / 2 + 1);
+  for (int n(0); n < num_frame; ++n) {
+    double* e(buffer->real_parts_[n]);
+    std::transform(power_spectra[n], power_spectra[n] + half_length, e,
+                   [](double x) { return std::log(x); });
+    std::reverse_copy(e + 1, e + half_length - 1, e + half_length);
+  }
+
+  // Obtain smoothed cepstra.
+  if (!inverse_fast_fourier_transform_.Run(
+          buffer->real_parts_, &buffer->real_parts_, &buffer->imag_parts_,
+          &buffer->buffer_for_inverse_fast_fourier_transform_)) {
+    return false;
+  }
+
+  // Initialize variables.
+  for (int n(0); n < num_frame; ++n) {
+    double* v((*cepstra)[n]);
+    double* e(buffer->real_parts_[n]);
+    for (int m(0); m <= num_order_; ++m) {
+      v[m] = e[m];
+      e[m] = 0.0;
+    }
+  }
+
+  // Perform the improved cepstral analysis method on all frames at once.
+  for (int i(0); i < num_iteration_; ++i) {
+    for (int n(0); n < num_frame; ++n) {
+      double* e(buffer->real_parts_[n]);
+      for (int m(1); m <= num_order_; ++m) {
+        e[fft_length - m] = e[m];
+      }
+    }
+
+    // Ek = DFT(em).
+    if (!fast_fourier_transform_.Run(
+            buffer->real_parts_, &buffer->real_parts_, &buffer->imag_parts_,
+            &buffer->buffer_for_fast_fourier_transform_)) {
+      return false;
+    }
+
+    // Apply function g.
+    for (int n(0); n < num_frame; ++n) {
+      double* e(buffer->real_parts_[n]);
+      for (int k(0); k < fft_length; ++k) {
+        if (e[k] < 0.0) {
+          e[k] = 0.0;
+        }
+      }
+    }
+
+    // em = IDFT(Ek).
+    if (!inverse_fast_fourier_transform_.Run(
+            buffer->real_parts_, &buffer->real_parts_, &buffer->imag_parts_,
+            &buffer->buffer_for_inverse_fast_fourier_transform_)) {
+      return false;
+    }
+
+    // Update vm and em.
+    for (int n(0); n < num_frame; ++n) {
+      double* v((*cepstra)[n]);
+      double* e(buffer->real_parts_[n]);
+      for (int m(0); m <= num_order_; ++m) {
+        const double tm(e[m] * (1.0 + acceleration_factor_));
+        v[m] += tm;
+        e[m] -= tm;
+      }
+    }
+  }
+
+  for (int n(0); n < num_frame; ++n) {
+    double* v((*cepstra)[n]);
+    v[0] *= 0.5;
+    if (fft_length / 2 == num_order_) {
+      v[num_order_] *= 0.5;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace sptk
@@ -94,7 +94,9 @@ bool PitchExtractionByRapt::Get(
     }
     f0->resize(target_length);
     std::copy(tmp_f0, tmp_f0 + tmp_length, f0->begin());
-    std::fill(f0->begin() + tmp_length, f0->end(), tmp_f0[tmp_length - 1]);
+    // Very short inputs may produce no frame; they are regarded as unvoiced.
+    std::fill(f0->begin() + tmp_length, f0->end(),
+              0 < tmp_length ? tmp_f0[tmp_length - 1] : 0.0);
     snack::ckfree(tmp_f0);
   }
 
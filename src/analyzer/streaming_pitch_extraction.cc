@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/analyzer/streaming_pitch_extraction.h"
+
+#include <cmath>  // std::ceil
+
+#include "SPTK/analyzer/pitch_extraction_by_world.h"
+#include "SPTK/analyzer/streaming_pitch_extraction_by_rapt.h"
+#include "SPTK/analyzer/streaming_pitch_extraction_by_segment.h"
+
+namespace {
+
+const double kSegmentDuration(0.5);
+const double kContextDuration(0.25);
+
+}  // namespace
+
+namespace sptk {
+
+StreamingPitchExtraction::StreamingPitchExtraction(
+    int frame_shift, double sampling_rate, double lower_f0, double upper_f0,
+    double voicing_threshold, PitchExtraction::Algorithms algorithm)
+    : pitch_extraction_(NULL), streaming_pitch_extraction_(NULL) {
+  switch (algorithm) {
+    case PitchExtraction::kRapt: {
+      streaming_pitch_extraction_ = new StreamingPitchExtractionByRapt(
+          frame_shift, sampling_rate, lower_f0, upper_f0, voicing_threshold);
+      return;
+    }
+    case PitchExtraction::kWorld: {
+      pitch_extraction_ = new PitchExtractionByWorld(
+          frame_shift, sampling_rate, lower_f0, upper_f0, voicing_threshold);
+      break;
+    }
+    default: {
+      // SWIPE' and REAPER are not supported since their results are sensitive
+      // to the segmentation.
+      return;
+    }
+  }
+
+  if (0 < frame_shift) {
+    const int segment_length(
+        static_cast<int>(std::ceil(kSegmentDuration * sampling_rate /
+                                   frame_shift)));
+    const int context_length(
+        static_cast<int>(std::ceil(kContextDuration * sampling_rate /
+                                   frame_shift)));
+    streaming_pitch_extraction_ = new StreamingPitchExtractionBySegment(
+        pitch_extraction_, frame_shift, segment_length, context_length);
+  }
+}
+
+}  // namespace sptk
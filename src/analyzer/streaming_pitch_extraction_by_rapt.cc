@@ -0,0 +1,165 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/analyzer/streaming_pitch_extraction_by_rapt.h"
+
+#include <algorithm>  // std::min
+
+#include "Snack/generic/jkGetF0.h"
+
+namespace sptk {
+
+StreamingPitchExtractionByRapt::StreamingPitchExtractionByRapt(
+    int frame_shift, double sampling_rate, double lower_f0, double upper_f0,
+    double voicing_threshold)
+    : frame_shift_(frame_shift),
+      sampling_rate_(sampling_rate),
+      lower_f0_(lower_f0),
+      upper_f0_(upper_f0),
+      voicing_threshold_(voicing_threshold),
+      is_valid_(true),
+      stream_(NULL),
+      latency_(0) {
+  if (frame_shift_ <= 0 || sampling_rate_ / 2 <= upper_f0_ ||
+      (sampling_rate_ <= 6000.0 || 98000.0 <= sampling_rate_) ||
+      (lower_f0_ <= 10.0 || upper_f0_ <= lower_f0_) ||
+      (voicing_threshold_ < -0.6 || 0.7 < voicing_threshold_)) {
+    is_valid_ = false;
+    return;
+  }
+
+  Start();
+  if (NULL == stream_) {
+    is_valid_ = false;
+    return;
+  }
+  latency_ = snack::cGet_f0_latency(stream_);
+}
+
+StreamingPitchExtractionByRapt::~StreamingPitchExtractionByRapt() {
+  if (NULL != stream_) {
+    std::vector<float> dummy;
+    snack::cGet_f0_close(stream_, &dummy);
+  }
+}
+
+bool StreamingPitchExtractionByRapt::Get(const std::vector<double>& waveform,
+                                         std::vector<double>* f0) {
+  // Check inputs.
+  if (!is_valid_ || NULL == stream_ || NULL == f0) {
+    return false;
+  }
+
+  f0->clear();
+  if (waveform.empty()) {
+    return true;
+  }
+
+  if (0 != snack::cGet_f0_put(stream_, &(waveform[0]), waveform.size(),
+                              &pending_f0_)) {
+    return false;
+  }
+  num_input_sample_ += waveform.size();
+
+  // The number of frames of the whole output is not less than this value.
+  const std::int64_t max_num_frame((num_input_sample_ + frame_shift_ - 1) /
+                                   frame_shift_);
+  const int num_frame(static_cast<int>(std::min<std::int64_t>(
+      pending_f0_.size(), max_num_frame - num_output_frame_)));
+  if (0 < num_frame) {
+    f0->assign(pending_f0_.begin(), pending_f0_.begin() + num_frame);
+    pending_f0_.erase(pending_f0_.begin(), pending_f0_.begin() + num_frame);
+    num_output_frame_ += num_frame;
+    last_f0_ = f0->back();
+  }
+
+  return true;
+}
+
+bool StreamingPitchExtractionByRapt::Finish(std::vector<double>* f0) {
+  // Check inputs.
+  if (!is_valid_ || NULL == stream_ || NULL == f0) {
+    return false;
+  }
+
+  f0->clear();
+  // Empty input is not an error unlike too short input.
+  const bool is_succeeded(0 == snack::cGet_f0_close(stream_, &pending_f0_) ||
+                          0 == num_input_sample_);
+  stream_ = NULL;
+
+  if (is_succeeded) {
+    // Fit the length of output to that of PitchExtractionByRapt.
+    const std::int64_t target_num_frame(
+        (num_input_sample_ + frame_shift_ - 1) / frame_shift_);
+    const int num_frame(static_cast<int>(target_num_frame - num_output_frame_));
+    const int num_valid_frame(
+        std::min(num_frame, static_cast<int>(pending_f0_.size())));
+    f0->assign(pending_f0_.begin(), pending_f0_.begin() + num_valid_frame);
+    if (0 < num_valid_frame) {
+      last_f0_ = f0->back();
+    }
+    f0->resize(num_frame, last_f0_);
+  }
+
+  // Prepare for the next input.
+  Start();
+  if (NULL == stream_) {
+    is_valid_ = false;
+    return false;
+  }
+
+  return is_succeeded;
+}
+
+void StreamingPitchExtractionByRapt::Start() {
+  stream_ = snack::cGet_f0_open(frame_shift_, sampling_rate_, lower_f0_,
+                                upper_f0_, voicing_threshold_);
+  num_input_sample_ = 0;
+  num_output_frame_ = 0;
+  last_f0_ = 0.0;
+  pending_f0_.clear();
+}
+
+}  // namespace sptk
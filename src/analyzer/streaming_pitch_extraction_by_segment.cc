@@ -0,0 +1,149 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/analyzer/streaming_pitch_extraction_by_segment.h"
+
+#include <algorithm>  // std::max
+
+namespace sptk {
+
+StreamingPitchExtractionBySegment::StreamingPitchExtractionBySegment(
+    const PitchExtractionInterface* pitch_extraction, int frame_shift,
+    int segment_length, int context_length)
+    : pitch_extraction_(pitch_extraction),
+      frame_shift_(frame_shift),
+      segment_length_(segment_length),
+      context_length_(context_length),
+      is_valid_(true),
+      first_sample_(0),
+      num_input_sample_(0),
+      num_output_frame_(0) {
+  if (NULL == pitch_extraction_ || !pitch_extraction_->IsValid() ||
+      frame_shift_ <= 0 || segment_length_ <= 0 || context_length_ < 0) {
+    is_valid_ = false;
+    return;
+  }
+}
+
+bool StreamingPitchExtractionBySegment::Get(const std::vector<double>& waveform,
+                                            std::vector<double>* f0) {
+  // Check inputs.
+  if (!is_valid_ || NULL == f0) {
+    return false;
+  }
+
+  f0->clear();
+  waveform_.insert(waveform_.end(), waveform.begin(), waveform.end());
+  num_input_sample_ += waveform.size();
+
+  // Process the segments whose lookahead is available.
+  for (std::int64_t end_sample(
+           (num_output_frame_ + segment_length_ + context_length_) *
+           frame_shift_);
+       end_sample <= num_input_sample_;
+       end_sample += segment_length_ * frame_shift_) {
+    if (!Extract(end_sample, segment_length_, f0)) {
+      return false;
+    }
+  }
+
+  // Discard the samples which are no longer needed.
+  const std::int64_t next_first_sample(
+      std::max<std::int64_t>(0, num_output_frame_ - context_length_) *
+      frame_shift_);
+  waveform_.erase(waveform_.begin(),
+                  waveform_.begin() + (next_first_sample - first_sample_));
+  first_sample_ = next_first_sample;
+
+  return true;
+}
+
+bool StreamingPitchExtractionBySegment::Finish(std::vector<double>* f0) {
+  // Check inputs.
+  if (!is_valid_ || NULL == f0) {
+    return false;
+  }
+
+  f0->clear();
+  const int num_remaining_frame(static_cast<int>(
+      (num_input_sample_ + frame_shift_ - 1) / frame_shift_ -
+      num_output_frame_));
+  const bool is_succeeded(
+      0 == num_remaining_frame ||
+      Extract(num_input_sample_, num_remaining_frame, f0));
+
+  // Prepare for the next input.
+  waveform_.clear();
+  first_sample_ = 0;
+  num_input_sample_ = 0;
+  num_output_frame_ = 0;
+
+  return is_succeeded;
+}
+
+bool StreamingPitchExtractionBySegment::Extract(std::int64_t end_sample,
+                                                int num_frame,
+                                                std::vector<double>* f0) {
+  // Segments start at frame boundaries to share the frame positions.
+  const std::int64_t begin_frame(
+      std::max<std::int64_t>(0, num_output_frame_ - context_length_));
+  segment_.assign(
+      waveform_.begin() + (begin_frame * frame_shift_ - first_sample_),
+      waveform_.begin() + (end_sample - first_sample_));
+  if (!pitch_extraction_->Get(segment_, &segment_f0_, NULL, NULL)) {
+    return false;
+  }
+
+  const int offset(static_cast<int>(num_output_frame_ - begin_frame));
+  if (static_cast<int>(segment_f0_.size()) < offset + num_frame) {
+    return false;
+  }
+  f0->insert(f0->end(), segment_f0_.begin() + offset,
+             segment_f0_.begin() + offset + num_frame);
+  num_output_frame_ += num_frame;
+
+  return true;
+}
+
+}  // namespace sptk
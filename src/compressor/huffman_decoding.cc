@@ -44,12 +44,20 @@
 
 #include "SPTK/compressor/huffman_decoding.h"
 
-#include <string>  // std::string
+#include <algorithm>  // std::max, std::min
+#include <map>        // std::map
+
+namespace {
+
+// Maximum number of bits looked up at once.
+const int kMaximumTableWidth(10);
+
+}  // namespace
 
 namespace sptk {
 
 HuffmanDecoding::HuffmanDecoding(std::ifstream* input_stream)
-    : is_valid_(true), root_(NULL), curr_node_(NULL) {
+    : is_valid_(true), root_(NULL), curr_node_(NULL), root_table_width_(0) {
   if (NULL == input_stream) {
     is_valid_ = false;
     return;
@@ -60,9 +68,12 @@ HuffmanDecoding::HuffmanDecoding(std::ifstream* input_stream)
     root_->left = NULL;
     root_->right = NULL;
 
+    std::vector<std::string> codewords;
     double symbol;
     std::string bits;
     while (*input_stream >> symbol >> bits) {
+      symbols_.push_back(symbol);
+      codewords.push_back(bits);
       Node* node(root_);
       for (char& bit : bits) {
         const bool right('1' == bit ? true : false);
@@ -81,8 +92,29 @@ HuffmanDecoding::HuffmanDecoding(std::ifstream* input_stream)
       }
       node->symbol = symbol;
     }
+
+    if (symbols_.empty()) {
+      Free(root_);
+      root_ = NULL;
+      is_valid_ = false;
+      return;
+    }
+
+    // The codewords must be prefix-free to build the lookup tables.
+    std::vector<int> indices(symbols_.size());
+    for (int i(0); i < static_cast<int>(indices.size()); ++i) {
+      indices[i] = i;
+    }
+    int offset;
+    if (!BuildTable(codewords, indices, 0, &offset, &root_table_width_)) {
+      Free(root_);
+      root_ = NULL;
+      is_valid_ = false;
+      return;
+    }
   } catch (...) {
     Free(root_);
+    root_ = NULL;
     is_valid_ = false;
     return;
   }
@@ -111,4 +143,65 @@ bool HuffmanDecoding::Get(bool input, double* output, bool* is_leaf) {
   return true;
 }
 
+bool HuffmanDecoding::BuildTable(const std::vector<std::string>& codewords,
+                                 const std::vector<int>& indices, int depth,
+                                 int* offset, int* width) {
+  int maximum_length(0);
+  for (std::vector<int>::const_iterator itr(indices.begin());
+       itr != indices.end(); ++itr) {
+    maximum_length =
+        std::max(maximum_length, static_cast<int>(codewords[*itr].size()));
+  }
+  *width = std::min(maximum_length - depth, kMaximumTableWidth);
+  *offset = static_cast<int>(tables_.size());
+  if (*width <= 0) {
+    return false;
+  }
+  tables_.resize(*offset + (1 << *width));
+
+  // Fill the entries of short codewords, and gather long codewords by the
+  // prefix in this table.
+  std::map<int, std::vector<int> > groups;
+  for (std::vector<int>::const_iterator itr(indices.begin());
+       itr != indices.end(); ++itr) {
+    const std::string& codeword(codewords[*itr]);
+    const int length(static_cast<int>(codeword.size()) - depth);
+    int prefix(0);
+    for (int i(0); i < std::min(length, *width); ++i) {
+      prefix = (prefix << 1) | ('1' == codeword[depth + i] ? 1 : 0);
+    }
+    if (length <= *width) {
+      const int shift(*width - length);
+      for (int j(prefix << shift); j < ((prefix + 1) << shift); ++j) {
+        Entry& entry(tables_[*offset + j]);
+        if (0 != entry.length) {
+          return false;
+        }
+        entry.value = *itr;
+        entry.length = length;
+      }
+    } else {
+      groups[prefix].push_back(*itr);
+    }
+  }
+
+  for (std::map<int, std::vector<int> >::const_iterator itr(groups.begin());
+       itr != groups.end(); ++itr) {
+    if (0 != tables_[*offset + itr->first].length) {
+      return false;
+    }
+    int next_offset;
+    int next_width;
+    if (!BuildTable(codewords, itr->second, depth + *width, &next_offset,
+                    &next_width)) {
+      return false;
+    }
+    // The tables may have been reallocated.
+    tables_[*offset + itr->first].value = next_offset;
+    tables_[*offset + itr->first].length = -next_width;
+  }
+
+  return true;
+}
+
 }  // namespace sptk
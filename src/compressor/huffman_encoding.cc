@@ -44,34 +44,88 @@
 
 #include "SPTK/compressor/huffman_encoding.h"
 
-#include <algorithm>  // std::copy
+#include <algorithm>  // std::max_element, std::min, std::min_element, std::sort
+#include <cmath>      // std::floor
 #include <cstddef>    // std::size_t
 #include <string>     // std::string
 #include <utility>    // std::make_pair
 
+namespace {
+
+// Maximum size of the table to look up the index of an integer symbol.
+const int kMaximumIntegerSymbolTableSize(1 << 16);
+
+}  // namespace
+
 namespace sptk {
 
 HuffmanEncoding::HuffmanEncoding(std::ifstream* input_stream)
-    : is_valid_(true) {
+    : minimum_integer_symbol_(0.0), is_valid_(true) {
   if (NULL == input_stream) {
     is_valid_ = false;
     return;
   }
 
+  std::vector<double> symbols;
+  std::vector<std::string> codewords;
   {
     double symbol;
     std::string bits;
     while (*input_stream >> symbol >> bits) {
-      std::vector<bool> codeword;
-      for (char& bit : bits) {
-        codeword.push_back('1' == bit ? true : false);
+      // The first codeword is used if the same symbol appears again.
+      if (!symbol_indices_.insert(std::make_pair(symbol, symbols.size()))
+               .second) {
+        continue;
+      }
+      symbols.push_back(symbol);
+      codewords.push_back(bits);
+
+      const int length(static_cast<int>(bits.size()));
+      codeword_offsets_.push_back(static_cast<int>(codeword_chunks_.size()));
+      codeword_lengths_.push_back(length);
+      for (int i(0); i < length; i += 32) {
+        std::uint32_t chunk(0);
+        for (int j(i); j < length && j < i + 32; ++j) {
+          chunk = (chunk << 1) | ('1' == bits[j] ? 1 : 0);
+        }
+        codeword_chunks_.push_back(chunk);
+      }
+      if (0 == length) {
+        codeword_chunks_.push_back(0);
       }
-      codebook_.insert(std::make_pair(symbol, codeword));
     }
   }
 
-  if (0 == codebook_.size()) {
+  if (symbols.empty()) {
     is_valid_ = false;
+    return;
+  }
+
+  // The codewords must be prefix-free to be decodable. After sorting, a
+  // codeword that is a prefix of another one is followed by such a codeword.
+  std::sort(codewords.begin(), codewords.end());
+  for (std::size_t i(1); i < codewords.size(); ++i) {
+    if (0 == codewords[i].compare(0, codewords[i - 1].size(),
+                                  codewords[i - 1])) {
+      is_valid_ = false;
+      return;
+    }
+  }
+
+  // Prepare the direct lookup table if possible.
+  const double minimum(*std::min_element(symbols.begin(), symbols.end()));
+  const double maximum(*std::max_element(symbols.begin(), symbols.end()));
+  bool is_integer(maximum - minimum < kMaximumIntegerSymbolTableSize);
+  for (std::vector<double>::const_iterator itr(symbols.begin());
+       is_integer && itr != symbols.end(); ++itr) {
+    if (std::floor(*itr) != *itr) is_integer = false;
+  }
+  if (is_integer) {
+    minimum_integer_symbol_ = minimum;
+    integer_symbol_indices_.assign(static_cast<int>(maximum - minimum) + 1, -1);
+    for (std::size_t i(0); i < symbols.size(); ++i) {
+      integer_symbol_indices_[static_cast<int>(symbols[i] - minimum)] = i;
+    }
   }
 }
 
@@ -81,17 +135,24 @@ bool HuffmanEncoding::Run(double input, std::vector<bool>* output) const {
     return false;
   }
 
-  if (codebook_.find(input) == codebook_.end()) {
+  const int index(GetSymbolIndex(input));
+  if (index < 0) {
     return false;
   }
 
-  const int output_length(codebook_.at(input).size());
+  const int output_length(codeword_lengths_[index]);
   if (output->size() != static_cast<std::size_t>(output_length)) {
     output->resize(output_length);
   }
 
-  std::copy(codebook_.at(input).begin(), codebook_.at(input).end(),
-            output->begin());
+  const std::uint32_t* chunk(&(codeword_chunks_[codeword_offsets_[index]]));
+  for (int i(0); i < output_length; i += 32) {
+    const int chunk_length(std::min(32, output_length - i));
+    for (int j(0); j < chunk_length; ++j) {
+      (*output)[i + j] = (*chunk >> (chunk_length - 1 - j)) & 1;
+    }
+    ++chunk;
+  }
 
   return true;
 }
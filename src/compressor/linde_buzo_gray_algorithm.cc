@@ -44,18 +44,111 @@
 
 #include "SPTK/compressor/linde_buzo_gray_algorithm.h"
 
-#include <cfloat>   // DBL_MAX
-#include <cmath>    // std::fabs
-#include <cstddef>  // std::size_t
+#include <cfloat>      // DBL_MAX
+#include <cmath>       // std::fabs
+#include <cstddef>     // std::size_t
+#include <functional>  // std::cref
+#include <thread>      // std::thread
 
 #include "SPTK/generator/normal_distributed_random_value_generation.h"
+#include "SPTK/quantizer/nearest_codeword_search.h"
+
+namespace {
+
+// Data shared among the worker threads.
+struct WorkerState {
+  const std::vector<std::vector<double> >* input_vectors;
+  const std::vector<std::vector<double> >* codebook_vectors;
+  const sptk::DistanceCalculator* distance_calculator;
+  const sptk::VectorQuantization* vector_quantization;
+  // NULL if exhaustive search is used.
+  const sptk::NearestCodewordSearch* nearest_codeword_search;
+  const sptk::StatisticsAccumulator* statistics_accumulator;
+  int num_thread;
+  std::vector<int>* codebook_index;
+  std::vector<double>* distances;
+  std::vector<sptk::StatisticsAccumulator::Buffer>* buffers;
+};
+
+// Find nearest codewords of the input vectors assigned to the given thread.
+void AssignVectors(const WorkerState& state, int thread_index,
+                   bool* is_succeeded) {
+  const int num_input_vector(state.input_vectors->size());
+  const int begin(static_cast<int>(static_cast<long long>(num_input_vector) *
+                                   thread_index / state.num_thread));
+  const int end(static_cast<int>(static_cast<long long>(num_input_vector) *
+                                 (thread_index + 1) / state.num_thread));
+  for (int i(begin); i < end; ++i) {
+    const std::vector<double>& input_vector((*state.input_vectors)[i]);
+    int* index(&((*state.codebook_index)[i]));
+    double* distance(&((*state.distances)[i]));
+    if (NULL != state.nearest_codeword_search) {
+      // The previous assignment is used as a hint of the search.
+      if (!state.nearest_codeword_search->Run(input_vector, *index, index,
+                                              distance)) {
+        *is_succeeded = false;
+        return;
+      }
+    } else {
+      if (!state.vector_quantization->Run(input_vector,
+                                          *state.codebook_vectors, index) ||
+          !state.distance_calculator->Run(
+              input_vector, (*state.codebook_vectors)[*index], distance)) {
+        *is_succeeded = false;
+        return;
+      }
+    }
+  }
+  *is_succeeded = true;
+}
+
+// Accumulate statistics of the clusters owned by the given thread. Each
+// cluster is updated by only one thread in the order of the input vectors, so
+// the result does not depend on the number of threads.
+void AccumulateStatistics(const WorkerState& state, int thread_index,
+                          bool* is_succeeded) {
+  const int num_input_vector(state.input_vectors->size());
+  for (int i(0); i < num_input_vector; ++i) {
+    const int index((*state.codebook_index)[i]);
+    if (index % state.num_thread == thread_index &&
+        !state.statistics_accumulator->Run((*state.input_vectors)[i],
+                                           &((*state.buffers)[index]))) {
+      *is_succeeded = false;
+      return;
+    }
+  }
+  *is_succeeded = true;
+}
+
+bool RunWorkers(void (*worker)(const WorkerState&, int, bool*),
+                const WorkerState& state) {
+  // The calling thread works as the first worker.
+  std::vector<std::thread> threads;
+  bool* is_succeeded(new bool[state.num_thread]);
+  for (int t(1); t < state.num_thread; ++t) {
+    threads.push_back(
+        std::thread(worker, std::cref(state), t, is_succeeded + t));
+  }
+  worker(state, 0, is_succeeded);
+
+  bool result(is_succeeded[0]);
+  for (int t(1); t < state.num_thread; ++t) {
+    threads[t - 1].join();
+    if (!is_succeeded[t]) result = false;
+  }
+  delete[] is_succeeded;
+  return result;
+}
+
+}  // namespace
 
 namespace sptk {
 
 LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
     int num_order, int seed, int initial_codebook_size,
     int target_codebook_size, int minimum_num_vector_in_cluster,
-    int num_iteration, double convergence_threshold, double splitting_factor)
+    int num_iteration, double convergence_threshold, double splitting_factor,
+    bool fast_search_flag, int num_thread)
     : num_order_(num_order),
       seed_(seed),
       initial_codebook_size_(initial_codebook_size),
@@ -64,6 +157,8 @@ LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
       num_iteration_(num_iteration),
       convergence_threshold_(convergence_threshold),
       splitting_factor_(splitting_factor),
+      fast_search_flag_(fast_search_flag),
+      num_thread_(num_thread),
       distance_calculator_(
           num_order_, DistanceCalculator::DistanceMetrics::kSquaredEuclidean),
       statistics_accumulator_(num_order_, 1),
@@ -73,8 +168,8 @@ LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
       target_codebook_size_ <= initial_codebook_size_ ||
       minimum_num_vector_in_cluster <= 0 || num_iteration_ <= 0 ||
       convergence_threshold < 0.0 || splitting_factor <= 0.0 ||
-      !distance_calculator_.IsValid() || !statistics_accumulator_.IsValid() ||
-      !vector_quantization_.IsValid()) {
+      num_thread_ <= 0 || !distance_calculator_.IsValid() ||
+      !statistics_accumulator_.IsValid() || !vector_quantization_.IsValid()) {
     is_valid_ = false;
   }
 }
@@ -99,6 +194,24 @@ bool LindeBuzoGrayAlgorithm::Run(
     codebook_index->resize(num_input_vector);
   }
   std::vector<StatisticsAccumulator::Buffer> buffers(target_codebook_size_);
+  std::vector<double> distances(num_input_vector);
+  NearestCodewordSearch nearest_codeword_search(num_order_);
+  for (int i(0); i < num_input_vector; ++i) {
+    (*codebook_index)[i] = 0;
+  }
+
+  WorkerState state;
+  state.input_vectors = &input_vectors;
+  state.codebook_vectors = codebook_vectors;
+  state.distance_calculator = &distance_calculator_;
+  state.vector_quantization = &vector_quantization_;
+  state.nearest_codeword_search =
+      fast_search_flag_ ? &nearest_codeword_search : NULL;
+  state.statistics_accumulator = &statistics_accumulator_;
+  state.num_thread = num_thread_;
+  state.codebook_index = codebook_index;
+  state.distances = &distances;
+  state.buffers = &buffers;
 
   // prepare random value generator
   NormalDistributedRandomValueGeneration random_value_generation(seed_);
@@ -136,24 +249,14 @@ bool LindeBuzoGrayAlgorithm::Run(
       }
 
       // accumulate statistics (E-step)
+      if ((fast_search_flag_ &&
+           !nearest_codeword_search.SetCodebook(*codebook_vectors)) ||
+          !RunWorkers(AssignVectors, state) ||
+          !RunWorkers(AccumulateStatistics, state)) {
+        return false;
+      }
       for (int i(0); i < num_input_vector; ++i) {
-        int index;
-        if (!vector_quantization_.Run(input_vectors[i], *codebook_vectors,
-                                      &index)) {
-          return false;
-        }
-        (*codebook_index)[i] = index;
-
-        if (!statistics_accumulator_.Run(input_vectors[i], &(buffers[index]))) {
-          return false;
-        }
-
-        double distance;
-        if (!distance_calculator_.Run(input_vectors[i],
-                                      (*codebook_vectors)[index], &distance)) {
-          return false;
-        }
-        total_distance += distance;
+        total_distance += distances[i];
       }
       total_distance /= num_input_vector;
 
@@ -213,11 +316,10 @@ bool LindeBuzoGrayAlgorithm::Run(
   }
 
   // save final results
-  for (int i(0); i < num_input_vector; ++i) {
-    if (!vector_quantization_.Run(input_vectors[i], *codebook_vectors,
-                                  &((*codebook_index)[i]))) {
-      return false;
-    }
+  if ((fast_search_flag_ &&
+       !nearest_codeword_search.SetCodebook(*codebook_vectors)) ||
+      !RunWorkers(AssignVectors, state)) {
+    return false;
   }
 
   return true;
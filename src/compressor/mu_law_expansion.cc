@@ -44,7 +44,31 @@
 
 #include "SPTK/compressor/mu_law_expansion.h"
 
-#include <cmath>  // std::fabs, std::pow
+#include <algorithm>  // std::min
+#include <cmath>      // std::fabs, std::floor, std::log, std::pow
+
+#include "SPTK/utils/simd.h"
+#include "SPTK/utils/simd_math.h"
+
+namespace {
+
+using sptk::simd::ApproximateExponential;
+using sptk::simd::Broadcast;
+using sptk::simd::Multiply;
+using sptk::simd::Subtract;
+using sptk::simd::Vector;
+
+// Upper bound of the magnitude of integer inputs looked up in the table. It
+// covers 16-bit data.
+const double kMaximumTableInput(32768.0);
+
+// Number of data processed at once in the block function.
+const int kNumDataInTile(512);
+
+// Upper bound of the input of the approximated exponential.
+const double kMaximumExponent(708.0);
+
+}  // namespace
 
 namespace sptk {
 
@@ -52,11 +76,19 @@ MuLawExpansion::MuLawExpansion(double abs_max_value, double compression_factor)
     : abs_max_value_(abs_max_value),
       compression_factor_(compression_factor),
       constant_(1.0 / compression_factor_),
-      is_valid_(true) {
+      is_valid_(true),
+      max_table_index_(0) {
   if (abs_max_value_ <= 0.0 || compression_factor_ <= 0.0) {
     is_valid_ = false;
     return;
   }
+
+  max_table_index_ = static_cast<int>(
+      std::floor(std::min(abs_max_value_, kMaximumTableInput)));
+  outputs_for_integer_inputs_.resize(2 * max_table_index_ + 1);
+  for (int i(-max_table_index_); i <= max_table_index_; ++i) {
+    Run(i, &outputs_for_integer_inputs_[i + max_table_index_]);
+  }
 }
 
 bool MuLawExpansion::Run(double input, double* output) const {
@@ -76,4 +108,67 @@ bool MuLawExpansion::Run(double* input_and_output) const {
   return Run(*input_and_output, input_and_output);
 }
 
+bool MuLawExpansion::Run(int num_data, bool uses_fast_approximation,
+                         double* input_and_output) const {
+  if (!is_valid_ || num_data < 0 ||
+      (0 < num_data && NULL == input_and_output)) {
+    return false;
+  }
+
+  // y = c * (exp(a * |x|) - 1), where c = V / mu and a = ln(1 + mu) / V.
+  const double log_base(std::log(1.0 + compression_factor_));
+  const Vector c(Broadcast(constant_ * abs_max_value_));
+  const Vector a(Broadcast(log_base / abs_max_value_));
+  const Vector one(Broadcast(1.0));
+  const double upper_bound(kMaximumExponent / log_base * abs_max_value_);
+  const double max_table_input(max_table_index_);
+  const double* table(&outputs_for_integer_inputs_[max_table_index_]);
+
+  int indices[kNumDataInTile];
+  double magnitudes[kNumDataInTile];
+  for (int begin(0); begin < num_data; begin += kNumDataInTile) {
+    const int end(std::min(begin + kNumDataInTile, num_data));
+
+    // Look up the table, and collect the rest.
+    int num_rest(0);
+    for (int i(begin); i < end; ++i) {
+      const double x(input_and_output[i]);
+      if (std::fabs(x) <= max_table_input) {
+        const int index(static_cast<int>(x));
+        if (index == x) {
+          input_and_output[i] = table[index];
+          continue;
+        }
+      }
+      if (uses_fast_approximation) {
+        indices[num_rest] = i;
+        magnitudes[num_rest] = std::fabs(x);
+        ++num_rest;
+      } else {
+        Run(x, &input_and_output[i]);
+      }
+    }
+    if (0 == num_rest) continue;
+
+    sptk::simd::ApplyApproximation(
+        [&](Vector x) {
+          return Multiply(
+              c, Subtract(ApproximateExponential(Multiply(a, x)), one));
+        },
+        [this](double x) {
+          double y(0.0);
+          Run(x, &y);
+          return y;
+        },
+        0.0, upper_bound, num_rest, magnitudes);
+    for (int j(0); j < num_rest; ++j) {
+      const int i(indices[j]);
+      input_and_output[i] =
+          (input_and_output[i] < 0.0) ? -magnitudes[j] : magnitudes[j];
+    }
+  }
+
+  return true;
+}
+
 }  // namespace sptk
@@ -193,21 +193,147 @@ bool FilterCoefficientsToSpectrum::Run(
         [gain](double x, double y) { return gain * x / y; });
   }
 
+  return ConvertPowerSpectrum(&((*spectrum)[0]));
+}
+
+bool FilterCoefficientsToSpectrum::Run(
+    const Matrix& numerator_coefficients,
+    const std::vector<double>& denominator_coefficients, Matrix* spectra,
+    FilterCoefficientsToSpectrum::Buffer* buffer) const {
+  // check inputs
+  const int num_frame(numerator_coefficients.GetNumRow());
+  const int numerator_length(num_numerator_order_ + 1);
+  const int denominator_length(num_denominator_order_ + 1);
+  if (!is_valid_ || numerator_coefficients.GetNumColumn() != numerator_length ||
+      denominator_coefficients.size() !=
+          static_cast<std::size_t>(denominator_length) ||
+      NULL == spectra || NULL == buffer) {
+    return false;
+  }
+
+  // get gain of transfer function
+  const double gain(denominator_coefficients[0] * denominator_coefficients[0]);
+  if (0.0 == gain) {
+    return false;
+  }
+
+  // prepare memories
+  const int output_length(fft_length_ / 2 + 1);
+  if (spectra->GetNumRow() != num_frame ||
+      spectra->GetNumColumn() != output_length) {
+    spectra->Resize(num_frame, output_length);
+  }
+  if (buffer->fast_fourier_transform_input_.size() <
+      static_cast<std::size_t>(fft_length_)) {
+    buffer->fast_fourier_transform_input_.resize(fft_length_);
+  }
+  if (buffer->denominator_of_transfer_function_.size() <
+      static_cast<std::size_t>(output_length)) {
+    buffer->denominator_of_transfer_function_.resize(output_length);
+  }
+
+  // calculate denominators of transfer function once for all frames
+  if (1 != denominator_length) {
+    buffer->fast_fourier_transform_input_[0] = 1.0;
+    std::copy(denominator_coefficients.begin() + 1,
+              denominator_coefficients.end(),
+              buffer->fast_fourier_transform_input_.begin() + 1);
+    std::fill(
+        buffer->fast_fourier_transform_input_.begin() + denominator_length,
+        buffer->fast_fourier_transform_input_.end(), 0.0);
+    if (!fast_fourier_transform_.Run(
+            buffer->fast_fourier_transform_input_,
+            &buffer->fast_fourier_transform_real_output_,
+            &buffer->fast_fourier_transform_imaginary_output_,
+            &buffer->fast_fourier_transform_buffer_)) {
+      return false;
+    }
+
+    const double* yr(&buffer->fast_fourier_transform_real_output_[0]);
+    const double* yi(&buffer->fast_fourier_transform_imaginary_output_[0]);
+    double* y(&buffer->denominator_of_transfer_function_[0]);
+    for (int i(0); i < output_length; ++i) {
+      y[i] = yr[i] * yr[i] + yi[i] * yi[i];
+      if (0.0 == y[i]) {
+        return false;
+      }
+    }
+  }
+
+  // calculate numerators of transfer function
+  if (1 != numerator_length) {
+    if (buffer->fast_fourier_transform_inputs_.GetNumRow() != num_frame ||
+        buffer->fast_fourier_transform_inputs_.GetNumColumn() != fft_length_) {
+      buffer->fast_fourier_transform_inputs_.Resize(num_frame, fft_length_);
+    }
+    for (int n(0); n < num_frame; ++n) {
+      double* x(buffer->fast_fourier_transform_inputs_[n]);
+      std::copy(numerator_coefficients[n],
+                numerator_coefficients[n] + numerator_length, x);
+      std::fill(x + numerator_length, x + fft_length_, 0.0);
+    }
+    if (!fast_fourier_transform_.Run(
+            buffer->fast_fourier_transform_inputs_,
+            &buffer->fast_fourier_transform_real_outputs_,
+            &buffer->fast_fourier_transform_imaginary_outputs_,
+            &buffer->fast_fourier_transform_buffer_)) {
+      return false;
+    }
+  }
+
+  // calculate power spectra
+  const double* y(&buffer->denominator_of_transfer_function_[0]);
+  for (int n(0); n < num_frame; ++n) {
+    double* spectrum((*spectra)[n]);
+    if (1 == numerator_length) {
+      const double tmp(gain * numerator_coefficients[n][0] *
+                       numerator_coefficients[n][0]);
+      if (1 == denominator_length) {
+        std::fill(spectrum, spectrum + output_length, tmp);
+      } else {
+        for (int i(0); i < output_length; ++i) {
+          spectrum[i] = tmp / y[i];
+        }
+      }
+    } else {
+      const double* xr(buffer->fast_fourier_transform_real_outputs_[n]);
+      const double* xi(buffer->fast_fourier_transform_imaginary_outputs_[n]);
+      if (1 == denominator_length) {
+        for (int i(0); i < output_length; ++i) {
+          spectrum[i] = gain * (xr[i] * xr[i] + xi[i] * xi[i]);
+        }
+      } else {
+        for (int i(0); i < output_length; ++i) {
+          spectrum[i] = gain * (xr[i] * xr[i] + xi[i] * xi[i]) / y[i];
+        }
+      }
+    }
+    if (!ConvertPowerSpectrum(spectrum)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool FilterCoefficientsToSpectrum::ConvertPowerSpectrum(
+    double* spectrum) const {
+  const int output_length(fft_length_ / 2 + 1);
   if (kLogAmplitudeSpectrumInDecibels == output_format_ ||
       kLogAmplitudeSpectrum == output_format_) {
     if (0.0 != epsilon_for_calculating_logarithms_) {
       std::transform(
-          spectrum->begin(), spectrum->end(), spectrum->begin(),
+          spectrum, spectrum + output_length, spectrum,
           std::bind(std::plus<double>(), epsilon_for_calculating_logarithms_,
                     std::placeholders::_1));
     }
     if (-DBL_MAX != relative_floor_in_decibels_) {
       const double max_value_of_power_spectrum(
-          *std::max_element(spectrum->begin(), spectrum->end()));
+          *std::max_element(spectrum, spectrum + output_length));
       const double floor_in_power_spectrum(
           max_value_of_power_spectrum *
           std::pow(10.0, 0.1 * relative_floor_in_decibels_));
-      std::transform(spectrum->begin(), spectrum->end(), spectrum->begin(),
+      std::transform(spectrum, spectrum + output_length, spectrum,
                      [floor_in_power_spectrum](double x) {
                        return std::max(x, floor_in_power_spectrum);
                      });
@@ -216,17 +342,17 @@ bool FilterCoefficientsToSpectrum::Run(
 
   switch (output_format_) {
     case kLogAmplitudeSpectrumInDecibels: {
-      std::transform(spectrum->begin(), spectrum->end(), spectrum->begin(),
+      std::transform(spectrum, spectrum + output_length, spectrum,
                      [this](double x) { return 10.0 * std::log10(x); });
       break;
     }
     case kLogAmplitudeSpectrum: {
-      std::transform(spectrum->begin(), spectrum->end(), spectrum->begin(),
+      std::transform(spectrum, spectrum + output_length, spectrum,
                      [this](double x) { return 0.5 * std::log(x); });
       break;
     }
     case kAmplitudeSpectrum: {
-      std::transform(spectrum->begin(), spectrum->end(), spectrum->begin(),
+      std::transform(spectrum, spectrum + output_length, spectrum,
                      [](double x) { return std::sqrt(x); });
       break;
     }
@@ -65,4 +65,14 @@ bool WaveformToSpectrum::Run(const std::vector<double>& waveform,
       &buffer->buffer_);
 }
 
+bool WaveformToSpectrum::Run(const Matrix& waveforms, Matrix* spectra,
+                             WaveformToSpectrum::Buffer* buffer) const {
+  if (NULL == buffer) {
+    return false;
+  }
+  return filter_coefficients_to_spectrum_.Run(
+      waveforms, dummy_for_filter_coefficients_to_spectrum_, spectra,
+      &buffer->buffer_);
+}
+
 }  // namespace sptk
@@ -49,8 +49,9 @@
 
 namespace sptk {
 
-AllPoleDigitalFilter::AllPoleDigitalFilter(int num_filter_order,
-                                           bool transposition)
+template <typename T>
+AllPoleDigitalFilterBase<T>::AllPoleDigitalFilterBase(int num_filter_order,
+                                                      bool transposition)
     : num_filter_order_(num_filter_order),
       transposition_(transposition),
       is_valid_(true) {
@@ -60,9 +61,10 @@ AllPoleDigitalFilter::AllPoleDigitalFilter(int num_filter_order,
   }
 }
 
-bool AllPoleDigitalFilter::Run(const std::vector<double>& filter_coefficients,
-                               double filter_input, double* filter_output,
-                               AllPoleDigitalFilter::Buffer* buffer) const {
+template <typename T>
+bool AllPoleDigitalFilterBase<T>::Run(
+    const std::vector<T>& filter_coefficients, T filter_input,
+    T* filter_output, AllPoleDigitalFilterBase::Buffer* buffer) const {
   // Check inputs.
   if (!is_valid_ ||
       filter_coefficients.size() !=
@@ -72,22 +74,114 @@ bool AllPoleDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   }
 
   // Prepare memories.
+  PrepareBuffer(buffer);
+
+  // Apply all-pole filter.
+  *filter_output =
+      ApplyFilter(&(filter_coefficients[0]), filter_input, buffer);
+
+  return true;
+}
+
+template <typename T>
+bool AllPoleDigitalFilterBase<T>::Run(
+    const std::vector<T>& filter_coefficients, T* input_and_output,
+    AllPoleDigitalFilterBase::Buffer* buffer) const {
+  if (NULL == input_and_output) return false;
+  return Run(filter_coefficients, *input_and_output, input_and_output, buffer);
+}
+
+template <typename T>
+bool AllPoleDigitalFilterBase<T>::Run(
+    const std::vector<T>& filter_coefficients,
+    const std::vector<T>& filter_input, std::vector<T>* filter_output,
+    AllPoleDigitalFilterBase::Buffer* buffer) const {
+  // Check inputs.
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // Apply all-pole filter.
+  const T* coefficients(&(filter_coefficients[0]));
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+template <typename T>
+bool AllPoleDigitalFilterBase<T>::Run(
+    const std::vector<T>& first_filter_coefficients,
+    const std::vector<T>& next_filter_coefficients,
+    const std::vector<T>& filter_input, std::vector<T>* filter_output,
+    AllPoleDigitalFilterBase::Buffer* buffer) const {
+  // Check inputs.
+  const int filter_length(num_filter_order_ + 1);
+  if (!is_valid_ ||
+      first_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      next_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = first_filter_coefficients;
+
+  // Apply all-pole filter while updating filter coefficients.
+  const T rate(static_cast<T>(1.0 / block_length));
+  const T* c0(&(first_filter_coefficients[0]));
+  const T* c1(&(next_filter_coefficients[0]));
+  T* coefficients(&buffer->interpolated_filter_coefficients_[0]);
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+    for (int m(0); m < filter_length; ++m) {
+      coefficients[m] += rate * (c1[m] - c0[m]);
+    }
+  }
+
+  return true;
+}
+
+template <typename T>
+void AllPoleDigitalFilterBase<T>::PrepareBuffer(
+    AllPoleDigitalFilterBase::Buffer* buffer) const {
   if (buffer->d_.size() != static_cast<std::size_t>(num_filter_order_)) {
     buffer->d_.resize(num_filter_order_);
     std::fill(buffer->d_.begin(), buffer->d_.end(), 0.0);
   }
+}
 
-  const double gained_input(filter_input * filter_coefficients[0]);
+template <typename T>
+T AllPoleDigitalFilterBase<T>::ApplyFilter(
+    const T* filter_coefficients, T filter_input,
+    AllPoleDigitalFilterBase::Buffer* buffer) const {
+  const T gained_input(filter_input * filter_coefficients[0]);
   if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
+    return gained_input;
   }
 
-  const double* a(&(filter_coefficients[1]));
-  double* d(&buffer->d_[0]);
-  double sum(gained_input);
+  const T* a(filter_coefficients + 1);
+  T* d(&buffer->d_[0]);
+  T sum(gained_input);
 
-  // Apply all-pole filter.
   if (transposition_) {
     sum -= d[0];
     for (int m(1); m < num_filter_order_; ++m) {
@@ -103,17 +197,10 @@ bool AllPoleDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     d[0] = sum;
   }
 
-  // Save result.
-  *filter_output = sum;
-
-  return true;
+  return sum;
 }
 
-bool AllPoleDigitalFilter::Run(const std::vector<double>& filter_coefficients,
-                               double* input_and_output,
-                               AllPoleDigitalFilter::Buffer* buffer) const {
-  if (NULL == input_and_output) return false;
-  return Run(filter_coefficients, *input_and_output, input_and_output, buffer);
-}
+template class AllPoleDigitalFilterBase<float>;
+template class AllPoleDigitalFilterBase<double>;
 
 }  // namespace sptk
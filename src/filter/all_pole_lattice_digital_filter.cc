@@ -61,20 +61,101 @@ bool AllPoleLatticeDigitalFilter::Run(
   }
 
   // prepare memory
+  PrepareBuffer(buffer);
+
+  // apply filter
+  *filter_output =
+      ApplyFilter(&(filter_coefficients[0]), filter_input, buffer);
+
+  return true;
+}
+
+bool AllPoleLatticeDigitalFilter::Run(
+    const std::vector<double>& filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    AllPoleLatticeDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // apply all-pole lattice filter
+  const double* coefficients(&(filter_coefficients[0]));
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+bool AllPoleLatticeDigitalFilter::Run(
+    const std::vector<double>& first_filter_coefficients,
+    const std::vector<double>& next_filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    AllPoleLatticeDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  const int filter_length(num_filter_order_ + 1);
+  if (!is_valid_ ||
+      first_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      next_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = first_filter_coefficients;
+
+  // apply all-pole lattice filter while updating filter coefficients
+  const double rate(1.0 / block_length);
+  const double* c0(&(first_filter_coefficients[0]));
+  const double* c1(&(next_filter_coefficients[0]));
+  double* coefficients(&buffer->interpolated_filter_coefficients_[0]);
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+    for (int m(0); m < filter_length; ++m) {
+      coefficients[m] += rate * (c1[m] - c0[m]);
+    }
+  }
+
+  return true;
+}
+
+void AllPoleLatticeDigitalFilter::PrepareBuffer(
+    AllPoleLatticeDigitalFilter::Buffer* buffer) const {
   if (buffer->signals_.size() != static_cast<std::size_t>(num_filter_order_)) {
     buffer->signals_.resize(num_filter_order_);
     std::fill(buffer->signals_.begin(), buffer->signals_.end(), 0.0);
   }
+}
 
+double AllPoleLatticeDigitalFilter::ApplyFilter(
+    const double* filter_coefficients, double filter_input,
+    AllPoleLatticeDigitalFilter::Buffer* buffer) const {
   // set value
   const double gained_input(filter_input * filter_coefficients[0]);
   if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
+    return gained_input;
   }
 
   // get values
-  const double* coefficients(&(filter_coefficients[0]));
+  const double* coefficients(filter_coefficients);
   double* signals(&buffer->signals_[0]);
 
   // apply filter
@@ -86,10 +167,7 @@ bool AllPoleLatticeDigitalFilter::Run(
   }
   signals[0] = sum;
 
-  // save result
-  *filter_output = sum;
-
-  return true;
+  return sum;
 }
 
 }  // namespace sptk
@@ -44,15 +44,46 @@
 
 #include "SPTK/filter/all_zero_digital_filter.h"
 
-#include <algorithm>  // std::fill
+#include <algorithm>  // std::copy, std::equal, std::fill, std::min
+#include <cmath>      // std::log2
 #include <cstddef>    // std::size_t
 
+namespace {
+
+// The overlap-save method is never used for lower orders.
+const int kMinimumOrderForFastConvolution(32);
+
+// The FFT length is the smallest power of two greater than this factor times
+// the filter length.
+const int kFftLengthFactor(4);
+
+// Relative cost of one FFT butterfly to one multiply-accumulate.
+const double kCostOfButterfly(2.0);
+
+int ChooseFftLength(int num_filter_order, bool transposition) {
+  if (transposition || num_filter_order < kMinimumOrderForFastConvolution) {
+    return 0;
+  }
+  int fft_length(2);
+  while (fft_length < kFftLengthFactor * (num_filter_order + 1)) {
+    fft_length *= 2;
+  }
+  return fft_length;
+}
+
+}  // namespace
+
 namespace sptk {
 
-AllZeroDigitalFilter::AllZeroDigitalFilter(int num_filter_order,
-                                           bool transposition)
+template <typename T>
+AllZeroDigitalFilterBase<T>::AllZeroDigitalFilterBase(int num_filter_order,
+                                                      bool transposition)
     : num_filter_order_(num_filter_order),
       transposition_(transposition),
+      fft_length_(ChooseFftLength(num_filter_order_, transposition_)),
+      fourier_transform_for_filter_(num_filter_order_, fft_length_),
+      fourier_transform_(fft_length_),
+      inverse_fourier_transform_(fft_length_),
       is_valid_(true) {
   if (num_filter_order_ < 0) {
     is_valid_ = false;
@@ -60,9 +91,10 @@ AllZeroDigitalFilter::AllZeroDigitalFilter(int num_filter_order,
   }
 }
 
-bool AllZeroDigitalFilter::Run(const std::vector<double>& filter_coefficients,
-                               double filter_input, double* filter_output,
-                               AllZeroDigitalFilter::Buffer* buffer) const {
+template <typename T>
+bool AllZeroDigitalFilterBase<T>::Run(
+    const std::vector<T>& filter_coefficients, T filter_input,
+    T* filter_output, AllZeroDigitalFilterBase::Buffer* buffer) const {
   // Check inputs.
   if (!is_valid_ ||
       filter_coefficients.size() !=
@@ -72,22 +104,122 @@ bool AllZeroDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   }
 
   // Prepare memories.
-  if (buffer->d_.size() != static_cast<std::size_t>(num_filter_order_)) {
-    buffer->d_.resize(num_filter_order_);
+  PrepareBuffer(buffer);
+
+  // Apply all-zero filter.
+  *filter_output =
+      ApplyFilter(&(filter_coefficients[0]), filter_input, buffer);
+
+  return true;
+}
+
+template <typename T>
+bool AllZeroDigitalFilterBase<T>::Run(
+    const std::vector<T>& filter_coefficients, T* input_and_output,
+    AllZeroDigitalFilterBase::Buffer* buffer) const {
+  if (NULL == input_and_output) return false;
+  return Run(filter_coefficients, *input_and_output, input_and_output, buffer);
+}
+
+template <typename T>
+bool AllZeroDigitalFilterBase<T>::Run(
+    const std::vector<T>& filter_coefficients,
+    const std::vector<T>& filter_input, std::vector<T>* filter_output,
+    AllZeroDigitalFilterBase::Buffer* buffer) const {
+  // Check inputs.
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // Apply all-zero filter.
+  if (UsesFastConvolution(block_length)) {
+    return ApplyFilterInFrequencyDomain(filter_coefficients, filter_input,
+                                        filter_output, buffer);
+  }
+  const T* coefficients(&(filter_coefficients[0]));
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+template <typename T>
+bool AllZeroDigitalFilterBase<T>::Run(
+    const std::vector<T>& first_filter_coefficients,
+    const std::vector<T>& next_filter_coefficients,
+    const std::vector<T>& filter_input, std::vector<T>* filter_output,
+    AllZeroDigitalFilterBase::Buffer* buffer) const {
+  // Check inputs.
+  const int filter_length(num_filter_order_ + 1);
+  if (!is_valid_ ||
+      first_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      next_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = first_filter_coefficients;
+
+  // Apply all-zero filter while updating filter coefficients.
+  const T rate(static_cast<T>(1.0 / block_length));
+  const T* c0(&(first_filter_coefficients[0]));
+  const T* c1(&(next_filter_coefficients[0]));
+  T* coefficients(&buffer->interpolated_filter_coefficients_[0]);
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+    for (int m(0); m < filter_length; ++m) {
+      coefficients[m] += rate * (c1[m] - c0[m]);
+    }
+  }
+
+  return true;
+}
+
+template <typename T>
+void AllZeroDigitalFilterBase<T>::PrepareBuffer(
+    AllZeroDigitalFilterBase::Buffer* buffer) const {
+  // The delay line of the direct form is a circular buffer whose contents are
+  // duplicated so that the past inputs are always contiguous.
+  const int size(transposition_ ? num_filter_order_ : 2 * num_filter_order_);
+  if (buffer->d_.size() != static_cast<std::size_t>(size)) {
+    buffer->d_.resize(size);
     std::fill(buffer->d_.begin(), buffer->d_.end(), 0.0);
+    buffer->position_in_d_ = 0;
   }
+}
 
-  const double gained_input(filter_input * filter_coefficients[0]);
+template <typename T>
+T AllZeroDigitalFilterBase<T>::ApplyFilter(
+    const T* filter_coefficients, T filter_input,
+    AllZeroDigitalFilterBase::Buffer* buffer) const {
+  const T gained_input(filter_input * filter_coefficients[0]);
   if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
+    return gained_input;
   }
 
-  const double* b(&(filter_coefficients[1]));
-  double* d(&buffer->d_[0]);
-  double sum(gained_input);
+  const T* b(filter_coefficients + 1);
+  T* d(&buffer->d_[0]);
+  T sum(gained_input);
 
-  // Apply all-zero filter.
   if (transposition_) {
     sum += d[0];
     for (int m(1); m < num_filter_order_; ++m) {
@@ -95,25 +227,136 @@ bool AllZeroDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     }
     d[num_filter_order_ - 1] = b[num_filter_order_ - 1] * filter_input;
   } else {
-    for (int m(num_filter_order_ - 1); 0 < m; --m) {
-      sum += b[m] * d[m];
-      d[m] = d[m - 1];
+    // x[m] is the (m + 1)-th past input.
+    const int position(buffer->position_in_d_);
+    const T* x(d + position);
+    for (int m(num_filter_order_ - 1); 0 <= m; --m) {
+      sum += b[m] * x[m];
     }
-    sum += b[0] * d[0];
-    d[0] = filter_input;
+    const int next_position(0 == position ? num_filter_order_ - 1
+                                          : position - 1);
+    d[next_position] = filter_input;
+    d[next_position + num_filter_order_] = filter_input;
+    buffer->position_in_d_ = next_position;
   }
 
-  // Save result.
-  *filter_output = sum;
+  return sum;
+}
 
-  return true;
+template <typename T>
+bool AllZeroDigitalFilterBase<T>::UsesFastConvolution(int block_length) const {
+  if (0 == fft_length_ || 0 == block_length) {
+    return false;
+  }
+
+  // Two segments are transformed at once as the real and imaginary parts.
+  const int segment_length(fft_length_ - num_filter_order_);
+  const int num_segment((block_length + segment_length - 1) / segment_length);
+  const int num_transform((num_segment + 1) / 2);
+  const double cost_of_fast_convolution(
+      kCostOfButterfly * num_transform * fft_length_ * std::log2(fft_length_));
+  const double cost_of_direct_form(static_cast<double>(block_length) *
+                                   (num_filter_order_ + 1));
+  return cost_of_fast_convolution < cost_of_direct_form;
 }
 
-bool AllZeroDigitalFilter::Run(const std::vector<double>& filter_coefficients,
-                               double* input_and_output,
-                               AllZeroDigitalFilter::Buffer* buffer) const {
-  if (NULL == input_and_output) return false;
-  return Run(filter_coefficients, *input_and_output, input_and_output, buffer);
+template <typename T>
+bool AllZeroDigitalFilterBase<T>::ApplyFilterInFrequencyDomain(
+    const std::vector<T>& filter_coefficients,
+    const std::vector<T>& filter_input, std::vector<T>* filter_output,
+    AllZeroDigitalFilterBase::Buffer* buffer) const {
+  const int block_length(static_cast<int>(filter_input.size()));
+  const int segment_length(fft_length_ - num_filter_order_);
+  const int num_segment((block_length + segment_length - 1) / segment_length);
+
+  // Calculate the spectrum of the filter if the coefficients are changed.
+  if (buffer->cached_filter_coefficients_.size() !=
+          filter_coefficients.size() ||
+      !std::equal(filter_coefficients.begin(), filter_coefficients.end(),
+                  buffer->cached_filter_coefficients_.begin())) {
+    if (!fourier_transform_for_filter_.Run(
+            filter_coefficients, &buffer->real_part_of_filter_spectrum_,
+            &buffer->imag_part_of_filter_spectrum_,
+            &buffer->fourier_transform_buffer_)) {
+      buffer->cached_filter_coefficients_.clear();
+      return false;
+    }
+    buffer->cached_filter_coefficients_ = filter_coefficients;
+  }
+
+  // Concatenate the past inputs and the current inputs in time order.
+  std::vector<T>& signal(buffer->extended_signal_);
+  signal.resize(num_filter_order_ + num_segment * segment_length);
+  {
+    const T* x(&buffer->d_[buffer->position_in_d_]);
+    for (int m(0); m < num_filter_order_; ++m) {
+      signal[m] = x[num_filter_order_ - 1 - m];
+    }
+    std::copy(filter_input.begin(), filter_input.end(),
+              signal.begin() + num_filter_order_);
+    std::fill(signal.begin() + num_filter_order_ + block_length, signal.end(),
+              0.0);
+  }
+
+  // The first M samples of each circular convolution are aliased, and the
+  // others are the outputs.
+  std::vector<T>& real(buffer->real_part_);
+  std::vector<T>& imag(buffer->imag_part_);
+  real.resize(fft_length_);
+  imag.resize(fft_length_);
+  const T* hr(&buffer->real_part_of_filter_spectrum_[0]);
+  const T* hi(&buffer->imag_part_of_filter_spectrum_[0]);
+  for (int s(0); s < num_segment; s += 2) {
+    const int first_begin(s * segment_length);
+    const int second_begin(first_begin + segment_length);
+    const bool has_second_segment(s + 1 < num_segment);
+    std::copy(signal.begin() + first_begin,
+              signal.begin() + first_begin + fft_length_, real.begin());
+    if (has_second_segment) {
+      std::copy(signal.begin() + second_begin,
+                signal.begin() + second_begin + fft_length_, imag.begin());
+    } else {
+      std::fill(imag.begin(), imag.end(), 0.0);
+    }
+
+    if (!fourier_transform_.Run(&real, &imag)) {
+      return false;
+    }
+    for (int k(0); k < fft_length_; ++k) {
+      const T xr(real[k]);
+      const T xi(imag[k]);
+      real[k] = xr * hr[k] - xi * hi[k];
+      imag[k] = xr * hi[k] + xi * hr[k];
+    }
+    if (!inverse_fourier_transform_.Run(&real, &imag)) {
+      return false;
+    }
+
+    const int first_end(std::min(first_begin + segment_length, block_length));
+    for (int n(first_begin); n < first_end; ++n) {
+      (*filter_output)[n] = real[num_filter_order_ + n - first_begin];
+    }
+    if (has_second_segment) {
+      const int second_end(
+          std::min(second_begin + segment_length, block_length));
+      for (int n(second_begin); n < second_end; ++n) {
+        (*filter_output)[n] = imag[num_filter_order_ + n - second_begin];
+      }
+    }
+  }
+
+  // Store the last M inputs to the delay line.
+  T* d(&buffer->d_[0]);
+  for (int m(0); m < num_filter_order_; ++m) {
+    d[m] = d[m + num_filter_order_] = signal[block_length + num_filter_order_ -
+                                             1 - m];
+  }
+  buffer->position_in_d_ = 0;
+
+  return true;
 }
 
+template class AllZeroDigitalFilterBase<float>;
+template class AllZeroDigitalFilterBase<double>;
+
 }  // namespace sptk
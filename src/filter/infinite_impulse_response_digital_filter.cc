@@ -75,12 +75,49 @@ bool InfiniteImpulseResponseDigitalFilter::Run(
   }
 
   // prepare memory
+  PrepareBuffer(buffer);
+
+  // apply filter
+  *filter_output = ApplyFilter(filter_input, buffer);
+
+  return true;
+}
+
+bool InfiniteImpulseResponseDigitalFilter::Run(
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ || NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // apply filter
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+void InfiniteImpulseResponseDigitalFilter::PrepareBuffer(
+    InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const {
   if (buffer->signals_.size() !=
       static_cast<std::size_t>(num_filter_order_ + 1)) {
     buffer->signals_.resize(num_filter_order_ + 1);
     std::fill(buffer->signals_.begin(), buffer->signals_.end(), 0.0);
   }
+}
 
+double InfiniteImpulseResponseDigitalFilter::ApplyFilter(
+    double filter_input,
+    InfiniteImpulseResponseDigitalFilter::Buffer* buffer) const {
   double* d(&buffer->signals_[0]);
 
   {
@@ -94,21 +131,20 @@ bool InfiniteImpulseResponseDigitalFilter::Run(
     d[buffer->p_] = -x;
   }
 
+  double y(0.0);
   {
     const double* b(&(numerator_filter_coefficients_[0]));
-    double y(0.0);
     for (int i(0), p(buffer->p_); i <= num_numerator_filter_order_; ++i, --p) {
       if (p < 0) p = num_filter_order_;
       y += d[p] * b[i];
     }
-    *filter_output = y;
   }
 
   if (num_filter_order_ < ++buffer->p_) {
     buffer->p_ = 0;
   }
 
-  return true;
+  return y;
 }
 
 }  // namespace sptk
@@ -63,6 +63,84 @@ bool LineSpectralPairsDigitalFilter::Run(
   }
 
   // prepare memory
+  PrepareBuffer(buffer);
+
+  // apply filter
+  *filter_output =
+      ApplyFilter(&(filter_coefficients[0]), filter_input, buffer);
+
+  return true;
+}
+
+bool LineSpectralPairsDigitalFilter::Run(
+    const std::vector<double>& filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    LineSpectralPairsDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // apply LSP filter
+  const double* coefficients(&(filter_coefficients[0]));
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+bool LineSpectralPairsDigitalFilter::Run(
+    const std::vector<double>& first_filter_coefficients,
+    const std::vector<double>& next_filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    LineSpectralPairsDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  const int filter_length(num_filter_order_ + 1);
+  if (!is_valid_ ||
+      first_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      next_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = first_filter_coefficients;
+
+  // apply LSP filter while updating filter coefficients
+  const double rate(1.0 / block_length);
+  const double* c0(&(first_filter_coefficients[0]));
+  const double* c1(&(next_filter_coefficients[0]));
+  double* coefficients(&buffer->interpolated_filter_coefficients_[0]);
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+    for (int m(0); m < filter_length; ++m) {
+      coefficients[m] += rate * (c1[m] - c0[m]);
+    }
+  }
+
+  return true;
+}
+
+void LineSpectralPairsDigitalFilter::PrepareBuffer(
+    LineSpectralPairsDigitalFilter::Buffer* buffer) const {
   if (buffer->signals1_.size() !=
       static_cast<std::size_t>(num_filter_order_ + 1)) {
     buffer->signals1_.resize(num_filter_order_ + 1);
@@ -73,16 +151,19 @@ bool LineSpectralPairsDigitalFilter::Run(
     buffer->signals2_.resize(num_filter_order_ + 1);
     std::fill(buffer->signals2_.begin(), buffer->signals2_.end(), 0.0);
   }
+}
 
+double LineSpectralPairsDigitalFilter::ApplyFilter(
+    const double* filter_coefficients, double filter_input,
+    LineSpectralPairsDigitalFilter::Buffer* buffer) const {
   // set value
   const double gained_input(filter_input * filter_coefficients[0]);
   if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
+    return gained_input;
   }
 
   // get values
-  const double* coefficients(&(filter_coefficients[0]));
+  const double* coefficients(filter_coefficients);
   double* signals1(&buffer->signals1_[0]);
   double* signals2(&buffer->signals2_[0]);
 
@@ -107,9 +188,6 @@ bool LineSpectralPairsDigitalFilter::Run(
     sum += signals1[num_filter_order_] - signals2[num_filter_order_];
   }
 
-  // save result
-  *filter_output = sum;
-
   // shift stored signals
   for (int i(num_filter_order_); 0 < i; --i) {
     signals1[i] = signals1[i - 1];
@@ -119,7 +197,7 @@ bool LineSpectralPairsDigitalFilter::Run(
   signals1[0] = delayed_output;
   signals2[0] = delayed_output;
 
-  return true;
+  return sum;
 }
 
 }  // namespace sptk
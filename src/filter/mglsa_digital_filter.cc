@@ -87,19 +87,113 @@ bool MglsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   }
 
   // prepare memories
+  PrepareBuffer(buffer);
+
+  // apply filter
+  *filter_output =
+      ApplyFilter(&(filter_coefficients[0]), filter_input, buffer);
+
+  return true;
+}
+
+bool MglsaDigitalFilter::Run(
+    const std::vector<double>& filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    MglsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  if (0 == num_stage_) {
+    return mlsa_digital_filter_.Run(filter_coefficients, filter_input,
+                                    filter_output,
+                                    &(buffer->mlsa_digital_filter_buffer_));
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // apply MGLSA filter
+  const double* coefficients(&(filter_coefficients[0]));
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+bool MglsaDigitalFilter::Run(
+    const std::vector<double>& first_filter_coefficients,
+    const std::vector<double>& next_filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    MglsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  const int filter_length(num_filter_order_ + 1);
+  if (!is_valid_ ||
+      first_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      next_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  if (0 == num_stage_) {
+    return mlsa_digital_filter_.Run(first_filter_coefficients,
+                                    next_filter_coefficients, filter_input,
+                                    filter_output,
+                                    &(buffer->mlsa_digital_filter_buffer_));
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = first_filter_coefficients;
+
+  // apply MGLSA filter while updating filter coefficients
+  const double rate(1.0 / block_length);
+  const double* c0(&(first_filter_coefficients[0]));
+  const double* c1(&(next_filter_coefficients[0]));
+  double* coefficients(&buffer->interpolated_filter_coefficients_[0]);
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+    for (int m(0); m < filter_length; ++m) {
+      coefficients[m] += rate * (c1[m] - c0[m]);
+    }
+  }
+
+  return true;
+}
+
+void MglsaDigitalFilter::PrepareBuffer(
+    MglsaDigitalFilter::Buffer* buffer) const {
   if (buffer->signals_.size() !=
       static_cast<std::size_t>((num_filter_order_ + 1) * num_stage_)) {
     buffer->signals_.resize((num_filter_order_ + 1) * num_stage_);
     std::fill(buffer->signals_.begin(), buffer->signals_.end(), 0.0);
   }
+}
 
+double MglsaDigitalFilter::ApplyFilter(
+    const double* filter_coefficients, double filter_input,
+    MglsaDigitalFilter::Buffer* buffer) const {
   const double gained_input(filter_input * std::exp(filter_coefficients[0]));
   if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
+    return gained_input;
   }
 
-  const double* b(&(filter_coefficients[1]));
+  const double* b(filter_coefficients + 1);
   const double beta(1.0 - alpha_ * alpha_);
   double x(gained_input);
 
@@ -131,9 +225,7 @@ bool MglsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     }
   }
 
-  *filter_output = x;
-
-  return true;
+  return x;
 }
 
 }  // namespace sptk
@@ -118,6 +118,84 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   }
 
   // prepare memories
+  PrepareBuffer(buffer);
+
+  // apply filter
+  *filter_output =
+      ApplyFilter(&(filter_coefficients[0]), filter_input, buffer);
+
+  return true;
+}
+
+bool MlsaDigitalFilter::Run(
+    const std::vector<double>& filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    MlsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+
+  // apply MLSA filter
+  const double* coefficients(&(filter_coefficients[0]));
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+  }
+
+  return true;
+}
+
+bool MlsaDigitalFilter::Run(
+    const std::vector<double>& first_filter_coefficients,
+    const std::vector<double>& next_filter_coefficients,
+    const std::vector<double>& filter_input, std::vector<double>* filter_output,
+    MlsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  const int filter_length(num_filter_order_ + 1);
+  if (!is_valid_ ||
+      first_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      next_filter_coefficients.size() !=
+          static_cast<std::size_t>(filter_length) ||
+      NULL == filter_output || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  const int block_length(static_cast<int>(filter_input.size()));
+  if (filter_output->size() != static_cast<std::size_t>(block_length)) {
+    filter_output->resize(block_length);
+  }
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = first_filter_coefficients;
+
+  // apply MLSA filter while updating filter coefficients
+  const double rate(1.0 / block_length);
+  const double* c0(&(first_filter_coefficients[0]));
+  const double* c1(&(next_filter_coefficients[0]));
+  double* coefficients(&buffer->interpolated_filter_coefficients_[0]);
+  for (int n(0); n < block_length; ++n) {
+    (*filter_output)[n] = ApplyFilter(coefficients, filter_input[n], buffer);
+    for (int m(0); m < filter_length; ++m) {
+      coefficients[m] += rate * (c1[m] - c0[m]);
+    }
+  }
+
+  return true;
+}
+
+void MlsaDigitalFilter::PrepareBuffer(
+    MlsaDigitalFilter::Buffer* buffer) const {
   if (buffer->signals_for_basic_filter1_.size() !=
       static_cast<std::size_t>(num_pade_order_ + 1)) {
     buffer->signals_for_basic_filter1_.resize(num_pade_order_ + 1);
@@ -143,15 +221,18 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     std::fill(buffer->signals_for_exp_filter2_.begin(),
               buffer->signals_for_exp_filter2_.end(), 0.0);
   }
+}
 
+double MlsaDigitalFilter::ApplyFilter(
+    const double* filter_coefficients, double filter_input,
+    MlsaDigitalFilter::Buffer* buffer) const {
   // set value
   const double gained_input(filter_input * std::exp(filter_coefficients[0]));
   if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
+    return gained_input;
   }
 
-  const double* b(&(filter_coefficients[0]));
+  const double* b(filter_coefficients);
   const double beta(1.0 - alpha_ * alpha_);
 
   // First stage
@@ -214,9 +295,7 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     second_output += x;
   }
 
-  *filter_output = second_output;
-
-  return true;
+  return second_output;
 }
 
 }  // namespace sptk
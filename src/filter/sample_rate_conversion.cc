@@ -0,0 +1,291 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+
+#include "SPTK/filter/sample_rate_conversion.h"
+
+#include <algorithm>  // std::max, std::min
+#include <cmath>      // std::ceil, std::pow, std::sin, std::sqrt
+#include <cstddef>    // std::size_t
+#include <limits>     // std::numeric_limits
+
+#include "SPTK/utils/simd.h"
+
+namespace {
+
+// Computes the modified Bessel function of the first kind of order zero.
+double ComputeModifiedBesselFunction(double x) {
+  const double half_x(0.5 * x);
+  double sum(1.0);
+  double term(1.0);
+  for (int k(1); k < 1000; ++k) {
+    term *= half_x / k;
+    const double squared_term(term * term);
+    sum += squared_term;
+    if (squared_term < sum * 1e-17) break;
+  }
+  return sum;
+}
+
+// Computes the inner product of a and b whose lengths are n.
+double ComputeInnerProduct(const double* a, const double* b, int n) {
+  using sptk::simd::Add;
+  using sptk::simd::Broadcast;
+  using sptk::simd::kVectorLength;
+  using sptk::simd::Load;
+  using sptk::simd::Multiply;
+  using sptk::simd::Store;
+  using sptk::simd::Vector;
+
+  // Two accumulators hide the latency of the additions.
+  Vector sum0(Broadcast(0.0));
+  Vector sum1(Broadcast(0.0));
+  int i(0);
+  for (; i + 2 * kVectorLength <= n; i += 2 * kVectorLength) {
+    sum0 = Add(sum0, Multiply(Load(a + i), Load(b + i)));
+    sum1 = Add(sum1, Multiply(Load(a + i + kVectorLength),
+                              Load(b + i + kVectorLength)));
+  }
+  double sums[kVectorLength];
+  Store(Add(sum0, sum1), sums);
+  double sum(0.0);
+  for (int j(0); j < kVectorLength; ++j) {
+    sum += sums[j];
+  }
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+}  // namespace
+
+namespace sptk {
+
+SampleRateConversion::SampleRateConversion(int upsampling_factor,
+                                           int downsampling_factor,
+                                           double stopband_attenuation,
+                                           double transition_width)
+    : upsampling_factor_(upsampling_factor),
+      downsampling_factor_(downsampling_factor),
+      stopband_attenuation_(stopband_attenuation),
+      transition_width_(transition_width),
+      half_length_(0),
+      num_tap_per_phase_(0),
+      is_valid_(true) {
+  if (upsampling_factor_ <= 0 || downsampling_factor_ <= 0 ||
+      stopband_attenuation_ <= 0.0 || transition_width_ <= 0.0 ||
+      1.0 < transition_width_) {
+    is_valid_ = false;
+    return;
+  }
+
+  // Reduce the factors to lowest terms.
+  {
+    int a(upsampling_factor_);
+    int b(downsampling_factor_);
+    while (0 != b) {
+      const int r(a % b);
+      a = b;
+      b = r;
+    }
+    upsampling_factor_ /= a;
+    downsampling_factor_ /= a;
+  }
+  const int l(upsampling_factor_);
+
+  // Design the lowpass filter in the upsampled domain by the Kaiser window
+  // method. The frequencies are normalized by the sampling frequency.
+  const double stopband_edge(
+      0.5 / std::max(upsampling_factor_, downsampling_factor_));
+  const double transition_band(stopband_edge * transition_width_);
+  const double cutoff_frequency(stopband_edge - 0.5 * transition_band);
+
+  double beta;
+  double num_order;
+  if (50.0 < stopband_attenuation_) {
+    beta = 0.1102 * (stopband_attenuation_ - 8.7);
+  } else if (21.0 < stopband_attenuation_) {
+    beta = (0.5842 * std::pow(stopband_attenuation_ - 21.0, 0.4) +
+            0.07886 * (stopband_attenuation_ - 21.0));
+  } else {
+    beta = 0.0;
+  }
+  if (21.0 < stopband_attenuation_) {
+    num_order = (stopband_attenuation_ - 7.95) / (14.36 * transition_band);
+  } else {
+    num_order = 0.9222 / transition_band;
+  }
+  if (std::numeric_limits<int>::max() / 4 < num_order) {
+    is_valid_ = false;
+    return;
+  }
+
+  // The filter has 2 * H * L + 1 taps, and its delay is H input samples.
+  half_length_ = std::max(
+      1, static_cast<int>(std::ceil(0.5 * num_order / upsampling_factor_)));
+  num_tap_per_phase_ = 2 * half_length_ + 1;
+  const int delay(half_length_ * l);
+  const double inverse_of_window_gain(1.0 /
+                                      ComputeModifiedBesselFunction(beta));
+
+  polyphase_filters_.resize(static_cast<std::size_t>(l) * num_tap_per_phase_);
+  for (int p(0); p < l; ++p) {
+    double* filter(&polyphase_filters_[p * num_tap_per_phase_]);
+    for (int r(0); r < num_tap_per_phase_; ++r) {
+      const int k(p + l * (num_tap_per_phase_ - 1 - r));
+      if (2 * delay < k) {
+        filter[r] = 0.0;
+        continue;
+      }
+      const double t(k - delay);
+      const double ratio(t / delay);
+      const double window(
+          ComputeModifiedBesselFunction(beta * std::sqrt(1.0 - ratio * ratio)) *
+          inverse_of_window_gain);
+      const double sinc(
+          (0 == k - delay)
+              ? 2.0 * cutoff_frequency
+              : std::sin(sptk::kTwoPi * cutoff_frequency * t) / (sptk::kPi * t));
+      // The gain L compensates the energy lost by the inserted zeros.
+      filter[r] = l * sinc * window;
+    }
+  }
+}
+
+bool SampleRateConversion::Run(const std::vector<double>& input,
+                               std::vector<double>* output,
+                               SampleRateConversion::Buffer* buffer) const {
+  // Check inputs.
+  if (!is_valid_ || NULL == output || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  PrepareBuffer(buffer);
+
+  buffer->signal_.insert(buffer->signal_.end(), input.begin(), input.end());
+  buffer->num_input_ += input.size();
+
+  // Convert.
+  output->clear();
+  Convert(std::numeric_limits<int64_t>::max(), output, buffer);
+
+  return true;
+}
+
+bool SampleRateConversion::Flush(std::vector<double>* output,
+                                 SampleRateConversion::Buffer* buffer) const {
+  // Check inputs.
+  if (!is_valid_ || NULL == output || NULL == buffer) {
+    return false;
+  }
+
+  // Prepare memories.
+  PrepareBuffer(buffer);
+
+  // The last output sample depends on at most H future input samples.
+  buffer->signal_.insert(buffer->signal_.end(), half_length_, 0.0);
+  const int64_t num_output(
+      (buffer->num_input_ * upsampling_factor_ + downsampling_factor_ - 1) /
+      downsampling_factor_);
+
+  // Convert.
+  output->clear();
+  Convert(num_output, output, buffer);
+
+  buffer->is_initialized_ = false;
+
+  return true;
+}
+
+void SampleRateConversion::PrepareBuffer(
+    SampleRateConversion::Buffer* buffer) const {
+  if (buffer->is_initialized_) return;
+  // Zeros precede the input signal.
+  buffer->signal_.assign(half_length_, 0.0);
+  buffer->first_input_index_ = -half_length_;
+  buffer->num_input_ = 0;
+  buffer->num_output_ = 0;
+  buffer->is_initialized_ = true;
+}
+
+void SampleRateConversion::Convert(int64_t num_output,
+                                   std::vector<double>* output,
+                                   SampleRateConversion::Buffer* buffer) const {
+  const int64_t delay(static_cast<int64_t>(half_length_) * upsampling_factor_);
+  const int64_t end_of_signal(buffer->first_input_index_ +
+                              static_cast<int64_t>(buffer->signal_.size()));
+
+  // The n-th output sample is the inner product of the p-th polyphase
+  // component and the input samples up to the i-th, where
+  // n * M + delay = i * L + p.
+  int64_t n(buffer->num_output_);
+  for (; n < num_output; ++n) {
+    const int64_t t(n * downsampling_factor_ + delay);
+    const int64_t i(t / upsampling_factor_);
+    if (end_of_signal <= i) break;
+    const int p(static_cast<int>(t % upsampling_factor_));
+    const int64_t start(i - (num_tap_per_phase_ - 1) -
+                        buffer->first_input_index_);
+    output->push_back(ComputeInnerProduct(
+        &polyphase_filters_[p * num_tap_per_phase_],
+        &buffer->signal_[start], num_tap_per_phase_));
+  }
+  buffer->num_output_ = n;
+
+  // Discard the input samples which are no longer used.
+  const int64_t next_start(
+      (n * downsampling_factor_ + delay) / upsampling_factor_ -
+      (num_tap_per_phase_ - 1) - buffer->first_input_index_);
+  if (0 < next_start) {
+    const int64_t num_discarded(
+        std::min(next_start, static_cast<int64_t>(buffer->signal_.size())));
+    buffer->signal_.erase(buffer->signal_.begin(),
+                          buffer->signal_.begin() + num_discarded);
+    buffer->first_input_index_ += num_discarded;
+  }
+}
+
+}  // namespace sptk
@@ -44,8 +44,8 @@
 
 #include "SPTK/generator/excitation_generation.h"
 
-#include <cmath>   // std::sqrt
-#include <vector>  // std::vector
+#include <cmath>    // std::sqrt
+#include <cstddef>  // std::size_t
 
 namespace sptk {
 
@@ -57,7 +57,7 @@ ExcitationGeneration::ExcitationGeneration(
       is_valid_(true),
       phase_(1.0) {
   if (NULL == input_source_ || NULL == random_generation_ ||
-      !input_source_->IsValid()) {
+      !input_source_->IsValid() || 1 != input_source_->GetSize()) {
     is_valid_ = false;
   }
 }
@@ -70,12 +70,10 @@ bool ExcitationGeneration::Get(double* excitation, double* pulse, double* noise,
 
   // Get pitch.
   double pitch_in_current_point;
-  {
-    std::vector<double> tmp;
-    if (!input_source_->Get(&tmp) || tmp[0] < 0.0) {
-      return false;
-    }
-    pitch_in_current_point = tmp[0];
+  int num_pitch;
+  if (!input_source_->GetBlock(1, &pitch_in_current_point, &num_pitch) ||
+      pitch_in_current_point < 0.0) {
+    return false;
   }
 
   // Get noise.
@@ -91,6 +89,53 @@ bool ExcitationGeneration::Get(double* excitation, double* pulse, double* noise,
     *noise = noise_in_current_point;
   }
 
+  Generate(pitch_in_current_point, noise_in_current_point, excitation, pulse);
+
+  return true;
+}
+
+bool ExcitationGeneration::GetBlock(int max_num_sample, double* excitation,
+                                    double* pulse, double* noise, double* pitch,
+                                    int* num_sample) {
+  if (!is_valid_ || max_num_sample <= 0 || NULL == num_sample) {
+    return false;
+  }
+
+  // Get pitch. The internal buffer is used if pitch is not required.
+  double* pitch_block(pitch);
+  if (NULL == pitch_block) {
+    if (pitch_buffer_.size() < static_cast<std::size_t>(max_num_sample)) {
+      pitch_buffer_.resize(max_num_sample);
+    }
+    pitch_block = &(pitch_buffer_[0]);
+  }
+  int num_pitch;
+  if (!input_source_->GetBlock(max_num_sample, pitch_block, &num_pitch)) {
+    *num_sample = 0;
+    return false;
+  }
+
+  for (int t(0); t < num_pitch; ++t) {
+    double noise_in_current_point;
+    if (pitch_block[t] < 0.0 ||
+        !random_generation_->Get(&noise_in_current_point)) {
+      *num_sample = t;
+      return false;
+    }
+    if (noise) {
+      noise[t] = noise_in_current_point;
+    }
+    Generate(pitch_block[t], noise_in_current_point,
+             excitation ? excitation + t : NULL, pulse ? pulse + t : NULL);
+  }
+
+  *num_sample = num_pitch;
+  return true;
+}
+
+void ExcitationGeneration::Generate(double pitch_in_current_point,
+                                    double noise_in_current_point,
+                                    double* excitation, double* pulse) {
   // If unvoiced point, return white noise.
   if (input_source_->GetMagicNumber() == pitch_in_current_point) {
     phase_ = 1.0;
@@ -100,7 +145,7 @@ bool ExcitationGeneration::Get(double* excitation, double* pulse, double* noise,
     if (pulse) {
       *pulse = 0.0;
     }
-    return true;
+    return;
   }
 
   // If voiced point, return pulse or zero.
@@ -121,8 +166,6 @@ bool ExcitationGeneration::Get(double* excitation, double* pulse, double* noise,
 
   // Proceed phase.
   phase_ += 1.0 / pitch_in_current_point;
-
-  return true;
 }
 
 }  // namespace sptk
@@ -44,7 +44,8 @@
 
 #include "SPTK/input/input_source_from_array.h"
 
-#include <cstddef>  // std::size_t
+#include <algorithm>  // std::copy, std::fill, std::min
+#include <cstddef>    // std::size_t
 
 namespace sptk {
 
@@ -81,4 +82,31 @@ bool InputSourceFromArray::Get(std::vector<double>* buffer) {
   return true;
 }
 
+bool InputSourceFromArray::GetBlock(int max_num_frame, double* buffer,
+                                    int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_ || array_size_ <= position_) {
+    return false;
+  }
+
+  // Copy complete frames at once.
+  int n(std::min(max_num_frame, (array_size_ - position_) / read_size_));
+  std::copy(input_array_ + position_,
+            input_array_ + position_ + n * read_size_, buffer);
+  position_ += n * read_size_;
+
+  // Copy the last incomplete frame.
+  if (n < max_num_frame && position_ < array_size_ && zero_padding_) {
+    double* frame(buffer + n * read_size_);
+    const int num_nonzeros(array_size_ - position_);
+    std::copy(input_array_ + position_, input_array_ + array_size_, frame);
+    std::fill(frame + num_nonzeros, frame + read_size_, 0.0);
+    position_ += read_size_;
+    ++n;
+  }
+
+  *num_frame = n;
+  return 0 < n;
+}
+
 }  // namespace sptk
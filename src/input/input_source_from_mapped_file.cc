@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/input/input_source_from_mapped_file.h"
+
+#include <algorithm>  // std::copy, std::fill, std::min
+
+namespace sptk {
+
+bool InputSourceFromMappedFile::Get(std::vector<double>* buffer) {
+  if (NULL == buffer || !is_valid_) {
+    return false;
+  }
+
+  const std::size_t num_element(matrix_.GetNumElement());
+  if (num_element <= position_) {
+    return false;
+  }
+
+  const std::size_t num_remaining_element(num_element - position_);
+  const std::size_t read_size(static_cast<std::size_t>(read_size_));
+  if (num_remaining_element < read_size && !zero_padding_) {
+    return false;
+  }
+
+  if (buffer->size() != read_size) {
+    buffer->resize(read_size);
+  }
+
+  const double* data(matrix_.GetData() + position_);
+  if (read_size <= num_remaining_element) {
+    std::copy(data, data + read_size, buffer->begin());
+    position_ += read_size;
+  } else {
+    std::copy(data, data + num_remaining_element, buffer->begin());
+    std::fill(buffer->begin() + num_remaining_element, buffer->end(), 0.0);
+    position_ = num_element;
+  }
+
+  return true;
+}
+
+bool InputSourceFromMappedFile::GetBlock(int max_num_frame, double* buffer,
+                                         int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_) {
+    return false;
+  }
+
+  const std::size_t num_element(matrix_.GetNumElement());
+  if (num_element <= position_) {
+    return false;
+  }
+
+  // Copy complete frames at once.
+  const std::size_t read_size(static_cast<std::size_t>(read_size_));
+  const double* data(matrix_.GetData());
+  const std::size_t num_complete_frame((num_element - position_) / read_size);
+  int n(static_cast<int>(
+      std::min(static_cast<std::size_t>(max_num_frame), num_complete_frame)));
+  std::copy(data + position_, data + position_ + n * read_size, buffer);
+  position_ += n * read_size;
+
+  // Copy the last incomplete frame.
+  if (n < max_num_frame && position_ < num_element && zero_padding_) {
+    double* frame(buffer + n * read_size);
+    const std::size_t num_nonzeros(num_element - position_);
+    std::copy(data + position_, data + num_element, frame);
+    std::fill(frame + num_nonzeros, frame + read_size, 0.0);
+    position_ = num_element;
+    ++n;
+  }
+
+  *num_frame = n;
+  return 0 < n;
+}
+
+}  // namespace sptk
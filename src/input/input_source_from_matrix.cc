@@ -66,4 +66,23 @@ bool InputSourceFromMatrix::Get(std::vector<double>* buffer) {
   return true;
 }
 
+bool InputSourceFromMatrix::GetBlock(int max_num_frame, double* buffer,
+                                     int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_ || col_size_ <= col_position_) {
+    return false;
+  }
+
+  int n(0);
+  for (; n < max_num_frame && col_position_ < col_size_; ++n) {
+    std::copy(&(input_matrix_[col_position_][0]),
+              &(input_matrix_[col_position_][row_size_]),
+              buffer + n * row_size_);
+    ++col_position_;
+  }
+
+  *num_frame = n;
+  return true;
+}
+
 }  // namespace sptk
@@ -44,6 +44,8 @@
 
 #include "SPTK/input/input_source_from_stream.h"
 
+#include <algorithm>  // std::fill
+
 namespace sptk {
 
 bool InputSourceFromStream::Get(std::vector<double>* buffer) {
@@ -54,4 +56,38 @@ bool InputSourceFromStream::Get(std::vector<double>* buffer) {
                           input_stream_, NULL);
 }
 
+bool InputSourceFromStream::GetBlock(int max_num_frame, double* buffer,
+                                     int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_ || !input_stream_->good()) {
+    return false;
+  }
+
+  // Read bytes directly from the stream buffer as sptk::ReadStream does.
+  const std::streamsize frame_bytes(sizeof(*buffer) * read_size_);
+  const std::streamsize num_bytes(frame_bytes * max_num_frame);
+  std::streambuf* stream_buffer(input_stream_->rdbuf());
+  const std::streamsize gcount(
+      NULL == stream_buffer
+          ? 0
+          : stream_buffer->sgetn(reinterpret_cast<char*>(buffer), num_bytes));
+  if (gcount != num_bytes) {
+    input_stream_->setstate(std::ios::eofbit | std::ios::failbit);
+  }
+
+  int n(static_cast<int>(gcount / frame_bytes));
+  const std::streamsize remaining_bytes(gcount % frame_bytes);
+  if (0 < remaining_bytes && zero_padding_) {
+    // An incompletely read value is also zeroed.
+    double* frame(buffer + n * read_size_);
+    const int num_nonzeros(
+        static_cast<int>(remaining_bytes / sizeof(*buffer)));
+    std::fill(frame + num_nonzeros, frame + read_size_, 0.0);
+    ++n;
+  }
+
+  *num_frame = n;
+  return 0 < n;
+}
+
 }  // namespace sptk
@@ -44,7 +44,7 @@
 
 #include "SPTK/input/input_source_from_vector.h"
 
-#include <algorithm>  // std::copy, std::fill_n
+#include <algorithm>  // std::copy, std::fill, std::fill_n, std::min
 #include <cstddef>    // std::size_t
 
 namespace sptk {
@@ -80,4 +80,31 @@ bool InputSourceFromVector::Get(std::vector<double>* buffer) {
   return true;
 }
 
+bool InputSourceFromVector::GetBlock(int max_num_frame, double* buffer,
+                                     int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_ || vector_size_ <= position_) {
+    return false;
+  }
+
+  // Copy complete frames at once.
+  const double* data(&((*input_vector_)[0]));
+  int n(std::min(max_num_frame, (vector_size_ - position_) / read_size_));
+  std::copy(data + position_, data + position_ + n * read_size_, buffer);
+  position_ += n * read_size_;
+
+  // Copy the last incomplete frame.
+  if (n < max_num_frame && position_ < vector_size_ && zero_padding_) {
+    double* frame(buffer + n * read_size_);
+    const int num_nonzeros(vector_size_ - position_);
+    std::copy(data + position_, data + vector_size_, frame);
+    std::fill(frame + num_nonzeros, frame + read_size_, 0.0);
+    position_ += read_size_;
+    ++n;
+  }
+
+  *num_frame = n;
+  return 0 < n;
+}
+
 }  // namespace sptk
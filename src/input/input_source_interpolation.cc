@@ -109,7 +109,29 @@ bool InputSourceInterpolation::Get(std::vector<double>* buffer) {
     buffer->resize(data_length_);
   }
 
-  std::copy(curr_data_.begin(), curr_data_.end(), buffer->begin());
+  Proceed(&((*buffer)[0]));
+
+  return true;
+}
+
+bool InputSourceInterpolation::GetBlock(int max_num_frame, double* buffer,
+                                        int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_) {
+    return false;
+  }
+
+  int n(0);
+  for (; n < max_num_frame && 0 < remained_num_samples_; ++n) {
+    Proceed(buffer + n * data_length_);
+  }
+
+  *num_frame = n;
+  return 0 < n;
+}
+
+void InputSourceInterpolation::Proceed(double* buffer) {
+  std::copy(curr_data_.begin(), curr_data_.end(), buffer);
 
   --remained_num_samples_;
 
@@ -117,7 +139,7 @@ bool InputSourceInterpolation::Get(std::vector<double>* buffer) {
     if (use_final_frame_for_exceeded_frame_) {
       remained_num_samples_ = 1;
     }
-    return true;
+    return;
   }
 
   // Update internal states for the next call.
@@ -150,8 +172,6 @@ bool InputSourceInterpolation::Get(std::vector<double>* buffer) {
              frame_period_ / 2 == point_index_in_frame_) {
     std::copy(next_data_.begin(), next_data_.end(), curr_data_.begin());
   }
-
-  return true;
 }
 
 }  // namespace sptk
@@ -59,23 +59,50 @@ bool InputSourcePreprocessingForFilterGain::Get(std::vector<double>* buffer) {
     return false;
   }
 
+  return Preprocess(&((*buffer)[0]), buffer->size());
+}
+
+bool InputSourcePreprocessingForFilterGain::GetBlock(int max_num_frame,
+                                                     double* buffer,
+                                                     int* num_frame) {
+  if (max_num_frame <= 0 || NULL == buffer || NULL == num_frame ||
+      !is_valid_) {
+    return false;
+  }
+
+  if (!source_->GetBlock(max_num_frame, buffer, num_frame)) {
+    return false;
+  }
+
+  const int size(source_->GetSize());
+  for (int n(0); n < *num_frame; ++n) {
+    if (!Preprocess(buffer + n * size, size)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool InputSourcePreprocessingForFilterGain::Preprocess(double* frame,
+                                                       int size) const {
   switch (gain_type_) {
     case kLinear: {
       // nothing to do
       break;
     }
     case kLog: {
-      (*buffer)[0] = std::exp((*buffer)[0]);
+      frame[0] = std::exp(frame[0]);
       break;
     }
     case kUnity: {
-      (*buffer)[0] = 1.0;
+      frame[0] = 1.0;
       break;
     }
     case kUnityForAllZeroFilter: {
-      if (0.0 == (*buffer)[0]) return false;
-      const double inverse_of_b0(1.0 / (*buffer)[0]);
-      std::transform(buffer->begin(), buffer->end(), buffer->begin(),
+      if (0.0 == frame[0]) return false;
+      const double inverse_of_b0(1.0 / frame[0]);
+      std::transform(frame, frame + size, frame,
                      std::bind1st(std::multiplies<double>(), inverse_of_b0));
       break;
     }
@@ -52,6 +52,7 @@
 #include <vector>     // std::vector
 
 #include "SPTK/converter/waveform_to_autocorrelation.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -137,6 +138,8 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int frame_length(kDefaultFrameLength);
   int num_order(kDefaultNumOrder);
   OutputFormats output_format(kDefaultOutputFormat);
@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/autocorrelation_to_composite_sinusoidal_modeling.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -86,6 +87,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
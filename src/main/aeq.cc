@@ -50,6 +50,7 @@
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>   // std::ostringstream
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -125,6 +126,8 @@ void PrintUsage(std::ostream* stream) {
  * @retval 1 Failed to run this command.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   double tolerance(kDefaultTolerance);
   bool enable_check_length(kDefaultEnableCheckLengthFlag);
 
@@ -51,6 +51,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/analyzer/adaptive_mel_generalized_cepstral_analysis.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -151,6 +152,8 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double alpha(kDefaultAlpha);
   int num_stage(kDefaultNumStage);
@@ -55,6 +55,7 @@
 #include <string>     // std::stold, std::string
 #include <vector>     // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
 #include "SPTK/utils/uint24_t.h"
@@ -296,6 +297,8 @@ class BlockCopyWrapper {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int input_start_number(kDefaultInputStartNumber);
   int input_end_number(kDefaultInputBlockLength - 1);
   int input_block_length(kDefaultInputBlockLength);
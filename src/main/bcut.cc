@@ -52,6 +52,7 @@
 #include <string>    // std::string
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
 #include "SPTK/utils/uint24_t.h"
@@ -215,6 +216,8 @@ class BinaryCutWrapper {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_number(kDefaultStartNumber);
   int end_number(kDefaultEndNumber);
   int block_length(kDefaultBlockLength);
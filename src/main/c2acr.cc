@@ -51,6 +51,9 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/cepstrum_to_autocorrelation.h"
+#include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -58,6 +61,7 @@ namespace {
 const int kDefaultNumInputOrder(25);
 const int kDefaultNumOutputOrder(25);
 const int kDefaultFftLength(256);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -70,6 +74,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -m m  : order of cepstrum        (   int)[" << std::setw(5) << std::right << kDefaultNumInputOrder  << "][ 0 <= m <  l ]" << std::endl;  // NOLINT
   *stream << "       -M M  : order of autocorrelation (   int)[" << std::setw(5) << std::right << kDefaultNumOutputOrder << "][ 0 <= M <  l ]" << std::endl;  // NOLINT
   *stream << "       -l l  : FFT length               (   int)[" << std::setw(5) << std::right << kDefaultFftLength      << "][ 2 <= l <=   ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads        (   int)[" << std::setw(5) << std::right << kDefaultNumThread      << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       cepstrum                         (double)[stdin]" << std::endl;  // NOLINT
@@ -81,6 +86,31 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  explicit FrameProcessor(
+      const sptk::CepstrumToAutocorrelation& cepstrum_to_autocorrelation)
+      : cepstrum_to_autocorrelation_(cepstrum_to_autocorrelation) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    if (!cepstrum_to_autocorrelation_.Run(input, output, &buffer_)) {
+      *message << "Failed to transform cepstrum to autocorrelation";
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  const sptk::CepstrumToAutocorrelation& cepstrum_to_autocorrelation_;
+
+  sptk::CepstrumToAutocorrelation::Buffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 /**
@@ -109,12 +139,15 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_input_order(kDefaultNumInputOrder);
   int num_output_order(kDefaultNumOutputOrder);
   int fft_length(kDefaultFftLength);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const char option_char(getopt_long(argc, argv, "m:M:l:h", NULL, NULL));
+    const char option_char(getopt_long(argc, argv, "m:M:l:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -149,6 +182,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("c2acr", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -190,7 +234,6 @@ int main(int argc, char* argv[]) {
 
   sptk::CepstrumToAutocorrelation cepstrum_to_autocorrelation(
       num_input_order, num_output_order, fft_length);
-  sptk::CepstrumToAutocorrelation::Buffer buffer;
   if (!cepstrum_to_autocorrelation.IsValid()) {
     std::ostringstream error_message;
     error_message << "FFT length must be a power of 2 and greater than 1";
@@ -199,27 +242,23 @@ int main(int argc, char* argv[]) {
   }
 
   const int input_length(num_input_order + 1);
-  const int output_length(num_output_order + 1);
-  std::vector<double> cepstrum(input_length);
-  std::vector<double> autocorrelation(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &cepstrum, &input_stream,
-                          NULL)) {
-    if (!cepstrum_to_autocorrelation.Run(cepstrum, &autocorrelation, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to transform cepstrum to autocorrelation";
-      sptk::PrintErrorMessage("c2acr", error_message);
-      return 1;
-    }
-
-    if (!sptk::WriteStream(0, output_length, autocorrelation, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write autocorrelation coefficients";
-      sptk::PrintErrorMessage("c2acr", error_message);
-      return 1;
-    }
+  sptk::InputSourceFromStream input_source(false, input_length, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "c2acr", "Failed to write autocorrelation coefficients");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(
+        new FrameProcessor(cepstrum_to_autocorrelation));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
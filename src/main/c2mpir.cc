@@ -51,6 +51,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/cepstrum_to_minimum_phase_impulse_response.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -99,6 +100,8 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_input_order(kDefaultNumInputOrder);
   int num_output_order(kDefaultNumOutputOrder);
 
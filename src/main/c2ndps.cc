@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/cepstrum_to_negative_derivative_of_phase_spectrum.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -96,6 +97,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   int fft_length(kDefaultFftLength);
   OutputFormats output_format(kDefaultOutputFormat);
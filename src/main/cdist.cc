@@ -52,6 +52,7 @@
 
 #include "SPTK/math/distance_calculator.h"
 #include "SPTK/math/statistics_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -99,6 +100,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   OutputFormats output_format(kDefaultOutputFormat);
   bool output_frame_by_frame(kDefaultOutputFrameByFrameFlag);
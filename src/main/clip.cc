@@ -50,6 +50,7 @@
 #include <sstream>   // std::ostringstream
 
 #include "SPTK/math/scalar_operation.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -81,6 +82,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   double lower_bound(kDefaultLowerBound);
   double upper_bound(kDefaultUpperBound);
 
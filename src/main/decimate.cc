@@ -49,6 +49,8 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/filter/sample_rate_conversion.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -56,6 +58,13 @@ namespace {
 const int kDefaultStartIndex(0);
 const int kDefaultVectorLength(1);
 const int kDefaultDecimationPeriod(10);
+const bool kDefaultFilteringFlag(false);
+
+// Parameters of the anti-aliasing filter.
+const double kStopbandAttenuation(80.0);
+const double kTransitionWidth(0.1);
+
+const int kNumVectorInBlock(1024);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -69,11 +78,15 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -l l  : length of vector   (   int)[" << std::setw(5) << std::right << kDefaultVectorLength     << "][ 0 <  l <=   ]" << std::endl;  // NOLINT
   *stream << "       -m m  : order of vector    (   int)[" << std::setw(5) << std::right << "l-1"                    << "][ 0 <= m <=   ]" << std::endl;  // NOLINT
   *stream << "       -p p  : decimation period  (   int)[" << std::setw(5) << std::right << kDefaultDecimationPeriod << "][ 0 <  p <=   ]" << std::endl;  // NOLINT
+  *stream << "       -f    : lowpass filtering  (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultFilteringFlag) << "][             ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       data sequence              (double)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       decimated data sequence    (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       if -f is given, each element of vector is lowpass filtered" << std::endl;  // NOLINT
+  *stream << "       before decimation to prevent aliasing" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -83,12 +96,15 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_index(kDefaultStartIndex);
   int vector_length(kDefaultVectorLength);
   int decimation_period(kDefaultDecimationPeriod);
+  bool filtering_flag(kDefaultFilteringFlag);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "s:l:m:p:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "s:l:m:p:fh", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -137,6 +153,10 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'f': {
+        filtering_flag = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -182,6 +202,66 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (filtering_flag) {
+    sptk::SampleRateConversion sample_rate_conversion(
+        1, decimation_period, kStopbandAttenuation, kTransitionWidth);
+    if (!sample_rate_conversion.IsValid()) {
+      std::ostringstream error_message;
+      error_message << "Failed to initialize SampleRateConversion";
+      sptk::PrintErrorMessage("decimate", error_message);
+      return 1;
+    }
+    std::vector<sptk::SampleRateConversion::Buffer> buffers(vector_length);
+
+    // Each element of vector is filtered as an independent sequence.
+    std::vector<double> block(kNumVectorInBlock * vector_length);
+    std::vector<double> input;
+    std::vector<double> output;
+    std::vector<double> rest_of_output;
+    std::vector<double> decimated_block;
+    for (bool is_end_of_input(false); !is_end_of_input;) {
+      int num_read;
+      if (!sptk::ReadStream(false, 0, 0, kNumVectorInBlock * vector_length,
+                            &block, &input_stream, &num_read)) {
+        is_end_of_input = true;
+      }
+      const int num_vector(num_read / vector_length);
+
+      for (int i(0); i < vector_length; ++i) {
+        input.resize(num_vector);
+        for (int t(0); t < num_vector; ++t) {
+          input[t] = block[t * vector_length + i];
+        }
+        if (!sample_rate_conversion.Run(input, &output, &buffers[i]) ||
+            (is_end_of_input &&
+             !sample_rate_conversion.Flush(&rest_of_output, &buffers[i]))) {
+          std::ostringstream error_message;
+          error_message << "Failed to filter data sequence";
+          sptk::PrintErrorMessage("decimate", error_message);
+          return 1;
+        }
+        if (is_end_of_input) {
+          output.insert(output.end(), rest_of_output.begin(),
+                        rest_of_output.end());
+        }
+        decimated_block.resize(output.size() * vector_length);
+        for (int t(0); t < static_cast<int>(output.size()); ++t) {
+          decimated_block[t * vector_length + i] = output[t];
+        }
+      }
+
+      if (!decimated_block.empty() &&
+          !sptk::WriteStream(0, static_cast<int>(decimated_block.size()),
+                             decimated_block, &std::cout, NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write decimated data sequence";
+        sptk::PrintErrorMessage("decimate", error_message);
+        return 1;
+      }
+    }
+    return 0;
+  }
+
   for (int sample_index(0); sptk::ReadStream(false, 0, 0, vector_length,
                                              &input_data, &input_stream, NULL);
        ++sample_index) {
@@ -49,6 +49,7 @@
 #include <queue>     // std::queue
 #include <sstream>   // std::ostringstream
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -82,6 +83,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_index(kDefaultStartIndex);
   bool keep_sequence_length_flag(kDefaultKeepSequenceLengthFlag);
 
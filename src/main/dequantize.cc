@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 
 #include "SPTK/quantizer/inverse_uniform_quantization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -91,6 +92,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   double absolute_maximum_value(kDefaultAbsoluteMaximumValue);
   int num_bit(kDefaultNumBit);
   sptk::UniformQuantization::QuantizationType quantization_type(
@@ -53,6 +53,7 @@
 #include <vector>     // std::vector
 
 #include "SPTK/filter/infinite_impulse_response_digital_filter.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -86,6 +87,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   double sampling_rate(kDefaultSamplingRate);
   std::vector<double> pole_frequencies;
   std::vector<double> pole_bandwidths;
@@ -50,10 +50,14 @@
 #include <vector>    // std::vector
 
 #include "SPTK/filter/infinite_impulse_response_digital_filter.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
+// Number of samples filtered at once.
+const int kNumDataInBlock(8192);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -82,6 +86,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   std::vector<double> denominator_coefficients;
   std::vector<double> numerator_coefficients;
   const char* denominator_coefficients_file(NULL);
@@ -218,7 +224,6 @@ int main(int argc, char* argv[]) {
     numerator_coefficients.push_back(1.0);
   }
 
-  double filter_input, filter_output;
   sptk::InfiniteImpulseResponseDigitalFilter filter(denominator_coefficients,
                                                     numerator_coefficients);
   sptk::InfiniteImpulseResponseDigitalFilter::Buffer buffer;
@@ -229,20 +234,25 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  while (sptk::ReadStream(&filter_input, &input_stream)) {
-    if (!filter.Run(filter_input, &filter_output, &buffer)) {
+  std::vector<double> signals(kNumDataInBlock);
+  int num_read;
+  while (sptk::ReadStream(true, 0, 0, kNumDataInBlock, &signals, &input_stream,
+                          &num_read)) {
+    signals.resize(num_read);
+    if (!filter.Run(signals, &signals, &buffer)) {
       std::ostringstream error_message;
       error_message << "Failed to apply digital filter";
       sptk::PrintErrorMessage("dfs", error_message);
       return 1;
     }
 
-    if (!sptk::WriteStream(filter_output, &std::cout)) {
+    if (!sptk::WriteStream(0, num_read, signals, &std::cout, NULL)) {
       std::ostringstream error_message;
       error_message << "Failed to write a filter output";
       sptk::PrintErrorMessage("dfs", error_message);
       return 1;
     }
+    signals.resize(kNumDataInBlock);
   }
 
   return 0;
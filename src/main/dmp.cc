@@ -50,6 +50,7 @@
 #include <sstream>   // std::ostringstream
 #include <string>    // std::string
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
 #include "SPTK/utils/uint24_t.h"
@@ -220,6 +221,8 @@ class DataDumpWrapper {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int minimum_index(0);
   int maximum_index(kMagicNumberForEndOfFile);
   std::string print_format("");
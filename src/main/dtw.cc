@@ -52,6 +52,7 @@
 
 #include "SPTK/math/distance_calculator.h"
 #include "SPTK/math/dynamic_time_warping.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -62,6 +63,8 @@ const sptk::DynamicTimeWarping::LocalPathConstraints
         sptk::DynamicTimeWarping::LocalPathConstraints::kType5);
 const sptk::DistanceCalculator::DistanceMetrics kDefaultDistanceMetric(
     sptk::DistanceCalculator::DistanceMetrics::kSquaredEuclidean);
+const bool kDefaultScoreOnlyFlag(false);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -70,6 +73,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << std::endl;
   *stream << "  usage:" << std::endl;
   *stream << "       dtw [ options ] file1 [ infile ] > stdout" << std::endl;
+  *stream << "       dtw [ options ] file1 infile file2 infile2 ... > stdout" << std::endl;  // NOLINT
   *stream << "  options:" << std::endl;
   *stream << "       -l l  : length of vector               (   int)[" << std::setw(5) << std::right << kDefaultNumOrder + 1        << "][ 0 <  l <=   ]" << std::endl;  // NOLINT
   *stream << "       -m m  : order of vector                (   int)[" << std::setw(5) << std::right << "l-1"                       << "][ 0 <= m <=   ]" << std::endl;  // NOLINT
@@ -83,22 +87,50 @@ void PrintUsage(std::ostream* stream) {
   *stream << "               Viterbi path" << std::endl;
   *stream << "       -S S  : output filename of double type (string)[" << std::setw(5) << std::right << "N/A"                       << "]" << std::endl;  // NOLINT
   *stream << "               total score" << std::endl;
+  *stream << "       -b b  : half width of Sakoe-Chiba band (   int)[" << std::setw(5) << std::right << "N/A"                       << "][ 0 <= b <=   ]" << std::endl;  // NOLINT
+  *stream << "       -i i  : maximum slope of Itakura       (double)[" << std::setw(5) << std::right << "N/A"                       << "][ 1 <= i <=   ]" << std::endl;  // NOLINT
+  *stream << "               parallelogram" << std::endl;
+  *stream << "       -s    : output only total score        (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultScoreOnlyFlag) << "]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads              (   int)[" << std::setw(5) << std::right << kDefaultNumThread           << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  file1:" << std::endl;
   *stream << "       reference vector sequence              (double)" << std::endl;  // NOLINT
   *stream << "  infile:" << std::endl;
   *stream << "       query vector sequence                  (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
-  *stream << "       warped vector sequence                 (double)" << std::endl;  // NOLINT
+  *stream << "       warped vector sequence or total score  (double)" << std::endl;  // NOLINT
+  *stream << "  notice:" << std::endl;
+  *stream << "       if more than two files are given, each pair is aligned independently" << std::endl;  // NOLINT
+  *stream << "       -b and -i options are exclusive" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+// Reads all vectors from a file or the standard input if the file name is
+// NULL. Returns false if the file cannot be opened.
+bool ReadVectors(const char* file_name, int length,
+                 std::vector<std::vector<double> >* vectors) {
+  std::ifstream ifs;
+  ifs.open(file_name, std::ios::in | std::ios::binary);
+  if (ifs.fail() && NULL != file_name) {
+    return false;
+  }
+  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+
+  std::vector<double> tmp(length);
+  while (sptk::ReadStream(false, 0, 0, length, &tmp, &input_stream, NULL)) {
+    vectors->push_back(tmp);
+  }
+  return true;
+}
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   sptk::DynamicTimeWarping::LocalPathConstraints local_path_constraint(
       kDefaultLocalPathConstraint);
@@ -106,9 +138,15 @@ int main(int argc, char* argv[]) {
       kDefaultDistanceMetric);
   const char* total_score_file(NULL);
   const char* viterbi_path_file(NULL);
+  sptk::DynamicTimeWarping::GlobalPathConstraints global_path_constraint(
+      sptk::DynamicTimeWarping::GlobalPathConstraints::kNone);
+  double global_path_constraint_parameter(0.0);
+  bool score_only_flag(kDefaultScoreOnlyFlag);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:p:d:P:S:h", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "l:m:p:d:P:S:b:i:sj:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -181,6 +219,56 @@ int main(int argc, char* argv[]) {
         total_score_file = optarg;
         break;
       }
+      case 'b': {
+        int band_width;
+        if (!sptk::ConvertStringToInteger(optarg, &band_width) ||
+            band_width < 0 ||
+            sptk::DynamicTimeWarping::GlobalPathConstraints::
+                    kItakuraParallelogram == global_path_constraint) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -b option must be a "
+                        << "non-negative integer and the -i option must not "
+                        << "be given";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        global_path_constraint =
+            sptk::DynamicTimeWarping::GlobalPathConstraints::kSakoeChibaBand;
+        global_path_constraint_parameter = band_width;
+        break;
+      }
+      case 'i': {
+        double slope;
+        if (!sptk::ConvertStringToDouble(optarg, &slope) || slope < 1.0 ||
+            sptk::DynamicTimeWarping::GlobalPathConstraints::kSakoeChibaBand ==
+                global_path_constraint) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -i option must be equal to "
+                        << "or greater than 1.0 and the -b option must not be "
+                        << "given";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        global_path_constraint = sptk::DynamicTimeWarping::
+            GlobalPathConstraints::kItakuraParallelogram;
+        global_path_constraint_parameter = slope;
+        break;
+      }
+      case 's': {
+        score_only_flag = true;
+        break;
+      }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -192,59 +280,43 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  // get input file
-  const char* reference_file;
-  const char* query_file;
+  // get input files
+  std::vector<const char*> reference_files;
+  std::vector<const char*> query_files;
   const int num_input_files(argc - optind);
-  if (2 == num_input_files) {
-    reference_file = argv[argc - 2];
-    query_file = argv[argc - 1];
-  } else if (1 == num_input_files) {
-    reference_file = argv[argc - 1];
-    query_file = NULL;
+  if (1 == num_input_files) {
+    reference_files.push_back(argv[optind]);
+    query_files.push_back(NULL);
+  } else if (2 <= num_input_files && 0 == num_input_files % 2) {
+    for (int i(optind); i < argc; i += 2) {
+      reference_files.push_back(argv[i]);
+      query_files.push_back(argv[i + 1]);
+    }
   } else {
     std::ostringstream error_message;
-    error_message << "Just two input files, file1 and infile, are required";
+    error_message << "Pairs of input files, file1 and infile, are required";
     sptk::PrintErrorMessage("dtw", error_message);
     return 1;
   }
 
   const int length(num_order + 1);
+  const int num_pair(reference_files.size());
 
-  std::vector<std::vector<double> > reference_vectors;
-  {
-    std::ifstream ifs;
-    ifs.open(reference_file, std::ios::in | std::ios::binary);
-    if (ifs.fail()) {
+  std::vector<std::vector<std::vector<double> > > reference_vectors(num_pair);
+  std::vector<std::vector<std::vector<double> > > query_vectors(num_pair);
+  for (int n(0); n < num_pair; ++n) {
+    if (!ReadVectors(reference_files[n], length, &reference_vectors[n])) {
       std::ostringstream error_message;
-      error_message << "Cannot open file " << reference_file;
+      error_message << "Cannot open file " << reference_files[n];
       sptk::PrintErrorMessage("dtw", error_message);
       return 1;
     }
-    std::istream& input_stream(ifs);
-
-    std::vector<double> tmp(length);
-    while (sptk::ReadStream(false, 0, 0, length, &tmp, &input_stream, NULL)) {
-      reference_vectors.push_back(tmp);
-    }
-  }
-
-  std::vector<std::vector<double> > query_vectors;
-  {
-    std::ifstream ifs;
-    ifs.open(query_file, std::ios::in | std::ios::binary);
-    if (ifs.fail() && NULL != query_file) {
+    if (!ReadVectors(query_files[n], length, &query_vectors[n])) {
       std::ostringstream error_message;
-      error_message << "Cannot open file " << query_file;
+      error_message << "Cannot open file " << query_files[n];
       sptk::PrintErrorMessage("dtw", error_message);
       return 1;
     }
-    std::istream& input_stream(ifs.fail() ? std::cin : ifs);
-
-    std::vector<double> tmp(length);
-    while (sptk::ReadStream(false, 0, 0, length, &tmp, &input_stream, NULL)) {
-      query_vectors.push_back(tmp);
-    }
   }
 
   std::ofstream ofs1;
@@ -272,7 +344,8 @@ int main(int argc, char* argv[]) {
   std::ostream& output_stream_for_path(ofs2);
 
   sptk::DynamicTimeWarping dynamic_time_warping(
-      num_order, local_path_constraint, distance_metric);
+      num_order, local_path_constraint, distance_metric,
+      global_path_constraint, global_path_constraint_parameter);
   if (!dynamic_time_warping.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set the condition for dynamic time warping";
@@ -280,48 +353,64 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  std::vector<std::pair<int, int> > viterbi_path;
-  double total_score;
-  if (!dynamic_time_warping.Run(query_vectors, reference_vectors, &viterbi_path,
-                                &total_score)) {
+  // The Viterbi path is not computed if it is not needed.
+  const bool path_flag(!score_only_flag || NULL != viterbi_path_file);
+  std::vector<std::vector<std::pair<int, int> > > viterbi_paths;
+  std::vector<double> total_scores;
+  if (!dynamic_time_warping.Run(query_vectors, reference_vectors, num_thread,
+                                path_flag ? &viterbi_paths : NULL,
+                                &total_scores)) {
     std::ostringstream error_message;
     error_message << "Failed to run dynamic time warping";
     sptk::PrintErrorMessage("dtw", error_message);
     return 1;
   }
 
-  for (std::vector<std::pair<int, int> >::iterator itr(viterbi_path.begin());
-       itr != viterbi_path.end(); ++itr) {
-    if (!sptk::WriteStream(0, length, query_vectors[itr->first], &std::cout,
-                           NULL) ||
-        !sptk::WriteStream(0, length, reference_vectors[itr->second],
-                           &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write warped vector";
-      sptk::PrintErrorMessage("dtw", error_message);
-      return 1;
-    }
-  }
-
-  if (NULL != viterbi_path_file) {
-    for (std::vector<std::pair<int, int> >::iterator itr(viterbi_path.begin());
-         itr != viterbi_path.end(); ++itr) {
-      if (!sptk::WriteStream(itr->first, &output_stream_for_path) ||
-          !sptk::WriteStream(itr->second, &output_stream_for_path)) {
+  for (int n(0); n < num_pair; ++n) {
+    if (score_only_flag) {
+      if (!sptk::WriteStream(total_scores[n], &std::cout)) {
         std::ostringstream error_message;
-        error_message << "Failed to write Viterbi path";
+        error_message << "Failed to write total score";
         sptk::PrintErrorMessage("dtw", error_message);
         return 1;
       }
+    } else {
+      for (std::vector<std::pair<int, int> >::iterator itr(
+               viterbi_paths[n].begin());
+           itr != viterbi_paths[n].end(); ++itr) {
+        if (!sptk::WriteStream(0, length, query_vectors[n][itr->first],
+                               &std::cout, NULL) ||
+            !sptk::WriteStream(0, length, reference_vectors[n][itr->second],
+                               &std::cout, NULL)) {
+          std::ostringstream error_message;
+          error_message << "Failed to write warped vector";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+      }
     }
-  }
 
-  if (NULL != total_score_file) {
-    if (!sptk::WriteStream(total_score, &output_stream_for_score)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write total score";
-      sptk::PrintErrorMessage("dtw", error_message);
-      return 1;
+    if (NULL != viterbi_path_file) {
+      for (std::vector<std::pair<int, int> >::iterator itr(
+               viterbi_paths[n].begin());
+           itr != viterbi_paths[n].end(); ++itr) {
+        if (!sptk::WriteStream(itr->first, &output_stream_for_path) ||
+            !sptk::WriteStream(itr->second, &output_stream_for_path)) {
+          std::ostringstream error_message;
+          error_message << "Failed to write Viterbi path";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+      }
+    }
+
+    if (NULL != total_score_file) {
+      if (!sptk::WriteStream(total_scores[n], &output_stream_for_score)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write total score";
+        sptk::PrintErrorMessage("dtw", error_message);
+        return 1;
+      }
     }
   }
 
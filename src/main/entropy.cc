@@ -51,6 +51,7 @@
 
 #include "SPTK/math/entropy_calculator.h"
 #include "SPTK/math/statistics_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -88,6 +89,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_element(kDefaultNumElement);
   sptk::EntropyCalculator::EntropyUnits entropy_unit(kDefaultEntropyUnit);
   bool output_frame_by_frame(kDefaultOutputFrameByFrameFlag);
@@ -48,11 +48,13 @@
 #include <iomanip>    // std::setw
 #include <iostream>   // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>    // std::ostringstream
+#include <vector>     // std::vector
 
 #include "SPTK/generator/excitation_generation.h"
 #include "SPTK/generator/m_sequence_generation.h"
 #include "SPTK/generator/normal_distributed_random_value_generation.h"
 #include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -62,6 +64,7 @@ const int kDefaultInterpolationPeriod(1);
 const bool kDefaultFlagToUseNormalDistributedRandomValue(false);
 const int kDefaultSeed(1);
 const double kMagicNumberForUnvoicedFrame(0.0);
+const int kBlockSize(1024);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -93,6 +96,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int frame_period(kDefaultFramePeriod);
   int interpolation_period(kDefaultInterpolationPeriod);
   bool use_normal_distributed_random_value(
@@ -212,9 +217,16 @@ int main(int argc, char* argv[]) {
       return 1;
     }
 
-    double excitation;
-    while (excitation_generation.Get(&excitation, NULL, NULL, NULL)) {
-      if (!sptk::WriteStream(excitation, &std::cout)) {
+    std::vector<double> excitation(kBlockSize);
+    bool is_continued(true);
+    while (is_continued) {
+      int num_sample(0);
+      is_continued = excitation_generation.GetBlock(kBlockSize,
+                                                    &(excitation[0]), NULL,
+                                                    NULL, NULL, &num_sample) &&
+                     kBlockSize == num_sample;
+      if (0 < num_sample &&
+          !sptk::WriteStream(0, num_sample, excitation, &std::cout, NULL)) {
         std::ostringstream error_message;
         error_message << "Failed to write excitation";
         sptk::PrintErrorMessage("excite", error_message);
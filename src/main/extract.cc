@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -83,6 +84,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kDefaultVectorLength);
   int codebook_index(kDefaultCodebookIndex);
 
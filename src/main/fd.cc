@@ -51,6 +51,7 @@
 #include <sstream>   // std::ostringstream
 #include <string>    // std::string
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -96,6 +97,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_index(kDefaultStartIndex);
   int num_column(kDefaultNumColumn);
   AddressFormats address_format(kDefaultAddressFormat);
@@ -45,13 +45,16 @@
 #include <getopt.h>  // getopt_long
 
 #include <cmath>     // std::sqrt
+#include <cstring>   // std::strncmp
 #include <fstream>   // std::ifstream
 #include <iomanip>   // std::setw
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>   // std::ostringstream
+#include <string>    // std::string
 #include <vector>    // std::vector
 
 #include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -67,6 +70,7 @@ enum OutputFormats {
 
 const int kDefaultFftLength(256);
 const OutputFormats kDefaultOutputFormat(kOutputRealAndImagParts);
+const char* kDefaultDataType("d");
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -84,19 +88,84 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 2 (imaginary part)" << std::endl;
   *stream << "                 3 (amplitude)" << std::endl;
   *stream << "                 4 (power)" << std::endl;
+  *stream << "       +type : data type                              [" << std::setw(5) << std::right << kDefaultDataType << "]" << std::endl;  // NOLINT
+  *stream << "                 "; sptk::PrintDataType("f", stream); sptk::PrintDataType("d", stream); *stream << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
-  *stream << "       data sequence                          (double)[stdin]" << std::endl;  // NOLINT
+  *stream << "       data sequence                          (  type)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
-  *stream << "       FFT sequence                           (double)" << std::endl;  // NOLINT
+  *stream << "       FFT sequence                           (  type)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
   *stream << "       value of l must be a power of 2" << std::endl;
+  *stream << "       if type is f, FFT is computed in single precision" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+template <typename T>
+bool ComputeFastFourierTransform(int num_order, int fft_length,
+                                 OutputFormats output_format,
+                                 std::istream* input_stream) {
+  sptk::FastFourierTransformBase<T> fast_fourier_transform(num_order,
+                                                          fft_length);
+  if (!fast_fourier_transform.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "FFT length must be a power of 2";
+    sptk::PrintErrorMessage("fft", error_message);
+    return false;
+  }
+
+  const int length(num_order + 1);
+  std::vector<T> input_x(length);
+  std::vector<T> input_y(length);
+  std::vector<T> output_x(fft_length);
+  std::vector<T> output_y(fft_length);
+
+  while (sptk::ReadStream(true, 0, 0, length, &input_x, input_stream, NULL) &&
+         sptk::ReadStream(true, 0, 0, length, &input_y, input_stream, NULL)) {
+    if (!fast_fourier_transform.Run(input_x, input_y, &output_x, &output_y)) {
+      std::ostringstream error_message;
+      error_message << "Failed to run fast Fourier transform";
+      sptk::PrintErrorMessage("fft", error_message);
+      return false;
+    }
+
+    if (kOutputAmplitude == output_format) {
+      for (int i(0); i < fft_length; ++i) {
+        output_x[i] =
+            std::sqrt(output_x[i] * output_x[i] + output_y[i] * output_y[i]);
+      }
+    } else if (kOutputPower == output_format) {
+      for (int i(0); i < fft_length; ++i) {
+        output_x[i] = output_x[i] * output_x[i] + output_y[i] * output_y[i];
+      }
+    }
+
+    if ((kOutputRealAndImagParts == output_format ||
+         kOutputRealPart == output_format ||
+         kOutputAmplitude == output_format || kOutputPower == output_format) &&
+        !sptk::WriteStream(0, fft_length, output_x, &std::cout, NULL)) {
+      std::ostringstream error_message;
+      error_message << "Failed to write output sequence";
+      sptk::PrintErrorMessage("fft", error_message);
+      return false;
+    }
+
+    if ((kOutputRealAndImagParts == output_format ||
+         kOutputImagPart == output_format) &&
+        !sptk::WriteStream(0, fft_length, output_y, &std::cout, NULL)) {
+      std::ostringstream error_message;
+      error_message << "Failed to write imaginary parts";
+      sptk::PrintErrorMessage("fft", error_message);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace
 
 /**
@@ -113,10 +182,14 @@ void PrintUsage(std::ostream* stream) {
  *     \arg \c 2 imaginary part
  *     \arg \c 3 amplitude spectrum
  *     \arg \c 4 power spectrum
+ * - \b +type \e char
+ *   - data type
+ *     \arg \c f float
+ *     \arg \c d double
  * - \b infile \e str
- *   - double-type data sequence
+ *   - data sequence
  * - \b stdout
- *   - double-type FFT sequence
+ *   - FFT sequence
  *
  * The below example analyzes a sine wave using Blackman window by padding
  * imaginary part with zeros.
@@ -130,6 +203,8 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   int num_order(kDefaultFftLength - 1);
   bool is_num_order_specified(false);
@@ -196,14 +271,22 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  const int num_input_files(argc - optind);
-  if (1 < num_input_files) {
-    std::ostringstream error_message;
-    error_message << "Too many input files";
-    sptk::PrintErrorMessage("fft", error_message);
-    return 1;
+  const char* input_file(NULL);
+  std::string data_type(kDefaultDataType);
+  for (int i(argc - optind); 1 <= i; --i) {
+    const char* arg(argv[argc - i]);
+    if (0 == std::strncmp(arg, "+", 1)) {
+      const std::string str(arg);
+      data_type = str.substr(1, std::string::npos);
+    } else if (NULL == input_file) {
+      input_file = arg;
+    } else {
+      std::ostringstream error_message;
+      error_message << "Too many input files";
+      sptk::PrintErrorMessage("fft", error_message);
+      return 1;
+    }
   }
-  const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
   std::ifstream ifs;
   ifs.open(input_file, std::ios::in | std::ios::binary);
@@ -215,59 +298,19 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
-  sptk::FastFourierTransform fast_fourier_transform(num_order, fft_length);
-  if (!fast_fourier_transform.IsValid()) {
+  bool is_succeeded;
+  if ("f" == data_type) {
+    is_succeeded = ComputeFastFourierTransform<float>(
+        num_order, fft_length, output_format, &input_stream);
+  } else if ("d" == data_type) {
+    is_succeeded = ComputeFastFourierTransform<double>(
+        num_order, fft_length, output_format, &input_stream);
+  } else {
     std::ostringstream error_message;
-    error_message << "FFT length must be a power of 2";
+    error_message << "Unexpected argument for the +type option";
     sptk::PrintErrorMessage("fft", error_message);
     return 1;
   }
 
-  const int length(num_order + 1);
-  std::vector<double> input_x(length);
-  std::vector<double> input_y(length);
-  std::vector<double> output_x(fft_length);
-  std::vector<double> output_y(fft_length);
-
-  while (sptk::ReadStream(true, 0, 0, length, &input_x, &input_stream, NULL) &&
-         sptk::ReadStream(true, 0, 0, length, &input_y, &input_stream, NULL)) {
-    if (!fast_fourier_transform.Run(input_x, input_y, &output_x, &output_y)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run fast Fourier transform";
-      sptk::PrintErrorMessage("fft", error_message);
-      return 1;
-    }
-
-    if (kOutputAmplitude == output_format) {
-      for (int i(0); i < fft_length; ++i) {
-        output_x[i] =
-            std::sqrt(output_x[i] * output_x[i] + output_y[i] * output_y[i]);
-      }
-    } else if (kOutputPower == output_format) {
-      for (int i(0); i < fft_length; ++i) {
-        output_x[i] = output_x[i] * output_x[i] + output_y[i] * output_y[i];
-      }
-    }
-
-    if ((kOutputRealAndImagParts == output_format ||
-         kOutputRealPart == output_format ||
-         kOutputAmplitude == output_format || kOutputPower == output_format) &&
-        !sptk::WriteStream(0, fft_length, output_x, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write output sequence";
-      sptk::PrintErrorMessage("fft", error_message);
-      return 1;
-    }
-
-    if ((kOutputRealAndImagParts == output_format ||
-         kOutputImagPart == output_format) &&
-        !sptk::WriteStream(0, fft_length, output_y, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write imaginary parts";
-      sptk::PrintErrorMessage("fft", error_message);
-      return 1;
-    }
-  }
-
-  return 0;
+  return is_succeeded ? 0 : 1;
 }
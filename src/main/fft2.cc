@@ -51,6 +51,7 @@
 
 #include "SPTK/math/matrix.h"
 #include "SPTK/math/two_dimensional_fast_fourier_transform.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -114,6 +115,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   int num_row(kDefaultFftLength);
   int num_column(kDefaultFftLength);
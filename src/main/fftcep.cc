@@ -55,6 +55,10 @@
 
 #include "SPTK/analyzer/fast_fourier_transform_cepstral_analysis.h"
 #include "SPTK/converter/waveform_to_spectrum.h"
+#include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/math/matrix.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -73,6 +77,7 @@ const int kDefaultNumOrder(25);
 const int kDefaultNumIteration(0);
 const double kDefaultAccelerationFactor(0.0);
 const InputFormats kDefaultInputFormat(kWaveform);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -94,6 +99,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 4 (windowed waveform)" << std::endl;
   *stream << "       -e e  : small value for log  (double)[" << std::setw(5) << std::right << "N/A"                      << "][ 0.0 <  e <=     ]" << std::endl;  // NOLINT
   *stream << "       -E E  : relative floor       (double)[" << std::setw(5) << std::right << "N/A"                      << "][     <= E <  0.0 ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads    (   int)[" << std::setw(5) << std::right << kDefaultNumThread          << "][   1 <= j <=     ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       data sequence                (double)[stdin]" << std::endl;
@@ -107,6 +113,134 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  FrameProcessor(const sptk::WaveformToSpectrum& waveform_to_spectrum,
+                 const sptk::FastFourierTransformCepstralAnalysis& analysis,
+                 InputFormats input_format, int fft_length)
+      : waveform_to_spectrum_(waveform_to_spectrum),
+        analysis_(analysis),
+        input_format_(input_format),
+        processed_input_(fft_length / 2 + 1) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    switch (input_format_) {
+      case kLogAmplitudeSpectrumInDecibels: {
+        std::transform(input.begin(), input.end(), processed_input_.begin(),
+                       [](double x) { return std::pow(10, 0.1 * x); });
+        break;
+      }
+      case kLogAmplitudeSpectrum: {
+        std::transform(input.begin(), input.end(), processed_input_.begin(),
+                       [](double x) { return std::exp(2.0 * x); });
+        break;
+      }
+      case kAmplitudeSpectrum: {
+        std::transform(input.begin(), input.end(), processed_input_.begin(),
+                       [](double x) { return x * x; });
+        break;
+      }
+      case kPowerSpectrum: {
+        std::copy(input.begin(), input.end(), processed_input_.begin());
+        break;
+      }
+      case kWaveform: {
+        if (!waveform_to_spectrum_.Run(input, &processed_input_,
+                                       &buffer_for_spectral_analysis_)) {
+          *message << "Failed to transform waveform to spectrum";
+          return false;
+        }
+        break;
+      }
+      default: { break; }
+    }
+
+    if (!analysis_.Run(processed_input_, output,
+                       &buffer_for_cepstral_analysis_)) {
+      *message << "Failed to run FFT cepstral analysis";
+      return false;
+    }
+
+    return true;
+  }
+
+  virtual bool RunChunk(const std::vector<std::vector<double> >& inputs,
+                        int num_frame,
+                        std::vector<std::vector<double> >* outputs) {
+    const int input_length(inputs[0].size());
+    if (processed_inputs_.GetNumRow() != num_frame) {
+      processed_inputs_.Resize(num_frame, processed_input_.size());
+    }
+    if (kWaveform == input_format_) {
+      if (waveforms_.GetNumRow() != num_frame) {
+        waveforms_.Resize(num_frame, input_length);
+      }
+      for (int i(0); i < num_frame; ++i) {
+        std::copy(inputs[i].begin(), inputs[i].end(), waveforms_[i]);
+      }
+      if (!waveform_to_spectrum_.Run(waveforms_, &processed_inputs_,
+                                     &buffer_for_spectral_analysis_)) {
+        return false;
+      }
+    } else {
+      for (int i(0); i < num_frame; ++i) {
+        double* processed_input(processed_inputs_[i]);
+        switch (input_format_) {
+          case kLogAmplitudeSpectrumInDecibels: {
+            std::transform(inputs[i].begin(), inputs[i].end(), processed_input,
+                           [](double x) { return std::pow(10, 0.1 * x); });
+            break;
+          }
+          case kLogAmplitudeSpectrum: {
+            std::transform(inputs[i].begin(), inputs[i].end(), processed_input,
+                           [](double x) { return std::exp(2.0 * x); });
+            break;
+          }
+          case kAmplitudeSpectrum: {
+            std::transform(inputs[i].begin(), inputs[i].end(), processed_input,
+                           [](double x) { return x * x; });
+            break;
+          }
+          case kPowerSpectrum: {
+            std::copy(inputs[i].begin(), inputs[i].end(), processed_input);
+            break;
+          }
+          default: { break; }
+        }
+      }
+    }
+
+    if (!analysis_.Run(processed_inputs_, &cepstra_,
+                       &buffer_for_cepstral_analysis_)) {
+      return false;
+    }
+
+    const int output_length(cepstra_.GetNumColumn());
+    for (int i(0); i < num_frame; ++i) {
+      (*outputs)[i].assign(cepstra_[i], cepstra_[i] + output_length);
+    }
+    return true;
+  }
+
+ private:
+  const sptk::WaveformToSpectrum& waveform_to_spectrum_;
+  const sptk::FastFourierTransformCepstralAnalysis& analysis_;
+  const InputFormats input_format_;
+
+  std::vector<double> processed_input_;
+  sptk::Matrix waveforms_;
+  sptk::Matrix processed_inputs_;
+  sptk::Matrix cepstra_;
+  sptk::WaveformToSpectrum::Buffer buffer_for_spectral_analysis_;
+  sptk::FastFourierTransformCepstralAnalysis::Buffer
+      buffer_for_cepstral_analysis_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 /**
@@ -150,6 +284,8 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   int num_order(kDefaultNumOrder);
   int num_iteration(kDefaultNumIteration);
@@ -157,10 +293,11 @@ int main(int argc, char* argv[]) {
   InputFormats input_format(kDefaultInputFormat);
   double epsilon_for_calculating_logarithms(0.0);
   double relative_floor_in_decibels(-DBL_MAX);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "l:m:i:a:q:e:E:h", NULL, NULL));
+        getopt_long(argc, argv, "l:m:i:a:q:e:E:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -244,6 +381,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("fftcep", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -288,7 +436,6 @@ int main(int argc, char* argv[]) {
       fft_length, fft_length,
       sptk::FilterCoefficientsToSpectrum::OutputFormats::kPowerSpectrum,
       epsilon_for_calculating_logarithms, relative_floor_in_decibels);
-  sptk::WaveformToSpectrum::Buffer buffer_for_spectral_analysis;
   if (!waveform_to_spectrum.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to initialize WaveformToSpectrum";
@@ -298,8 +445,6 @@ int main(int argc, char* argv[]) {
 
   sptk::FastFourierTransformCepstralAnalysis analysis(
       fft_length, num_order, num_iteration, acceleration_factor);
-  sptk::FastFourierTransformCepstralAnalysis::Buffer
-      buffer_for_cepstral_analysis;
   if (!analysis.IsValid()) {
     std::ostringstream error_message;
     error_message
@@ -310,61 +455,23 @@ int main(int argc, char* argv[]) {
 
   const int input_length(kWaveform == input_format ? fft_length
                                                    : fft_length / 2 + 1);
-  const int output_length(num_order + 1);
-  std::vector<double> input(input_length);
-  std::vector<double> processed_input(fft_length / 2 + 1);
-  std::vector<double> output(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &input, &input_stream,
-                          NULL)) {
-    switch (input_format) {
-      case kLogAmplitudeSpectrumInDecibels: {
-        std::transform(input.begin(), input.end(), processed_input.begin(),
-                       [](double x) { return std::pow(10, 0.1 * x); });
-        break;
-      }
-      case kLogAmplitudeSpectrum: {
-        std::transform(input.begin(), input.end(), processed_input.begin(),
-                       [](double x) { return std::exp(2.0 * x); });
-        break;
-      }
-      case kAmplitudeSpectrum: {
-        std::transform(input.begin(), input.end(), processed_input.begin(),
-                       [](double x) { return x * x; });
-        break;
-      }
-      case kPowerSpectrum: {
-        std::copy(input.begin(), input.end(), processed_input.begin());
-        break;
-      }
-      case kWaveform: {
-        if (!waveform_to_spectrum.Run(input, &processed_input,
-                                      &buffer_for_spectral_analysis)) {
-          std::ostringstream error_message;
-          error_message << "Failed to transform waveform to spectrum";
-          sptk::PrintErrorMessage("fftcep", error_message);
-          return 1;
-        }
-        break;
-      }
-      default: { break; }
-    }
-
-    if (!analysis.Run(processed_input, &output,
-                      &buffer_for_cepstral_analysis)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run FFT cepstral analysis";
-      sptk::PrintErrorMessage("fftcep", error_message);
-      return 1;
-    }
-
-    if (!sptk::WriteStream(0, output_length, output, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write FFT cepstrum";
-      sptk::PrintErrorMessage("fftcep", error_message);
-      return 1;
-    }
+  sptk::InputSourceFromStream input_source(false, input_length, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "fftcep", "Failed to write FFT cepstrum");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(new FrameProcessor(
+        waveform_to_spectrum, analysis, input_format, fft_length));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
@@ -50,7 +50,10 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/math/frequency_transform.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -59,6 +62,7 @@ const int kDefaultNumInputOrder(25);
 const int kDefaultNumOutputOrder(25);
 const double kDefaultInputAlpha(0.0);
 const double kDefaultOutputAlpha(0.35);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -72,6 +76,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -M M  : order of warped sequence             (   int)[" << std::setw(5) << std::right << kDefaultNumOutputOrder << "][    0 <= M <=     ]" << std::endl;  // NOLINT
   *stream << "       -a a  : all-pass constant of input sequence  (double)[" << std::setw(5) << std::right << kDefaultInputAlpha     << "][ -1.0 <  a <  1.0 ]" << std::endl;  // NOLINT
   *stream << "       -A A  : all-pass constant of output sequence (double)[" << std::setw(5) << std::right << kDefaultOutputAlpha    << "][ -1.0 <  A <  1.0 ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads                    (   int)[" << std::setw(5) << std::right << kDefaultNumThread      << "][    1 <= j <=     ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       minimum phase sequence                       (double)[stdin]" << std::endl;  // NOLINT
@@ -83,6 +88,31 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  explicit FrameProcessor(
+      const sptk::FrequencyTransform& frequency_transform)
+      : frequency_transform_(frequency_transform) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    if (!frequency_transform_.Run(input, output, &buffer_)) {
+      *message << "Failed to run frequency transform";
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  const sptk::FrequencyTransform& frequency_transform_;
+
+  sptk::FrequencyTransform::Buffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 /**
@@ -120,13 +150,17 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_input_order(kDefaultNumInputOrder);
   int num_output_order(kDefaultNumOutputOrder);
   double input_alpha(kDefaultInputAlpha);
   double output_alpha(kDefaultOutputAlpha);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "m:M:a:A:h", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "m:M:a:A:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -174,6 +208,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("freqt", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -206,9 +251,8 @@ int main(int argc, char* argv[]) {
 
   const double alpha((output_alpha - input_alpha) /
                      (1.0 - input_alpha * output_alpha));
-  sptk::FrequencyTransform frequency_transform(num_input_order,
-                                               num_output_order, alpha);
-  sptk::FrequencyTransform::Buffer buffer;
+  sptk::FrequencyTransform frequency_transform(
+      num_input_order, num_output_order, alpha);
   if (!frequency_transform.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to initialize FrequencyTransform";
@@ -217,28 +261,22 @@ int main(int argc, char* argv[]) {
   }
 
   const int input_length(num_input_order + 1);
-  const int output_length(num_output_order + 1);
-  std::vector<double> minimum_phase_sequence(input_length);
-  std::vector<double> warped_sequence(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &minimum_phase_sequence,
-                          &input_stream, NULL)) {
-    if (!frequency_transform.Run(minimum_phase_sequence, &warped_sequence,
-                                 &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run frequency transform";
-      sptk::PrintErrorMessage("freqt", error_message);
-      return 1;
-    }
-
-    if (!sptk::WriteStream(0, output_length, warped_sequence, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write warped sequence";
-      sptk::PrintErrorMessage("freqt", error_message);
-      return 1;
-    }
+  sptk::InputSourceFromStream input_source(false, input_length, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "freqt", "Failed to write warped sequence");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(new FrameProcessor(frequency_transform));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
@@ -51,6 +51,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/normalizer/generalized_cepstrum_gain_normalization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -113,6 +114,8 @@ void PrintUsage(std::ostream* stream) {
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double gamma(kDefaultGamma);
 
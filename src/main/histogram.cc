@@ -54,6 +54,7 @@
 
 #include "SPTK/math/histogram_calculator.h"
 #include "SPTK/math/statistics_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -91,6 +92,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int output_interval(kMagicNumberForEndOfFile);
   int num_bin(kDefaultNumBin);
   double lower_bound(kDefaultLowerBound);
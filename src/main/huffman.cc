@@ -51,6 +51,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/compressor/huffman_coding.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -82,6 +83,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_index(kDefaultStartIndex);
   const char* average_code_length_file(NULL);
 
@@ -44,14 +44,23 @@
 
 #include <getopt.h>  // getopt_long
 #include <fstream>   // std::ifstream
+#include <iomanip>   // std::setw
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>   // std::ostringstream
+#include <vector>    // std::vector
 
 #include "SPTK/compressor/huffman_decoding.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/bit_stream.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
+// Number of data written at once.
+const int kNumDataInBlock(4096);
+
+const bool kDefaultPackedFormatFlag(false);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -60,6 +69,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "  usage:" << std::endl;
   *stream << "       huffman_decode [ options ] cbfile [ infile ] > stdout" << std::endl;  // NOLINT
   *stream << "  options:" << std::endl;
+  *stream << "       -p    : use packed format        (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultPackedFormatFlag) << "]" << std::endl;  // NOLINT
+  *stream << "               of bitstream" << std::endl;
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  cbfile:" << std::endl;
   *stream << "       codebook                   (string)" << std::endl;
@@ -67,6 +78,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       input sequence             (  bool)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       decoded sequence           (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       -p option must be given if -p option is given in huffman_encode" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -76,11 +89,19 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
+  bool is_packed(kDefaultPackedFormatFlag);
+
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "ph", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
+      case 'p': {
+        is_packed = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -134,24 +155,35 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs2.fail() ? std::cin : ifs2);
 
-  bool input;
-  double output;
-  bool is_leaf;
+  sptk::BitStreamReader bit_stream_reader(&input_stream, is_packed);
+  std::vector<double> outputs(kNumDataInBlock);
+  int num_data(0);
 
-  while (sptk::ReadStream(&input, &input_stream)) {
-    if (!huffman_decoding.Get(input, &output, &is_leaf)) {
-      std::ostringstream error_message;
-      error_message << "Failed to decode";
-      sptk::PrintErrorMessage("huffman_decode", error_message);
-      return 1;
+  for (;;) {
+    bool is_decoded;
+    const bool is_succeeded(huffman_decoding.Run(
+        &bit_stream_reader, &outputs[num_data], &is_decoded));
+    if (is_succeeded && is_decoded) ++num_data;
+
+    // Write the decoded data before exit.
+    if (kNumDataInBlock == num_data || !is_succeeded || !is_decoded) {
+      if (0 < num_data &&
+          !sptk::WriteStream(0, num_data, outputs, &std::cout, NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write decoded data";
+        sptk::PrintErrorMessage("huffman_decode", error_message);
+        return 1;
+      }
+      num_data = 0;
     }
 
-    if (is_leaf && !sptk::WriteStream(output, &std::cout)) {
+    if (!is_succeeded) {
       std::ostringstream error_message;
-      error_message << "Failed to write decoded data";
+      error_message << "Failed to decode";
       sptk::PrintErrorMessage("huffman_decode", error_message);
       return 1;
     }
+    if (!is_decoded) break;
   }
 
   return 0;
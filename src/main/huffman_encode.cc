@@ -44,15 +44,23 @@
 
 #include <getopt.h>  // getopt_long
 #include <fstream>   // std::ifstream
+#include <iomanip>   // std::setw
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
 #include "SPTK/compressor/huffman_encoding.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/bit_stream.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
+// Number of data read at once.
+const int kNumDataInBlock(4096);
+
+const bool kDefaultPackedFormatFlag(false);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -61,6 +69,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "  usage:" << std::endl;
   *stream << "       huffman_encode [ options ] cbfile [ infile ] > stdout" << std::endl;  // NOLINT
   *stream << "  options:" << std::endl;
+  *stream << "       -p    : use packed format        (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultPackedFormatFlag) << "]" << std::endl;  // NOLINT
+  *stream << "               of bitstream" << std::endl;
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  cbfile:" << std::endl;
   *stream << "       codebook                   (string)" << std::endl;
@@ -68,6 +78,9 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       input sequence             (double)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       encoded sequence           (  bool)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       if -p option is given, 8 bits are packed into a byte and" << std::endl;  // NOLINT
+  *stream << "       the last byte is padded with a one followed by zeros" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -77,11 +90,19 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
+  bool is_packed(kDefaultPackedFormatFlag);
+
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "ph", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
+      case 'p': {
+        is_packed = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -135,27 +156,35 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs2.fail() ? std::cin : ifs2);
 
-  double input;
-  std::vector<bool> output;
-
-  while (sptk::ReadStream(&input, &input_stream)) {
-    if (!huffman_encoding.Run(input, &output)) {
-      std::ostringstream error_message;
-      error_message << "Failed to encode " << input;
-      sptk::PrintErrorMessage("huffman_encode", error_message);
-      return 1;
-    }
+  sptk::BitStreamWriter bit_stream_writer(&std::cout, is_packed);
+  std::vector<double> inputs(kNumDataInBlock);
+  int num_data;
 
-    const int output_length(output.size());
-    for (int i(0); i < output_length; ++i) {
-      if (!sptk::WriteStream(static_cast<bool>(output[i]), &std::cout)) {
+  while (sptk::ReadStream(true, 0, 0, kNumDataInBlock, &inputs, &input_stream,
+                          &num_data) &&
+         0 < num_data) {
+    for (int i(0); i < num_data; ++i) {
+      if (!huffman_encoding.Run(inputs[i], &bit_stream_writer)) {
         std::ostringstream error_message;
-        error_message << "Failed to write encoded data";
+        if (bit_stream_writer.IsValid()) {
+          // Write the codewords of the preceding inputs.
+          bit_stream_writer.Finish();
+          error_message << "Failed to encode " << inputs[i];
+        } else {
+          error_message << "Failed to write encoded data";
+        }
         sptk::PrintErrorMessage("huffman_encode", error_message);
         return 1;
       }
     }
   }
 
+  if (!bit_stream_writer.Finish()) {
+    std::ostringstream error_message;
+    error_message << "Failed to write encoded data";
+    sptk::PrintErrorMessage("huffman_encode", error_message);
+    return 1;
+  }
+
   return 0;
 }
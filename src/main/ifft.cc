@@ -44,13 +44,16 @@
 
 #include <getopt.h>  // getopt_long
 
+#include <cstring>   // std::strncmp
 #include <fstream>   // std::ifstream
 #include <iomanip>   // std::setw
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>   // std::ostringstream
+#include <string>    // std::string
 #include <vector>    // std::vector
 
 #include "SPTK/math/inverse_fast_fourier_transform.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -72,6 +75,7 @@ enum OutputFormats {
 const int kDefaultFftLength(256);
 const InputFormats kDefaultInputFormat(kInputRealAndImagParts);
 const OutputFormats kDefaultOutputFormat(kOutputRealAndImagParts);
+const char* kDefaultDataType("d");
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -90,19 +94,85 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 0 (real and imaginary parts)" << std::endl;
   *stream << "                 1 (real part)" << std::endl;
   *stream << "                 2 (imaginary part)" << std::endl;
+  *stream << "       +type : data type                              [" << std::setw(5) << std::right << kDefaultDataType << "]" << std::endl;  // NOLINT
+  *stream << "                 "; sptk::PrintDataType("f", stream); sptk::PrintDataType("d", stream); *stream << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
-  *stream << "       data sequence                          (double)[stdin]" << std::endl;  // NOLINT
+  *stream << "       data sequence                          (  type)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
-  *stream << "       inverse FFT sequence                   (double)" << std::endl;  // NOLINT
+  *stream << "       inverse FFT sequence                   (  type)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
   *stream << "       value of l must be a power of 2" << std::endl;
+  *stream << "       if type is f, inverse FFT is computed in single precision" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+template <typename T>
+bool ComputeInverseFastFourierTransform(int fft_length,
+                                        InputFormats input_format,
+                                        OutputFormats output_format,
+                                        std::istream* input_stream) {
+  sptk::InverseFastFourierTransformBase<T> inverse_fast_fourier_transform(
+      fft_length);
+  if (!inverse_fast_fourier_transform.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "FFT length must be a power of 2";
+    sptk::PrintErrorMessage("ifft", error_message);
+    return false;
+  }
+
+  std::vector<T> input_x(fft_length);
+  std::vector<T> input_y(fft_length);
+  std::vector<T> output_x(fft_length);
+  std::vector<T> output_y(fft_length);
+
+  for (;;) {
+    if ((kInputRealAndImagParts == input_format ||
+         kInputRealPart == input_format) &&
+        !sptk::ReadStream(false, 0, 0, fft_length, &input_x, input_stream,
+                          NULL)) {
+      break;
+    }
+    if ((kInputRealAndImagParts == input_format ||
+         kInputImagPart == input_format) &&
+        !sptk::ReadStream(false, 0, 0, fft_length, &input_y, input_stream,
+                          NULL)) {
+      break;
+    }
+
+    if (!inverse_fast_fourier_transform.Run(input_x, input_y, &output_x,
+                                            &output_y)) {
+      std::ostringstream error_message;
+      error_message << "Failed to run inverse fast Fourier transform";
+      sptk::PrintErrorMessage("ifft", error_message);
+      return false;
+    }
+
+    if ((kOutputRealAndImagParts == output_format ||
+         kOutputRealPart == output_format) &&
+        !sptk::WriteStream(0, fft_length, output_x, &std::cout, NULL)) {
+      std::ostringstream error_message;
+      error_message << "Failed to write real parts";
+      sptk::PrintErrorMessage("ifft", error_message);
+      return false;
+    }
+
+    if ((kOutputRealAndImagParts == output_format ||
+         kOutputImagPart == output_format) &&
+        !sptk::WriteStream(0, fft_length, output_y, &std::cout, NULL)) {
+      std::ostringstream error_message;
+      error_message << "Failed to write imaginary parts";
+      sptk::PrintErrorMessage("ifft", error_message);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace
 
 /**
@@ -120,16 +190,22 @@ void PrintUsage(std::ostream* stream) {
  *     \arg \c 0 real and imaginary parts
  *     \arg \c 1 real part
  *     \arg \c 2 imaginary part
+ * - \b +type \e char
+ *   - data type
+ *     \arg \c f float
+ *     \arg \c d double
  * - \b infile \e str
- *   - double-type data sequence
+ *   - data sequence
  * - \b stdout
- *   - double-type inverse FFT sequence
+ *   - inverse FFT sequence
  *
  * @param[in] argc Number of arguments.
  * @param[in] argv Argument vector.
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   InputFormats input_format(kDefaultInputFormat);
   OutputFormats output_format(kDefaultOutputFormat);
@@ -189,14 +265,22 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  const int num_input_files(argc - optind);
-  if (1 < num_input_files) {
-    std::ostringstream error_message;
-    error_message << "Too many input files";
-    sptk::PrintErrorMessage("ifft", error_message);
-    return 1;
+  const char* input_file(NULL);
+  std::string data_type(kDefaultDataType);
+  for (int i(argc - optind); 1 <= i; --i) {
+    const char* arg(argv[argc - i]);
+    if (0 == std::strncmp(arg, "+", 1)) {
+      const std::string str(arg);
+      data_type = str.substr(1, std::string::npos);
+    } else if (NULL == input_file) {
+      input_file = arg;
+    } else {
+      std::ostringstream error_message;
+      error_message << "Too many input files";
+      sptk::PrintErrorMessage("ifft", error_message);
+      return 1;
+    }
   }
-  const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
   std::ifstream ifs;
   ifs.open(input_file, std::ios::in | std::ios::binary);
@@ -208,59 +292,19 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
-  sptk::InverseFastFourierTransform inverse_fast_fourier_transform(fft_length);
-  if (!inverse_fast_fourier_transform.IsValid()) {
+  bool is_succeeded;
+  if ("f" == data_type) {
+    is_succeeded = ComputeInverseFastFourierTransform<float>(
+        fft_length, input_format, output_format, &input_stream);
+  } else if ("d" == data_type) {
+    is_succeeded = ComputeInverseFastFourierTransform<double>(
+        fft_length, input_format, output_format, &input_stream);
+  } else {
     std::ostringstream error_message;
-    error_message << "FFT length must be a power of 2";
+    error_message << "Unexpected argument for the +type option";
     sptk::PrintErrorMessage("ifft", error_message);
     return 1;
   }
 
-  std::vector<double> input_x(fft_length);
-  std::vector<double> input_y(fft_length);
-  std::vector<double> output_x(fft_length);
-  std::vector<double> output_y(fft_length);
-
-  for (;;) {
-    if ((kInputRealAndImagParts == input_format ||
-         kInputRealPart == input_format) &&
-        !sptk::ReadStream(false, 0, 0, fft_length, &input_x, &input_stream,
-                          NULL)) {
-      break;
-    }
-    if ((kInputRealAndImagParts == input_format ||
-         kInputImagPart == input_format) &&
-        !sptk::ReadStream(false, 0, 0, fft_length, &input_y, &input_stream,
-                          NULL)) {
-      break;
-    }
-
-    if (!inverse_fast_fourier_transform.Run(input_x, input_y, &output_x,
-                                            &output_y)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run inverse fast Fourier transform";
-      sptk::PrintErrorMessage("ifft", error_message);
-      return 1;
-    }
-
-    if ((kOutputRealAndImagParts == output_format ||
-         kOutputRealPart == output_format) &&
-        !sptk::WriteStream(0, fft_length, output_x, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write real parts";
-      sptk::PrintErrorMessage("ifft", error_message);
-      return 1;
-    }
-
-    if ((kOutputRealAndImagParts == output_format ||
-         kOutputImagPart == output_format) &&
-        !sptk::WriteStream(0, fft_length, output_y, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write imaginary parts";
-      sptk::PrintErrorMessage("ifft", error_message);
-      return 1;
-    }
-  }
-
-  return 0;
+  return is_succeeded ? 0 : 1;
 }
@@ -57,6 +57,7 @@
 #include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/input/input_source_interpolation.h"
 #include "SPTK/normalizer/generalized_cepstrum_gain_normalization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -223,6 +224,8 @@ class InputSourcePreprocessingForMelCepstrum
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_filter_order(kDefaultNumFilterOrder);
   double alpha(kDefaultAlpha);
   int num_stage(kDefaultNumStage);
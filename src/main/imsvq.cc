@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/quantizer/inverse_multistage_vector_quantization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -83,6 +84,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   std::vector<char*> codebook_vectors_file;
 
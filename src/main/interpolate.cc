@@ -49,17 +49,30 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/filter/sample_rate_conversion.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
-enum OutputFormats { kPadWithZero = 0, kPadWithSameValue, kNumOutputFormats };
+enum OutputFormats {
+  kPadWithZero = 0,
+  kPadWithSameValue,
+  kLowpassFiltering,
+  kNumOutputFormats
+};
 
 const int kDefaultStartIndex(0);
 const int kDefaultVectorLength(1);
 const int kDefaultInterpolationPeriod(10);
 const OutputFormats kDefaultOutputFormat(kPadWithZero);
 
+// Parameters of the anti-imaging filter.
+const double kStopbandAttenuation(80.0);
+const double kTransitionWidth(0.1);
+
+const int kNumVectorInBlock(1024);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -72,14 +85,18 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -l l  : length of vector     (   int)[" << std::setw(5) << std::right << kDefaultVectorLength        << "][ 0 <  l <=   ]" << std::endl;  // NOLINT
   *stream << "       -m m  : order of vector      (   int)[" << std::setw(5) << std::right << "l-1"                       << "][ 0 <= m <=   ]" << std::endl;  // NOLINT
   *stream << "       -p p  : interpolation period (   int)[" << std::setw(5) << std::right << kDefaultInterpolationPeriod << "][ 0 <  p <=   ]" << std::endl;  // NOLINT
-  *stream << "       -o o  : output format        (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat        << "][ 0 <= o <= 1 ]" << std::endl;  // NOLINT
+  *stream << "       -o o  : output format        (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat        << "][ 0 <= o <= 2 ]" << std::endl;  // NOLINT
   *stream << "                 0 ( x(0), 0,    ..., x(1), 0,    ..., )" << std::endl;  // NOLINT
   *stream << "                 1 ( x(0), x(0), ..., x(1), x(1), ..., )" << std::endl;  // NOLINT
+  *stream << "                 2 ( x(0), x(1/p), ..., x(1), x(1+1/p), ..., )" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       data sequence                (double)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       interpolated data sequence   (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       if o = 2, each element of vector is lowpass filtered" << std::endl;  // NOLINT
+  *stream << "       after zero padding to remove images" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -89,6 +106,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_index(kDefaultStartIndex);
   int vector_length(kDefaultVectorLength);
   int interpolation_period(kDefaultInterpolationPeriod);
@@ -204,6 +223,66 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (kLowpassFiltering == output_format) {
+    sptk::SampleRateConversion sample_rate_conversion(
+        interpolation_period, 1, kStopbandAttenuation, kTransitionWidth);
+    if (!sample_rate_conversion.IsValid()) {
+      std::ostringstream error_message;
+      error_message << "Failed to initialize SampleRateConversion";
+      sptk::PrintErrorMessage("interpolate", error_message);
+      return 1;
+    }
+    std::vector<sptk::SampleRateConversion::Buffer> buffers(vector_length);
+
+    // Each element of vector is filtered as an independent sequence.
+    std::vector<double> block(kNumVectorInBlock * vector_length);
+    std::vector<double> input;
+    std::vector<double> output;
+    std::vector<double> rest_of_output;
+    std::vector<double> interpolated_block;
+    for (bool is_end_of_input(false); !is_end_of_input;) {
+      int num_read;
+      if (!sptk::ReadStream(false, 0, 0, kNumVectorInBlock * vector_length,
+                            &block, &input_stream, &num_read)) {
+        is_end_of_input = true;
+      }
+      const int num_vector(num_read / vector_length);
+
+      for (int i(0); i < vector_length; ++i) {
+        input.resize(num_vector);
+        for (int t(0); t < num_vector; ++t) {
+          input[t] = block[t * vector_length + i];
+        }
+        if (!sample_rate_conversion.Run(input, &output, &buffers[i]) ||
+            (is_end_of_input &&
+             !sample_rate_conversion.Flush(&rest_of_output, &buffers[i]))) {
+          std::ostringstream error_message;
+          error_message << "Failed to filter data sequence";
+          sptk::PrintErrorMessage("interpolate", error_message);
+          return 1;
+        }
+        if (is_end_of_input) {
+          output.insert(output.end(), rest_of_output.begin(),
+                        rest_of_output.end());
+        }
+        interpolated_block.resize(output.size() * vector_length);
+        for (int t(0); t < static_cast<int>(output.size()); ++t) {
+          interpolated_block[t * vector_length + i] = output[t];
+        }
+      }
+
+      if (!interpolated_block.empty() &&
+          !sptk::WriteStream(0, static_cast<int>(interpolated_block.size()),
+                             interpolated_block, &std::cout, NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write interpolated data sequence";
+        sptk::PrintErrorMessage("interpolate", error_message);
+        return 1;
+      }
+    }
+    return 0;
+  }
+
   while (sptk::ReadStream(false, 0, 0, vector_length, &data, &input_stream,
                           NULL)) {
     switch (output_format) {
@@ -51,6 +51,7 @@
 
 #include "SPTK/compressor/linde_buzo_gray_algorithm.h"
 #include "SPTK/math/statistics_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -62,6 +63,8 @@ const int kDefaultMinimumNumVectorInCluster(1);
 const int kDefaultNumIteration(1000);
 const double kDefaultConvergenceThreshold(1e-5);
 const double kDefaultSplittingFactor(1e-5);
+const bool kDefaultFastSearchFlag(false);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -79,6 +82,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "               initial codebook" << std::endl;
   *stream << "       -I I  : output filename of int type   (string)[" << std::setw(5) << std::right << "N/A"                             << "]" << std::endl;  // NOLINT
   *stream << "               codebook index" << std::endl;
+  *stream << "       -j j  : number of threads             (   int)[" << std::setw(5) << std::right << kDefaultNumThread                 << "][   1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "     (level 2)" << std::endl;
   *stream << "       -n n  : minimum number of vectors in  (   int)[" << std::setw(5) << std::right << kDefaultMinimumNumVectorInCluster << "][   0 <  n <=   ]" << std::endl;  // NOLINT
@@ -86,6 +90,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -i i  : maximum number of iterations  (   int)[" << std::setw(5) << std::right << kDefaultNumIteration              << "][   0 <  i <=   ]" << std::endl;  // NOLINT
   *stream << "       -d d  : convergence threshold         (double)[" << std::setw(5) << std::right << kDefaultConvergenceThreshold      << "][ 0.0 <= d <=   ]" << std::endl;  // NOLINT
   *stream << "       -r r  : splitting factor              (double)[" << std::setw(5) << std::right << kDefaultSplittingFactor           << "][ 0.0 <  r <=   ]" << std::endl;  // NOLINT
+  *stream << "       -f    : use fast nearest codeword     (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultFastSearchFlag) << "]" << std::endl;  // NOLINT
+  *stream << "               search" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       vectors                               (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
@@ -102,6 +108,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   int seed(kDefaultSeed);
   int target_codebook_size(kDefaultTargetCodebookSize);
@@ -111,10 +119,12 @@ int main(int argc, char* argv[]) {
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
   double splitting_factor(kDefaultSplittingFactor);
+  bool fast_search_flag(kDefaultFastSearchFlag);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "l:m:s:e:C:I:n:i:d:r:h", NULL, NULL));
+        getopt_long(argc, argv, "l:m:s:e:C:I:j:n:i:d:r:fh", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -169,6 +179,17 @@ int main(int argc, char* argv[]) {
         codebook_index_file = optarg;
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("lbg", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'n': {
         if (!sptk::ConvertStringToInteger(optarg,
                                           &minimum_num_vector_in_cluster) ||
@@ -214,6 +235,10 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'f': {
+        fast_search_flag = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -309,7 +334,7 @@ int main(int argc, char* argv[]) {
   sptk::LindeBuzoGrayAlgorithm codebook_designer(
       num_order, seed, codebook_vectors.size(), target_codebook_size,
       minimum_num_vector_in_cluster, num_iteration, convergence_threshold,
-      splitting_factor);
+      splitting_factor, fast_search_flag, num_thread);
   if (!codebook_designer.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set the condition for codebook design";
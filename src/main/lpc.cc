@@ -50,7 +50,10 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/waveform_to_autocorrelation.h"
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/math/levinson_durbin_recursion.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -60,6 +63,7 @@ enum WarningType { kIgnore = 0, kWarn, kExit, kNumWarningTypes };
 const int kDefaultFrameLength(256);
 const int kDefaultNumOrder(25);
 const WarningType kDefaultWarningType(kIgnore);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -76,6 +80,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 1 (output the index to stderr)" << std::endl;
   *stream << "                 2 (output the index to stderr and" << std::endl;
   *stream << "                    exit immediately)" << std::endl;
+  *stream << "       -j j  : number of threads                       (   int)[" << std::setw(5) << std::right << kDefaultNumThread   << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       windowed sequence                               (double)[stdin]" << std::endl;  // NOLINT
@@ -87,15 +92,63 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  FrameProcessor(
+      const sptk::WaveformToAutocorrelation& waveform_to_autocorrelation,
+      const sptk::LevinsonDurbinRecursion& levinson_durbin_recursion,
+      WarningType warning_type)
+      : waveform_to_autocorrelation_(waveform_to_autocorrelation),
+        levinson_durbin_recursion_(levinson_durbin_recursion),
+        warning_type_(warning_type) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    if (!waveform_to_autocorrelation_.Run(input, &autocorrelation_sequence_)) {
+      *message << "Failed to obtain autocorrelation sequence";
+      return false;
+    }
+
+    bool is_stable(false);
+    if (!levinson_durbin_recursion_.Run(autocorrelation_sequence_, output,
+                                        &is_stable, &buffer_)) {
+      *message << "Failed to solve autocorrelation normal equations";
+      return false;
+    }
+
+    if (!is_stable && kIgnore != warning_type_) {
+      *message << frame_index << "th frame is unstable";
+      if (kExit == warning_type_) return false;
+    }
+
+    return true;
+  }
+
+ private:
+  const sptk::WaveformToAutocorrelation& waveform_to_autocorrelation_;
+  const sptk::LevinsonDurbinRecursion& levinson_durbin_recursion_;
+  const WarningType warning_type_;
+
+  std::vector<double> autocorrelation_sequence_;
+  sptk::LevinsonDurbinRecursion::Buffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int frame_length(kDefaultFrameLength);
   int num_order(kDefaultNumOrder);
   WarningType warning_type(kDefaultWarningType);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:e:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "l:m:e:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -136,6 +189,17 @@ int main(int argc, char* argv[]) {
         warning_type = static_cast<WarningType>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("lpc", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -178,7 +242,6 @@ int main(int argc, char* argv[]) {
   }
 
   sptk::LevinsonDurbinRecursion levinson_durbin_recursion(num_order);
-  sptk::LevinsonDurbinRecursion::Buffer buffer;
   if (!levinson_durbin_recursion.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for Levinson-Durbin recursion";
@@ -186,47 +249,23 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  const int output_length(num_order + 1);
-  std::vector<double> windowed_sequence(frame_length);
-  std::vector<double> autocorrelation_sequence(output_length);
-  std::vector<double> linear_predictive_coefficients(output_length);
-
-  for (int frame_index(0); sptk::ReadStream(
-           false, 0, 0, frame_length, &windowed_sequence, &input_stream, NULL);
-       ++frame_index) {
-    if (!waveform_to_autocorrelation.Run(windowed_sequence,
-                                         &autocorrelation_sequence)) {
-      std::ostringstream error_message;
-      error_message << "Failed to obtain autocorrelation sequence";
-      sptk::PrintErrorMessage("lpc", error_message);
-      return 1;
-    }
-
-    bool is_stable(false);
-    if (!levinson_durbin_recursion.Run(autocorrelation_sequence,
-                                       &linear_predictive_coefficients,
-                                       &is_stable, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to solve autocorrelation normal equations";
-      sptk::PrintErrorMessage("lpc", error_message);
-      return 1;
-    }
-
-    if (!is_stable && kIgnore != warning_type) {
-      std::ostringstream error_message;
-      error_message << frame_index << "th frame is unstable";
-      sptk::PrintErrorMessage("lpc", error_message);
-      if (kExit == warning_type) return 1;
-    }
-
-    if (!sptk::WriteStream(0, output_length, linear_predictive_coefficients,
-                           &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write linear predictive coefficients";
-      sptk::PrintErrorMessage("lpc", error_message);
-      return 1;
-    }
+  sptk::InputSourceFromStream input_source(false, frame_length, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "lpc", "Failed to write linear predictive coefficients");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(new FrameProcessor(
+        waveform_to_autocorrelation, levinson_durbin_recursion, warning_type));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
@@ -53,6 +53,9 @@
 #include <vector>      // std::vector
 
 #include "SPTK/converter/linear_predictive_coefficients_to_line_spectral_pairs.h"
+#include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -79,6 +82,7 @@ const OutputFormats kDefaultOutputFormat(kNormalizedFrequencyInRadians);
 const int kDefaultNumSplit(256);
 const int kDefaultNumIteration(4);
 const double kDefaultConvergenceThreshold(1e-6);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -99,6 +103,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 1 (normalized frequency [0...1/2])" << std::endl;
   *stream << "                 2 (frequency [kHz])" << std::endl;
   *stream << "                 3 (frequency [Hz])" << std::endl;
+  *stream << "       -j j  : number of threads                       (   int)[" << std::setw(5) << std::right << kDefaultNumThread            << "][   1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "     (level 2)" << std::endl;
   *stream << "       -n n  : number of splits of unit circle         (   int)[" << std::setw(5) << std::right << kDefaultNumSplit             << "][   0 <  n <=   ]" << std::endl;  // NOLINT
@@ -114,9 +119,100 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  FrameProcessor(const sptk::LinearPredictiveCoefficientsToLineSpectralPairs&
+                     linear_predictive_coefficients_to_line_spectral_pairs,
+                 double sampling_frequency, OutputGainType output_gain_type,
+                 OutputFormats output_format)
+      : linear_predictive_coefficients_to_line_spectral_pairs_(
+            linear_predictive_coefficients_to_line_spectral_pairs),
+        sampling_frequency_(sampling_frequency),
+        output_gain_type_(output_gain_type),
+        output_format_(output_format) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    if (!linear_predictive_coefficients_to_line_spectral_pairs_.Run(
+            input, &line_spectral_pairs_, &buffer_)) {
+      *message << "Failed to transform linear predictive coefficients to "
+                  "line spectral pairs";
+      return false;
+    }
+
+    switch (output_format_) {
+      case kNormalizedFrequencyInRadians: {
+        std::transform(line_spectral_pairs_.begin() + 1,
+                       line_spectral_pairs_.end(),
+                       line_spectral_pairs_.begin() + 1,
+                       std::bind1st(std::multiplies<double>(), sptk::kTwoPi));
+        break;
+      }
+      case kNormalizedFrequencyInCycles: {
+        // nothing to do
+        break;
+      }
+      case kFrequecnyInkHz: {
+        std::transform(
+            line_spectral_pairs_.begin() + 1, line_spectral_pairs_.end(),
+            line_spectral_pairs_.begin() + 1,
+            std::bind1st(std::multiplies<double>(), sampling_frequency_));
+        break;
+      }
+      case kFrequecnyInHz: {
+        std::transform(line_spectral_pairs_.begin() + 1,
+                       line_spectral_pairs_.end(),
+                       line_spectral_pairs_.begin() + 1,
+                       std::bind1st(std::multiplies<double>(),
+                                    1000.0 * sampling_frequency_));
+        break;
+      }
+      default: { break; }
+    }
+
+    switch (output_gain_type_) {
+      case kLinearGain: {
+        // nothing to do
+        break;
+      }
+      case kLogGain: {
+        line_spectral_pairs_[0] = std::log(line_spectral_pairs_[0]);
+        break;
+      }
+      case kWithoutGain: {
+        // nothing to do
+        break;
+      }
+      default: { break; }
+    }
+
+    const int begin(kWithoutGain == output_gain_type_ ? 1 : 0);
+    output->assign(line_spectral_pairs_.begin() + begin,
+                   line_spectral_pairs_.end());
+
+    return true;
+  }
+
+ private:
+  const sptk::LinearPredictiveCoefficientsToLineSpectralPairs&
+      linear_predictive_coefficients_to_line_spectral_pairs_;
+  const double sampling_frequency_;
+  const OutputGainType output_gain_type_;
+  const OutputFormats output_format_;
+
+  std::vector<double> line_spectral_pairs_;
+  sptk::LinearPredictiveCoefficientsToLineSpectralPairs::Buffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double sampling_frequency(kDefaultSamplingFrequency);
   OutputGainType output_gain_type(kDefaultOutputGainType);
@@ -124,10 +220,11 @@ int main(int argc, char* argv[]) {
   int num_split(kDefaultNumSplit);
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "m:s:k:o:n:i:d:h", NULL, NULL));
+        getopt_long(argc, argv, "m:s:k:o:n:i:d:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -216,6 +313,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("lpc2lsp", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -252,7 +360,6 @@ int main(int argc, char* argv[]) {
   sptk::LinearPredictiveCoefficientsToLineSpectralPairs
       linear_predictive_coefficients_to_line_spectral_pairs(
           num_order, num_split, num_iteration, convergence_threshold);
-  sptk::LinearPredictiveCoefficientsToLineSpectralPairs::Buffer buffer;
   if (!linear_predictive_coefficients_to_line_spectral_pairs.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for transformation";
@@ -260,77 +367,24 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  const int length(num_order + 1);
-  const int write_size(kWithoutGain == output_gain_type ? num_order : length);
-  const int begin(kWithoutGain == output_gain_type ? 1 : 0);
-  std::vector<double> linear_predictive_coefficients(length);
-  std::vector<double> line_spectral_pairs(length);
-
-  while (sptk::ReadStream(false, 0, 0, length, &linear_predictive_coefficients,
-                          &input_stream, NULL)) {
-    if (!linear_predictive_coefficients_to_line_spectral_pairs.Run(
-            linear_predictive_coefficients, &line_spectral_pairs, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to transform linear predictive coefficients to "
-                       "line spectral pairs";
-      sptk::PrintErrorMessage("lpc2lsp", error_message);
-      return 1;
-    }
-
-    switch (output_format) {
-      case kNormalizedFrequencyInRadians: {
-        std::transform(line_spectral_pairs.begin() + 1,
-                       line_spectral_pairs.end(),
-                       line_spectral_pairs.begin() + 1,
-                       std::bind1st(std::multiplies<double>(), sptk::kTwoPi));
-        break;
-      }
-      case kNormalizedFrequencyInCycles: {
-        // nothing to do
-        break;
-      }
-      case kFrequecnyInkHz: {
-        std::transform(
-            line_spectral_pairs.begin() + 1, line_spectral_pairs.end(),
-            line_spectral_pairs.begin() + 1,
-            std::bind1st(std::multiplies<double>(), sampling_frequency));
-        break;
-      }
-      case kFrequecnyInHz: {
-        std::transform(line_spectral_pairs.begin() + 1,
-                       line_spectral_pairs.end(),
-                       line_spectral_pairs.begin() + 1,
-                       std::bind1st(std::multiplies<double>(),
-                                    1000.0 * sampling_frequency));
-        break;
-      }
-      default: { break; }
-    }
-
-    switch (output_gain_type) {
-      case kLinearGain: {
-        // nothing to do
-        break;
-      }
-      case kLogGain: {
-        line_spectral_pairs[0] = std::log(line_spectral_pairs[0]);
-        break;
-      }
-      case kWithoutGain: {
-        // nothing to do
-        break;
-      }
-      default: { break; }
-    }
-
-    if (!sptk::WriteStream(begin, write_size, line_spectral_pairs, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write line spectral pairs";
-      sptk::PrintErrorMessage("lpc2lsp", error_message);
-      return 1;
-    }
+  sptk::InputSourceFromStream input_source(false, num_order + 1, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "lpc2lsp", "Failed to write line spectral pairs");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(new FrameProcessor(
+        linear_predictive_coefficients_to_line_spectral_pairs,
+        sampling_frequency, output_gain_type, output_format));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
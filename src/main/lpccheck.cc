@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/linear_predictive_coefficients_stability_check.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -91,6 +92,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   WarningType warning_type(kDefaultWarningType);
   double margin(kDefaultMargin);
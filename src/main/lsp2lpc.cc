@@ -53,6 +53,7 @@
 #include <vector>      // std::vector
 
 #include "SPTK/converter/line_spectral_pairs_to_linear_predictive_coefficients.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -113,6 +114,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double sampling_frequency(kDefaultSamplingFrequency);
   InputGainType input_gain_type(kDefaultInputGainType);
@@ -52,6 +52,7 @@
 #include <sstream>     // std::ostringstream
 #include <vector>      // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/line_spectral_pairs_stability_check.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -127,6 +128,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double sampling_frequency(kDefaultSamplingFrequency);
   GainType gain_type(kDefaultGainType);
@@ -42,17 +42,19 @@
 // POSSIBILITY OF SUCH DAMAGE.                                       //
 // ----------------------------------------------------------------- //
 
-#include <getopt.h>  // getopt_long
-#include <fstream>   // std::ifstream
-#include <iomanip>   // std::setw
-#include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
-#include <sstream>   // std::ostringstream
-#include <vector>    // std::vector
+#include <getopt.h>    // getopt_long
+#include <fstream>     // std::ifstream
+#include <functional>  // std::function
+#include <iomanip>     // std::setw
+#include <iostream>    // std::cerr, std::cin, std::cout, std::endl, etc.
+#include <sstream>     // std::ostringstream
+#include <vector>      // std::vector
 
 #include "SPTK/filter/all_pole_lattice_digital_filter.h"
 #include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/input/input_source_interpolation.h"
 #include "SPTK/input/input_source_preprocessing_for_filter_gain.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -62,6 +64,9 @@ const int kDefaultFramePeriod(100);
 const int kDefaultInterpolationPeriod(1);
 const bool kDefaultGainFlag(true);
 
+// Number of samples filtered at once when the filter is time-invariant.
+const int kNumDataInBlock(8192);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -83,6 +88,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       filter output                        (double)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
   *stream << "       if i = 0, don't interpolate filter coefficients" << std::endl;  // NOLINT
+  *stream << "       if kfile has only one frame, filter input block by block" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -92,6 +98,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_filter_order(kDefaultNumFilterOrder);
   int frame_period(kDefaultFramePeriod);
   int interpolation_period(kDefaultInterpolationPeriod);
@@ -222,6 +230,41 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  // If the coefficient stream ended after its first frame while the input
+  // source was being prepared, the filter is time-invariant.
+  const bool is_time_invariant(
+      sptk::IsExhaustedAfterFirstFrame(stream_for_filter_coefficients));
+
+  if (is_time_invariant) {
+    if (!interpolation.Get(&filter_coefficients)) {
+      std::ostringstream error_message;
+      error_message << "Cannot get filter coefficients";
+      sptk::PrintErrorMessage("ltcdf", error_message);
+      return 1;
+    }
+
+    bool is_applied(true);
+    const std::function<bool(std::vector<double>*)> apply_filter(
+        [&](std::vector<double>* signals) {
+          is_applied =
+              filter.Run(filter_coefficients, *signals, signals, &buffer);
+          return is_applied;
+        });
+    if (!sptk::ProcessStreamInBlocks(kNumDataInBlock, apply_filter,
+                                     &stream_for_filter_input, &std::cout)) {
+      std::ostringstream error_message;
+      if (is_applied) {
+        error_message << "Failed to write a filter output";
+      } else {
+        error_message << "Failed to apply all-pole lattice digital filter";
+      }
+      sptk::PrintErrorMessage("ltcdf", error_message);
+      return 1;
+    }
+
+    return 0;
+  }
+
   while (sptk::ReadStream(&filter_input, &stream_for_filter_input)) {
     if (!interpolation.Get(&filter_coefficients)) {
       std::ostringstream error_message;
@@ -43,19 +43,25 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>   // getopt_long
-#include <algorithm>  // std::sort
+#include <algorithm>  // std::min, std::min_element, std::nth_element
 #include <fstream>    // std::ifstream
 #include <iomanip>    // std::setw
 #include <iostream>   // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>    // std::ostringstream
+#include <thread>     // std::thread
 #include <vector>     // std::vector
 
+#include "SPTK/math/quantile_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/mapped_matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
 const int kDefaultVectorLength(1);
 const int kMagicNumberForEndOfFile(-1);
+const double kDefaultPercentile(50.0);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -68,49 +74,93 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -l l  : length of vector   (   int)[" << std::setw(5) << std::right << kDefaultVectorLength << "][ 1 <= l <=   ]" << std::endl;  // NOLINT
   *stream << "       -m m  : order of vector    (   int)[" << std::setw(5) << std::right << "l-1"                << "][ 0 <= m <=   ]" << std::endl;  // NOLINT
   *stream << "       -t t  : output interval    (   int)[" << std::setw(5) << std::right << "EOF"                << "][ 1 <= t <=   ]" << std::endl;  // NOLINT
+  *stream << "       -p p  : percentile         (double)[" << std::setw(5) << std::right << kDefaultPercentile   << "][ 0 <= p <= 100 ]" << std::endl;  // NOLINT
+  *stream << "       -s s  : compression of     (   int)[" << std::setw(5) << std::right << "N/A"                << "][ 1 <= s <=   ]" << std::endl;  // NOLINT
+  *stream << "               streaming sketch" << std::endl;
+  *stream << "       -j j  : number of threads  (   int)[" << std::setw(5) << std::right << kDefaultNumThread    << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       vectors                    (double)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       median                     (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       if -s option is given, percentiles are estimated in one pass" << std::endl;  // NOLINT
+  *stream << "       with bounded memory; otherwise they are calculated exactly" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
-bool OutputMedian(const std::vector<std::vector<double> >& input_vectors) {
-  const int num_vector(input_vectors.size());
-  const int half_num_vector(num_vector / 2);
-  const int vector_length(input_vectors[0].size());
+// Calculates the percentiles of the dimensions assigned to the given thread.
+// Between data points, the percentile is linearly interpolated.
+void CalculatePercentiles(const double* input_vectors, int num_vector,
+                          int vector_length, double percentile,
+                          int num_thread, int thread_index,
+                          std::vector<double>* percentiles) {
+  const double position(percentile / 100.0 * (num_vector - 1));
+  const int lower_index(std::min(static_cast<int>(position), num_vector - 1));
+  const double fraction(position - lower_index);
 
-  std::vector<double> vector_for_sort(num_vector);
-  for (int data_index(0); data_index < vector_length; ++data_index) {
-    for (int i(0); i < num_vector; ++i) {
-      vector_for_sort[i] = input_vectors[i][data_index];
+  std::vector<double> vector_for_selection(num_vector);
+  for (int data_index(thread_index); data_index < vector_length;
+       data_index += num_thread) {
+    const double* input(input_vectors + data_index);
+    for (int i(0); i < num_vector; ++i, input += vector_length) {
+      vector_for_selection[i] = *input;
     }
-    std::sort(vector_for_sort.begin(), vector_for_sort.end());
-    const double median(0 == num_vector % 2
-                            ? (vector_for_sort[half_num_vector - 1] +
-                               vector_for_sort[half_num_vector]) *
-                                  0.5
-                            : vector_for_sort[half_num_vector]);
-    if (!sptk::WriteStream(median, &std::cout)) {
-      return false;
+    std::nth_element(vector_for_selection.begin(),
+                     vector_for_selection.begin() + lower_index,
+                     vector_for_selection.end());
+    const double lower(vector_for_selection[lower_index]);
+    if (0.0 == fraction) {
+      (*percentiles)[data_index] = lower;
+    } else {
+      // The next order statistic is the minimum of the upper partition.
+      const double upper(
+          *std::min_element(vector_for_selection.begin() + lower_index + 1,
+                            vector_for_selection.end()));
+      (*percentiles)[data_index] = (1.0 - fraction) * lower + fraction * upper;
     }
   }
+}
+
+bool OutputMedian(const double* input_vectors, int num_vector,
+                  int vector_length, double percentile, int num_thread) {
+  std::vector<double> percentiles(vector_length);
+  const int num_actual_thread(std::min(num_thread, vector_length));
+
+  // The calling thread works as the first worker.
+  std::vector<std::thread> threads;
+  for (int t(1); t < num_actual_thread; ++t) {
+    threads.push_back(std::thread(CalculatePercentiles, input_vectors,
+                                  num_vector, vector_length, percentile,
+                                  num_actual_thread, t, &percentiles));
+  }
+  CalculatePercentiles(input_vectors, num_vector, vector_length, percentile,
+                       num_actual_thread, 0, &percentiles);
+  for (std::vector<std::thread>::iterator itr(threads.begin());
+       itr != threads.end(); ++itr) {
+    itr->join();
+  }
 
-  return true;
+  return sptk::WriteStream(0, vector_length, percentiles, &std::cout, NULL);
 }
 
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kDefaultVectorLength);
   int output_interval(kMagicNumberForEndOfFile);
+  double percentile(kDefaultPercentile);
+  int compression(0);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:t:h", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "l:m:t:p:s:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -148,6 +198,39 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'p': {
+        if (!sptk::ConvertStringToDouble(optarg, &percentile) ||
+            !sptk::IsInRange(percentile, 0.0, 100.0)) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -p option must be a number "
+                        << "in the range of 0 to 100";
+          sptk::PrintErrorMessage("median", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 's': {
+        if (!sptk::ConvertStringToInteger(optarg, &compression) ||
+            compression <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -s option must be a positive integer";
+          sptk::PrintErrorMessage("median", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("median", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -169,6 +252,32 @@ int main(int argc, char* argv[]) {
   }
   const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
+  // Regular files are accessed through the mapped view without copying.
+  const bool uses_sketch(0 < compression);
+  if (NULL != input_file && !uses_sketch) {
+    const sptk::MappedMatrix<double> input_vectors(input_file, vector_length);
+    if (input_vectors.IsValid()) {
+      const int num_vector(input_vectors.GetNumRow());
+      const int num_median(kMagicNumberForEndOfFile == output_interval
+                               ? (0 < num_vector ? 1 : 0)
+                               : num_vector / output_interval);
+      const int num_vector_per_median(
+          kMagicNumberForEndOfFile == output_interval ? num_vector
+                                                      : output_interval);
+      for (int i(0); i < num_median; ++i) {
+        if (!OutputMedian(input_vectors[i * num_vector_per_median],
+                          num_vector_per_median, vector_length, percentile,
+                          num_thread)) {
+          std::ostringstream error_message;
+          error_message << "Failed to write median";
+          sptk::PrintErrorMessage("median", error_message);
+          return 1;
+        }
+      }
+      return 0;
+    }
+  }
+
   // open stream
   std::ifstream ifs;
   ifs.open(input_file, std::ios::in | std::ios::binary);
@@ -180,29 +289,89 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
-  std::vector<std::vector<double> > input_vectors;
+  if (uses_sketch) {
+    sptk::QuantileAccumulator accumulator(vector_length - 1, compression);
+    sptk::QuantileAccumulator::Buffer buffer;
+    if (!accumulator.IsValid()) {
+      std::ostringstream error_message;
+      error_message << "Failed to set condition for accumulation";
+      sptk::PrintErrorMessage("median", error_message);
+      return 1;
+    }
+
+    std::vector<double> data(vector_length);
+    std::vector<double> percentiles(vector_length);
+    for (int vector_index(1); sptk::ReadStream(false, 0, 0, vector_length,
+                                               &data, &input_stream, NULL);
+         ++vector_index) {
+      if (!accumulator.Run(data, &buffer)) {
+        std::ostringstream error_message;
+        error_message << "Failed to accumulate data";
+        sptk::PrintErrorMessage("median", error_message);
+        return 1;
+      }
+      if (kMagicNumberForEndOfFile != output_interval &&
+          0 == vector_index % output_interval) {
+        if (!accumulator.GetQuantile(buffer, percentile / 100.0,
+                                     &percentiles) ||
+            !sptk::WriteStream(0, vector_length, percentiles, &std::cout,
+                               NULL)) {
+          std::ostringstream error_message;
+          error_message << "Failed to write median";
+          sptk::PrintErrorMessage("median", error_message);
+          return 1;
+        }
+        accumulator.Clear(&buffer);
+      }
+    }
+
+    int num_vector;
+    if (!accumulator.GetNumData(buffer, &num_vector)) {
+      std::ostringstream error_message;
+      error_message << "Failed to accumulate data";
+      sptk::PrintErrorMessage("median", error_message);
+      return 1;
+    }
+    if (kMagicNumberForEndOfFile == output_interval && 0 < num_vector) {
+      if (!accumulator.GetQuantile(buffer, percentile / 100.0, &percentiles) ||
+          !sptk::WriteStream(0, vector_length, percentiles, &std::cout,
+                             NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write median";
+        sptk::PrintErrorMessage("median", error_message);
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  std::vector<double> input_vectors;
   if (kMagicNumberForEndOfFile != output_interval) {
-    input_vectors.reserve(output_interval);
+    input_vectors.reserve(output_interval * vector_length);
   }
   std::vector<double> data(vector_length);
-  for (int index(1);
-       sptk::ReadStream(false, 0, 0, vector_length, &data, &input_stream, NULL);
-       ++index) {
-    input_vectors.push_back(data);
+  int num_vector(0);
+  while (
+      sptk::ReadStream(false, 0, 0, vector_length, &data, &input_stream, NULL)) {
+    input_vectors.insert(input_vectors.end(), data.begin(), data.end());
+    ++num_vector;
     if (kMagicNumberForEndOfFile != output_interval &&
-        0 == index % output_interval) {
-      if (!OutputMedian(input_vectors)) {
+        output_interval == num_vector) {
+      if (!OutputMedian(&(input_vectors[0]), num_vector, vector_length,
+                        percentile, num_thread)) {
         std::ostringstream error_message;
         error_message << "Failed to write median";
         sptk::PrintErrorMessage("median", error_message);
         return 1;
       }
       input_vectors.clear();
+      num_vector = 0;
     }
   }
 
-  if (kMagicNumberForEndOfFile == output_interval && 0 < input_vectors.size()) {
-    if (!OutputMedian(input_vectors)) {
+  if (kMagicNumberForEndOfFile == output_interval && 0 < num_vector) {
+    if (!OutputMedian(&(input_vectors[0]), num_vector, vector_length,
+                      percentile, num_thread)) {
       std::ostringstream error_message;
       error_message << "Failed to write median";
       sptk::PrintErrorMessage("median", error_message);
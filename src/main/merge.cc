@@ -52,6 +52,7 @@
 #include <string>    // std::string
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
 #include "SPTK/utils/uint24_t.h"
@@ -234,6 +235,8 @@ class VectorMergeWrapper {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int insert_point(kDefaultInsertPoint);
   int input_length(kDefaultFrameLengthOfInputData);
   int insert_length(kDefaultFrameLengthOfInsertData);
@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/mel_generalized_cepstrum_to_mel_generalized_cepstrum.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -102,6 +103,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int input_num_order(kDefaultInputNumOrder);
   double input_alpha(kDefaultInputAlpha);
   double input_gamma(kDefaultInputGamma);
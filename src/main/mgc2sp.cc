@@ -53,6 +53,9 @@
 #include <vector>      // std::vector
 
 #include "SPTK/converter/mel_generalized_cepstrum_to_spectrum.h"
+#include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -75,6 +78,7 @@ const bool kDefaultNormalizationFlag(false);
 const bool kDefaultMultiplicationFlag(false);
 const int kDefaultFftLength(256);
 const OutputFormats kDefaultOutputFormat(kLogAmplitudeSpectrumInDecibels);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -100,6 +104,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 4 (arg|H(z)|/pi)" << std::endl;
   *stream << "                 5 (arg|H(z)|)" << std::endl;
   *stream << "                 6 (arg|H(z)|*180/pi)" << std::endl;
+  *stream << "       -j j  : number of threads                          (   int)[" << std::setw(5) << std::right << kDefaultNumThread    << "][    1 <= j <=     ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       mel-generalized cepstrum                           (double)[stdin]" << std::endl;  // NOLINT
@@ -114,9 +119,137 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  FrameProcessor(const sptk::MelGeneralizedCepstrumToSpectrum&
+                     mel_generalized_cepstrum_to_spectrum,
+                 double gamma, bool normalization_flag,
+                 bool multiplication_flag, int fft_length,
+                 OutputFormats output_format)
+      : mel_generalized_cepstrum_to_spectrum_(
+            mel_generalized_cepstrum_to_spectrum),
+        gamma_(gamma),
+        normalization_flag_(normalization_flag),
+        multiplication_flag_(multiplication_flag),
+        output_length_(fft_length / 2 + 1),
+        output_format_(output_format),
+        amplitude_spectrum_(fft_length),
+        phase_spectrum_(fft_length) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    // input modification
+    mel_generalized_cepstrum_ = input;
+    if (!normalization_flag_ && multiplication_flag_) {
+      (*mel_generalized_cepstrum_.begin()) =
+          (*(mel_generalized_cepstrum_.begin()) - 1.0) / gamma_;
+    }
+
+    // transform
+    if (!mel_generalized_cepstrum_to_spectrum_.Run(
+            mel_generalized_cepstrum_, &amplitude_spectrum_, &phase_spectrum_,
+            &buffer_)) {
+      *message << "Failed to transform mel-generalized ceptrum to spectrum";
+      return false;
+    }
+
+    switch (output_format_) {
+      case kLogAmplitudeSpectrumInDecibels: {
+        std::transform(amplitude_spectrum_.begin(),
+                       amplitude_spectrum_.begin() + output_length_,
+                       amplitude_spectrum_.begin(),
+                       std::bind1st(std::multiplies<double>(), sptk::kNeper));
+        break;
+      }
+      case kLogAmplitudeSpectrum: {
+        // nothing to do
+        break;
+      }
+      case kAmplitudeSpectrum: {
+        std::transform(amplitude_spectrum_.begin(),
+                       amplitude_spectrum_.begin() + output_length_,
+                       amplitude_spectrum_.begin(),
+                       std::ptr_fun<double, double>(std::exp));
+        break;
+      }
+      case kPowerSpectrum: {
+        std::transform(amplitude_spectrum_.begin(),
+                       amplitude_spectrum_.begin() + output_length_,
+                       amplitude_spectrum_.begin(),
+                       std::ptr_fun<double, double>(
+                           [](double x) { return std::exp(2.0 * x); }));
+        break;
+      }
+      case kPhaseSpectrumInNormalizedRadians: {
+        std::transform(
+            phase_spectrum_.begin(), phase_spectrum_.begin() + output_length_,
+            phase_spectrum_.begin(),
+            std::bind1st(std::multiplies<double>(), 1.0 / sptk::kPi));
+        break;
+      }
+      case kPhaseSpectrumInRadians: {
+        // nothing to do
+        break;
+      }
+      case kPhaseSpectrumInDegrees: {
+        std::transform(
+            phase_spectrum_.begin(), phase_spectrum_.begin() + output_length_,
+            phase_spectrum_.begin(),
+            std::bind1st(std::multiplies<double>(), 180.0 / sptk::kPi));
+        break;
+      }
+      default: { break; }
+    }
+
+    switch (output_format_) {
+      case kLogAmplitudeSpectrumInDecibels:
+      case kLogAmplitudeSpectrum:
+      case kAmplitudeSpectrum:
+      case kPowerSpectrum: {
+        output->assign(amplitude_spectrum_.begin(),
+                       amplitude_spectrum_.begin() + output_length_);
+        break;
+      }
+      case kPhaseSpectrumInNormalizedRadians:
+      case kPhaseSpectrumInRadians:
+      case kPhaseSpectrumInDegrees: {
+        output->assign(phase_spectrum_.begin(),
+                       phase_spectrum_.begin() + output_length_);
+        break;
+      }
+      default: {
+        output->clear();
+        break;
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  const sptk::MelGeneralizedCepstrumToSpectrum&
+      mel_generalized_cepstrum_to_spectrum_;
+  const double gamma_;
+  const bool normalization_flag_;
+  const bool multiplication_flag_;
+  const int output_length_;
+  const OutputFormats output_format_;
+
+  std::vector<double> mel_generalized_cepstrum_;
+  std::vector<double> amplitude_spectrum_;
+  std::vector<double> phase_spectrum_;
+  sptk::MelGeneralizedCepstrumToSpectrum::Buffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double alpha(kDefaultAlpha);
   double gamma(kDefaultGamma);
@@ -124,10 +257,11 @@ int main(int argc, char* argv[]) {
   bool multiplication_flag(kDefaultMultiplicationFlag);
   int fft_length(kDefaultFftLength);
   OutputFormats output_format(kDefaultOutputFormat);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "m:a:g:c:nul:o:h", NULL, NULL));
+        getopt_long(argc, argv, "m:a:g:c:nul:o:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -208,6 +342,17 @@ int main(int argc, char* argv[]) {
         output_format = static_cast<OutputFormats>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("mgc2sp", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -251,7 +396,6 @@ int main(int argc, char* argv[]) {
   sptk::MelGeneralizedCepstrumToSpectrum mel_generalized_cepstrum_to_spectrum(
       num_order, alpha, gamma, normalization_flag, multiplication_flag,
       fft_length);
-  sptk::MelGeneralizedCepstrumToSpectrum::Buffer buffer;
   if (!mel_generalized_cepstrum_to_spectrum.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for transformation";
@@ -260,107 +404,26 @@ int main(int argc, char* argv[]) {
   }
 
   const int input_length(num_order + 1);
-  const int output_length(fft_length / 2 + 1);
-  std::vector<double> mel_generalized_cepstrum(input_length);
-  std::vector<double> amplitude_spectrum(fft_length);
-  std::vector<double> phase_spectrum(fft_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &mel_generalized_cepstrum,
-                          &input_stream, NULL)) {
-    // input modification
-    if (!normalization_flag && multiplication_flag) {
-      (*mel_generalized_cepstrum.begin()) =
-          (*(mel_generalized_cepstrum.begin()) - 1.0) / gamma;
-    }
-
-    // transform
-    if (!mel_generalized_cepstrum_to_spectrum.Run(mel_generalized_cepstrum,
-                                                  &amplitude_spectrum,
-                                                  &phase_spectrum, &buffer)) {
-      std::ostringstream error_message;
-      error_message
-          << "Failed to transform mel-generalized ceptrum to spectrum";
-      sptk::PrintErrorMessage("mgc2sp", error_message);
-      return 1;
-    }
-
-    switch (output_format) {
-      case kLogAmplitudeSpectrumInDecibels: {
-        std::transform(amplitude_spectrum.begin(),
-                       amplitude_spectrum.begin() + output_length,
-                       amplitude_spectrum.begin(),
-                       std::bind1st(std::multiplies<double>(), sptk::kNeper));
-        break;
-      }
-      case kLogAmplitudeSpectrum: {
-        // nothing to do
-        break;
-      }
-      case kAmplitudeSpectrum: {
-        std::transform(amplitude_spectrum.begin(),
-                       amplitude_spectrum.begin() + output_length,
-                       amplitude_spectrum.begin(),
-                       std::ptr_fun<double, double>(std::exp));
-        break;
-      }
-      case kPowerSpectrum: {
-        std::transform(amplitude_spectrum.begin(),
-                       amplitude_spectrum.begin() + output_length,
-                       amplitude_spectrum.begin(),
-                       std::ptr_fun<double, double>(
-                           [](double x) { return std::exp(2.0 * x); }));
-        break;
-      }
-      case kPhaseSpectrumInNormalizedRadians: {
-        std::transform(
-            phase_spectrum.begin(), phase_spectrum.begin() + output_length,
-            phase_spectrum.begin(),
-            std::bind1st(std::multiplies<double>(), 1.0 / sptk::kPi));
-        break;
-      }
-      case kPhaseSpectrumInRadians: {
-        // nothing to do
-        break;
-      }
-      case kPhaseSpectrumInDegrees: {
-        std::transform(
-            phase_spectrum.begin(), phase_spectrum.begin() + output_length,
-            phase_spectrum.begin(),
-            std::bind1st(std::multiplies<double>(), 180.0 / sptk::kPi));
-        break;
-      }
-      default: { break; }
-    }
-
-    switch (output_format) {
-      case kLogAmplitudeSpectrumInDecibels:
-      case kLogAmplitudeSpectrum:
-      case kAmplitudeSpectrum:
-      case kPowerSpectrum: {
-        if (!sptk::WriteStream(0, output_length, amplitude_spectrum, &std::cout,
-                               NULL)) {
-          std::ostringstream error_message;
-          error_message << "Failed to write amplitude spectrum";
-          sptk::PrintErrorMessage("mgc2sp", error_message);
-          return 1;
-        }
-        break;
-      }
-      case kPhaseSpectrumInNormalizedRadians:
-      case kPhaseSpectrumInRadians:
-      case kPhaseSpectrumInDegrees: {
-        if (!sptk::WriteStream(0, output_length, phase_spectrum, &std::cout,
-                               NULL)) {
-          std::ostringstream error_message;
-          error_message << "Failed to write phase spectrum";
-          sptk::PrintErrorMessage("mgc2sp", error_message);
-          return 1;
-        }
-        break;
-      }
-      default: { break; }
-    }
+  sptk::InputSourceFromStream input_source(false, input_length, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "mgc2sp", kPhaseSpectrumInNormalizedRadians <= output_format
+                    ? "Failed to write phase spectrum"
+                    : "Failed to write amplitude spectrum");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(new FrameProcessor(
+        mel_generalized_cepstrum_to_spectrum, gamma, normalization_flag,
+        multiplication_flag, fft_length, output_format));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
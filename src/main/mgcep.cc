@@ -55,7 +55,10 @@
 #include "SPTK/analyzer/mel_generalized_cepstral_analysis.h"
 #include "SPTK/converter/mel_cepstrum_to_mlsa_digital_filter_coefficients.h"
 #include "SPTK/converter/waveform_to_spectrum.h"
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/normalizer/generalized_cepstrum_gain_normalization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -85,6 +88,7 @@ const InputFormats kDefaultInputFormat(kWaveform);
 const OutputFormats kDefaultOutputFormat(kCepstrum);
 const int kDefaultNumIteration(10);
 const double kDefaultConvergenceThreshold(1e-3);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -115,6 +119,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -d d  : convergence threshold             (double)[" << std::setw(5) << std::right << kDefaultConvergenceThreshold << "][  0.0 <= d <=     ]" << std::endl;  // NOLINT
   *stream << "       -e e  : small value for calculating log   (double)[" << std::setw(5) << std::right << "N/A"                        << "][  0.0 <  e <=     ]" << std::endl;  // NOLINT
   *stream << "       -E E  : relative floor in decibels        (double)[" << std::setw(5) << std::right << "N/A"                        << "][      <= E <  0.0 ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads                 (   int)[" << std::setw(5) << std::right << kDefaultNumThread            << "][    1 <= j <=     ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       windowed data sequence or spectrum        (double)[stdin]" << std::endl;  // NOLINT
@@ -129,9 +134,112 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  FrameProcessor(
+      const sptk::WaveformToSpectrum& waveform_to_spectrum,
+      const sptk::MelGeneralizedCepstralAnalysis& analysis,
+      const sptk::MelCepstrumToMlsaDigitalFilterCoefficients&
+          mel_cepstrum_to_mlsa_digital_filter_coefficients,
+      const sptk::GeneralizedCepstrumGainNormalization&
+          generalized_cepstrum_gain_normalization,
+      InputFormats input_format, OutputFormats output_format, double alpha,
+      int fft_length)
+      : waveform_to_spectrum_(waveform_to_spectrum),
+        analysis_(analysis),
+        mel_cepstrum_to_mlsa_digital_filter_coefficients_(
+            mel_cepstrum_to_mlsa_digital_filter_coefficients),
+        generalized_cepstrum_gain_normalization_(
+            generalized_cepstrum_gain_normalization),
+        input_format_(input_format),
+        output_format_(output_format),
+        alpha_(alpha),
+        processed_input_(fft_length / 2 + 1) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    switch (input_format_) {
+      case kLogAmplitudeSpectrumInDecibels: {
+        std::transform(input.begin(), input.end(), processed_input_.begin(),
+                       [](double x) { return std::pow(10, 0.1 * x); });
+        break;
+      }
+      case kLogAmplitudeSpectrum: {
+        std::transform(input.begin(), input.end(), processed_input_.begin(),
+                       [](double x) { return std::exp(2.0 * x); });
+        break;
+      }
+      case kAmplitudeSpectrum: {
+        std::transform(input.begin(), input.end(), processed_input_.begin(),
+                       [](double x) { return x * x; });
+        break;
+      }
+      case kPeriodogram: {
+        std::copy(input.begin(), input.end(), processed_input_.begin());
+        break;
+      }
+      case kWaveform: {
+        if (!waveform_to_spectrum_.Run(input, &processed_input_,
+                                       &buffer_for_spectral_analysis_)) {
+          *message << "Failed to transform waveform to spectrum";
+          return false;
+        }
+        break;
+      }
+      default: { break; }
+    }
+
+    if (!analysis_.Run(processed_input_, output,
+                       &buffer_for_cepstral_analysis_)) {
+      *message << "Failed to run mel-generalized cepstral analysis";
+      return false;
+    }
+
+    if (0.0 != alpha_ &&
+        (kMlsaFilterCoefficients == output_format_ ||
+         kGainNormalizedMlsaFilterCoefficients == output_format_)) {
+      if (!mel_cepstrum_to_mlsa_digital_filter_coefficients_.Run(output)) {
+        *message << "Failed to convert to MLSA filter coefficients";
+        return false;
+      }
+    }
+
+    if (kGainNormalizedCepstrum == output_format_ ||
+        kGainNormalizedMlsaFilterCoefficients == output_format_) {
+      if (!generalized_cepstrum_gain_normalization_.Run(output)) {
+        *message << "Failed to normalize generalized cepstrum";
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  const sptk::WaveformToSpectrum& waveform_to_spectrum_;
+  const sptk::MelGeneralizedCepstralAnalysis& analysis_;
+  const sptk::MelCepstrumToMlsaDigitalFilterCoefficients&
+      mel_cepstrum_to_mlsa_digital_filter_coefficients_;
+  const sptk::GeneralizedCepstrumGainNormalization&
+      generalized_cepstrum_gain_normalization_;
+  const InputFormats input_format_;
+  const OutputFormats output_format_;
+  const double alpha_;
+
+  std::vector<double> processed_input_;
+  sptk::WaveformToSpectrum::Buffer buffer_for_spectral_analysis_;
+  sptk::MelGeneralizedCepstralAnalysis::Buffer buffer_for_cepstral_analysis_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double alpha(kDefaultAlpha);
   double gamma(kDefaultGamma);
@@ -142,10 +250,11 @@ int main(int argc, char* argv[]) {
   double convergence_threshold(kDefaultConvergenceThreshold);
   double epsilon_for_calculating_logarithms(0.0);
   double relative_floor_in_decibels(-DBL_MAX);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "m:a:g:c:l:q:o:i:d:e:E:h", NULL, NULL));
+        getopt_long(argc, argv, "m:a:g:c:l:q:o:i:d:e:E:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -278,6 +387,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("mgcep", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -314,7 +434,6 @@ int main(int argc, char* argv[]) {
       fft_length, fft_length,
       sptk::FilterCoefficientsToSpectrum::OutputFormats::kPowerSpectrum,
       epsilon_for_calculating_logarithms, relative_floor_in_decibels);
-  sptk::WaveformToSpectrum::Buffer buffer_for_spectral_analysis;
   if (!waveform_to_spectrum.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for spectral analysis";
@@ -325,7 +444,6 @@ int main(int argc, char* argv[]) {
   sptk::MelGeneralizedCepstralAnalysis analysis(fft_length, num_order, alpha,
                                                 gamma, num_iteration,
                                                 convergence_threshold);
-  sptk::MelGeneralizedCepstralAnalysis::Buffer buffer_for_cepstral_analysis;
   if (!analysis.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for cepstral analysis";
@@ -353,82 +471,26 @@ int main(int argc, char* argv[]) {
 
   const int input_length(kWaveform == input_format ? fft_length
                                                    : fft_length / 2 + 1);
-  const int output_length(num_order + 1);
-  std::vector<double> input(input_length);
-  std::vector<double> processed_input(fft_length / 2 + 1);
-  std::vector<double> output(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &input, &input_stream,
-                          NULL)) {
-    switch (input_format) {
-      case kLogAmplitudeSpectrumInDecibels: {
-        std::transform(input.begin(), input.end(), processed_input.begin(),
-                       [](double x) { return std::pow(10, 0.1 * x); });
-        break;
-      }
-      case kLogAmplitudeSpectrum: {
-        std::transform(input.begin(), input.end(), processed_input.begin(),
-                       [](double x) { return std::exp(2.0 * x); });
-        break;
-      }
-      case kAmplitudeSpectrum: {
-        std::transform(input.begin(), input.end(), processed_input.begin(),
-                       [](double x) { return x * x; });
-        break;
-      }
-      case kPeriodogram: {
-        std::copy(input.begin(), input.end(), processed_input.begin());
-        break;
-      }
-      case kWaveform: {
-        if (!waveform_to_spectrum.Run(input, &processed_input,
-                                      &buffer_for_spectral_analysis)) {
-          std::ostringstream error_message;
-          error_message << "Failed to transform waveform to spectrum";
-          sptk::PrintErrorMessage("mgcep", error_message);
-          return 1;
-        }
-        break;
-      }
-      default: { break; }
-    }
-
-    if (!analysis.Run(processed_input, &output,
-                      &buffer_for_cepstral_analysis)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run mel-generalized cepstral analysis";
-      sptk::PrintErrorMessage("mgcep", error_message);
-      return 1;
-    }
-
-    if (0.0 != alpha &&
-        (kMlsaFilterCoefficients == output_format ||
-         kGainNormalizedMlsaFilterCoefficients == output_format)) {
-      if (!mel_cepstrum_to_mlsa_digital_filter_coefficients.Run(&output)) {
-        std::ostringstream error_message;
-        error_message << "Failed to convert to MLSA filter coefficients";
-        sptk::PrintErrorMessage("mgcep", error_message);
-        return 1;
-      }
-    }
-
-    if (kGainNormalizedCepstrum == output_format ||
-        kGainNormalizedMlsaFilterCoefficients == output_format) {
-      if (!generalized_cepstrum_gain_normalization.Run(&output)) {
-        std::ostringstream error_message;
-        error_message << "Failed to normalize generalized cepstrum";
-        sptk::PrintErrorMessage("mgcep", error_message);
-        return 1;
-      }
-    }
-
-    if (!sptk::WriteStream(0, output_length, output, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write mel-generalized cepstrum";
-      sptk::PrintErrorMessage("mgcep", error_message);
-      return 1;
-    }
+  sptk::InputSourceFromStream input_source(false, input_length, &input_stream);
+  sptk::FrameParallelDriver frame_parallel_driver(
+      "mgcep", "Failed to write mel-generalized cepstrum");
+  std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+      frame_processors;
+  for (int i(0); i < num_thread; ++i) {
+    frame_processors.push_back(new FrameProcessor(
+        waveform_to_spectrum, analysis,
+        mel_cepstrum_to_mlsa_digital_filter_coefficients,
+        generalized_cepstrum_gain_normalization, input_format, output_format,
+        alpha, fft_length));
+  }
+  const bool is_succeeded(
+      frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+  for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+           iterator itr(frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    delete *itr;
   }
+  if (!is_succeeded) return 1;
 
   return 0;
 }
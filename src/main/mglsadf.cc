@@ -46,7 +46,7 @@
 #include <algorithm>   // std::transform
 #include <cmath>       // std::log
 #include <fstream>     // std::ifstream
-#include <functional>  // std::bind1st, std::multiplies
+#include <functional>  // std::bind1st, std::function, std::multiplies
 #include <iomanip>     // std::setw
 #include <iostream>    // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>     // std::ostringstream
@@ -57,6 +57,7 @@
 #include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/input/input_source_interpolation.h"
 #include "SPTK/normalizer/generalized_cepstrum_gain_normalization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -70,6 +71,9 @@ const int kDefaultNumPadeOrder(4);
 const bool kDefaultTranspositionFlag(false);
 const bool kDefaultGainFlag(true);
 
+// Number of samples filtered at once when the filter is time-invariant.
+const int kNumDataInBlock(8192);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -97,6 +101,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       if i = 0, don't interpolate filter coefficients" << std::endl;  // NOLINT
   *stream << "       if c = 0, MLSA filter is used" << std::endl;
   *stream << "       otherwise MGLSA filter is used and P is ignored" << std::endl;  // NOLINT
+  *stream << "       if mgcfile has only one frame, filter input block by block" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -223,6 +228,8 @@ class InputSourcePreprocessingForMelCepstrum
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_filter_order(kDefaultNumFilterOrder);
   double alpha(kDefaultAlpha);
   int num_stage(kDefaultNumStage);
@@ -395,6 +402,41 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  // If the coefficient stream ended after its first frame while the input
+  // source was being prepared, the filter is time-invariant.
+  const bool is_time_invariant(
+      sptk::IsExhaustedAfterFirstFrame(stream_for_filter_coefficients));
+
+  if (is_time_invariant) {
+    if (!interpolation.Get(&filter_coefficients)) {
+      std::ostringstream error_message;
+      error_message << "Cannot get filter coefficients";
+      sptk::PrintErrorMessage("mglsadf", error_message);
+      return 1;
+    }
+
+    bool is_applied(true);
+    const std::function<bool(std::vector<double>*)> apply_filter(
+        [&](std::vector<double>* signals) {
+          is_applied =
+              filter.Run(filter_coefficients, *signals, signals, &buffer);
+          return is_applied;
+        });
+    if (!sptk::ProcessStreamInBlocks(kNumDataInBlock, apply_filter,
+                                     &stream_for_filter_input, &std::cout)) {
+      std::ostringstream error_message;
+      if (is_applied) {
+        error_message << "Failed to write a filter output";
+      } else {
+        error_message << "Failed to apply MGLSA digital filter";
+      }
+      sptk::PrintErrorMessage("mglsadf", error_message);
+      return 1;
+    }
+
+    return 0;
+  }
+
   while (sptk::ReadStream(&filter_input, &stream_for_filter_input)) {
     if (!interpolation.Get(&filter_coefficients)) {
       std::ostringstream error_message;
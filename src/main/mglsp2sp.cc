@@ -53,6 +53,7 @@
 #include <vector>      // std::vector
 
 #include "SPTK/converter/mel_generalized_line_spectral_pairs_to_spectrum.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -133,6 +134,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   double alpha(kDefaultAlpha);
   double gamma(kDefaultGamma);
@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/math/minmax_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -158,6 +159,8 @@ bool WriteMinMaxValues(
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   int num_best(kDefaultNumBest);
   OutputFormats output_format(kDefaultOutputFormat);
@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/mlsa_digital_filter_stability_check.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -111,6 +112,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_filter_order(kDefaultNumFilterOrder);
   int fft_length(kDefaultFftLength);
   double alpha(kDefaultAlpha);
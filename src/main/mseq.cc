@@ -48,6 +48,7 @@
 #include <sstream>   // std::ostringstream
 
 #include "SPTK/generator/m_sequence_generation.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -76,6 +77,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int output_length(kMagicNumberForInfinity);
 
   for (;;) {
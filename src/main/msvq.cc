@@ -43,6 +43,7 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>  // getopt_long
+#include <cstddef>   // std::size_t
 #include <fstream>   // std::ifstream
 #include <iomanip>   // std::setw
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
@@ -50,12 +51,16 @@
 #include <vector>    // std::vector
 
 #include "SPTK/quantizer/multistage_vector_quantization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
 const int kDefaultNumOrder(25);
 
+// Number of vectors quantized at once.
+const int kBatchSize(256);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -83,6 +88,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
   std::vector<char*> codebook_vectors_file;
 
@@ -192,24 +199,67 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  std::vector<double> input_vector(length);
-  std::vector<int> codebook_index(num_stage);
-  while (sptk::ReadStream(false, 0, 0, length, &input_vector,
-                          &stream_for_input_vectors, NULL)) {
-    if (!multistage_vector_quantization.Run(input_vector, codebook_vectors,
-                                            &codebook_index, &buffer)) {
+  // build searchers of nearest codeword
+  std::vector<sptk::NearestCodewordSearch*> nearest_codeword_searches;
+  std::vector<const sptk::NearestCodewordSearch*> const_searches;
+  for (int i(0); i < num_stage; ++i) {
+    nearest_codeword_searches.push_back(
+        new sptk::NearestCodewordSearch(num_order));
+    const_searches.push_back(nearest_codeword_searches.back());
+  }
+  for (int i(0); i < num_stage; ++i) {
+    if (!nearest_codeword_searches[i]->SetCodebook(codebook_vectors[i])) {
+      for (int j(0); j < num_stage; ++j) {
+        delete nearest_codeword_searches[j];
+      }
       std::ostringstream error_message;
-      error_message << "Failed to quantize";
+      error_message << "Failed to set codebook " << codebook_vectors_file[i];
       sptk::PrintErrorMessage("msvq", error_message);
       return 1;
     }
-    if (!sptk::WriteStream(0, num_stage, codebook_index, &std::cout, NULL)) {
+  }
+
+  std::vector<std::vector<double> > input_vectors;
+  std::vector<std::vector<int> > codebook_indices;
+  std::vector<double> input_vector(length);
+  bool is_succeeded(true);
+  bool is_end(false);
+  while (is_succeeded && !is_end) {
+    input_vectors.clear();
+    while (input_vectors.size() < static_cast<std::size_t>(kBatchSize)) {
+      if (!sptk::ReadStream(false, 0, 0, length, &input_vector,
+                            &stream_for_input_vectors, NULL)) {
+        is_end = true;
+        break;
+      }
+      input_vectors.push_back(input_vector);
+    }
+    if (input_vectors.empty()) break;
+
+    if (!multistage_vector_quantization.Run(input_vectors, codebook_vectors,
+                                            const_searches, &codebook_indices,
+                                            &buffer)) {
       std::ostringstream error_message;
-      error_message << "Failed to write codebook index";
+      error_message << "Failed to quantize";
       sptk::PrintErrorMessage("msvq", error_message);
-      return 1;
+      is_succeeded = false;
+      break;
+    }
+    for (std::size_t i(0); i < codebook_indices.size(); ++i) {
+      if (!sptk::WriteStream(0, num_stage, codebook_indices[i], &std::cout,
+                             NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write codebook index";
+        sptk::PrintErrorMessage("msvq", error_message);
+        is_succeeded = false;
+        break;
+      }
     }
   }
 
-  return 0;
+  for (int i(0); i < num_stage; ++i) {
+    delete nearest_codeword_searches[i];
+  }
+
+  return is_succeeded ? 0 : 1;
 }
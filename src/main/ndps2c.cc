@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/converter/negative_derivative_of_phase_spectrum_to_cepstrum.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -83,6 +84,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   int num_order(kDefaultNumOrder);
 
@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/normalizer/filter_coefficient_normalization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -79,6 +80,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
 
   for (;;) {
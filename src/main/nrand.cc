@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 
 #include "SPTK/generator/normal_distributed_random_value_generation.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -84,6 +85,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int output_length(kMagicNumberForInfinity);
   int seed(kDefaultSeed);
   double mean(kDefaultMean);
@@ -53,6 +53,7 @@
 #include <vector>      // std::vector
 
 #include "SPTK/math/principal_component_analysis.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -61,6 +62,8 @@ const int kDefaultVectorLength(25);
 const int kDefaultNumPrincipalComponent(2);
 const int kDefaultNumIteration(10000);
 const double kDefaultConvergenceThreshold(1e-6);
+const sptk::PrincipalComponentAnalysis::Algorithms kDefaultAlgorithm(
+    sptk::PrincipalComponentAnalysis::Algorithms::kJacobi);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -75,6 +78,10 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -n n  : number of principal components (   int)[" << std::setw(5) << std::right << kDefaultNumPrincipalComponent << "][   1 <= n <= l ]" << std::endl;  // NOLINT
   *stream << "       -i i  : maximum number of iterations   (   int)[" << std::setw(5) << std::right << kDefaultNumIteration          << "][   1 <= i <=   ]" << std::endl;  // NOLINT
   *stream << "       -d d  : convergence threshold          (double)[" << std::setw(5) << std::right << kDefaultConvergenceThreshold  << "][ 0.0 <= d <=   ]" << std::endl;  // NOLINT
+  *stream << "       -a a  : algorithm                      (   int)[" << std::setw(5) << std::right << kDefaultAlgorithm             << "][   0 <= a <= 2 ]" << std::endl;  // NOLINT
+  *stream << "                 0 (Jacobi)" << std::endl;
+  *stream << "                 1 (Householder and QR)" << std::endl;
+  *stream << "                 2 (subspace iteration)" << std::endl;
   *stream << "       -v v  : output filename of double type (string)[" << std::setw(5) << std::right << "N/A"                         << "]" << std::endl;  // NOLINT
   *stream << "               eigenvalues and proportions" << std::endl;
   *stream << "       -h    : print this message" << std::endl;
@@ -91,14 +98,17 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kDefaultVectorLength);
   int num_principal_component(kDefaultNumPrincipalComponent);
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
+  sptk::PrincipalComponentAnalysis::Algorithms algorithm(kDefaultAlgorithm);
   const char* eigenvalues_file(NULL);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:n:i:d:v:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "l:m:n:i:d:a:v:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -158,6 +168,25 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'a': {
+        const int min(0);
+        const int max(
+            static_cast<int>(
+                sptk::PrincipalComponentAnalysis::Algorithms::kNumAlgorithms) -
+            1);
+        int tmp;
+        if (!sptk::ConvertStringToInteger(optarg, &tmp) ||
+            !sptk::IsInRange(tmp, min, max)) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -a option must be an integer "
+                        << "in the range of " << min << " to " << max;
+          sptk::PrintErrorMessage("pca", error_message);
+          return 1;
+        }
+        algorithm =
+            static_cast<sptk::PrincipalComponentAnalysis::Algorithms>(tmp);
+        break;
+      }
       case 'v': {
         eigenvalues_file = optarg;
         break;
@@ -217,7 +246,8 @@ int main(int argc, char* argv[]) {
 
   // prepare for principal component analysis
   sptk::PrincipalComponentAnalysis principal_component_analysis(
-      vector_length - 1, num_iteration, convergence_threshold);
+      vector_length - 1, num_iteration, convergence_threshold, algorithm,
+      num_principal_component);
   sptk::PrincipalComponentAnalysis::Buffer buffer;
   if (!principal_component_analysis.IsValid()) {
     std::ostringstream error_message;
@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 
 #include "SPTK/math/matrix.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -83,6 +84,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kDefaultVectorLength);
   int num_principal_component(kDefaultNumPrincipalComponent);
 
@@ -201,9 +204,19 @@ int main(int argc, char* argv[]) {
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
   sptk::Matrix input_vector(vector_length, 1);
+  sptk::Matrix centered_vector(vector_length, 1);
+  sptk::Matrix principal_component_score(num_principal_component, 1);
   while (sptk::ReadStream(&input_vector, &input_stream)) {
-    if (!sptk::WriteStream(eigenvector_matrix * (input_vector - mean_vector),
-                           &std::cout)) {
+    if (!sptk::Matrix::Subtract(input_vector, mean_vector, &centered_vector) ||
+        !sptk::Matrix::Multiply(eigenvector_matrix, centered_vector,
+                                &principal_component_score)) {
+      std::ostringstream error_message;
+      error_message << "Failed to calculate principal component scores";
+      sptk::PrintErrorMessage("pcas", error_message);
+      return 1;
+    }
+
+    if (!sptk::WriteStream(principal_component_score, &std::cout)) {
       std::ostringstream error_message;
       error_message << "Failed to write principal component scores";
       sptk::PrintErrorMessage("pcas", error_message);
@@ -44,15 +44,20 @@
 
 #include <getopt.h>  // getopt_long_only
 
-#include <algorithm>  // std::transform
-#include <cmath>      // std::log
-#include <fstream>    // std::ifstream
-#include <iomanip>    // std::setw
-#include <iostream>   // std::cerr, std::cin, std::cout, std::endl, etc.
-#include <sstream>    // std::ostringstream
-#include <vector>     // std::vector
+#include <algorithm>   // std::min, std::transform
+#include <cmath>       // std::log
+#include <fstream>     // std::ifstream
+#include <functional>  // std::cref
+#include <iomanip>     // std::setw
+#include <iostream>    // std::cerr, std::cin, std::cout, std::endl, etc.
+#include <sstream>     // std::ostringstream
+#include <thread>      // std::thread
+#include <vector>      // std::vector
 
 #include "SPTK/analyzer/pitch_extraction.h"
+#include "SPTK/analyzer/streaming_pitch_extraction.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/mapped_matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -62,6 +67,7 @@ enum LongOptions {
   kT1,
   kT2,
   kT3,
+  kStreaming,
 };
 
 enum OutputFormats { kPitch = 0, kF0, kLogF0, kNumOutputFormats };
@@ -77,6 +83,15 @@ const double kDefaultVoicingThresholdForSwipe(0.3);
 const double kDefaultVoicingThresholdForReaper(0.9);
 const double kDefaultVoicingThresholdForWorld(0.1);
 const OutputFormats kDefaultOutputFormat(kPitch);
+const int kDefaultNumThread(1);
+const bool kDefaultStreamingFlag(false);
+
+enum Statuses {
+  kSucceeded = 0,
+  kFailedToRead,
+  kFailedToExtract,
+  kFailedToWrite,
+};
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -85,6 +100,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << std::endl;
   *stream << "  usage:" << std::endl;
   *stream << "       pitch [ options ] [ infile ] > stdout" << std::endl;
+  *stream << "       pitch [ options ] infile1 infile2 ... > stdout" << std::endl;
   *stream << "  options:" << std::endl;
   *stream << "       -a a  : algorithm used for pitch      (   int)[" << std::setw(5) << std::right << kDefaultAlgorithm                 << "][    0 <= a <= 3     ]" << std::endl;  // NOLINT
   *stream << "               estimation" << std::endl;
@@ -106,6 +122,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 0 (1/F0)" << std::endl;
   *stream << "                 1 (F0)" << std::endl;
   *stream << "                 2 (log F0)" << std::endl;
+  *stream << "       -j j  : number of threads             (   int)[" << std::setw(5) << std::right << kDefaultNumThread                 << "][    1 <= j          ]" << std::endl;  // NOLINT
+  *stream << "       -streaming : streaming mode           (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultStreamingFlag) << "]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       waveform                              (double)[stdin]" << std::endl;  // NOLINT
@@ -114,17 +132,172 @@ void PrintUsage(std::ostream* stream) {
   *stream << "  notice:" << std::endl;
   *stream << "       if t is raised, the number of voiced frames increase in RAPT, REAPER, and WORLD" << std::endl;  // NOLINT
   *stream << "       if t is dropped, the number of voiced frames increase in SWIPE'" << std::endl;  // NOLINT
+  *stream << "       if multiple infiles are given, their pitch is output in the given order" << std::endl;  // NOLINT
+  *stream << "       -streaming is available only for RAPT and WORLD and processes infiles one by one" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+bool ReadWaveform(const char* input_file, std::vector<double>* waveform) {
+  // Regular files are loaded from the mapped view with a single allocation.
+  const sptk::MappedMatrix<double> mapped_waveform(input_file, 1);
+  if (NULL != input_file && mapped_waveform.IsValid()) {
+    const double* data(mapped_waveform.GetData());
+    waveform->assign(data, data + mapped_waveform.GetNumRow());
+    return true;
+  }
+
+  std::ifstream ifs;
+  ifs.open(input_file, std::ios::in | std::ios::binary);
+  if (ifs.fail() && NULL != input_file) {
+    return false;
+  }
+  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+
+  waveform->clear();
+  double tmp;
+  while (sptk::ReadStream(&tmp, &input_stream)) {
+    waveform->push_back(tmp);
+  }
+  return true;
+}
+
+void ConvertF0(OutputFormats output_format, double sampling_rate_in_hz,
+               std::vector<double>* f0) {
+  switch (output_format) {
+    case kPitch: {
+      std::transform(f0->begin(), f0->end(), f0->begin(),
+                     [sampling_rate_in_hz](double x) {
+                       return (0.0 < x) ? sampling_rate_in_hz / x : 0.0;
+                     });
+      break;
+    }
+    case kF0: {
+      // nothing to do
+      break;
+    }
+    case kLogF0: {
+      std::transform(f0->begin(), f0->end(), f0->begin(), [](double x) {
+        return (0.0 < x) ? std::log(x) : sptk::kLogZero;
+      });
+      break;
+    }
+    default: { break; }
+  }
+}
+
+struct WorkerState {
+  const sptk::PitchExtraction* pitch_extraction;
+  const std::vector<const char*>* input_files;
+  OutputFormats output_format;
+  double sampling_rate_in_hz;
+  int num_thread;
+  std::vector<std::vector<double> >* f0s;
+  std::vector<Statuses>* statuses;
+};
+
+// Extracts pitch from every num_thread-th file starting from thread_index.
+void ExtractPitch(const WorkerState& state, int thread_index) {
+  const int num_file(state.input_files->size());
+  std::vector<double> waveform;
+  for (int n(thread_index); n < num_file; n += state.num_thread) {
+    std::vector<double>& f0((*state.f0s)[n]);
+    if (!ReadWaveform((*state.input_files)[n], &waveform)) {
+      (*state.statuses)[n] = kFailedToRead;
+      continue;
+    }
+    if (waveform.empty()) {
+      (*state.statuses)[n] = kSucceeded;
+      continue;
+    }
+    if (!state.pitch_extraction->Run(waveform, &f0, NULL, NULL)) {
+      (*state.statuses)[n] = kFailedToExtract;
+      continue;
+    }
+    ConvertF0(state.output_format, state.sampling_rate_in_hz, &f0);
+    (*state.statuses)[n] = kSucceeded;
+  }
+}
+
+// Reads waveform chunk by chunk and writes pitch as soon as it is determined.
+Statuses ExtractPitchInStreaming(
+    const char* input_file, int chunk_size, OutputFormats output_format,
+    double sampling_rate_in_hz,
+    sptk::StreamingPitchExtraction* pitch_extraction) {
+  std::ifstream ifs;
+  ifs.open(input_file, std::ios::in | std::ios::binary);
+  if (ifs.fail() && NULL != input_file) {
+    return kFailedToRead;
+  }
+  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+
+  std::vector<double> waveform;
+  std::vector<double> f0;
+  std::vector<double> remaining_f0;
+  for (;;) {
+    int num_sample(0);
+    const bool is_last(!sptk::ReadStream(false, 0, 0, chunk_size, &waveform,
+                                         &input_stream, &num_sample));
+    waveform.resize(num_sample);
+    if (!pitch_extraction->Run(waveform, &f0)) {
+      return kFailedToExtract;
+    }
+    if (is_last) {
+      if (!pitch_extraction->Finish(&remaining_f0)) {
+        return kFailedToExtract;
+      }
+      f0.insert(f0.end(), remaining_f0.begin(), remaining_f0.end());
+    }
+
+    if (!f0.empty()) {
+      ConvertF0(output_format, sampling_rate_in_hz, &f0);
+      if (!sptk::WriteStream(0, f0.size(), f0, &std::cout, NULL)) {
+        return kFailedToWrite;
+      }
+      std::cout.flush();
+    }
+
+    if (is_last) break;
+  }
+
+  return kSucceeded;
+}
+
+bool CheckStatus(Statuses status, const char* input_file) {
+  switch (status) {
+    case kFailedToRead: {
+      std::ostringstream error_message;
+      error_message << "Cannot open file " << input_file;
+      sptk::PrintErrorMessage("pitch", error_message);
+      return false;
+    }
+    case kFailedToExtract: {
+      std::ostringstream error_message;
+      error_message << "Failed to extract pitch";
+      sptk::PrintErrorMessage("pitch", error_message);
+      return false;
+    }
+    case kFailedToWrite: {
+      std::ostringstream error_message;
+      error_message << "Failed to write pitch";
+      sptk::PrintErrorMessage("pitch", error_message);
+      return false;
+    }
+    default: {
+      return true;
+    }
+  }
+}
+
 }  // namespace
 
 /**
  * \a pitch [ \e option ] [ \e infile ]
  *
+ * \a pitch [ \e option ] \e infile1 \e infile2 ...
+ *
  * - \b -a \e int
  *   - algorithm used for pitch extraction
  *     \arg \c 0 RAPT
@@ -152,6 +325,10 @@ void PrintUsage(std::ostream* stream) {
  *     \arg \c 0 pitch (S / F0)
  *     \arg \c 1 F0
  *     \arg \c 2 log F0
+ * - \b -j \e int
+ *   - number of threads \f$(1 \le J)\f$
+ * - \b -streaming \e bool
+ *   - streaming mode (RAPT and WORLD only)
  * - \b infile \e str
  *   - double-type waveform
  * - \b stdout
@@ -165,11 +342,31 @@ void PrintUsage(std::ostream* stream) {
  *   pitch -s 16 -p 80 -L 80 -H 200 -o 1 < data.d > data.f0
  * @endcode
  *
+ * If multiple input files are given, they are processed by \f$J\f$ threads and
+ * their pitch is output in the given order.
+ *
+ * @code{.sh}
+ *   pitch -s 16 -p 80 -j 4 data1.d data2.d data3.d > data.f0
+ * @endcode
+ *
+ * In the streaming mode, the waveform is read frame by frame and the pitch is
+ * written as soon as it is determined, so the memory usage does not depend on
+ * the length of the waveform. The output of RAPT is the same as the normal
+ * mode and is delayed by about 1.4 seconds at most. WORLD processes the
+ * waveform in overlapping segments and its output is delayed by about 0.75
+ * seconds.
+ *
+ * @code{.sh}
+ *   x2x +sd data.short | pitch -s 16 -p 80 -streaming > data.f0
+ * @endcode
+ *
  * @param[in] argc Number of arguments.
  * @param[in] argv Argument vector.
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   sptk::PitchExtraction::Algorithms algorithm(kDefaultAlgorithm);
   int frame_shift(kDefaultFrameShift);
   double sampling_rate(kDefaultSamplingRate);
@@ -180,18 +377,21 @@ int main(int argc, char* argv[]) {
       kDefaultVoicingThresholdForReaper, kDefaultVoicingThresholdForWorld,
   };
   OutputFormats output_format(kDefaultOutputFormat);
+  int num_thread(kDefaultNumThread);
+  bool streaming_flag(kDefaultStreamingFlag);
 
   const struct option long_options[] = {
       {"t0", required_argument, NULL, kT0},
       {"t1", required_argument, NULL, kT1},
       {"t2", required_argument, NULL, kT2},
       {"t3", required_argument, NULL, kT3},
+      {"streaming", no_argument, NULL, kStreaming},
       {0, 0, 0, 0},
   };
 
   for (;;) {
     const int option_char(
-        getopt_long_only(argc, argv, "a:p:s:L:H:o:h", long_options, NULL));
+        getopt_long_only(argc, argv, "a:p:s:L:H:o:j:h", long_options, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -333,6 +533,21 @@ int main(int argc, char* argv[]) {
         output_format = static_cast<OutputFormats>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("pitch", error_message);
+          return 1;
+        }
+        break;
+      }
+      case kStreaming: {
+        streaming_flag = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -361,23 +576,36 @@ int main(int argc, char* argv[]) {
   }
 
   const int num_input_files(argc - optind);
-  if (1 < num_input_files) {
-    std::ostringstream error_message;
-    error_message << "Too many input files";
-    sptk::PrintErrorMessage("pitch", error_message);
-    return 1;
+  std::vector<const char*> input_files;
+  if (0 == num_input_files) {
+    input_files.push_back(NULL);
+  } else {
+    for (int i(optind); i < argc; ++i) {
+      input_files.push_back(argv[i]);
+    }
   }
-  const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
-  std::ifstream ifs;
-  ifs.open(input_file, std::ios::in | std::ios::binary);
-  if (ifs.fail() && NULL != input_file) {
-    std::ostringstream error_message;
-    error_message << "Cannot open file " << input_file;
-    sptk::PrintErrorMessage("pitch", error_message);
-    return 1;
+  if (streaming_flag) {
+    sptk::StreamingPitchExtraction pitch_extraction(
+        frame_shift, sampling_rate_in_hz, lower_f0, upper_f0,
+        voicing_thresholds[algorithm], algorithm);
+    if (!pitch_extraction.IsValid()) {
+      std::ostringstream error_message;
+      error_message << "Failed to initialize StreamingPitchExtraction";
+      sptk::PrintErrorMessage("pitch", error_message);
+      return 1;
+    }
+
+    for (const char* input_file : input_files) {
+      if (!CheckStatus(
+              ExtractPitchInStreaming(input_file, frame_shift, output_format,
+                                      sampling_rate_in_hz, &pitch_extraction),
+              input_file)) {
+        return 1;
+      }
+    }
+    return 0;
   }
-  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
   sptk::PitchExtraction pitch_extraction(
       frame_shift, sampling_rate_in_hz, lower_f0, upper_f0,
@@ -389,49 +617,33 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  std::vector<double> waveform;
-  {
-    double tmp;
-    while (sptk::ReadStream(&tmp, &input_stream)) {
-      waveform.push_back(tmp);
-    }
+  // Extract pitch from the input files in parallel. The calling thread also
+  // works as the first worker.
+  const int num_file(input_files.size());
+  const int num_worker(std::min(num_thread, num_file));
+  std::vector<std::vector<double> > f0s(num_file);
+  std::vector<Statuses> statuses(num_file, kSucceeded);
+  const WorkerState state = {
+      &pitch_extraction, &input_files, output_format, sampling_rate_in_hz,
+      num_worker,        &f0s,         &statuses,
+  };
+  std::vector<std::thread> threads;
+  for (int t(1); t < num_worker; ++t) {
+    threads.push_back(std::thread(ExtractPitch, std::cref(state), t));
   }
-  if (waveform.empty()) return 0;
-
-  std::vector<double> f0;
-  if (!pitch_extraction.Run(waveform, &f0, NULL, NULL)) {
-    std::ostringstream error_message;
-    error_message << "Failed to extract pitch";
-    sptk::PrintErrorMessage("pitch", error_message);
-    return 1;
+  ExtractPitch(state, 0);
+  for (std::thread& thread : threads) {
+    thread.join();
   }
 
-  switch (output_format) {
-    case kPitch: {
-      std::transform(f0.begin(), f0.end(), f0.begin(),
-                     [sampling_rate_in_hz](double x) {
-                       return (0.0 < x) ? sampling_rate_in_hz / x : 0.0;
-                     });
-      break;
-    }
-    case kF0: {
-      // nothing to do
-      break;
+  for (int n(0); n < num_file; ++n) {
+    if (kSucceeded == statuses[n] && !f0s[n].empty() &&
+        !sptk::WriteStream(0, f0s[n].size(), f0s[n], &std::cout, NULL)) {
+      statuses[n] = kFailedToWrite;
     }
-    case kLogF0: {
-      std::transform(f0.begin(), f0.end(), f0.begin(), [](double x) {
-        return (0.0 < x) ? std::log(x) : sptk::kLogZero;
-      });
-      break;
+    if (!CheckStatus(statuses[n], input_files[n])) {
+      return 1;
     }
-    default: { break; }
-  }
-
-  if (!sptk::WriteStream(0, f0.size(), f0, &std::cout, NULL)) {
-    std::ostringstream error_message;
-    error_message << "Failed to write pitch";
-    sptk::PrintErrorMessage("pitch", error_message);
-    return 1;
   }
 
   return 0;
@@ -53,6 +53,7 @@
 #include <vector>     // std::vector
 
 #include "SPTK/analyzer/pitch_extraction.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -138,6 +139,8 @@ void PrintUsage(std::ostream* stream) {
  * @sa sptk::PitchExtraction
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   double sampling_rate(kDefaultSamplingRate);
   double lower_f0(kDefaultLowerF0);
   double upper_f0(kDefaultUpperF0);
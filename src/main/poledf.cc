@@ -44,16 +44,21 @@
 
 #include <getopt.h>  // getopt_long
 
-#include <fstream>   // std::ifstream
-#include <iomanip>   // std::setw
-#include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
-#include <sstream>   // std::ostringstream
-#include <vector>    // std::vector
+#include <cstring>     // std::strncmp
+#include <fstream>     // std::ifstream
+#include <functional>  // std::function
+#include <iomanip>     // std::setw
+#include <iostream>    // std::cerr, std::cin, std::cout, std::endl, etc.
+#include <sstream>     // std::ostringstream
+#include <string>      // std::string
+#include <vector>      // std::vector
 
 #include "SPTK/filter/all_pole_digital_filter.h"
 #include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/input/input_source_interface.h"
 #include "SPTK/input/input_source_interpolation.h"
 #include "SPTK/input/input_source_preprocessing_for_filter_gain.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -63,6 +68,10 @@ const int kDefaultFramePeriod(100);
 const int kDefaultInterpolationPeriod(1);
 const bool kDefaultTranspositionFlag(false);
 const bool kDefaultGainFlag(true);
+const char* kDefaultDataType("d");
+
+// Number of samples filtered at once when the filter is time-invariant.
+const int kNumDataInBlock(8192);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -77,21 +86,120 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -i i  : interpolation period         (   int)[" << std::setw(5) << std::right << kDefaultInterpolationPeriod << "][ 0 <= i <= p/2 ]" << std::endl;  // NOLINT
   *stream << "       -t    : transpose filter             (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultTranspositionFlag) << "]" << std::endl;  // NOLINT
   *stream << "       -k    : filtering without gain       (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(!kDefaultGainFlag)         << "]" << std::endl;  // NOLINT
+  *stream << "       +type : data type of input and output        [" << std::setw(5) << std::right << kDefaultDataType << "]" << std::endl;  // NOLINT
+  *stream << "                 "; sptk::PrintDataType("f", stream); sptk::PrintDataType("d", stream); *stream << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  afile:" << std::endl;
   *stream << "       filter (AR) coefficients             (double)" << std::endl;  // NOLINT
   *stream << "  infile:" << std::endl;
-  *stream << "       filter input                         (double)[stdin]" << std::endl;  // NOLINT
+  *stream << "       filter input                         (  type)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
-  *stream << "       filter output                        (double)" << std::endl;  // NOLINT
+  *stream << "       filter output                        (  type)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
   *stream << "       if i = 0, don't interpolate filter coefficients" << std::endl;  // NOLINT
+  *stream << "       if type is f, filtering is done in single precision" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+// The input source always gives filter coefficients in double precision.
+bool GetFilterCoefficients(sptk::InputSourceInterface* input_source,
+                           std::vector<double>* buffer,
+                           std::vector<double>* filter_coefficients) {
+  return input_source->Get(filter_coefficients);
+}
+
+bool GetFilterCoefficients(sptk::InputSourceInterface* input_source,
+                           std::vector<double>* buffer,
+                           std::vector<float>* filter_coefficients) {
+  if (!input_source->Get(buffer)) {
+    return false;
+  }
+  filter_coefficients->assign(buffer->begin(), buffer->end());
+  return true;
+}
+
+template <typename T>
+bool ApplyAllPoleDigitalFilter(int num_filter_order, bool transposition_flag,
+                               bool is_time_invariant,
+                               sptk::InputSourceInterface* input_source,
+                               std::istream* stream_for_filter_input) {
+  sptk::AllPoleDigitalFilterBase<T> filter(num_filter_order,
+                                           transposition_flag);
+  typename sptk::AllPoleDigitalFilterBase<T>::Buffer buffer;
+  if (!filter.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to initialize AllPoleDigitalFilter";
+    sptk::PrintErrorMessage("poledf", error_message);
+    return false;
+  }
+
+  const int filter_length(num_filter_order + 1);
+  std::vector<double> filter_coefficients_in_double(filter_length);
+  std::vector<T> filter_coefficients(filter_length);
+
+  if (is_time_invariant) {
+    if (!GetFilterCoefficients(input_source, &filter_coefficients_in_double,
+                               &filter_coefficients)) {
+      std::ostringstream error_message;
+      error_message << "Cannot get filter coefficients";
+      sptk::PrintErrorMessage("poledf", error_message);
+      return false;
+    }
+
+    bool is_applied(true);
+    const std::function<bool(std::vector<T>*)> apply_filter(
+        [&](std::vector<T>* signals) {
+          is_applied =
+              filter.Run(filter_coefficients, *signals, signals, &buffer);
+          return is_applied;
+        });
+    if (!sptk::ProcessStreamInBlocks(kNumDataInBlock, apply_filter,
+                                     stream_for_filter_input, &std::cout)) {
+      std::ostringstream error_message;
+      if (is_applied) {
+        error_message << "Failed to write a filter output";
+      } else {
+        error_message << "Failed to apply all-pole digital filter";
+      }
+      sptk::PrintErrorMessage("poledf", error_message);
+      return false;
+    }
+
+    return true;
+  }
+
+  T signal;
+
+  while (sptk::ReadStream(&signal, stream_for_filter_input)) {
+    if (!GetFilterCoefficients(input_source, &filter_coefficients_in_double,
+                               &filter_coefficients)) {
+      std::ostringstream error_message;
+      error_message << "Cannot get filter coefficients";
+      sptk::PrintErrorMessage("poledf", error_message);
+      return false;
+    }
+
+    if (!filter.Run(filter_coefficients, &signal, &buffer)) {
+      std::ostringstream error_message;
+      error_message << "Failed to apply all-pole digital filter";
+      sptk::PrintErrorMessage("poledf", error_message);
+      return false;
+    }
+
+    if (!sptk::WriteStream(signal, &std::cout)) {
+      std::ostringstream error_message;
+      error_message << "Failed to write a filter output";
+      sptk::PrintErrorMessage("poledf", error_message);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace
 
 /**
@@ -107,12 +215,16 @@ void PrintUsage(std::ostream* stream) {
  *   - transpose filter
  * - \b -k \e bool
  *   - filtering without gain \f$K\f$
+ * - \b +type \e char
+ *   - data type of input and output
+ *     \arg \c f float
+ *     \arg \c d double
  * - \b afile \e str
  *   - double-type LPC coefficients
  * - \b infile \e str
- *   - double-type input sequence
+ *   - input sequence
  * - \b stdout
- *   - double-type output sequence
+ *   - output sequence
  *
  * In the below example, an exciation signal generated from pitch information is
  * passed through the standard form synthesis filter built from LPC
@@ -122,11 +234,17 @@ void PrintUsage(std::ostream* stream) {
  *   excite < data.pitch | poledf data.lpc > data.syn
  * @endcode
  *
+ * If \e afile contains only one frame, the filter is regarded as time-invariant
+ * and the input sequence is filtered block by block. This also holds when
+ * \e afile is a pipe.
+ *
  * @param[in] argc Number of arguments.
  * @param[in] argv Argument vector.
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_filter_order(kDefaultNumFilterOrder);
   int frame_period(kDefaultFramePeriod);
   int interpolation_period(kDefaultInterpolationPeriod);
@@ -199,16 +317,24 @@ int main(int argc, char* argv[]) {
   }
 
   // Get input file names.
-  const char* filter_coefficients_file;
-  const char* filter_input_file;
-  const int num_input_files(argc - optind);
-  if (2 == num_input_files) {
-    filter_coefficients_file = argv[argc - 2];
-    filter_input_file = argv[argc - 1];
-  } else if (1 == num_input_files) {
-    filter_coefficients_file = argv[argc - 1];
-    filter_input_file = NULL;
-  } else {
+  const char* filter_coefficients_file(NULL);
+  const char* filter_input_file(NULL);
+  std::string data_type(kDefaultDataType);
+  bool has_too_many_input_files(false);
+  for (int i(argc - optind); 1 <= i; --i) {
+    const char* arg(argv[argc - i]);
+    if (0 == std::strncmp(arg, "+", 1)) {
+      const std::string str(arg);
+      data_type = str.substr(1, std::string::npos);
+    } else if (NULL == filter_coefficients_file) {
+      filter_coefficients_file = arg;
+    } else if (NULL == filter_input_file) {
+      filter_input_file = arg;
+    } else {
+      has_too_many_input_files = true;
+    }
+  }
+  if (NULL == filter_coefficients_file || has_too_many_input_files) {
     std::ostringstream error_message;
     error_message << "Just two input files, afile and infile, are required";
     sptk::PrintErrorMessage("poledf", error_message);
@@ -239,7 +365,6 @@ int main(int argc, char* argv[]) {
 
   // Prepare variables for filtering.
   const int filter_length(num_filter_order + 1);
-  std::vector<double> filter_coefficients(filter_length);
   sptk::InputSourceFromStream input_source(false, filter_length,
                                            &stream_for_filter_coefficients);
   sptk::InputSourceInterpolation interpolation(
@@ -258,39 +383,26 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  sptk::AllPoleDigitalFilter filter(num_filter_order, transposition_flag);
-  sptk::AllPoleDigitalFilter::Buffer buffer;
-  if (!filter.IsValid()) {
+  // If the coefficient stream ended after its first frame while the input
+  // source was being prepared, the filter is time-invariant.
+  const bool is_time_invariant(
+      sptk::IsExhaustedAfterFirstFrame(stream_for_filter_coefficients));
+
+  bool is_succeeded;
+  if ("f" == data_type) {
+    is_succeeded = ApplyAllPoleDigitalFilter<float>(
+        num_filter_order, transposition_flag, is_time_invariant,
+        &preprocessing, &stream_for_filter_input);
+  } else if ("d" == data_type) {
+    is_succeeded = ApplyAllPoleDigitalFilter<double>(
+        num_filter_order, transposition_flag, is_time_invariant,
+        &preprocessing, &stream_for_filter_input);
+  } else {
     std::ostringstream error_message;
-    error_message << "Failed to initialize AllPoleDigitalFilter";
+    error_message << "Unexpected argument for the +type option";
     sptk::PrintErrorMessage("poledf", error_message);
     return 1;
   }
 
-  double signal;
-
-  while (sptk::ReadStream(&signal, &stream_for_filter_input)) {
-    if (!preprocessing.Get(&filter_coefficients)) {
-      std::ostringstream error_message;
-      error_message << "Cannot get filter coefficients";
-      sptk::PrintErrorMessage("poledf", error_message);
-      return 1;
-    }
-
-    if (!filter.Run(filter_coefficients, &signal, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to apply all-pole digital filter";
-      sptk::PrintErrorMessage("poledf", error_message);
-      return 1;
-    }
-
-    if (!sptk::WriteStream(signal, &std::cout)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write a filter output";
-      sptk::PrintErrorMessage("poledf", error_message);
-      return 1;
-    }
-  }
-
-  return 0;
+  return is_succeeded ? 0 : 1;
 }
@@ -0,0 +1,282 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+
+#include <getopt.h>  // getopt_long
+
+#include <cmath>     // std::round
+#include <fstream>   // std::ifstream
+#include <iomanip>   // std::setw
+#include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
+#include <limits>    // std::numeric_limits
+#include <sstream>   // std::ostringstream
+#include <vector>    // std::vector
+
+#include "SPTK/filter/sample_rate_conversion.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace {
+
+const int kNumDataInBlock(4096);
+
+const double kDefaultInputSamplingRate(48.0);
+const double kDefaultOutputSamplingRate(16.0);
+const double kDefaultStopbandAttenuation(80.0);
+const double kDefaultTransitionWidth(0.1);
+
+void PrintUsage(std::ostream* stream) {
+  // clang-format off
+  *stream << std::endl;
+  *stream << " resample - sampling rate conversion" << std::endl;
+  *stream << std::endl;
+  *stream << "  usage:" << std::endl;
+  *stream << "       resample [ options ] [ infile ] > stdout" << std::endl;
+  *stream << "  options:" << std::endl;
+  *stream << "       -s s  : input sampling rate [kHz]  (double)[" << std::setw(5) << std::right << kDefaultInputSamplingRate   << "][ 0.0 <  s <=     ]" << std::endl;  // NOLINT
+  *stream << "       -r r  : output sampling rate [kHz] (double)[" << std::setw(5) << std::right << kDefaultOutputSamplingRate  << "][ 0.0 <  r <=     ]" << std::endl;  // NOLINT
+  *stream << "       -a a  : stopband attenuation [dB]  (double)[" << std::setw(5) << std::right << kDefaultStopbandAttenuation << "][ 0.0 <  a <=     ]" << std::endl;  // NOLINT
+  *stream << "       -w w  : relative transition width  (double)[" << std::setw(5) << std::right << kDefaultTransitionWidth     << "][ 0.0 <  w <= 1.0 ]" << std::endl;  // NOLINT
+  *stream << "       -h    : print this message" << std::endl;
+  *stream << "  infile:" << std::endl;
+  *stream << "       input sequence                     (double)[stdin]" << std::endl;  // NOLINT
+  *stream << "  stdout:" << std::endl;
+  *stream << "       resampled sequence                 (double)" << std::endl;  // NOLINT
+  *stream << "  notice:" << std::endl;
+  *stream << "       s and r are rounded to multiples of 1 Hz" << std::endl;
+  *stream << "       w is relative to the lower Nyquist frequency" << std::endl;
+  *stream << std::endl;
+  *stream << " SPTK: version " << sptk::kVersion << std::endl;
+  *stream << std::endl;
+  // clang-format on
+}
+
+}  // namespace
+
+/**
+ * \a resample [ \e option ] [ \e infile ]
+ *
+ * - \b -s \e double
+ *   - input sampling rate in kHz \f$(0 < F_s)\f$
+ * - \b -r \e double
+ *   - output sampling rate in kHz \f$(0 < F_r)\f$
+ * - \b -a \e double
+ *   - stopband attenuation of lowpass filter in dB \f$(0 < A)\f$
+ * - \b -w \e double
+ *   - transition width relative to the lower Nyquist frequency
+ *     \f$(0 < W \le 1)\f$
+ * - \b infile \e str
+ *   - double-type input sequence
+ * - \b stdout
+ *   - double-type resampled sequence
+ *
+ * The input is resampled by the rational factor \f$F_r/F_s\f$ with a
+ * polyphase FIR filter. The passband of the filter ends at \f$(1 - W)\f$ times
+ * the lower Nyquist frequency.
+ *
+ * In the below example, 44.1 kHz waveform is converted to 16 kHz.
+ *
+ * @code{.sh}
+ *   x2x +sd data.44k | resample -s 44.1 -r 16 | x2x +ds -r > data.16k
+ * @endcode
+ *
+ * @param[in] argc Number of arguments.
+ * @param[in] argv Argument vector.
+ * @return 0 on success, 1 on failure.
+ */
+int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
+  double input_sampling_rate(kDefaultInputSamplingRate);
+  double output_sampling_rate(kDefaultOutputSamplingRate);
+  double stopband_attenuation(kDefaultStopbandAttenuation);
+  double transition_width(kDefaultTransitionWidth);
+
+  for (;;) {
+    const int option_char(getopt_long(argc, argv, "s:r:a:w:h", NULL, NULL));
+    if (-1 == option_char) break;
+
+    switch (option_char) {
+      case 's': {
+        if (!sptk::ConvertStringToDouble(optarg, &input_sampling_rate) ||
+            input_sampling_rate <= 0.0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -s option must be a positive number";
+          sptk::PrintErrorMessage("resample", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'r': {
+        if (!sptk::ConvertStringToDouble(optarg, &output_sampling_rate) ||
+            output_sampling_rate <= 0.0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -r option must be a positive number";
+          sptk::PrintErrorMessage("resample", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'a': {
+        if (!sptk::ConvertStringToDouble(optarg, &stopband_attenuation) ||
+            stopband_attenuation <= 0.0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -a option must be a positive number";
+          sptk::PrintErrorMessage("resample", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'w': {
+        if (!sptk::ConvertStringToDouble(optarg, &transition_width) ||
+            transition_width <= 0.0 || 1.0 < transition_width) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -w option must be a number "
+                        << "in the range of (0.0, 1.0]";
+          sptk::PrintErrorMessage("resample", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'h': {
+        PrintUsage(&std::cout);
+        return 0;
+      }
+      default: {
+        PrintUsage(&std::cerr);
+        return 1;
+      }
+    }
+  }
+
+  // The sampling rates in Hz give the conversion factors.
+  const double input_sampling_rate_in_hz(std::round(input_sampling_rate * 1e3));
+  const double output_sampling_rate_in_hz(
+      std::round(output_sampling_rate * 1e3));
+  const double max_sampling_rate_in_hz(std::numeric_limits<int>::max());
+  if (input_sampling_rate_in_hz < 1.0 || output_sampling_rate_in_hz < 1.0 ||
+      max_sampling_rate_in_hz < input_sampling_rate_in_hz ||
+      max_sampling_rate_in_hz < output_sampling_rate_in_hz) {
+    std::ostringstream error_message;
+    error_message << "Sampling rates must be in the range of 1 Hz to "
+                  << max_sampling_rate_in_hz << " Hz";
+    sptk::PrintErrorMessage("resample", error_message);
+    return 1;
+  }
+
+  const int num_input_files(argc - optind);
+  if (1 < num_input_files) {
+    std::ostringstream error_message;
+    error_message << "Too many input files";
+    sptk::PrintErrorMessage("resample", error_message);
+    return 1;
+  }
+  const char* input_file(0 == num_input_files ? NULL : argv[optind]);
+
+  std::ifstream ifs;
+  ifs.open(input_file, std::ios::in | std::ios::binary);
+  if (ifs.fail() && NULL != input_file) {
+    std::ostringstream error_message;
+    error_message << "Cannot open file " << input_file;
+    sptk::PrintErrorMessage("resample", error_message);
+    return 1;
+  }
+  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+
+  sptk::SampleRateConversion sample_rate_conversion(
+      static_cast<int>(output_sampling_rate_in_hz),
+      static_cast<int>(input_sampling_rate_in_hz), stopband_attenuation,
+      transition_width);
+  sptk::SampleRateConversion::Buffer buffer;
+  if (!sample_rate_conversion.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to initialize SampleRateConversion";
+    sptk::PrintErrorMessage("resample", error_message);
+    return 1;
+  }
+
+  std::vector<double> input(kNumDataInBlock);
+  std::vector<double> output;
+  int num_input;
+
+  while (sptk::ReadStream(true, 0, 0, kNumDataInBlock, &input, &input_stream,
+                          &num_input)) {
+    input.resize(num_input);
+    if (!sample_rate_conversion.Run(input, &output, &buffer)) {
+      std::ostringstream error_message;
+      error_message << "Failed to resample";
+      sptk::PrintErrorMessage("resample", error_message);
+      return 1;
+    }
+    if (!output.empty() &&
+        !sptk::WriteStream(0, static_cast<int>(output.size()), output,
+                           &std::cout, NULL)) {
+      std::ostringstream error_message;
+      error_message << "Failed to write resampled sequence";
+      sptk::PrintErrorMessage("resample", error_message);
+      return 1;
+    }
+    input.resize(kNumDataInBlock);
+  }
+
+  if (!sample_rate_conversion.Flush(&output, &buffer)) {
+    std::ostringstream error_message;
+    error_message << "Failed to resample";
+    sptk::PrintErrorMessage("resample", error_message);
+    return 1;
+  }
+  if (!output.empty() &&
+      !sptk::WriteStream(0, static_cast<int>(output.size()), output,
+                         &std::cout, NULL)) {
+    std::ostringstream error_message;
+    error_message << "Failed to write resampled sequence";
+    sptk::PrintErrorMessage("resample", error_message);
+    return 1;
+  }
+
+  return 0;
+}
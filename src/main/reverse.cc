@@ -50,6 +50,7 @@
 #include <sstream>    // std::ostringstream
 #include <vector>     // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -78,6 +79,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int block_length(0);
 
   for (;;) {
@@ -50,6 +50,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/math/reverse_levinson_durbin_recursion.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -80,6 +81,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_order(kDefaultNumOrder);
 
   for (;;) {
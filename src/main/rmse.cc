@@ -51,6 +51,7 @@
 #include <vector>    // std::vector
 
 #include "SPTK/math/statistics_accumulator.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -88,6 +89,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kMagicNumberForEndOfFile);
   double magic_number(0.0);
   bool use_magic_number(kDefaultUseMagicNumber);
@@ -44,14 +44,22 @@
 
 #include <getopt.h>  // getopt_long_only
 #include <fstream>   // std::ifstream
+#include <iomanip>   // std::setw
 #include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
 #include <sstream>   // std::ostringstream
+#include <vector>    // std::vector
 
 #include "SPTK/math/scalar_operation.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
+// Number of data read at once.
+const int kNumDataInBlock(4096);
+
+const bool kDefaultFastApproximationFlag(false);
+
 enum LongOptions {
   kABS = 1000,
   kINV,
@@ -123,6 +131,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -ATAN        : arctangent                          [    atan(x) ]" << std::endl;  // NOLINT
   *stream << "       -magic magic : remove magic number  (double)[  N/A][            ]" << std::endl;  // NOLINT
   *stream << "       -MAGIC MAGIC : replace magic number (double)[  N/A][      MAGIC ]" << std::endl;  // NOLINT
+  *stream << "       -f           : fast approximation   (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultFastApproximationFlag) << "][            ]" << std::endl;  // NOLINT
+  *stream << "                      of -LN, -LOG*, -EXP, -POW*, -SIN, -COS" << std::endl;  // NOLINT
   *stream << "       -h           : print this message" << std::endl;
   *stream << "" << std::endl;
   *stream << "       the following strings can be used as the argument of -a, -s, -m," << std::endl;  // NOLINT
@@ -145,6 +155,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       data sequence after operations      (double)" << std::endl;
   *stream << "  notice:" << std::endl;
   *stream << "       if -MAGIC is given before -magic is given, return error" << std::endl;  // NOLINT
+  *stream << "       error of fast approximation is less than 1e-9" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -154,7 +165,10 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   sptk::ScalarOperation scalar_operation;
+  bool uses_fast_approximation(kDefaultFastApproximationFlag);
 
   const struct option long_options[] = {
       {"ABS", no_argument, NULL, kABS},
@@ -187,8 +201,8 @@ int main(int argc, char* argv[]) {
   };
 
   for (;;) {
-    const int option_char(
-        getopt_long_only(argc, argv, "a:s:m:d:r:p:l:u:h", long_options, NULL));
+    const int option_char(getopt_long_only(
+        argc, argv, "a:s:m:d:r:p:l:u:fh", long_options, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -591,6 +605,10 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'f': {
+        uses_fast_approximation = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -623,16 +641,30 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
-  double number;
-  while (sptk::ReadStream(&number, &input_stream)) {
-    bool is_magic_number;
-    if (!scalar_operation.Run(&number, &is_magic_number)) {
+  std::vector<double> numbers(kNumDataInBlock);
+  bool is_magic_number[kNumDataInBlock];
+  int num_data;
+  while (sptk::ReadStream(true, 0, 0, kNumDataInBlock, &numbers,
+                          &input_stream, &num_data) &&
+         0 < num_data) {
+    if (!scalar_operation.Run(num_data, uses_fast_approximation, &numbers[0],
+                              is_magic_number)) {
       std::ostringstream error_message;
       error_message << "Failed to perform scalar operation";
       sptk::PrintErrorMessage("sopr", error_message);
       return 1;
     }
-    if (!is_magic_number && !sptk::WriteStream(number, &std::cout)) {
+
+    // Remove magic numbers.
+    int num_output_data(0);
+    for (int i(0); i < num_data; ++i) {
+      if (!is_magic_number[i]) {
+        numbers[num_output_data++] = numbers[i];
+      }
+    }
+
+    if (0 < num_output_data &&
+        !sptk::WriteStream(0, num_output_data, numbers, &std::cout, NULL)) {
       std::ostringstream error_message;
       error_message << "Failed to write data";
       sptk::PrintErrorMessage("sopr", error_message);
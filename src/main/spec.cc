@@ -52,6 +52,10 @@
 
 #include "SPTK/converter/filter_coefficients_to_spectrum.h"
 #include "SPTK/converter/waveform_to_spectrum.h"
+#include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/math/matrix.h"
+#include "SPTK/utils/binary_stream_buffer.h"
+#include "SPTK/utils/frame_parallel_driver.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -63,6 +67,7 @@ const double kDefaultEpsilonForCalculatingLogarithms(0.0);
 const double kDefaultRelativeFloorInDecibels(-DBL_MAX);
 const sptk::FilterCoefficientsToSpectrum::OutputFormats kDefaultOutputFormat(
     sptk::FilterCoefficientsToSpectrum::kLogAmplitudeSpectrumInDecibels);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -86,6 +91,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 1 (ln|H(z)|)" << std::endl;
   *stream << "                 2 (|H(z)|)" << std::endl;
   *stream << "                 3 (|H(z)|^2)" << std::endl;
+  *stream << "       -j j  : number of threads                      (   int)[" << std::setw(5) << std::right << kDefaultNumThread           << "][   1 <= j <=     ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       data sequence                                  (double)[stdin]" << std::endl;  // NOLINT
@@ -93,15 +99,66 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       spectrum                                       (double)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
   *stream << "       value of l must be a power of 2" << std::endl;
+  *stream << "       -j is valid only for data sequence input" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+class FrameProcessor
+    : public sptk::FrameParallelDriver::FrameProcessorInterface {
+ public:
+  explicit FrameProcessor(const sptk::WaveformToSpectrum& waveform_to_spectrum)
+      : waveform_to_spectrum_(waveform_to_spectrum) {
+  }
+
+  virtual bool Run(int frame_index, const std::vector<double>& input,
+                   std::vector<double>* output, std::ostringstream* message) {
+    if (!waveform_to_spectrum_.Run(input, output, &buffer_)) {
+      *message << "Failed to transform waveform to spectrum";
+      return false;
+    }
+    return true;
+  }
+
+  virtual bool RunChunk(const std::vector<std::vector<double> >& inputs,
+                        int num_frame,
+                        std::vector<std::vector<double> >* outputs) {
+    const int frame_length(waveform_to_spectrum_.GetFrameLength());
+    if (waveforms_.GetNumRow() != num_frame) {
+      waveforms_.Resize(num_frame, frame_length);
+    }
+    for (int i(0); i < num_frame; ++i) {
+      std::copy(inputs[i].begin(), inputs[i].end(), waveforms_[i]);
+    }
+
+    if (!waveform_to_spectrum_.Run(waveforms_, &spectra_, &buffer_)) {
+      return false;
+    }
+
+    const int output_length(spectra_.GetNumColumn());
+    for (int i(0); i < num_frame; ++i) {
+      (*outputs)[i].assign(spectra_[i], spectra_[i] + output_length);
+    }
+    return true;
+  }
+
+ private:
+  const sptk::WaveformToSpectrum& waveform_to_spectrum_;
+
+  sptk::Matrix waveforms_;
+  sptk::Matrix spectra_;
+  sptk::WaveformToSpectrum::Buffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameProcessor);
+};
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   int num_numerator_order(kDefaultNumNumeratorOrder);
   int num_denominator_order(kDefaultNumDenominatorOrder);
@@ -114,10 +171,11 @@ int main(int argc, char* argv[]) {
   double relative_floor_in_decibels(kDefaultRelativeFloorInDecibels);
   sptk::FilterCoefficientsToSpectrum::OutputFormats output_format(
       kDefaultOutputFormat);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "l:m:n:z:p:e:E:o:h", NULL, NULL));
+        getopt_long(argc, argv, "l:m:n:z:p:e:E:o:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -206,6 +264,17 @@ int main(int argc, char* argv[]) {
             static_cast<sptk::FilterCoefficientsToSpectrum::OutputFormats>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("spec", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -341,7 +410,6 @@ int main(int argc, char* argv[]) {
     sptk::WaveformToSpectrum waveform_to_spectrum(
         fft_length, fft_length, output_format,
         epsilon_for_calculating_logarithms, relative_floor_in_decibels);
-    sptk::WaveformToSpectrum::Buffer buffer;
     if (!waveform_to_spectrum.IsValid()) {
       std::ostringstream error_message;
       error_message << "Failed to set condition for transformation";
@@ -349,25 +417,22 @@ int main(int argc, char* argv[]) {
       return 1;
     }
 
-    const int output_length(fft_length / 2 + 1);
-    std::vector<double> waveform(fft_length);
-    std::vector<double> output(output_length);
-    while (sptk::ReadStream(true, 0, 0, fft_length, &waveform, &input_stream,
-                            NULL)) {
-      if (!waveform_to_spectrum.Run(waveform, &output, &buffer)) {
-        std::ostringstream error_message;
-        error_message << "Failed to transform waveform to spectrum";
-        sptk::PrintErrorMessage("spec", error_message);
-        return 1;
-      }
-
-      if (!sptk::WriteStream(0, output_length, output, &std::cout, NULL)) {
-        std::ostringstream error_message;
-        error_message << "Failed to write spectrum";
-        sptk::PrintErrorMessage("spec", error_message);
-        return 1;
-      }
+    sptk::InputSourceFromStream input_source(true, fft_length, &input_stream);
+    sptk::FrameParallelDriver frame_parallel_driver("spec",
+                                                    "Failed to write spectrum");
+    std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>
+        frame_processors;
+    for (int i(0); i < num_thread; ++i) {
+      frame_processors.push_back(new FrameProcessor(waveform_to_spectrum));
+    }
+    const bool is_succeeded(
+        frame_parallel_driver.Run(frame_processors, &input_source, &std::cout));
+    for (std::vector<sptk::FrameParallelDriver::FrameProcessorInterface*>::
+             iterator itr(frame_processors.begin());
+         itr != frame_processors.end(); ++itr) {
+      delete *itr;
     }
+    if (!is_succeeded) return 1;
   }
 
   return 0;
@@ -53,6 +53,7 @@
 #include <sstream>    // std::ostringstream
 #include <string>     // std::string
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
 #include "SPTK/utils/uint24_t.h"
@@ -221,6 +222,8 @@ class ByteSwapWrapper {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int start_address(kDefaultStartAddress);
   int start_offset_number(kDefaultStartOffsetNumber);
   int end_address(kDefaultEndAddress);
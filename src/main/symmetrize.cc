@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/data_symmetrizing.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -95,6 +96,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int fft_length(kDefaultFftLength);
   sptk::DataSymmetrizing::InputOutputFormats input_format(kDefaultInputFormat);
   sptk::DataSymmetrizing::InputOutputFormats output_format(
@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 
 #include "SPTK/math/matrix.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -80,6 +81,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int num_row(0);
   int num_column(0);
 
@@ -44,18 +44,35 @@
 
 #include <getopt.h>  // getopt_long
 
-#include <fstream>   // std::ifstream
-#include <iomanip>   // std::setw
-#include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
-#include <sstream>   // std::ostringstream
+#include <algorithm>  // std::copy
+#include <cstdint>    // int16_t, uint8_t
+#include <fstream>    // std::ifstream
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cerr, std::cin, std::cout, std::endl, etc.
+#include <sstream>    // std::ostringstream
+#include <vector>     // std::vector
 
 #include "SPTK/compressor/mu_law_compression.h"
+#include "SPTK/quantizer/uniform_quantization.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
 
+enum InputFormats { kDouble, kShort, kNumInputFormats };
+
+enum OutputFormats { kCompressedValue, kCode, kNumOutputFormats };
+
+const int kNumDataInBlock(4096);
+
+// The compressed value is quantized to an 8-bit code as quantize does.
+const int kNumBitOfCode(8);
+
 const double kDefaultAbsMaxValue(32768.0);
 const double kDefaultCompressionFactor(255);
+const InputFormats kDefaultInputFormat(kDouble);
+const OutputFormats kDefaultOutputFormat(kCompressedValue);
+const bool kDefaultFastApproximationFlag(false);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -67,11 +84,21 @@ void PrintUsage(std::ostream* stream) {
   *stream << "  options:" << std::endl;
   *stream << "       -v v  : absolute maximum of input (double)[" << std::setw(5) << std::right << kDefaultAbsMaxValue       << "][ 0.0 <  v <=   ]" << std::endl;  // NOLINT
   *stream << "       -u u  : compression factor        (double)[" << std::setw(5) << std::right << kDefaultCompressionFactor << "][ 0.0 <  u <=   ]" << std::endl;  // NOLINT
+  *stream << "       -q q  : input format              (   int)[" << std::setw(5) << std::right << kDefaultInputFormat       << "][   0 <= q <= 1 ]" << std::endl;  // NOLINT
+  *stream << "                 0 (double)" << std::endl;
+  *stream << "                 1 (short)" << std::endl;
+  *stream << "       -o o  : output format             (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat      << "][   0 <= o <= 1 ]" << std::endl;  // NOLINT
+  *stream << "                 0 (compressed value, double)" << std::endl;
+  *stream << "                 1 (8-bit code, unsigned char)" << std::endl;
+  *stream << "       -f    : fast approximation        (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultFastApproximationFlag) << "]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       input sequence                    (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
   *stream << "       compressed sequence               (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       integer inputs in [-min(v,32768), min(v,32768)] are not approximated" << std::endl;  // NOLINT
+  *stream << "       error of fast approximation is less than 1e-9 * v" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -87,10 +114,20 @@ void PrintUsage(std::ostream* stream) {
  *   - absolute maximum value of input \f$(0 < V)\f$
  * - \b -u \e double
  *   - compression factor \f$(0 < \mu)\f$
+ * - \b -q \e int
+ *   - input format
+ *     \arg \c 0 double
+ *     \arg \c 1 short
+ * - \b -o \e int
+ *   - output format
+ *     \arg \c 0 compressed value (double)
+ *     \arg \c 1 8-bit code (unsigned char)
+ * - \b -f \e bool
+ *   - approximate logarithms by vectorized polynomials
  * - \b infile \e str
- *   - double-type input data sequence
+ *   - double-type or short-type input data sequence
  * - \b stdout
- *   - double-type compressed data sequence
+ *   - double-type compressed data sequence or 8-bit code sequence
  *
  * In the below example, 16-bit data read from \c data.short is compressed to
  * 8-bit ulaw format.
@@ -99,16 +136,29 @@ void PrintUsage(std::ostream* stream) {
  *   x2x +sd data.short | ulaw | quantize > data.ulaw
  * @endcode
  *
+ * The same conversion is done directly as follows, except that the codes are
+ * written as unsigned char. Integer inputs are compressed via a table, and
+ * the results are identical to the above.
+ *
+ * @code{.sh}
+ *   ulaw -q 1 -o 1 data.short > data.ulaw
+ * @endcode
+ *
  * @param[in] argc Number of arguments.
  * @param[in] argv Argument vector.
  * @return 0 on success, 1 on failure.
  */
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   double abs_max_value(kDefaultAbsMaxValue);
   double compression_factor(kDefaultCompressionFactor);
+  InputFormats input_format(kDefaultInputFormat);
+  OutputFormats output_format(kDefaultOutputFormat);
+  bool uses_fast_approximation(kDefaultFastApproximationFlag);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "v:u:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "v:u:q:o:fh", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -134,6 +184,40 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'q': {
+        const int min(0);
+        const int max(static_cast<int>(kNumInputFormats) - 1);
+        int tmp;
+        if (!sptk::ConvertStringToInteger(optarg, &tmp) ||
+            !sptk::IsInRange(tmp, min, max)) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -q option must be an integer "
+                        << "in the range of " << min << " to " << max;
+          sptk::PrintErrorMessage("ulaw", error_message);
+          return 1;
+        }
+        input_format = static_cast<InputFormats>(tmp);
+        break;
+      }
+      case 'o': {
+        const int min(0);
+        const int max(static_cast<int>(kNumOutputFormats) - 1);
+        int tmp;
+        if (!sptk::ConvertStringToInteger(optarg, &tmp) ||
+            !sptk::IsInRange(tmp, min, max)) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -o option must be an integer "
+                        << "in the range of " << min << " to " << max;
+          sptk::PrintErrorMessage("ulaw", error_message);
+          return 1;
+        }
+        output_format = static_cast<OutputFormats>(tmp);
+        break;
+      }
+      case 'f': {
+        uses_fast_approximation = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -172,17 +256,61 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  double data;
+  sptk::UniformQuantization uniform_quantization(
+      abs_max_value, kNumBitOfCode,
+      sptk::UniformQuantization::QuantizationType::kMidRise);
+  if (kCode == output_format && !uniform_quantization.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to initialize UniformQuantization";
+    sptk::PrintErrorMessage("ulaw", error_message);
+    return 1;
+  }
+
+  std::vector<double> data(kNumDataInBlock);
+  std::vector<int16_t> short_data(kNumDataInBlock);
+  std::vector<uint8_t> codes(kNumDataInBlock);
+  int num_data;
+
+  for (;;) {
+    if (kShort == input_format) {
+      if (!sptk::ReadStream(true, 0, 0, kNumDataInBlock, &short_data,
+                            &input_stream, &num_data)) {
+        break;
+      }
+      std::copy(short_data.begin(), short_data.begin() + num_data,
+                data.begin());
+    } else {
+      if (!sptk::ReadStream(true, 0, 0, kNumDataInBlock, &data,
+                            &input_stream, &num_data)) {
+        break;
+      }
+    }
 
-  while (sptk::ReadStream(&data, &input_stream)) {
-    if (!mu_law_compression.Run(&data)) {
+    if (!mu_law_compression.Run(num_data, uses_fast_approximation,
+                                &data[0])) {
       std::ostringstream error_message;
       error_message << "Failed to compress";
       sptk::PrintErrorMessage("ulaw", error_message);
       return 1;
     }
 
-    if (!sptk::WriteStream(data, &std::cout)) {
+    bool is_written;
+    if (kCode == output_format) {
+      for (int i(0); i < num_data; ++i) {
+        int index;
+        if (!uniform_quantization.Run(data[i], &index)) {
+          std::ostringstream error_message;
+          error_message << "Failed to quantize";
+          sptk::PrintErrorMessage("ulaw", error_message);
+          return 1;
+        }
+        codes[i] = static_cast<uint8_t>(index);
+      }
+      is_written = sptk::WriteStream(0, num_data, codes, &std::cout, NULL);
+    } else {
+      is_written = sptk::WriteStream(0, num_data, data, &std::cout, NULL);
+    }
+    if (!is_written) {
       std::ostringstream error_message;
       error_message << "Failed to write compressed data";
       sptk::PrintErrorMessage("ulaw", error_message);
@@ -52,6 +52,7 @@
 #include <sstream>     // std::ostringstream
 #include <vector>      // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -128,6 +129,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kDefaultVectorLength);
   InputFormats input_format(kDefaultInputFormat);
   int operation_type(-1);
@@ -42,16 +42,23 @@
 // POSSIBILITY OF SUCH DAMAGE.                                       //
 // ----------------------------------------------------------------- //
 
-#include <getopt.h>  // getopt_long
-#include <cmath>     // std::sqrt
-#include <fstream>   // std::ifstream
-#include <iomanip>   // std::setw
-#include <iostream>  // std::cerr, std::cin, std::cout, std::endl, etc.
-#include <sstream>   // std::ostringstream
-#include <vector>    // std::vector
+#include <getopt.h>   // getopt_long
+#include <algorithm>  // std::copy, std::max, std::min
+#include <cmath>      // std::sqrt
+#include <cstring>    // std::strncmp
+#include <fstream>    // std::ifstream
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cerr, std::cin, std::cout, std::endl, etc.
+#include <sstream>    // std::ostringstream
+#include <string>     // std::string
+#include <thread>     // std::thread
+#include <vector>     // std::vector
 
+#include "SPTK/math/matrix.h"
+#include "SPTK/math/quantile_accumulator.h"
 #include "SPTK/math/statistics_accumulator.h"
 #include "SPTK/math/symmetric_matrix.h"
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -64,6 +71,7 @@ enum OutputFormats {
   kCorrelation,
   kPrecision,
   kMeanAndLowerAndUpperBounds,
+  kPercentile,
   kNumOutputFormats
 };
 
@@ -72,6 +80,17 @@ const int kDefaultVectorLength(1);
 const double kDefaultConfidenceLevel(95.0);
 const OutputFormats kDefaultOutputFormat(kMeanAndCovariance);
 const bool kDefaultOutputOnlyDiagonalElementsFlag(false);
+const double kDefaultPercentile(50.0);
+const int kDefaultCompression(100);
+const int kDefaultNumThread(1);
+const char* kDefaultDataType("d");
+
+// Number of vectors read at once per thread.
+const int kNumVectorInBlockPerThread(4096);
+
+// Minimum number of vectors assigned to a thread. Smaller blocks are
+// accumulated by fewer threads since starting a thread costs more than that.
+const int kMinNumVectorPerThread(2048);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -85,7 +104,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -m m  : order of vector      (   int)[" << std::setw(5) << std::right << "l-1"                   << "][ 0 <= m <=     ]" << std::endl;  // NOLINT
   *stream << "       -t t  : output interval      (   int)[" << std::setw(5) << std::right << "EOF"                   << "][ 1 <= t <=     ]" << std::endl;  // NOLINT
   *stream << "       -c c  : confidence level     (double)[" << std::setw(5) << std::right << kDefaultConfidenceLevel << "][ 0 <  c <  100 ]" << std::endl;  // NOLINT
-  *stream << "       -o o  : output format        (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat    << "][ 0 <= o <= 6   ]" << std::endl;  // NOLINT
+  *stream << "       -o o  : output format        (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat    << "][ 0 <= o <= 7   ]" << std::endl;  // NOLINT
   *stream << "                 0 (mean and covariance)" << std::endl;
   *stream << "                 1 (mean)" << std::endl;
   *stream << "                 2 (covariance)" << std::endl;
@@ -93,23 +112,125 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 4 (correlation)" << std::endl;
   *stream << "                 5 (precision)" << std::endl;
   *stream << "                 6 (mean and lower/upper bounds)" << std::endl;
+  *stream << "                 7 (percentile)" << std::endl;
   *stream << "       -d    : output only diagonal (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultOutputOnlyDiagonalElementsFlag) << "]" << std::endl;  // NOLINT
   *stream << "               elements" << std::endl;
+  *stream << "       -p p  : percentile           (double)[" << std::setw(5) << std::right << kDefaultPercentile      << "][ 0 <= p <= 100 ]" << std::endl;  // NOLINT
+  *stream << "       -s s  : compression of       (   int)[" << std::setw(5) << std::right << kDefaultCompression     << "][ 1 <= s <=     ]" << std::endl;  // NOLINT
+  *stream << "               percentile sketch" << std::endl;
+  *stream << "       -j j  : number of threads    (   int)[" << std::setw(5) << std::right << kDefaultNumThread       << "][ 1 <= j <=     ]" << std::endl;  // NOLINT
+  *stream << "       +type : data type of input           [" << std::setw(5) << std::right << kDefaultDataType        << "]" << std::endl;  // NOLINT
+  *stream << "                 "; sptk::PrintDataType("f", stream); sptk::PrintDataType("d", stream); *stream << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
-  *stream << "       vectors                      (double)[stdin]" << std::endl;
+  *stream << "       vectors                      (  type)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       statistics                   (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       statistics are always accumulated in double precision" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+// Memories owned by each thread.
+struct Shard {
+  sptk::Matrix data;
+  sptk::StatisticsAccumulator::Buffer buffer;
+  sptk::QuantileAccumulator::Buffer quantile_buffer;
+  char is_succeeded;
+};
+
+// Accumulates the statistics of the given vectors into the shard. The vectors
+// are gathered into a matrix to use the batched update. If the quantile
+// accumulator is given, the percentile sketch is updated instead.
+void AccumulateStatistics(
+    const sptk::StatisticsAccumulator* accumulator,
+    const sptk::QuantileAccumulator* quantile_accumulator,
+    const std::vector<std::vector<double> >* data, int begin, int end,
+    Shard* shard) {
+  shard->is_succeeded = 1;
+  if (NULL != quantile_accumulator) {
+    for (int i(begin); i < end; ++i) {
+      if (!quantile_accumulator->Run((*data)[i], &shard->quantile_buffer)) {
+        shard->is_succeeded = 0;
+        return;
+      }
+    }
+    return;
+  }
+
+  const int num_vector(end - begin);
+  const int vector_length(accumulator->GetNumOrder() + 1);
+  if (shard->data.GetNumRow() != num_vector ||
+      shard->data.GetNumColumn() != vector_length) {
+    shard->data.Resize(num_vector, vector_length);
+  }
+  for (int i(0); i < num_vector; ++i) {
+    std::copy((*data)[begin + i].begin(), (*data)[begin + i].end(),
+              shard->data[i]);
+  }
+  if (!accumulator->Run(shard->data, &shard->buffer)) {
+    shard->is_succeeded = 0;
+  }
+}
+
+// Splits the given vectors into contiguous shards, accumulates each of them in
+// a separate thread, and merges the results into the buffer in order. If the
+// number of vectors is small, only the calling thread is used.
+bool AccumulateStatisticsInParallel(
+    const sptk::StatisticsAccumulator& accumulator,
+    const sptk::QuantileAccumulator* quantile_accumulator,
+    const std::vector<std::vector<double> >& data, int num_data,
+    std::vector<Shard>* shards, sptk::StatisticsAccumulator::Buffer* buffer,
+    sptk::QuantileAccumulator::Buffer* quantile_buffer) {
+  const int num_thread(
+      std::max(1, std::min(static_cast<int>(shards->size()),
+                           num_data / kMinNumVectorPerThread)));
+  const int quotient(num_data / num_thread);
+  const int remainder(num_data % num_thread);
+  std::vector<std::thread> threads;
+  for (int t(0); t < num_thread; ++t) {
+    accumulator.Clear(&(*shards)[t].buffer);
+    if (NULL != quantile_accumulator) {
+      quantile_accumulator->Clear(&(*shards)[t].quantile_buffer);
+    }
+    if (0 == t) continue;
+    const int begin(quotient * t + std::min(t, remainder));
+    const int end(begin + quotient + (t < remainder ? 1 : 0));
+    threads.push_back(std::thread(AccumulateStatistics, &accumulator,
+                                  quantile_accumulator, &data, begin, end,
+                                  &(*shards)[t]));
+  }
+  // The calling thread works as the first worker.
+  AccumulateStatistics(&accumulator, quantile_accumulator, &data, 0,
+                       quotient + (0 < remainder ? 1 : 0), &(*shards)[0]);
+
+  bool result(true);
+  for (int t(0); t < num_thread; ++t) {
+    if (0 < t) threads[t - 1].join();
+    const Shard& shard((*shards)[t]);
+    if (0 == shard.is_succeeded) {
+      result = false;
+    } else if (NULL != quantile_accumulator) {
+      if (!quantile_accumulator->Merge(shard.quantile_buffer,
+                                       quantile_buffer)) {
+        result = false;
+      }
+    } else if (!accumulator.Merge(shard.buffer, buffer)) {
+      result = false;
+    }
+  }
+  return result;
+}
+
 bool OutputStatistics(const sptk::StatisticsAccumulator& accumulator,
                       const sptk::StatisticsAccumulator::Buffer& buffer,
+                      const sptk::QuantileAccumulator& quantile_accumulator,
+                      const sptk::QuantileAccumulator::Buffer& quantile_buffer,
                       int vector_length, OutputFormats output_format,
-                      double confidence_level,
+                      double confidence_level, double percentile,
                       bool outputs_only_diagonal_elements) {
   if (kMeanAndCovariance == output_format || kMean == output_format ||
       kMeanAndLowerAndUpperBounds == output_format) {
@@ -239,20 +360,48 @@ bool OutputStatistics(const sptk::StatisticsAccumulator& accumulator,
     }
   }
 
+  if (kPercentile == output_format) {
+    std::vector<double> quantile(vector_length);
+    if (!quantile_accumulator.GetQuantile(quantile_buffer, percentile / 100.0,
+                                          &quantile)) {
+      return false;
+    }
+    if (!sptk::WriteStream(0, vector_length, quantile, &std::cout, NULL)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Reads a float vector and converts it to double precision.
+bool ReadFloatVector(int vector_length, std::vector<float>* buffer,
+                     std::vector<double>* data, std::istream* input_stream) {
+  if (!sptk::ReadStream(false, 0, 0, vector_length, buffer, input_stream,
+                        NULL)) {
+    return false;
+  }
+  data->assign(buffer->begin(), buffer->end());
   return true;
 }
 
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int vector_length(kDefaultVectorLength);
   int output_interval(kMagicNumberForEndOfFile);
   double confidence_level(kDefaultConfidenceLevel);
   OutputFormats output_format(kDefaultOutputFormat);
   bool outputs_only_diagonal_elements(kDefaultOutputOnlyDiagonalElementsFlag);
+  double percentile(kDefaultPercentile);
+  int compression(kDefaultCompression);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:t:c:o:dh", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "l:m:t:c:o:dp:s:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -320,6 +469,39 @@ int main(int argc, char* argv[]) {
         outputs_only_diagonal_elements = true;
         break;
       }
+      case 'p': {
+        if (!sptk::ConvertStringToDouble(optarg, &percentile) ||
+            !sptk::IsInRange(percentile, 0.0, 100.0)) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -p option must be a number "
+                        << "in the range of 0 to 100";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 's': {
+        if (!sptk::ConvertStringToInteger(optarg, &compression) ||
+            compression <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -s option must be a positive integer";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -332,14 +514,28 @@ int main(int argc, char* argv[]) {
   }
 
   // get input file
-  const int num_input_files(argc - optind);
-  if (1 < num_input_files) {
+  const char* input_file(NULL);
+  std::string data_type(kDefaultDataType);
+  for (int i(argc - optind); 1 <= i; --i) {
+    const char* arg(argv[argc - i]);
+    if (0 == std::strncmp(arg, "+", 1)) {
+      const std::string str(arg);
+      data_type = str.substr(1, std::string::npos);
+    } else if (NULL == input_file) {
+      input_file = arg;
+    } else {
+      std::ostringstream error_message;
+      error_message << "Too many input files";
+      sptk::PrintErrorMessage("vstat", error_message);
+      return 1;
+    }
+  }
+  if ("f" != data_type && "d" != data_type) {
     std::ostringstream error_message;
-    error_message << "Too many input files";
+    error_message << "Unexpected argument for the +type option";
     sptk::PrintErrorMessage("vstat", error_message);
     return 1;
   }
-  const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
   // open stream
   std::ifstream ifs;
@@ -354,39 +550,76 @@ int main(int argc, char* argv[]) {
 
   sptk::StatisticsAccumulator accumulator(vector_length - 1, 2);
   sptk::StatisticsAccumulator::Buffer buffer;
-  if (!accumulator.IsValid()) {
+  sptk::QuantileAccumulator quantile_accumulator(vector_length - 1,
+                                                 compression);
+  sptk::QuantileAccumulator::Buffer quantile_buffer;
+  if (!accumulator.IsValid() || !quantile_accumulator.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for accumulation";
     sptk::PrintErrorMessage("vstat", error_message);
     return 1;
   }
 
-  std::vector<double> data(vector_length);
-  for (int vector_index(1);
-       sptk::ReadStream(false, 0, 0, vector_length, &data, &input_stream, NULL);
-       ++vector_index) {
-    if (!accumulator.Run(data, &buffer)) {
+  // Vectors are read block by block. A block never straddles an output
+  // interval so that the statistics are output at the right timing.
+  const int max_block_size(kNumVectorInBlockPerThread * num_thread);
+  std::vector<std::vector<double> > data(
+      max_block_size, std::vector<double>(vector_length));
+  std::vector<float> data_in_float(vector_length);
+  std::vector<Shard> shards(num_thread);
+  const sptk::QuantileAccumulator* quantile_accumulator_for_shards(
+      kPercentile == output_format ? &quantile_accumulator : NULL);
+  int num_remaining_vector(output_interval);
+  for (bool is_end_of_input(false); !is_end_of_input;) {
+    const int block_size(kMagicNumberForEndOfFile == output_interval
+                             ? max_block_size
+                             : std::min(max_block_size, num_remaining_vector));
+    int num_data(0);
+    while (num_data < block_size) {
+      if ("f" == data_type
+              ? !ReadFloatVector(vector_length, &data_in_float,
+                                 &data[num_data], &input_stream)
+              : !sptk::ReadStream(false, 0, 0, vector_length,
+                                  &data[num_data], &input_stream, NULL)) {
+        is_end_of_input = true;
+        break;
+      }
+      ++num_data;
+    }
+
+    if (!AccumulateStatisticsInParallel(
+            accumulator, quantile_accumulator_for_shards, data, num_data,
+            &shards, &buffer, &quantile_buffer)) {
       std::ostringstream error_message;
       error_message << "Failed to accumulate statistics";
       sptk::PrintErrorMessage("vstat", error_message);
       return 1;
     }
 
-    if (kMagicNumberForEndOfFile != output_interval &&
-        0 == vector_index % output_interval) {
-      if (!OutputStatistics(accumulator, buffer, vector_length, output_format,
-                            confidence_level, outputs_only_diagonal_elements)) {
-        std::ostringstream error_message;
-        error_message << "Failed to write statistics";
-        sptk::PrintErrorMessage("vstat", error_message);
-        return 1;
+    if (kMagicNumberForEndOfFile != output_interval) {
+      num_remaining_vector -= num_data;
+      if (0 == num_remaining_vector) {
+        if (!OutputStatistics(accumulator, buffer, quantile_accumulator,
+                              quantile_buffer, vector_length, output_format,
+                              confidence_level, percentile,
+                              outputs_only_diagonal_elements)) {
+          std::ostringstream error_message;
+          error_message << "Failed to write statistics";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        accumulator.Clear(&buffer);
+        quantile_accumulator.Clear(&quantile_buffer);
+        num_remaining_vector = output_interval;
       }
-      accumulator.Clear(&buffer);
     }
   }
 
   int num_actual_vector;
-  if (!accumulator.GetNumData(buffer, &num_actual_vector)) {
+  if (kPercentile == output_format
+          ? !quantile_accumulator.GetNumData(quantile_buffer,
+                                             &num_actual_vector)
+          : !accumulator.GetNumData(buffer, &num_actual_vector)) {
     std::ostringstream error_message;
     error_message << "Failed to accumulate statistics";
     sptk::PrintErrorMessage("vstat", error_message);
@@ -394,8 +627,10 @@ int main(int argc, char* argv[]) {
   }
 
   if (kMagicNumberForEndOfFile == output_interval && 0 < num_actual_vector) {
-    if (!OutputStatistics(accumulator, buffer, vector_length, output_format,
-                          confidence_level, outputs_only_diagonal_elements)) {
+    if (!OutputStatistics(accumulator, buffer, quantile_accumulator,
+                          quantile_buffer, vector_length, output_format,
+                          confidence_level, percentile,
+                          outputs_only_diagonal_elements)) {
       std::ostringstream error_message;
       error_message << "Failed to write statistics";
       sptk::PrintErrorMessage("vstat", error_message);
@@ -49,6 +49,7 @@
 #include <sstream>   // std::ostringstream
 #include <vector>    // std::vector
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/data_windowing.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -96,6 +97,8 @@ void PrintUsage(std::ostream* stream) {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   int input_length(kDefaultFrameLength);
   int output_length(kDefaultFrameLength);
   bool is_output_length_specified(false);
@@ -54,6 +54,7 @@
 #include <stdexcept>  // std::invalid_argument
 #include <string>     // std::stold, std::string
 
+#include "SPTK/utils/binary_stream_buffer.h"
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
 #include "SPTK/utils/uint24_t.h"
@@ -1184,6 +1185,8 @@ class DataTransformWrapper {
 }  // namespace
 
 int main(int argc, char* argv[]) {
+  sptk::BufferedStandardStreams buffered_standard_streams;
+
   bool rounding_flag(kDefaultRoundingFlag);
   WarningType warning_type(kDefaultWarningType);
   int num_column(kDefaultNumColumn);
@@ -44,8 +44,308 @@
 
 #include "SPTK/math/distance_calculator.h"
 
-#include <cmath>    // std::fabs, std::log, std::sqrt
-#include <cstddef>  // std::size_t
+#include <algorithm>  // std::copy, std::min
+#include <cmath>      // std::fabs, std::log, std::sqrt
+#include <cstddef>    // std::size_t
+
+#include "SPTK/utils/simd.h"
+
+namespace {
+
+using sptk::simd::Absolute;
+using sptk::simd::Add;
+using sptk::simd::Broadcast;
+using sptk::simd::Gather;
+using sptk::simd::kVectorLength;
+using sptk::simd::Load;
+using sptk::simd::Multiply;
+using sptk::simd::Store;
+using sptk::simd::Subtract;
+using sptk::simd::Vector;
+
+// Number of groups of rows processed at once to hide the latency of addition.
+const int kNumParallelGroup(4);
+
+// Number of rows copied at once when a vector is compared with rows.
+const int kChunkSize(16 * kNumParallelGroup * kVectorLength);
+
+// Rows of a matrix read in place. The m-th elements of the rows in a group are
+// gathered into a vector. Lanes beyond the last row read the first row of the
+// group.
+class StridedRows {
+ public:
+  class Group {
+   public:
+    Group(const double* first_row, int length, int group_size) {
+      for (int k(0); k < kVectorLength; ++k) {
+        rows_[k] = first_row + (k < group_size ? k * length : 0);
+      }
+    }
+    Vector Get(int m) const {
+      return Gather(rows_, m);
+    }
+    Vector GetLogarithm(int m) const {
+      return Broadcast(0.0);
+    }
+
+   private:
+    const double* rows_[kVectorLength];
+  };
+
+  StridedRows(const sptk::Matrix& matrix, int row_offset, int num_row)
+      : first_row_(0 == num_row ? NULL : matrix[row_offset]),
+        length_(matrix.GetNumColumn()),
+        num_row_(num_row) {
+  }
+
+  Group GetGroup(int g) const {
+    return Group(first_row_ + g * kVectorLength * length_, length_,
+                 num_row_ - g * kVectorLength);
+  }
+
+ private:
+  const double* first_row_;
+  const int length_;
+  const int num_row_;
+};
+
+// Rows copied in groups so that the m-th elements of the rows in a group are
+// contiguous. The logarithms of the elements are also stored if required.
+class InterleavedRows {
+ public:
+  class Group {
+   public:
+    Group(const double* values, const double* logarithms)
+        : values_(values), logarithms_(logarithms) {
+    }
+    Vector Get(int m) const {
+      return Load(values_ + m * kVectorLength);
+    }
+    Vector GetLogarithm(int m) const {
+      return Load(logarithms_ + m * kVectorLength);
+    }
+
+   private:
+    const double* values_;
+    const double* logarithms_;
+  };
+
+  InterleavedRows() : length_(0) {
+  }
+
+  // Returns false if a logarithm is required but undefined.
+  bool Set(const sptk::Matrix& matrix, int row_offset, int num_row,
+           bool stores_logarithm) {
+    length_ = matrix.GetNumColumn();
+    const int num_group((num_row + kVectorLength - 1) / kVectorLength);
+    values_.resize(num_group * length_ * kVectorLength);
+    logarithms_.resize(stores_logarithm ? values_.size() : 0);
+    for (int n(0); n < num_group * kVectorLength; ++n) {
+      // Lanes beyond the last row hold the first row of the group.
+      const double* row(
+          matrix[row_offset + (n < num_row ? n : n - n % kVectorLength)]);
+      const int offset((n / kVectorLength) * length_ * kVectorLength +
+                       n % kVectorLength);
+      for (int m(0); m < length_; ++m) {
+        values_[offset + m * kVectorLength] = row[m];
+        if (stores_logarithm) {
+          if (row[m] <= 0.0) return false;
+          logarithms_[offset + m * kVectorLength] = std::log(row[m]);
+        }
+      }
+    }
+    return true;
+  }
+
+  Group GetGroup(int g) const {
+    const int offset(g * length_ * kVectorLength);
+    return Group(&(values_[offset]),
+                 logarithms_.empty() ? NULL : &(logarithms_[offset]));
+  }
+
+ private:
+  int length_;
+  std::vector<double> values_;
+  std::vector<double> logarithms_;
+};
+
+// Adds the element-wise distance between x and the m-th elements of a group
+// to a sum. The logarithms are read only for the symmetric Kullback-Leibler
+// divergence.
+template <sptk::DistanceCalculator::DistanceMetrics metric, class Group>
+inline Vector Accumulate(const double* x, const double* log_x,
+                         const Group& group, int m, Vector sum) {
+  const Vector diff(Subtract(Broadcast(x[m]), group.Get(m)));
+  switch (metric) {
+    case sptk::DistanceCalculator::kManhattan: {
+      return Add(sum, Absolute(diff));
+    }
+    case sptk::DistanceCalculator::kEuclidean:
+    case sptk::DistanceCalculator::kSquaredEuclidean: {
+      return Add(sum, Multiply(diff, diff));
+    }
+    case sptk::DistanceCalculator::kSymmetricKullbackLeibler: {
+      const Vector log_diff(
+          Subtract(Broadcast(log_x[m]), group.GetLogarithm(m)));
+      return Add(sum, Multiply(diff, log_diff));
+    }
+    default: {
+      return sum;
+    }
+  }
+}
+
+// Stores the distances of a group.
+template <sptk::DistanceCalculator::DistanceMetrics metric>
+inline void StoreDistances(Vector sum, int group_size, double* distances) {
+  double buffer[kVectorLength];
+  Store(sum, buffer);
+  for (int k(0); k < group_size && k < kVectorLength; ++k) {
+    distances[k] = (sptk::DistanceCalculator::kEuclidean == metric)
+                       ? std::sqrt(buffer[k])
+                       : buffer[k];
+  }
+}
+
+// Calculates the distances between a vector and rows.
+template <sptk::DistanceCalculator::DistanceMetrics metric, class Rows>
+void CalculateDistances(const double* x, const double* log_x, const Rows& rows,
+                        int num_row, int length, double* distances) {
+  const int num_group((num_row + kVectorLength - 1) / kVectorLength);
+  int g(0);
+
+  for (; g + kNumParallelGroup <= num_group; g += kNumParallelGroup) {
+    const typename Rows::Group group0(rows.GetGroup(g));
+    const typename Rows::Group group1(rows.GetGroup(g + 1));
+    const typename Rows::Group group2(rows.GetGroup(g + 2));
+    const typename Rows::Group group3(rows.GetGroup(g + 3));
+    Vector sum0(Broadcast(0.0));
+    Vector sum1(Broadcast(0.0));
+    Vector sum2(Broadcast(0.0));
+    Vector sum3(Broadcast(0.0));
+    for (int m(0); m < length; ++m) {
+      sum0 = Accumulate<metric>(x, log_x, group0, m, sum0);
+      sum1 = Accumulate<metric>(x, log_x, group1, m, sum1);
+      sum2 = Accumulate<metric>(x, log_x, group2, m, sum2);
+      sum3 = Accumulate<metric>(x, log_x, group3, m, sum3);
+    }
+    const int n(g * kVectorLength);
+    StoreDistances<metric>(sum0, num_row - n, distances + n);
+    StoreDistances<metric>(sum1, num_row - n - kVectorLength,
+                           distances + n + kVectorLength);
+    StoreDistances<metric>(sum2, num_row - n - 2 * kVectorLength,
+                           distances + n + 2 * kVectorLength);
+    StoreDistances<metric>(sum3, num_row - n - 3 * kVectorLength,
+                           distances + n + 3 * kVectorLength);
+  }
+
+  for (; g < num_group; ++g) {
+    const typename Rows::Group group(rows.GetGroup(g));
+    Vector sum(Broadcast(0.0));
+    for (int m(0); m < length; ++m) {
+      sum = Accumulate<metric>(x, log_x, group, m, sum);
+    }
+    const int n(g * kVectorLength);
+    StoreDistances<metric>(sum, num_row - n, distances + n);
+  }
+}
+
+// Calculates the distances between a vector and rows with the given metric.
+template <class Rows>
+bool CalculateDistances(sptk::DistanceCalculator::DistanceMetrics metric,
+                        const double* x, const double* log_x, const Rows& rows,
+                        int num_row, int length, double* distances) {
+  switch (metric) {
+    case sptk::DistanceCalculator::kManhattan: {
+      CalculateDistances<sptk::DistanceCalculator::kManhattan>(
+          x, log_x, rows, num_row, length, distances);
+      break;
+    }
+    case sptk::DistanceCalculator::kEuclidean: {
+      CalculateDistances<sptk::DistanceCalculator::kEuclidean>(
+          x, log_x, rows, num_row, length, distances);
+      break;
+    }
+    case sptk::DistanceCalculator::kSquaredEuclidean: {
+      CalculateDistances<sptk::DistanceCalculator::kSquaredEuclidean>(
+          x, log_x, rows, num_row, length, distances);
+      break;
+    }
+    case sptk::DistanceCalculator::kSymmetricKullbackLeibler: {
+      CalculateDistances<sptk::DistanceCalculator::kSymmetricKullbackLeibler>(
+          x, log_x, rows, num_row, length, distances);
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Calculates the distance between two vectors. The elements are accumulated
+// in double precision whatever the element type is.
+template <typename T>
+bool CalculateDistance(sptk::DistanceCalculator::DistanceMetrics metric,
+                       const T* x, const T* y, int length, double* distance) {
+  double sum(0.0);
+
+  switch (metric) {
+    case sptk::DistanceCalculator::kManhattan: {
+      for (int i(0); i < length; ++i) {
+        const double diff(static_cast<double>(x[i]) - y[i]);
+        sum += std::fabs(diff);
+      }
+      break;
+    }
+    case sptk::DistanceCalculator::kEuclidean: {
+      for (int i(0); i < length; ++i) {
+        const double diff(static_cast<double>(x[i]) - y[i]);
+        sum += diff * diff;
+      }
+      sum = std::sqrt(sum);
+      break;
+    }
+    case sptk::DistanceCalculator::kSquaredEuclidean: {
+      for (int i(0); i < length; ++i) {
+        const double diff(static_cast<double>(x[i]) - y[i]);
+        sum += diff * diff;
+      }
+      break;
+    }
+    case sptk::DistanceCalculator::kSymmetricKullbackLeibler: {
+      for (int i(0); i < length; ++i) {
+        if (x[i] <= 0.0 || y[i] <= 0.0) return false;
+        const double diff(static_cast<double>(x[i]) - y[i]);
+        const double log_diff(std::log(static_cast<double>(x[i])) -
+                              std::log(static_cast<double>(y[i])));
+        sum += diff * log_diff;
+      }
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+
+  *distance = sum;
+
+  return true;
+}
+
+// Calculates the logarithms of the elements of a vector. Returns false if a
+// logarithm is undefined.
+bool CalculateLogarithms(const double* x, int length,
+                         std::vector<double>* logarithms) {
+  logarithms->resize(length);
+  for (int m(0); m < length; ++m) {
+    if (x[m] <= 0.0) return false;
+    (*logarithms)[m] = std::log(x[m]);
+  }
+  return true;
+}
+
+}  // namespace
 
 namespace sptk {
 
@@ -70,49 +370,119 @@ bool DistanceCalculator::Run(const std::vector<double>& vector1,
     return false;
   }
 
-  // get values
-  const double* x(&(vector1[0]));
-  const double* y(&(vector2[0]));
+  return CalculateDistance(distance_metric_, &(vector1[0]), &(vector2[0]),
+                           num_order_ + 1, distance);
+}
 
-  double sum(0.0);
+bool DistanceCalculator::Run(const std::vector<float>& vector1,
+                             const std::vector<float>& vector2,
+                             double* distance) const {
+  // check inputs
+  if (!is_valid_ ||
+      vector1.size() != static_cast<std::size_t>(num_order_ + 1) ||
+      vector2.size() != static_cast<std::size_t>(num_order_ + 1) ||
+      NULL == distance) {
+    return false;
+  }
 
-  switch (distance_metric_) {
-    case kManhattan: {
-      for (int i(0); i <= num_order_; ++i) {
-        const double diff(x[i] - y[i]);
-        sum += std::fabs(diff);
-      }
-      break;
+  return CalculateDistance(distance_metric_, &(vector1[0]), &(vector2[0]),
+                           num_order_ + 1, distance);
+}
+
+
+bool DistanceCalculator::Run(const std::vector<double>& vector,
+                             const Matrix& matrix,
+                             std::vector<double>* distances) const {
+  return Run(vector, matrix, 0, matrix.GetNumRow(), distances);
+}
+
+bool DistanceCalculator::Run(const std::vector<double>& vector,
+                             const Matrix& matrix, int row_offset, int num_row,
+                             std::vector<double>* distances) const {
+  // Check inputs.
+  const int length(num_order_ + 1);
+  if (!is_valid_ || vector.size() != static_cast<std::size_t>(length) ||
+      matrix.GetNumColumn() != length || row_offset < 0 || num_row < 0 ||
+      matrix.GetNumRow() < row_offset + num_row || NULL == distances) {
+    return false;
+  }
+
+  // Prepare memories.
+  if (distances->size() != static_cast<std::size_t>(num_row)) {
+    distances->resize(num_row);
+  }
+  if (0 == num_row) {
+    return true;
+  }
+
+  // The logarithms are required for the symmetric Kullback-Leibler
+  // divergence, so the rows are copied with their logarithms chunk by chunk.
+  // Otherwise, the rows are read in place.
+  if (kSymmetricKullbackLeibler == distance_metric_) {
+    std::vector<double> log_vector;
+    if (!CalculateLogarithms(&(vector[0]), length, &log_vector)) {
+      return false;
     }
-    case kEuclidean: {
-      for (int i(0); i <= num_order_; ++i) {
-        const double diff(x[i] - y[i]);
-        sum += diff * diff;
+    InterleavedRows rows;
+    for (int n(0); n < num_row; n += kChunkSize) {
+      const int chunk_size(std::min(kChunkSize, num_row - n));
+      if (!rows.Set(matrix, row_offset + n, chunk_size, true) ||
+          !CalculateDistances(distance_metric_, &(vector[0]), &(log_vector[0]),
+                              rows, chunk_size, length,
+                              &((*distances)[n]))) {
+        return false;
       }
-      sum = std::sqrt(sum);
-      break;
     }
-    case kSquaredEuclidean: {
-      for (int i(0); i <= num_order_; ++i) {
-        const double diff(x[i] - y[i]);
-        sum += diff * diff;
-      }
-      break;
+    return true;
+  }
+
+  const StridedRows rows(matrix, row_offset, num_row);
+  return CalculateDistances(distance_metric_, &(vector[0]), NULL, rows,
+                            num_row, length, &((*distances)[0]));
+}
+
+bool DistanceCalculator::Run(const Matrix& first_matrix,
+                             const Matrix& second_matrix,
+                             Matrix* distances) const {
+  // Check inputs.
+  const int length(num_order_ + 1);
+  if (!is_valid_ || first_matrix.GetNumColumn() != length ||
+      second_matrix.GetNumColumn() != length || NULL == distances ||
+      &first_matrix == distances || &second_matrix == distances) {
+    return false;
+  }
+
+  // Prepare memories.
+  const int num_row(first_matrix.GetNumRow());
+  const int num_column(second_matrix.GetNumRow());
+  if (distances->GetNumRow() != num_row ||
+      distances->GetNumColumn() != num_column) {
+    distances->Resize(num_row, num_column);
+  }
+  if (0 == num_row || 0 == num_column) {
+    return true;
+  }
+
+  // The second matrix is copied once for all rows of the first matrix.
+  const bool uses_logarithm(kSymmetricKullbackLeibler == distance_metric_);
+  InterleavedRows rows;
+  if (!rows.Set(second_matrix, 0, num_column, uses_logarithm)) {
+    return false;
+  }
+
+  std::vector<double> log_vector;
+  for (int i(0); i < num_row; ++i) {
+    if (uses_logarithm &&
+        !CalculateLogarithms(first_matrix[i], length, &log_vector)) {
+      return false;
     }
-    case kSymmetricKullbackLeibler: {
-      for (int i(0); i <= num_order_; ++i) {
-        if (x[i] <= 0.0 || y[i] <= 0.0) return false;
-        const double diff(x[i] - y[i]);
-        const double log_diff(std::log(x[i]) - std::log(y[i]));
-        sum += diff * log_diff;
-      }
-      break;
+    if (!CalculateDistances(distance_metric_, first_matrix[i],
+                            uses_logarithm ? &(log_vector[0]) : NULL, rows,
+                            num_column, length, (*distances)[i])) {
+      return false;
     }
-    default: { return false; }
   }
 
-  *distance = sum;
-
   return true;
 }
 
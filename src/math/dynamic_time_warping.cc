@@ -44,18 +44,452 @@
 
 #include "SPTK/math/dynamic_time_warping.h"
 
-#include <algorithm>  // std::reverse
+#include <algorithm>  // std::copy, std::max, std::min, std::reverse
 #include <cfloat>     // DBL_MAX
+#include <cmath>      // std::ceil, std::floor
+#include <cstddef>    // std::size_t
+#include <thread>     // std::thread
 #include <utility>    // std::make_pair
 
 namespace {
 
-struct Cell {
-  double score;
-  int horizontal_back_pointer;
-  int vertical_back_pointer;
+// Maximum number of lattice points whose back pointers are kept at once. A
+// larger lattice is divided at the point where the best path crosses its
+// middle row, so memory usage is linear in the sequence length.
+const long long kMaxNumPointWithBackPointer(1 << 25);
+
+// Minimum number of rows of a lattice to be divided. The division point can be
+// one row above the middle row because of the transitions skipping a row.
+const int kMinNumRowToBeDivided(5);
+
+// Tolerance for the band edges computed in floating point.
+const double kBandTolerance(1e-9);
+
+// Score of unreachable points. Layer 0 holds the best score of all paths and
+// layer 1 holds that of the paths whose last transition is diagonal, which is
+// used for the local path constraints prohibiting successive skips.
+const double kUnreachable(DBL_MAX);
+const int kNumLayer(2);
+
+struct Transition {
+  int di;
+  int dj;
+  double weight;
+  // The previous point is read from layer 1.
+  bool is_skip;
+  // The transition updates layer 1.
+  bool is_diagonal;
+};
+
+// A rectangular part of the lattice. The first point is given its scores and
+// is not computed.
+struct Region {
+  int begin_i;
+  int begin_j;
+  int end_i;
+  int end_j;
+  double initial_score[kNumLayer];
+};
+
+class Lattice {
+ public:
+  Lattice(const std::vector<Transition>& transitions,
+          const sptk::DistanceCalculator& distance_calculator,
+          sptk::DynamicTimeWarping::GlobalPathConstraints
+              global_path_constraint,
+          double global_path_constraint_parameter,
+          const std::vector<std::vector<double> >& query_vector_sequence,
+          const std::vector<std::vector<double> >& reference_vector_sequence)
+      : transitions_(transitions),
+        distance_calculator_(distance_calculator),
+        global_path_constraint_(global_path_constraint),
+        global_path_constraint_parameter_(global_path_constraint_parameter),
+        query_vector_sequence_(query_vector_sequence),
+        reference_vector_sequence_(reference_vector_sequence),
+        num_query_vector_(query_vector_sequence.size()),
+        num_reference_vector_(reference_vector_sequence.size()),
+        reference_matrix_(num_reference_vector_,
+                          distance_calculator.GetNumOrder() + 1),
+        is_valid_(true) {
+    const std::size_t length(distance_calculator.GetNumOrder() + 1);
+    for (int j(0); j < num_reference_vector_; ++j) {
+      if (reference_vector_sequence[j].size() != length) {
+        is_valid_ = false;
+        return;
+      }
+      std::copy(reference_vector_sequence[j].begin(),
+                reference_vector_sequence[j].end(), reference_matrix_[j]);
+    }
+  }
+
+  bool CalculateScore(double* total_score) {
+    Region whole;
+    if (!GetWholeRegion(&whole)) {
+      return false;
+    }
+    double end_score[kNumLayer];
+    if (!Forward(whole, false, -1, end_score, NULL) ||
+        !(end_score[0] < kUnreachable)) {
+      return false;
+    }
+    *total_score = end_score[0] / (num_query_vector_ + num_reference_vector_);
+    return true;
+  }
+
+  bool FindPath(std::vector<std::pair<int, int> >* viterbi_path,
+                double* total_score) {
+    Region whole;
+    if (!GetWholeRegion(&whole)) {
+      return false;
+    }
+    double end_score;
+    viterbi_path->clear();
+    viterbi_path->push_back(std::make_pair(0, 0));
+    if (!Solve(whole, 0, viterbi_path, &end_score)) {
+      return false;
+    }
+    *total_score = end_score / (num_query_vector_ + num_reference_vector_);
+    return true;
+  }
+
+ private:
+  bool GetWholeRegion(Region* whole) const {
+    if (!is_valid_) {
+      return false;
+    }
+    int begin, end;
+    GetBandRange(0, &begin, &end);
+    if (0 < begin) {
+      return false;
+    }
+    double local_distance;
+    if (!distance_calculator_.Run(query_vector_sequence_[0],
+                                  reference_vector_sequence_[0],
+                                  &local_distance)) {
+      return false;
+    }
+    whole->begin_i = 0;
+    whole->begin_j = 0;
+    whole->end_i = num_query_vector_ - 1;
+    whole->end_j = num_reference_vector_ - 1;
+    whole->initial_score[0] = local_distance;
+    whole->initial_score[1] = kUnreachable;
+    return true;
+  }
+
+  // Gets the range of reference index allowed by the global path constraint.
+  void GetBandRange(int i, int* begin, int* end) const {
+    const double q(num_query_vector_ - 1);
+    const double r(num_reference_vector_ - 1);
+    double lower(0.0), upper(r);
+    switch (global_path_constraint_) {
+      case sptk::DynamicTimeWarping::GlobalPathConstraints::kSakoeChibaBand: {
+        if (0.0 < q) {
+          const double center(i * r / q);
+          lower = center - global_path_constraint_parameter_;
+          upper = center + global_path_constraint_parameter_;
+        }
+        break;
+      }
+      case sptk::DynamicTimeWarping::GlobalPathConstraints::
+          kItakuraParallelogram: {
+        const double slope(global_path_constraint_parameter_);
+        lower = std::max(i / slope, r - slope * (q - i));
+        upper = std::min(slope * i, r - (q - i) / slope);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+    *begin = std::max(0, static_cast<int>(std::ceil(lower - kBandTolerance)));
+    *end = std::min(num_reference_vector_ - 1,
+                    static_cast<int>(std::floor(upper + kBandTolerance)));
+  }
+
+  // Computes the scores of the points in the region row by row. Only the last
+  // three rows are kept because a transition skips at most one row. If
+  // records_transitions is true, the best transitions of all the points in the
+  // band are kept for backtracking. If split_row is not negative, the last
+  // point not below the split row on the best path to each point is tracked.
+  bool Forward(const Region& region, bool records_transitions, int split_row,
+               double* end_score, int* end_ancestor) {
+    const int num_slot(3);
+    const int num_row(region.end_i - region.begin_i + 1);
+    const int width(region.end_j - region.begin_j + 1);
+    const bool tracks_ancestor(0 <= split_row);
+    for (int l(0); l < kNumLayer; ++l) {
+      score_[l].assign(num_slot * width, kUnreachable);
+      if (tracks_ancestor) {
+        ancestor_[l].assign(num_slot * width, -1);
+        boundary_score_[l].assign(2 * width, kUnreachable);
+      }
+    }
+    const long long num_point(GetNumPoint(region));
+    if (records_transitions) {
+      for (int l(0); l < kNumLayer; ++l) {
+        transition_[l].assign(num_point, -1);
+      }
+    }
+    std::vector<int> written_begin(num_slot, 0), written_end(num_slot, -1);
+    const int num_transition(transitions_.size());
+
+    for (int i(region.begin_i); i <= region.end_i; ++i) {
+      const int slot((i - region.begin_i) % num_slot);
+      const int offset(slot * width - region.begin_j);
+
+      // Clear the row computed before.
+      for (int l(0); l < kNumLayer; ++l) {
+        for (int j(written_begin[slot]); j <= written_end[slot]; ++j) {
+          score_[l][offset + j] = kUnreachable;
+        }
+      }
+
+      const int begin(row_begin_[i - region.begin_i]);
+      const int end(row_end_[i - region.begin_i]);
+      written_begin[slot] = begin;
+      written_end[slot] = end;
+
+      if (begin <= end &&
+          !distance_calculator_.Run(query_vector_sequence_[i],
+                                    reference_matrix_, begin, end - begin + 1,
+                                    &local_distances_)) {
+        return false;
+      }
+
+      for (int j(begin); j <= end; ++j) {
+        if (i == region.begin_i && j == region.begin_j) {
+          for (int l(0); l < kNumLayer; ++l) {
+            score_[l][offset + j] = region.initial_score[l];
+          }
+          continue;
+        }
+
+        const double local_distance(local_distances_[j - begin]);
+
+        double best_score[kNumLayer] = {kUnreachable, kUnreachable};
+        int best_transition[kNumLayer] = {-1, -1};
+        for (int k(0); k < num_transition; ++k) {
+          const Transition& transition(transitions_[k]);
+          const int prev_i(i - transition.di);
+          const int prev_j(j - transition.dj);
+          if (prev_i < region.begin_i || prev_j < region.begin_j) continue;
+          const int prev_index(((prev_i - region.begin_i) % num_slot) * width +
+                               prev_j - region.begin_j);
+          const double score(transition.weight * local_distance +
+                             score_[transition.is_skip ? 1 : 0][prev_index]);
+          if (transition.is_diagonal && score < best_score[1]) {
+            best_score[1] = score;
+            best_transition[1] = k;
+          }
+          if (score < best_score[0]) {
+            best_score[0] = score;
+            best_transition[0] = k;
+          }
+        }
+
+        for (int l(0); l < kNumLayer; ++l) {
+          score_[l][offset + j] = best_score[l];
+          if (records_transitions) {
+            transition_[l][row_offset_[i - region.begin_i] + j - begin] =
+                static_cast<signed char>(best_transition[l]);
+          }
+          if (tracks_ancestor && split_row < i && 0 <= best_transition[l]) {
+            const Transition& transition(transitions_[best_transition[l]]);
+            const int prev_i(i - transition.di);
+            const int prev_j(j - transition.dj);
+            const int prev_layer(transition.is_skip ? 1 : 0);
+            if (prev_i <= split_row) {
+              ancestor_[l][offset + j] =
+                  ((prev_i - split_row + 1) * width + prev_j - region.begin_j) *
+                      kNumLayer +
+                  prev_layer;
+            } else {
+              ancestor_[l][offset + j] =
+                  ancestor_[prev_layer]
+                           [((prev_i - region.begin_i) % num_slot) * width +
+                            prev_j - region.begin_j];
+            }
+          }
+        }
+      }
+
+      if (tracks_ancestor && split_row - 1 <= i && i <= split_row) {
+        const int boundary_offset((i - split_row + 1) * width);
+        for (int l(0); l < kNumLayer; ++l) {
+          std::copy(score_[l].begin() + slot * width,
+                    score_[l].begin() + (slot + 1) * width,
+                    boundary_score_[l].begin() + boundary_offset);
+        }
+      }
+    }
+
+    const int end_index(((num_row - 1) % num_slot) * width + region.end_j -
+                        region.begin_j);
+    for (int l(0); l < kNumLayer; ++l) {
+      end_score[l] = score_[l][end_index];
+      if (tracks_ancestor) {
+        end_ancestor[l] = ancestor_[l][end_index];
+      }
+    }
+    return true;
+  }
+
+  // Sets the band of each row in the region and returns the number of points
+  // in the band.
+  long long GetNumPoint(const Region& region) {
+    const int num_row(region.end_i - region.begin_i + 1);
+    row_begin_.resize(num_row);
+    row_end_.resize(num_row);
+    row_offset_.resize(num_row);
+    long long num_point(0);
+    for (int i(region.begin_i); i <= region.end_i; ++i) {
+      const int r(i - region.begin_i);
+      GetBandRange(i, &row_begin_[r], &row_end_[r]);
+      row_begin_[r] = std::max(row_begin_[r], region.begin_j);
+      row_end_[r] = std::min(row_end_[r], region.end_j);
+      row_offset_[r] = num_point;
+      if (row_begin_[r] <= row_end_[r]) {
+        num_point += row_end_[r] - row_begin_[r] + 1;
+      }
+    }
+    return num_point;
+  }
+
+  // Appends the best path from the first point (exclusive) to the last point
+  // (inclusive) of the region.
+  bool Solve(const Region& region, int end_layer,
+             std::vector<std::pair<int, int> >* viterbi_path,
+             double* end_score) {
+    const int num_row(region.end_i - region.begin_i + 1);
+    const int width(region.end_j - region.begin_j + 1);
+    double score[kNumLayer];
+
+    if (num_row < kMinNumRowToBeDivided ||
+        GetNumPoint(region) <= kMaxNumPointWithBackPointer) {
+      if (!Forward(region, true, -1, score, NULL) ||
+          !(score[end_layer] < kUnreachable)) {
+        return false;
+      }
+      *end_score = score[end_layer];
+
+      const std::size_t start(viterbi_path->size());
+      int i(region.end_i), j(region.end_j), l(end_layer);
+      while (i != region.begin_i || j != region.begin_j) {
+        viterbi_path->push_back(std::make_pair(i, j));
+        const int r(i - region.begin_i);
+        const int k(transition_[l][row_offset_[r] + j - row_begin_[r]]);
+        if (k < 0) {
+          return false;
+        }
+        i -= transitions_[k].di;
+        j -= transitions_[k].dj;
+        l = transitions_[k].is_skip ? 1 : 0;
+      }
+      std::reverse(viterbi_path->begin() + start, viterbi_path->end());
+      return true;
+    }
+
+    // Find the point where the best path crosses the middle row.
+    const int split_row((region.begin_i + region.end_i) / 2);
+    int ancestor[kNumLayer];
+    if (!Forward(region, false, split_row, score, ancestor) ||
+        !(score[end_layer] < kUnreachable) || ancestor[end_layer] < 0) {
+      return false;
+    }
+    *end_score = score[end_layer];
+
+    const int split_layer(ancestor[end_layer] % kNumLayer);
+    const int split_index(ancestor[end_layer] / kNumLayer);
+    Region upper(region);
+    upper.end_i = split_row - 1 + split_index / width;
+    upper.end_j = region.begin_j + split_index % width;
+    Region lower(region);
+    lower.begin_i = upper.end_i;
+    lower.begin_j = upper.end_j;
+    for (int l(0); l < kNumLayer; ++l) {
+      lower.initial_score[l] = boundary_score_[l][split_index];
+    }
+
+    double tmp;
+    return Solve(upper, split_layer, viterbi_path, &tmp) &&
+           Solve(lower, end_layer, viterbi_path, &tmp);
+  }
+
+  const std::vector<Transition>& transitions_;
+  const sptk::DistanceCalculator& distance_calculator_;
+  const sptk::DynamicTimeWarping::GlobalPathConstraints global_path_constraint_;
+  const double global_path_constraint_parameter_;
+  const std::vector<std::vector<double> >& query_vector_sequence_;
+  const std::vector<std::vector<double> >& reference_vector_sequence_;
+  const int num_query_vector_;
+  const int num_reference_vector_;
+
+  sptk::Matrix reference_matrix_;
+  bool is_valid_;
+  std::vector<double> local_distances_;
+  std::vector<int> row_begin_;
+  std::vector<int> row_end_;
+  std::vector<long long> row_offset_;
+  std::vector<double> score_[kNumLayer];
+  std::vector<signed char> transition_[kNumLayer];
+  std::vector<int> ancestor_[kNumLayer];
+  std::vector<double> boundary_score_[kNumLayer];
+
+  DISALLOW_COPY_AND_ASSIGN(Lattice);
+};
+
+void MakeTransitions(
+    const std::vector<std::pair<int, int> >& local_path_candidates,
+    const std::vector<double>& local_path_weights,
+    bool includes_skip_transition, std::vector<Transition>* transitions) {
+  const int num_candidate(local_path_candidates.size());
+  transitions->resize(num_candidate);
+  for (int k(0); k < num_candidate; ++k) {
+    Transition& transition((*transitions)[k]);
+    transition.di = local_path_candidates[k].first;
+    transition.dj = local_path_candidates[k].second;
+    transition.weight = local_path_weights[k];
+    transition.is_skip = includes_skip_transition &&
+                         (0 == transition.di || 0 == transition.dj);
+    transition.is_diagonal = includes_skip_transition &&
+                             (0 != transition.di && 0 != transition.dj);
+  }
+}
+
+struct BatchState {
+  const sptk::DynamicTimeWarping* dynamic_time_warping;
+  const std::vector<std::vector<std::vector<double> > >* query_vector_sequences;
+  const std::vector<std::vector<std::vector<double> > >*
+      reference_vector_sequences;
+  int num_thread;
+  std::vector<std::vector<std::pair<int, int> > >* viterbi_paths;
+  std::vector<double>* total_scores;
 };
 
+// Aligns the pairs assigned to the given thread.
+void AlignPairs(const BatchState* state, int thread_index, char* is_succeeded) {
+  const int num_pair(state->query_vector_sequences->size());
+  for (int p(thread_index); p < num_pair; p += state->num_thread) {
+    const std::vector<std::vector<double> >& query_vector_sequence(
+        (*state->query_vector_sequences)[p]);
+    const std::vector<std::vector<double> >& reference_vector_sequence(
+        (*state->reference_vector_sequences)[p]);
+    double* total_score(&((*state->total_scores)[p]));
+    if (NULL == state->viterbi_paths
+            ? !state->dynamic_time_warping->Run(
+                  query_vector_sequence, reference_vector_sequence,
+                  total_score)
+            : !state->dynamic_time_warping->Run(
+                  query_vector_sequence, reference_vector_sequence,
+                  &((*state->viterbi_paths)[p]), total_score)) {
+      *is_succeeded = 0;
+      return;
+    }
+  }
+  *is_succeeded = 1;
+}
+
 }  // namespace
 
 namespace sptk {
@@ -66,8 +500,127 @@ DynamicTimeWarping::DynamicTimeWarping(
     : num_order_(num_order),
       local_path_constraint_(local_path_constraint),
       distance_calculator_(num_order_, distance_metric),
+      global_path_constraint_(kNone),
+      global_path_constraint_parameter_(0.0),
       is_valid_(true) {
-  if (num_order_ < 0 || !distance_calculator_.IsValid()) {
+  Initialize();
+}
+
+DynamicTimeWarping::DynamicTimeWarping(
+    int num_order, LocalPathConstraints local_path_constraint,
+    DistanceCalculator::DistanceMetrics distance_metric,
+    GlobalPathConstraints global_path_constraint,
+    double global_path_constraint_parameter)
+    : num_order_(num_order),
+      local_path_constraint_(local_path_constraint),
+      distance_calculator_(num_order_, distance_metric),
+      global_path_constraint_(global_path_constraint),
+      global_path_constraint_parameter_(global_path_constraint_parameter),
+      is_valid_(true) {
+  Initialize();
+}
+
+bool DynamicTimeWarping::Run(
+    const std::vector<std::vector<double> >& query_vector_sequence,
+    const std::vector<std::vector<double> >& reference_vector_sequence,
+    std::vector<std::pair<int, int> >* viterbi_path,
+    double* total_score) const {
+  // check inputs
+  if (!is_valid_ || query_vector_sequence.empty() ||
+      reference_vector_sequence.empty() || NULL == viterbi_path ||
+      NULL == total_score) {
+    return false;
+  }
+
+  std::vector<Transition> transitions;
+  MakeTransitions(local_path_candidates_, local_path_weights_,
+                  kType5 == local_path_constraint_ ||
+                      kType7 == local_path_constraint_,
+                  &transitions);
+  Lattice lattice(transitions, distance_calculator_, global_path_constraint_,
+                  global_path_constraint_parameter_, query_vector_sequence,
+                  reference_vector_sequence);
+  return lattice.FindPath(viterbi_path, total_score);
+}
+
+bool DynamicTimeWarping::Run(
+    const std::vector<std::vector<double> >& query_vector_sequence,
+    const std::vector<std::vector<double> >& reference_vector_sequence,
+    double* total_score) const {
+  // check inputs
+  if (!is_valid_ || query_vector_sequence.empty() ||
+      reference_vector_sequence.empty() || NULL == total_score) {
+    return false;
+  }
+
+  std::vector<Transition> transitions;
+  MakeTransitions(local_path_candidates_, local_path_weights_,
+                  kType5 == local_path_constraint_ ||
+                      kType7 == local_path_constraint_,
+                  &transitions);
+  Lattice lattice(transitions, distance_calculator_, global_path_constraint_,
+                  global_path_constraint_parameter_, query_vector_sequence,
+                  reference_vector_sequence);
+  return lattice.CalculateScore(total_score);
+}
+
+bool DynamicTimeWarping::Run(
+    const std::vector<std::vector<std::vector<double> > >&
+        query_vector_sequences,
+    const std::vector<std::vector<std::vector<double> > >&
+        reference_vector_sequences,
+    int num_thread,
+    std::vector<std::vector<std::pair<int, int> > >* viterbi_paths,
+    std::vector<double>* total_scores) const {
+  // check inputs
+  const int num_pair(query_vector_sequences.size());
+  if (!is_valid_ ||
+      reference_vector_sequences.size() != static_cast<std::size_t>(num_pair) ||
+      num_thread <= 0 || NULL == total_scores) {
+    return false;
+  }
+
+  // prepare memories
+  if (NULL != viterbi_paths &&
+      viterbi_paths->size() != static_cast<std::size_t>(num_pair)) {
+    viterbi_paths->resize(num_pair);
+  }
+  if (total_scores->size() != static_cast<std::size_t>(num_pair)) {
+    total_scores->resize(num_pair);
+  }
+
+  BatchState state;
+  state.dynamic_time_warping = this;
+  state.query_vector_sequences = &query_vector_sequences;
+  state.reference_vector_sequences = &reference_vector_sequences;
+  state.num_thread = std::min(num_thread, std::max(num_pair, 1));
+  state.viterbi_paths = viterbi_paths;
+  state.total_scores = total_scores;
+
+  // The calling thread works as the first worker.
+  std::vector<std::thread> threads;
+  std::vector<char> is_succeeded(state.num_thread);
+  for (int t(1); t < state.num_thread; ++t) {
+    threads.push_back(std::thread(AlignPairs, &state, t, &is_succeeded[t]));
+  }
+  AlignPairs(&state, 0, &is_succeeded[0]);
+
+  bool result(0 != is_succeeded[0]);
+  for (int t(1); t < state.num_thread; ++t) {
+    threads[t - 1].join();
+    if (0 == is_succeeded[t]) result = false;
+  }
+  return result;
+}
+
+void DynamicTimeWarping::Initialize() {
+  if (num_order_ < 0 || !distance_calculator_.IsValid() ||
+      global_path_constraint_ < kNone ||
+      kNumGlobalPathConstraints <= global_path_constraint_ ||
+      (kSakoeChibaBand == global_path_constraint_ &&
+       global_path_constraint_parameter_ < 0.0) ||
+      (kItakuraParallelogram == global_path_constraint_ &&
+       global_path_constraint_parameter_ < 1.0)) {
     is_valid_ = false;
     return;
   }
@@ -127,121 +680,4 @@ DynamicTimeWarping::DynamicTimeWarping(
   }
 }
 
-bool DynamicTimeWarping::Run(
-    const std::vector<std::vector<double> >& query_vector_sequence,
-    const std::vector<std::vector<double> >& reference_vector_sequence,
-    std::vector<std::pair<int, int> >* viterbi_path,
-    double* total_score) const {
-  // check inputs
-  if (!is_valid_ || query_vector_sequence.empty() ||
-      reference_vector_sequence.empty() || NULL == viterbi_path ||
-      NULL == total_score) {
-    return false;
-  }
-
-  const int num_candidate(local_path_candidates_.size());
-  const int num_query_vector(query_vector_sequence.size());
-  const int num_reference_vector(reference_vector_sequence.size());
-
-  std::vector<std::vector<Cell> > cell(num_query_vector,
-                                       std::vector<Cell>(num_reference_vector));
-  std::vector<std::vector<Cell> > cell_for_skip_transition(
-      num_query_vector, std::vector<Cell>(num_reference_vector));
-
-  const bool includes_skip_transition(
-      (kType5 == local_path_constraint_ || kType7 == local_path_constraint_)
-          ? true
-          : false);
-
-  for (int i(0); i < num_query_vector; ++i) {
-    for (int j(0); j < num_reference_vector; ++j) {
-      double local_distance;
-      if (!distance_calculator_.Run(query_vector_sequence[i],
-                                    reference_vector_sequence[j],
-                                    &local_distance)) {
-        return false;
-      }
-
-      double best_score_of_all_paths((0 == i && 0 == j) ? local_distance
-                                                        : DBL_MAX);
-      int best_i_of_all_paths(-1), best_j_of_all_paths(-1);
-
-      double best_score_of_diagonal_paths(DBL_MAX);
-      int best_i_of_diagonal_paths(-1), best_j_of_diagonal_paths(-1);
-
-      for (int k(0); k < num_candidate; ++k) {
-        const int i_k(i - local_path_candidates_[k].first);
-        const int j_k(j - local_path_candidates_[k].second);
-        if (0 <= i_k && 0 <= j_k) {
-          double score;
-          if (includes_skip_transition && (i_k == i || j_k == j)) {
-            score = local_path_weights_[k] * local_distance +
-                    cell_for_skip_transition[i_k][j_k].score;
-          } else {
-            score =
-                local_path_weights_[k] * local_distance + cell[i_k][j_k].score;
-          }
-
-          if (includes_skip_transition && (i_k != i && j_k != j) &&
-              score < best_score_of_diagonal_paths) {
-            best_score_of_diagonal_paths = score;
-            best_i_of_diagonal_paths = i_k;
-            best_j_of_diagonal_paths = j_k;
-          }
-          if (score < best_score_of_all_paths) {
-            best_score_of_all_paths = score;
-            best_i_of_all_paths = i_k;
-            best_j_of_all_paths = j_k;
-          }
-        }
-      }
-
-      if (includes_skip_transition) {
-        cell_for_skip_transition[i][j].score = best_score_of_diagonal_paths;
-        cell_for_skip_transition[i][j].horizontal_back_pointer =
-            best_i_of_diagonal_paths;
-        cell_for_skip_transition[i][j].vertical_back_pointer =
-            best_j_of_diagonal_paths;
-      }
-      cell[i][j].score = best_score_of_all_paths;
-      cell[i][j].horizontal_back_pointer = best_i_of_all_paths;
-      cell[i][j].vertical_back_pointer = best_j_of_all_paths;
-    }
-  }
-
-  if (DBL_MAX == cell[num_query_vector - 1][num_reference_vector - 1].score) {
-    return false;
-  }
-
-  *total_score = cell[num_query_vector - 1][num_reference_vector - 1].score /
-                 (num_query_vector + num_reference_vector);
-
-  {
-    bool skip_transition(false);
-    int i(num_query_vector - 1);
-    int j(num_reference_vector - 1);
-    viterbi_path->clear();
-    viterbi_path->push_back(std::make_pair(i, j));
-    while (0 <= i && 0 <= j) {
-      const int prev_i(
-          (includes_skip_transition && skip_transition)
-              ? cell_for_skip_transition[i][j].horizontal_back_pointer
-              : cell[i][j].horizontal_back_pointer);
-      const int prev_j(
-          (includes_skip_transition && skip_transition)
-              ? cell_for_skip_transition[i][j].vertical_back_pointer
-              : cell[i][j].vertical_back_pointer);
-      if (0 <= prev_i && 0 <= prev_j) {
-        viterbi_path->push_back(std::make_pair(prev_i, prev_j));
-      }
-      skip_transition = (prev_i == i || prev_j == j) ? true : false;
-      i = prev_i;
-      j = prev_j;
-    }
-    std::reverse(viterbi_path->begin(), viterbi_path->end());
-  }
-
-  return true;
-}
-
 }  // namespace sptk
@@ -44,17 +44,107 @@
 
 #include "SPTK/math/fast_fourier_transform.h"
 
-#include <algorithm>  // std::copy, std::fill
-#include <cmath>      // std::sin
+#include <algorithm>  // std::copy, std::fill, std::swap
+#include <cmath>      // std::cos, std::sin
 #include <cstddef>    // std::size_t
 
+#include "SPTK/utils/simd.h"
+
+namespace {
+
+// Real and imaginary parts are stored separately, so each lane of the vector
+// holds an independent butterfly.
+using sptk::simd::Add;
+using sptk::simd::Load;
+using sptk::simd::Multiply;
+using sptk::simd::Store;
+using sptk::simd::Subtract;
+
+// Performs radix-4 decimation-in-time butterflies on a block of length 4q.
+// The twiddle factors w are stored as cos(2 pi k i / 4q) and sin(2 pi k i / 4q)
+// for k = 1, 2, 3 in the order of c1, s1, c2, s2, c3, s3 (each of length q).
+template <typename T>
+void RunRadix4Butterflies(int q, const T* w, T* x, T* y) {
+  typedef typename sptk::simd::VectorTraits<T>::Type Vector;
+  const int kVectorLength(sptk::simd::VectorTraits<T>::kLength);
+  const T* c1(w);
+  const T* s1(w + q);
+  const T* c2(w + 2 * q);
+  const T* s2(w + 3 * q);
+  const T* c3(w + 4 * q);
+  const T* s3(w + 5 * q);
+  T* x0(x);
+  T* y0(y);
+  T* x1(x + q);
+  T* y1(y + q);
+  T* x2(x + 2 * q);
+  T* y2(y + 2 * q);
+  T* x3(x + 3 * q);
+  T* y3(y + 3 * q);
+
+  int i(0);
+  for (; i + kVectorLength <= q; i += kVectorLength) {
+    const Vector ar(Load(x0 + i)), ai(Load(y0 + i));
+    const Vector xr1(Load(x1 + i)), xi1(Load(y1 + i));
+    const Vector xr2(Load(x2 + i)), xi2(Load(y2 + i));
+    const Vector xr3(Load(x3 + i)), xi3(Load(y3 + i));
+    const Vector wc1(Load(c1 + i)), ws1(Load(s1 + i));
+    const Vector wc2(Load(c2 + i)), ws2(Load(s2 + i));
+    const Vector wc3(Load(c3 + i)), ws3(Load(s3 + i));
+    // Multiply by exp(-j 2 pi k i / 4q).
+    const Vector br(Add(Multiply(xr1, wc2), Multiply(xi1, ws2)));
+    const Vector bi(Subtract(Multiply(xi1, wc2), Multiply(xr1, ws2)));
+    const Vector cr(Add(Multiply(xr2, wc1), Multiply(xi2, ws1)));
+    const Vector ci(Subtract(Multiply(xi2, wc1), Multiply(xr2, ws1)));
+    const Vector dr(Add(Multiply(xr3, wc3), Multiply(xi3, ws3)));
+    const Vector di(Subtract(Multiply(xi3, wc3), Multiply(xr3, ws3)));
+    const Vector t0r(Add(ar, br)), t0i(Add(ai, bi));
+    const Vector t1r(Subtract(ar, br)), t1i(Subtract(ai, bi));
+    const Vector t2r(Add(cr, dr)), t2i(Add(ci, di));
+    const Vector t3r(Subtract(cr, dr)), t3i(Subtract(ci, di));
+    Store(Add(t0r, t2r), x0 + i);
+    Store(Add(t0i, t2i), y0 + i);
+    Store(Add(t1r, t3i), x1 + i);
+    Store(Subtract(t1i, t3r), y1 + i);
+    Store(Subtract(t0r, t2r), x2 + i);
+    Store(Subtract(t0i, t2i), y2 + i);
+    Store(Subtract(t1r, t3i), x3 + i);
+    Store(Add(t1i, t3r), y3 + i);
+  }
+  for (; i < q; ++i) {
+    const T br(x1[i] * c2[i] + y1[i] * s2[i]);
+    const T bi(y1[i] * c2[i] - x1[i] * s2[i]);
+    const T cr(x2[i] * c1[i] + y2[i] * s1[i]);
+    const T ci(y2[i] * c1[i] - x2[i] * s1[i]);
+    const T dr(x3[i] * c3[i] + y3[i] * s3[i]);
+    const T di(y3[i] * c3[i] - x3[i] * s3[i]);
+    const T t0r(x0[i] + br), t0i(y0[i] + bi);
+    const T t1r(x0[i] - br), t1i(y0[i] - bi);
+    const T t2r(cr + dr), t2i(ci + di);
+    const T t3r(cr - dr), t3i(ci - di);
+    x0[i] = t0r + t2r;
+    y0[i] = t0i + t2i;
+    x1[i] = t1r + t3i;
+    y1[i] = t1i - t3r;
+    x2[i] = t0r - t2r;
+    y2[i] = t0i - t2i;
+    x3[i] = t1r - t3i;
+    y3[i] = t1i + t3r;
+  }
+}
+
+}  // namespace
+
 namespace sptk {
 
-FastFourierTransform::FastFourierTransform(int fft_length)
-    : FastFourierTransform(fft_length - 1, fft_length) {
+template <typename T>
+FastFourierTransformBase<T>::FastFourierTransformBase(int fft_length)
+    : FastFourierTransformBase(fft_length - 1, fft_length) {
 }
 
-FastFourierTransform::FastFourierTransform(int num_order, int fft_length)
+template <typename T>
+FastFourierTransformBase<T>::FastFourierTransformBase(int num_order,
+                                                      int fft_length)
     : num_order_(num_order),
       fft_length_(fft_length),
       half_fft_length_(fft_length_ / 2),
@@ -65,20 +155,38 @@ FastFourierTransform::FastFourierTransform(int num_order, int fft_length)
     return;
   }
 
-  const int table_size(fft_length_ - fft_length_ / 4 + 1);
-  const double argument(sptk::kPi / fft_length_ * 2);
-  sine_table_.resize(table_size);
-  for (int i(0); i < table_size; ++i) {
-    sine_table_[i] = std::sin(argument * i);
+  // Make bit reversal table.
+  bit_reversal_table_.resize(fft_length_);
+  bit_reversal_table_[0] = 0;
+  for (int i(1); i < fft_length_; ++i) {
+    bit_reversal_table_[i] = (bit_reversal_table_[i / 2] / 2) |
+                             ((i & 1) ? half_fft_length_ : 0);
+  }
+
+  // Make twiddle factors of radix-4 stages. If the FFT length is an odd power
+  // of two, a radix-2 stage is performed first. Otherwise, the first radix-4
+  // stage needs no multiplication.
+  int n(1);
+  while (n < fft_length_) n *= 4;
+  for (int q(n == fft_length_ ? 4 : 2); 4 * q <= fft_length_; q *= 4) {
+    const double argument(sptk::kPi * 2.0 / (4 * q));
+    for (int k(1); k <= 3; ++k) {
+      for (int i(0); i < q; ++i) {
+        twiddle_factor_.push_back(static_cast<T>(std::cos(argument * k * i)));
+      }
+      for (int i(0); i < q; ++i) {
+        twiddle_factor_.push_back(static_cast<T>(std::sin(argument * k * i)));
+      }
+    }
   }
-  sine_table_[fft_length_ / 2] = 0.0;
 }
 
-bool FastFourierTransform::Run(
-    const std::vector<double>& real_part_input,
-    const std::vector<double>& imaginary_part_input,
-    std::vector<double>* real_part_output,
-    std::vector<double>* imaginary_part_output) const {
+template <typename T>
+bool FastFourierTransformBase<T>::Run(
+    const std::vector<T>& real_part_input,
+    const std::vector<T>& imaginary_part_input,
+    std::vector<T>* real_part_output,
+    std::vector<T>* imaginary_part_output) const {
   // Check inputs.
   if (!is_valid_ ||
       real_part_input.size() != static_cast<std::size_t>(num_order_ + 1) ||
@@ -87,6 +195,11 @@ bool FastFourierTransform::Run(
     return false;
   }
 
+  const bool in_place(&real_part_input == real_part_output ||
+                      &real_part_input == imaginary_part_output ||
+                      &imaginary_part_input == real_part_output ||
+                      &imaginary_part_input == imaginary_part_output);
+
   // Prepare memories.
   if (real_part_output->size() != static_cast<std::size_t>(fft_length_)) {
     real_part_output->resize(fft_length_);
@@ -95,97 +208,105 @@ bool FastFourierTransform::Run(
     imaginary_part_output->resize(fft_length_);
   }
 
-  // Copy inputs and fill zero.
-  std::copy(real_part_input.begin(), real_part_input.end(),
-            real_part_output->begin());
-  std::fill(real_part_output->begin() + real_part_input.size(),
-            real_part_output->end(), 0.0);
-  std::copy(imaginary_part_input.begin(), imaginary_part_input.end(),
-            imaginary_part_output->begin());
-  std::fill(imaginary_part_output->begin() + imaginary_part_input.size(),
-            imaginary_part_output->end(), 0.0);
-
-  double* x(&((*real_part_output)[0]));
-  double* y(&((*imaginary_part_output)[0]));
+  T* x(&((*real_part_output)[0]));
+  T* y(&((*imaginary_part_output)[0]));
 
-  {
-    int lix(fft_length_);
-    int lmx(half_fft_length_);
-    int lf(1);
-    while (1 < lmx) {
-      const double* sinp(&(sine_table_[0]));
-      const double* cosp(&(sine_table_[0]) + fft_length_ / 4);
-      for (int i(0); i < lmx; ++i) {
-        double* xpi(&(x[i]));
-        double* ypi(&(y[i]));
-        for (int li(lix); li <= fft_length_; li += lix) {
-          const double t1(*(xpi) - *(xpi + lmx));
-          const double t2(*(ypi) - *(ypi + lmx));
-          *(xpi) += *(xpi + lmx);
-          *(ypi) += *(ypi + lmx);
-          *(xpi + lmx) = *cosp * t1 + *sinp * t2;
-          *(ypi + lmx) = *cosp * t2 - *sinp * t1;
-          xpi += lix;
-          ypi += lix;
-        }
-        sinp += lf;
-        cosp += lf;
-      }
-      lix = lmx;
-      lmx /= 2;
-      lf *= 2;
+  // Copy inputs in bit reversed order and fill zero.
+  if (in_place) {
+    const int input_length(num_order_ + 1);
+    if (&real_part_input != real_part_output) {
+      std::copy(real_part_input.begin(), real_part_input.end(), x);
+    }
+    if (&imaginary_part_input != imaginary_part_output) {
+      std::copy(imaginary_part_input.begin(), imaginary_part_input.end(), y);
+    }
+    std::fill(x + input_length, x + fft_length_, 0.0);
+    std::fill(y + input_length, y + fft_length_, 0.0);
+    RunInPlace(x, y);
+  } else {
+    std::fill(x, x + fft_length_, 0.0);
+    std::fill(y, y + fft_length_, 0.0);
+    for (int i(0); i <= num_order_; ++i) {
+      const int j(bit_reversal_table_[i]);
+      x[j] = real_part_input[i];
+      y[j] = imaginary_part_input[i];
     }
+    RunButterflies(x, y);
   }
 
-  {
-    double* xp(x);
-    double* yp(y);
-    for (int li(0); li < half_fft_length_; ++li) {
-      const double t1(*(xp) - *(xp + 1));
-      const double t2(*(yp) - *(yp + 1));
-      *(xp) += *(xp + 1);
-      *(yp) += *(yp + 1);
-      *(xp + 1) = t1;
-      *(yp + 1) = t2;
-      xp += 2;
-      yp += 2;
+  return true;
+}
+
+template <typename T>
+bool FastFourierTransformBase<T>::Run(std::vector<T>* real_part,
+                                      std::vector<T>* imag_part) const {
+  if (NULL == real_part || NULL == imag_part) return false;
+  return Run(*real_part, *imag_part, real_part, imag_part);
+}
+
+template <typename T>
+void FastFourierTransformBase<T>::RunInPlace(T* x, T* y) const {
+  // Bit reversal.
+  for (int i(0); i < fft_length_; ++i) {
+    const int j(bit_reversal_table_[i]);
+    if (i < j) {
+      std::swap(x[i], x[j]);
+      std::swap(y[i], y[j]);
     }
   }
 
-  // Bit reversal.
+  RunButterflies(x, y);
+}
+
+template <typename T>
+void FastFourierTransformBase<T>::RunButterflies(T* x, T* y) const {
+  int q;
   {
-    double* xp(x);
-    double* yp(y);
-    const int dec_fft_length(fft_length_ - 1);
-    for (int lmx(0), j(0); lmx < dec_fft_length; ++lmx) {
-      const int lmxj(lmx - j);
-      if (lmxj < 0) {
-        const double t1(*(xp));
-        const double t2(*(yp));
-        *(xp) = *(xp + lmxj);
-        *(yp) = *(yp + lmxj);
-        *(xp + lmxj) = t1;
-        *(yp + lmxj) = t2;
-      }
+    int n(1);
+    while (n < fft_length_) n *= 4;
+    q = (n == fft_length_) ? 1 : 2;
+  }
 
-      int li(half_fft_length_);
-      while (li <= j) {
-        j -= li;
-        li /= 2;
-      }
-      j += li;
-      xp = x + j;
-      yp = y + j;
+  // Radix-2 stage.
+  if (2 == q) {
+    for (int i(0); i < fft_length_; i += 2) {
+      const T t1(x[i] - x[i + 1]);
+      const T t2(y[i] - y[i + 1]);
+      x[i] += x[i + 1];
+      y[i] += y[i + 1];
+      x[i + 1] = t1;
+      y[i + 1] = t2;
     }
   }
 
-  return true;
+  // Radix-4 stages.
+  if (1 == q && 4 <= fft_length_) {
+    for (int i(0); i < fft_length_; i += 4) {
+      const T t0r(x[i] + x[i + 1]), t0i(y[i] + y[i + 1]);
+      const T t1r(x[i] - x[i + 1]), t1i(y[i] - y[i + 1]);
+      const T t2r(x[i + 2] + x[i + 3]), t2i(y[i + 2] + y[i + 3]);
+      const T t3r(x[i + 2] - x[i + 3]), t3i(y[i + 2] - y[i + 3]);
+      x[i] = t0r + t2r;
+      y[i] = t0i + t2i;
+      x[i + 1] = t1r + t3i;
+      y[i + 1] = t1i - t3r;
+      x[i + 2] = t0r - t2r;
+      y[i + 2] = t0i - t2i;
+      x[i + 3] = t1r - t3i;
+      y[i + 3] = t1i + t3r;
+    }
+    q = 4;
+  }
+  const T* w(twiddle_factor_.empty() ? NULL : &(twiddle_factor_[0]));
+  for (; 4 * q <= fft_length_; q *= 4) {
+    for (int i(0); i < fft_length_; i += 4 * q) {
+      RunRadix4Butterflies(q, w, x + i, y + i);
+    }
+    w += 6 * q;
+  }
 }
 
-bool FastFourierTransform::Run(std::vector<double>* real_part,
-                               std::vector<double>* imag_part) const {
-  if (NULL == real_part || NULL == imag_part) return false;
-  return Run(*real_part, *imag_part, real_part, imag_part);
-}
+template class FastFourierTransformBase<float>;
+template class FastFourierTransformBase<double>;
 
 }  // namespace sptk
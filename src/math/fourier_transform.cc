@@ -44,8 +44,8 @@
 
 #include "SPTK/math/fourier_transform.h"
 
-#include "SPTK/math/discrete_fourier_transform.h"
 #include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/math/mixed_radix_fast_fourier_transform.h"
 
 namespace {
 
@@ -73,29 +73,29 @@ class FastFourierTransformWrapper
   DISALLOW_COPY_AND_ASSIGN(FastFourierTransformWrapper);
 };
 
-class DiscreteFourierTransformWrapper
+class MixedRadixFastFourierTransformWrapper
     : public sptk::FourierTransform::FourierTransformInterface {
  public:
-  explicit DiscreteFourierTransformWrapper(int dft_length)
-      : discrete_fourier_tranform_(dft_length) {
+  explicit MixedRadixFastFourierTransformWrapper(int fft_length)
+      : mixed_radix_fast_fourier_tranform_(fft_length) {
   }
-  virtual ~DiscreteFourierTransformWrapper() {
+  virtual ~MixedRadixFastFourierTransformWrapper() {
   }
   virtual bool IsValid() const {
-    return discrete_fourier_tranform_.IsValid();
+    return mixed_radix_fast_fourier_tranform_.IsValid();
   }
   virtual bool Run(const std::vector<double>& real_part_input,
                    const std::vector<double>& imaginary_part_input,
                    std::vector<double>* real_part_output,
                    std::vector<double>* imaginary_part_output) const {
-    return discrete_fourier_tranform_.Run(real_part_input, imaginary_part_input,
-                                          real_part_output,
-                                          imaginary_part_output);
+    return mixed_radix_fast_fourier_tranform_.Run(
+        real_part_input, imaginary_part_input, real_part_output,
+        imaginary_part_output);
   }
 
  private:
-  const sptk::DiscreteFourierTransform discrete_fourier_tranform_;
-  DISALLOW_COPY_AND_ASSIGN(DiscreteFourierTransformWrapper);
+  const sptk::MixedRadixFastFourierTransform mixed_radix_fast_fourier_tranform_;
+  DISALLOW_COPY_AND_ASSIGN(MixedRadixFastFourierTransformWrapper);
 };
 
 }  // namespace
@@ -106,7 +106,7 @@ FourierTransform::FourierTransform(int data_length) {
   if (sptk::IsPowerOfTwo(data_length)) {
     fourier_transform_ = new FastFourierTransformWrapper(data_length);
   } else {
-    fourier_transform_ = new DiscreteFourierTransformWrapper(data_length);
+    fourier_transform_ = new MixedRadixFastFourierTransformWrapper(data_length);
   }
 }
 
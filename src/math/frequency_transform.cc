@@ -49,8 +49,10 @@
 
 namespace sptk {
 
-FrequencyTransform::FrequencyTransform(int num_input_order,
-                                       int num_output_order, double alpha)
+template <typename T>
+FrequencyTransformBase<T>::FrequencyTransformBase(int num_input_order,
+                                                  int num_output_order,
+                                                  double alpha)
     : num_input_order_(num_input_order),
       num_output_order_(num_output_order),
       alpha_(alpha),
@@ -62,9 +64,11 @@ FrequencyTransform::FrequencyTransform(int num_input_order,
   }
 }
 
-bool FrequencyTransform::Run(const std::vector<double>& minimum_phase_sequence,
-                             std::vector<double>* warped_sequence,
-                             FrequencyTransform::Buffer* buffer) const {
+template <typename T>
+bool FrequencyTransformBase<T>::Run(
+    const std::vector<T>& minimum_phase_sequence,
+    std::vector<T>* warped_sequence,
+    FrequencyTransformBase::Buffer* buffer) const {
   // Check inputs.
   const int input_length(num_input_order_ + 1);
   if (!is_valid_ ||
@@ -99,26 +103,30 @@ bool FrequencyTransform::Run(const std::vector<double>& minimum_phase_sequence,
 
   std::fill(warped_sequence->begin(), warped_sequence->end(), 0.0);
 
-  const double beta(1.0 - alpha_ * alpha_);
-  const double* c(&(minimum_phase_sequence[0]));
-  double* d(&buffer->d_[0]);
-  double* g(&((*warped_sequence)[0]));
+  const T alpha(static_cast<T>(alpha_));
+  const T beta(static_cast<T>(1.0 - alpha_ * alpha_));
+  const T* c(&(minimum_phase_sequence[0]));
+  T* d(&buffer->d_[0]);
+  T* g(&((*warped_sequence)[0]));
 
   // Apply recursive formula.
   for (int i(num_input_order_); 0 <= i; --i) {
     d[0] = g[0];
-    g[0] = c[i] + alpha_ * d[0];
+    g[0] = c[i] + alpha * d[0];
     if (1 <= num_output_order_) {
       d[1] = g[1];
-      g[1] = beta * d[0] + alpha_ * d[1];
+      g[1] = beta * d[0] + alpha * d[1];
     }
     for (int m(2); m <= num_output_order_; ++m) {
       d[m] = g[m];
-      g[m] = d[m - 1] + alpha_ * (d[m] - g[m - 1]);
+      g[m] = d[m - 1] + alpha * (d[m] - g[m - 1]);
     }
   }
 
   return true;
 }
 
+template class FrequencyTransformBase<float>;
+template class FrequencyTransformBase<double>;
+
 }  // namespace sptk
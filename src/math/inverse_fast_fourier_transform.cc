@@ -48,41 +48,48 @@
 
 namespace sptk {
 
-InverseFastFourierTransform::InverseFastFourierTransform(int fft_length)
-    : InverseFastFourierTransform(fft_length - 1, fft_length) {
+template <typename T>
+InverseFastFourierTransformBase<T>::InverseFastFourierTransformBase(
+    int fft_length)
+    : InverseFastFourierTransformBase(fft_length - 1, fft_length) {
 }
 
-InverseFastFourierTransform::InverseFastFourierTransform(int num_order,
-                                                         int fft_length)
+template <typename T>
+InverseFastFourierTransformBase<T>::InverseFastFourierTransformBase(
+    int num_order, int fft_length)
     : fast_fourier_transform_(num_order, fft_length) {
 }
 
-bool InverseFastFourierTransform::Run(
-    const std::vector<double>& real_part_input,
-    const std::vector<double>& imag_part_input,
-    std::vector<double>* real_part_output,
-    std::vector<double>* imag_part_output) const {
+template <typename T>
+bool InverseFastFourierTransformBase<T>::Run(
+    const std::vector<T>& real_part_input,
+    const std::vector<T>& imag_part_input, std::vector<T>* real_part_output,
+    std::vector<T>* imag_part_output) const {
   if (!fast_fourier_transform_.Run(imag_part_input, real_part_input,
                                    imag_part_output, real_part_output)) {
     return false;
   }
 
   const int fft_length(fast_fourier_transform_.GetFftLength());
-  const double z(1.0 / fft_length);
+  const T z(static_cast<T>(1.0 / fft_length));
   std::transform(real_part_output->begin(),
                  real_part_output->begin() + fft_length,
-                 real_part_output->begin(), [z](double x) { return x * z; });
+                 real_part_output->begin(), [z](T x) { return x * z; });
   std::transform(imag_part_output->begin(),
                  imag_part_output->begin() + fft_length,
-                 imag_part_output->begin(), [z](double x) { return x * z; });
+                 imag_part_output->begin(), [z](T x) { return x * z; });
 
   return true;
 }
 
-bool InverseFastFourierTransform::Run(std::vector<double>* real_part,
-                                      std::vector<double>* imag_part) const {
+template <typename T>
+bool InverseFastFourierTransformBase<T>::Run(std::vector<T>* real_part,
+                                             std::vector<T>* imag_part) const {
   if (NULL == real_part || NULL == imag_part) return false;
   return Run(*real_part, *imag_part, real_part, imag_part);
 }
 
+template class InverseFastFourierTransformBase<float>;
+template class InverseFastFourierTransformBase<double>;
+
 }  // namespace sptk
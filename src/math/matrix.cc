@@ -48,11 +48,66 @@
 #include <functional>  // std::minus, std::negate, std::plus
 #include <stdexcept>   // std::logic_error, std::out_of_range
 
+#include "SPTK/utils/simd.h"
+
 namespace {
 
+using sptk::simd::Add;
+using sptk::simd::Broadcast;
+using sptk::simd::kVectorLength;
+using sptk::simd::Load;
+using sptk::simd::Multiply;
+using sptk::simd::Store;
+using sptk::simd::Vector;
+
 const char* kErrorMessageForOutOfRange("Matrix: Out of range");
 const char* kErrorMessageForLogicError("Matrix: Matrix sizes do not match");
 
+// Tile size of inner and column dimensions in matrix multiplication. A tile of
+// the second matrix (64 x 64 doubles) fits in L2 cache.
+const int kBlockSize(64);
+
+// Returns c + a * b. Multiplication and addition are not fused so that the
+// result does not depend on the instruction set.
+inline Vector MultiplyAdd(Vector a, Vector b, Vector c) {
+  return Add(c, Multiply(a, b));
+}
+
+// Updates a 4 x (2 * kVectorLength) block of the output matrix c by
+// c[i][j] += a[i][k] * b[k][j] (k = k_begin, ..., k_end - 1). The block is kept
+// in registers during the update.
+inline void UpdateBlock(const double* const* a, const double* const* b,
+                        int k_begin, int k_end, int j, double* const* c) {
+  Vector c00(Load(c[0] + j)), c01(Load(c[0] + j + kVectorLength));
+  Vector c10(Load(c[1] + j)), c11(Load(c[1] + j + kVectorLength));
+  Vector c20(Load(c[2] + j)), c21(Load(c[2] + j + kVectorLength));
+  Vector c30(Load(c[3] + j)), c31(Load(c[3] + j + kVectorLength));
+  for (int k(k_begin); k < k_end; ++k) {
+    const Vector b0(Load(b[k] + j));
+    const Vector b1(Load(b[k] + j + kVectorLength));
+    const Vector a0(Broadcast(a[0][k]));
+    c00 = MultiplyAdd(a0, b0, c00);
+    c01 = MultiplyAdd(a0, b1, c01);
+    const Vector a1(Broadcast(a[1][k]));
+    c10 = MultiplyAdd(a1, b0, c10);
+    c11 = MultiplyAdd(a1, b1, c11);
+    const Vector a2(Broadcast(a[2][k]));
+    c20 = MultiplyAdd(a2, b0, c20);
+    c21 = MultiplyAdd(a2, b1, c21);
+    const Vector a3(Broadcast(a[3][k]));
+    c30 = MultiplyAdd(a3, b0, c30);
+    c31 = MultiplyAdd(a3, b1, c31);
+  }
+  Store(c00, c[0] + j);
+  Store(c01, c[0] + j + kVectorLength);
+  Store(c10, c[1] + j);
+  Store(c11, c[1] + j + kVectorLength);
+  Store(c20, c[2] + j);
+  Store(c21, c[2] + j + kVectorLength);
+  Store(c30, c[3] + j);
+  Store(c31, c[3] + j + kVectorLength);
+}
+
 }  // namespace
 
 namespace sptk {
@@ -148,32 +203,34 @@ Matrix& Matrix::operator-=(const Matrix& matrix) {
 }
 
 Matrix& Matrix::operator*=(const Matrix& matrix) {
-  *this = *this * matrix;
+  Matrix result;
+  if (!Multiply(*this, matrix, &result)) {
+    throw std::logic_error(kErrorMessageForLogicError);
+  }
+  num_row_ = result.num_row_;
+  num_column_ = result.num_column_;
+  data_.swap(result.data_);
+  index_.swap(result.index_);
   return *this;
 }
 
 Matrix Matrix::operator+(const Matrix& matrix) const {
   Matrix result(*this);
-  return result += matrix;
+  result += matrix;
+  return result;
 }
 
 Matrix Matrix::operator-(const Matrix& matrix) const {
   Matrix result(*this);
-  return result -= matrix;
+  result -= matrix;
+  return result;
 }
 
 Matrix Matrix::operator*(const Matrix& matrix) const {
-  if (num_column_ != matrix.num_row_) {
+  Matrix result;
+  if (!Multiply(*this, matrix, &result)) {
     throw std::logic_error(kErrorMessageForLogicError);
   }
-  Matrix result(num_row_, matrix.num_column_);
-  for (int i(0); i < num_row_; ++i) {
-    for (int j(0); j < matrix.num_column_; ++j) {
-      for (int k(0); k < num_column_; ++k) {
-        result.index_[i][j] += index_[i][k] * matrix.index_[k][j];
-      }
-    }
-  }
   return result;
 }
 
@@ -183,6 +240,105 @@ Matrix Matrix::operator-() const {
   return result;
 }
 
+bool Matrix::Add(const Matrix& first_matrix, const Matrix& second_matrix,
+                 Matrix* output) {
+  if (first_matrix.num_row_ != second_matrix.num_row_ ||
+      first_matrix.num_column_ != second_matrix.num_column_ ||
+      NULL == output) {
+    return false;
+  }
+
+  if (output->num_row_ != first_matrix.num_row_ ||
+      output->num_column_ != first_matrix.num_column_) {
+    output->Resize(first_matrix.num_row_, first_matrix.num_column_);
+  }
+
+  std::transform(first_matrix.data_.begin(), first_matrix.data_.end(),
+                 second_matrix.data_.begin(), output->data_.begin(),
+                 std::plus<double>());
+  return true;
+}
+
+bool Matrix::Subtract(const Matrix& first_matrix, const Matrix& second_matrix,
+                      Matrix* output) {
+  if (first_matrix.num_row_ != second_matrix.num_row_ ||
+      first_matrix.num_column_ != second_matrix.num_column_ ||
+      NULL == output) {
+    return false;
+  }
+
+  if (output->num_row_ != first_matrix.num_row_ ||
+      output->num_column_ != first_matrix.num_column_) {
+    output->Resize(first_matrix.num_row_, first_matrix.num_column_);
+  }
+
+  std::transform(first_matrix.data_.begin(), first_matrix.data_.end(),
+                 second_matrix.data_.begin(), output->data_.begin(),
+                 std::minus<double>());
+  return true;
+}
+
+bool Matrix::Multiply(const Matrix& first_matrix, const Matrix& second_matrix,
+                      Matrix* output) {
+  if (first_matrix.num_column_ != second_matrix.num_row_ || NULL == output ||
+      output == &first_matrix || output == &second_matrix) {
+    return false;
+  }
+
+  const int num_row(first_matrix.num_row_);
+  const int num_column(second_matrix.num_column_);
+  const int num_inner(first_matrix.num_column_);
+  if (output->num_row_ != num_row || output->num_column_ != num_column) {
+    output->Resize(num_row, num_column);
+  } else {
+    output->Fill(0.0);
+  }
+  if (0 == num_row || 0 == num_column || 0 == num_inner) {
+    return true;
+  }
+
+  // The product is accumulated tile by tile. Within a tile, 4 x (2 *
+  // kVectorLength) blocks of the output are updated in registers and the
+  // remaining rows and columns are updated by scalar loops. The summation
+  // order over k is the same as that of the naive triple loop.
+  const double* const* a(&(first_matrix.index_[0]));
+  const double* const* b(&(second_matrix.index_[0]));
+  double* const* c(&(output->index_[0]));
+  const int block_width(2 * kVectorLength);
+  for (int k_begin(0); k_begin < num_inner; k_begin += kBlockSize) {
+    const int k_end(std::min(k_begin + kBlockSize, num_inner));
+    for (int j_begin(0); j_begin < num_column; j_begin += kBlockSize) {
+      const int j_end(std::min(j_begin + kBlockSize, num_column));
+      const int j_vector_end(j_begin +
+                             (j_end - j_begin) / block_width * block_width);
+      int i(0);
+      for (; i + 4 <= num_row; i += 4) {
+        for (int j(j_begin); j < j_vector_end; j += block_width) {
+          UpdateBlock(a + i, b, k_begin, k_end, j, c + i);
+        }
+        for (int r(i); r < i + 4; ++r) {
+          for (int k(k_begin); k < k_end; ++k) {
+            const double ark(a[r][k]);
+            for (int j(j_vector_end); j < j_end; ++j) {
+              c[r][j] += ark * b[k][j];
+            }
+          }
+        }
+      }
+      for (; i < num_row; ++i) {
+        for (int k(k_begin); k < k_end; ++k) {
+          const double aik(a[i][k]);
+          for (int j(j_begin); j < j_end; ++j) {
+            c[i][j] += aik * b[k][j];
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
 void Matrix::Fill(double value) {
   std::fill(data_.begin(), data_.end(), value);
 }
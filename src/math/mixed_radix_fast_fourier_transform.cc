@@ -0,0 +1,388 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/math/mixed_radix_fast_fourier_transform.h"
+
+#include <cmath>    // std::cos, std::sin
+#include <cstddef>  // std::size_t
+
+namespace {
+
+const double kCos72(0.309016994374947);   // cos(2pi/5)
+const double kCos144(-0.809016994374947);  // cos(4pi/5)
+const double kSin60(0.866025403784439);   // sin(2pi/3)
+const double kSin72(0.951056516295154);   // sin(2pi/5)
+const double kSin144(0.587785252292473);  // sin(4pi/5)
+
+}  // namespace
+
+namespace sptk {
+
+MixedRadixFastFourierTransform::MixedRadixFastFourierTransform(int fft_length)
+    : fft_length_(fft_length), is_valid_(true), fast_fourier_transform_(NULL) {
+  if (fft_length_ <= 0) {
+    is_valid_ = false;
+    return;
+  }
+
+  // Factorize DFT length.
+  int remainder(fft_length_);
+  while (0 == remainder % 4) {
+    radices_.push_back(4);
+    remainder /= 4;
+  }
+  while (0 == remainder % 2) {
+    radices_.push_back(2);
+    remainder /= 2;
+  }
+  while (0 == remainder % 3) {
+    radices_.push_back(3);
+    remainder /= 3;
+  }
+  while (0 == remainder % 5) {
+    radices_.push_back(5);
+    remainder /= 5;
+  }
+
+  if (1 == remainder) {
+    // Make permutation table by mixed-radix digit reversal.
+    permutation_table_.assign(1, 0);
+    for (std::vector<int>::const_iterator radix(radices_.begin());
+         radix != radices_.end(); ++radix) {
+      const int span(static_cast<int>(permutation_table_.size()));
+      std::vector<int> next_permutation_table(span * *radix);
+      for (int q(0); q < *radix; ++q) {
+        for (int p(0); p < span; ++p) {
+          next_permutation_table[q * span + p] =
+              *radix * permutation_table_[p] + q;
+        }
+      }
+      permutation_table_.swap(next_permutation_table);
+    }
+
+    // Make twiddle factor table.
+    cosine_table_.reserve(fft_length_);
+    sine_table_.reserve(fft_length_);
+    int span(1);
+    for (std::vector<int>::const_iterator radix(radices_.begin());
+         radix != radices_.end(); ++radix) {
+      const double argument(sptk::kTwoPi / (span * *radix));
+      for (int j(0); j < span; ++j) {
+        for (int q(1); q < *radix; ++q) {
+          cosine_table_.push_back(std::cos(argument * j * q));
+          sine_table_.push_back(std::sin(argument * j * q));
+        }
+      }
+      span *= *radix;
+    }
+  } else {
+    radices_.clear();
+
+    int convolution_length(1);
+    while (convolution_length < 2 * fft_length_ - 1) {
+      convolution_length *= 2;
+    }
+    fast_fourier_transform_ =
+        new FastFourierTransform(convolution_length);
+    if (!fast_fourier_transform_->IsValid()) {
+      is_valid_ = false;
+      return;
+    }
+
+    // Make chirp sequence: w(n) = exp(-j pi n^2 / L).
+    chirp_real_part_.resize(fft_length_);
+    chirp_imag_part_.resize(fft_length_);
+    const long long int double_fft_length(2 * fft_length_);  // NOLINT
+    for (int n(0); n < fft_length_; ++n) {
+      const long long int n2(static_cast<long long int>(n) * n %  // NOLINT
+                             double_fft_length);
+      const double argument(sptk::kPi * n2 / fft_length_);
+      chirp_real_part_[n] = std::cos(argument);
+      chirp_imag_part_[n] = -std::sin(argument);
+    }
+
+    // Calculate spectrum of conjugate chirp sequence.
+    chirp_spectrum_real_part_.assign(convolution_length, 0.0);
+    chirp_spectrum_imag_part_.assign(convolution_length, 0.0);
+    chirp_spectrum_real_part_[0] = chirp_real_part_[0];
+    chirp_spectrum_imag_part_[0] = -chirp_imag_part_[0];
+    for (int n(1); n < fft_length_; ++n) {
+      chirp_spectrum_real_part_[n] = chirp_real_part_[n];
+      chirp_spectrum_imag_part_[n] = -chirp_imag_part_[n];
+      chirp_spectrum_real_part_[convolution_length - n] = chirp_real_part_[n];
+      chirp_spectrum_imag_part_[convolution_length - n] = -chirp_imag_part_[n];
+    }
+    if (!fast_fourier_transform_->Run(&chirp_spectrum_real_part_,
+                                      &chirp_spectrum_imag_part_)) {
+      is_valid_ = false;
+      return;
+    }
+  }
+}
+
+bool MixedRadixFastFourierTransform::Run(
+    const std::vector<double>& real_part_input,
+    const std::vector<double>& imag_part_input,
+    std::vector<double>* real_part_output,
+    std::vector<double>* imag_part_output) const {
+  // Check inputs.
+  if (!is_valid_ ||
+      real_part_input.size() != static_cast<std::size_t>(fft_length_) ||
+      imag_part_input.size() != static_cast<std::size_t>(fft_length_) ||
+      NULL == real_part_output || NULL == imag_part_output ||
+      real_part_output == imag_part_output) {
+    return false;
+  }
+
+  // Input and output must not share memory.
+  if (&real_part_input == real_part_output ||
+      &real_part_input == imag_part_output ||
+      &imag_part_input == real_part_output ||
+      &imag_part_input == imag_part_output) {
+    const std::vector<double> real_part_copy(real_part_input);
+    const std::vector<double> imag_part_copy(imag_part_input);
+    return Run(real_part_copy, imag_part_copy, real_part_output,
+               imag_part_output);
+  }
+
+  if (IsBluesteinUsed()) {
+    return RunBluestein(real_part_input, imag_part_input, real_part_output,
+                        imag_part_output);
+  }
+  return RunMixedRadix(real_part_input, imag_part_input, real_part_output,
+                       imag_part_output);
+}
+
+bool MixedRadixFastFourierTransform::RunMixedRadix(
+    const std::vector<double>& real_part_input,
+    const std::vector<double>& imag_part_input,
+    std::vector<double>* real_part_output,
+    std::vector<double>* imag_part_output) const {
+  // Prepare memories.
+  if (real_part_output->size() != static_cast<std::size_t>(fft_length_)) {
+    real_part_output->resize(fft_length_);
+  }
+  if (imag_part_output->size() != static_cast<std::size_t>(fft_length_)) {
+    imag_part_output->resize(fft_length_);
+  }
+
+  double* x(&((*real_part_output)[0]));
+  double* y(&((*imag_part_output)[0]));
+
+  // Reorder inputs.
+  for (int i(0); i < fft_length_; ++i) {
+    x[i] = real_part_input[permutation_table_[i]];
+    y[i] = imag_part_input[permutation_table_[i]];
+  }
+
+  const double* cosp(cosine_table_.empty() ? NULL : &(cosine_table_[0]));
+  const double* sinp(sine_table_.empty() ? NULL : &(sine_table_[0]));
+  int span(1);
+  for (std::vector<int>::const_iterator radix(radices_.begin());
+       radix != radices_.end(); ++radix) {
+    const int next_span(span * *radix);
+    for (int j(0); j < span; ++j) {
+      const double* c(cosp + j * (*radix - 1));
+      const double* s(sinp + j * (*radix - 1));
+      for (int k(j); k < fft_length_; k += next_span) {
+        double* xp(x + k);
+        double* yp(y + k);
+
+        // Multiply twiddle factors.
+        for (int q(1); q < *radix; ++q) {
+          const double tx(xp[q * span]);
+          const double ty(yp[q * span]);
+          xp[q * span] = tx * c[q - 1] + ty * s[q - 1];
+          yp[q * span] = ty * c[q - 1] - tx * s[q - 1];
+        }
+
+        // Perform butterfly.
+        switch (*radix) {
+          case 2: {
+            const double x0(xp[0]), y0(yp[0]);
+            const double x1(xp[span]), y1(yp[span]);
+            xp[0] = x0 + x1;
+            yp[0] = y0 + y1;
+            xp[span] = x0 - x1;
+            yp[span] = y0 - y1;
+            break;
+          }
+          case 3: {
+            const double x0(xp[0]), y0(yp[0]);
+            const double x1(xp[span]), y1(yp[span]);
+            const double x2(xp[2 * span]), y2(yp[2 * span]);
+            const double t1x(x1 + x2), t1y(y1 + y2);
+            const double t2x(x0 - 0.5 * t1x), t2y(y0 - 0.5 * t1y);
+            const double t3x(kSin60 * (x1 - x2)), t3y(kSin60 * (y1 - y2));
+            xp[0] = x0 + t1x;
+            yp[0] = y0 + t1y;
+            xp[span] = t2x + t3y;
+            yp[span] = t2y - t3x;
+            xp[2 * span] = t2x - t3y;
+            yp[2 * span] = t2y + t3x;
+            break;
+          }
+          case 4: {
+            const double x0(xp[0]), y0(yp[0]);
+            const double x1(xp[span]), y1(yp[span]);
+            const double x2(xp[2 * span]), y2(yp[2 * span]);
+            const double x3(xp[3 * span]), y3(yp[3 * span]);
+            const double t0x(x0 + x2), t0y(y0 + y2);
+            const double t1x(x0 - x2), t1y(y0 - y2);
+            const double t2x(x1 + x3), t2y(y1 + y3);
+            const double t3x(x1 - x3), t3y(y1 - y3);
+            xp[0] = t0x + t2x;
+            yp[0] = t0y + t2y;
+            xp[span] = t1x + t3y;
+            yp[span] = t1y - t3x;
+            xp[2 * span] = t0x - t2x;
+            yp[2 * span] = t0y - t2y;
+            xp[3 * span] = t1x - t3y;
+            yp[3 * span] = t1y + t3x;
+            break;
+          }
+          case 5: {
+            const double x0(xp[0]), y0(yp[0]);
+            const double x1(xp[span]), y1(yp[span]);
+            const double x2(xp[2 * span]), y2(yp[2 * span]);
+            const double x3(xp[3 * span]), y3(yp[3 * span]);
+            const double x4(xp[4 * span]), y4(yp[4 * span]);
+            const double t1x(x1 + x4), t1y(y1 + y4);
+            const double t2x(x2 + x3), t2y(y2 + y3);
+            const double t3x(x1 - x4), t3y(y1 - y4);
+            const double t4x(x2 - x3), t4y(y2 - y3);
+            const double a1x(x0 + kCos72 * t1x + kCos144 * t2x);
+            const double a1y(y0 + kCos72 * t1y + kCos144 * t2y);
+            const double a2x(x0 + kCos144 * t1x + kCos72 * t2x);
+            const double a2y(y0 + kCos144 * t1y + kCos72 * t2y);
+            const double b1x(kSin72 * t3x + kSin144 * t4x);
+            const double b1y(kSin72 * t3y + kSin144 * t4y);
+            const double b2x(kSin144 * t3x - kSin72 * t4x);
+            const double b2y(kSin144 * t3y - kSin72 * t4y);
+            xp[0] = x0 + t1x + t2x;
+            yp[0] = y0 + t1y + t2y;
+            xp[span] = a1x + b1y;
+            yp[span] = a1y - b1x;
+            xp[2 * span] = a2x + b2y;
+            yp[2 * span] = a2y - b2x;
+            xp[3 * span] = a2x - b2y;
+            yp[3 * span] = a2y + b2x;
+            xp[4 * span] = a1x - b1y;
+            yp[4 * span] = a1y + b1x;
+            break;
+          }
+          default: {
+            return false;
+          }
+        }
+      }
+    }
+    cosp += span * (*radix - 1);
+    sinp += span * (*radix - 1);
+    span = next_span;
+  }
+
+  return true;
+}
+
+bool MixedRadixFastFourierTransform::RunBluestein(
+    const std::vector<double>& real_part_input,
+    const std::vector<double>& imag_part_input,
+    std::vector<double>* real_part_output,
+    std::vector<double>* imag_part_output) const {
+  // The output vectors are temporarily extended to hold the convolution.
+  const int convolution_length(fast_fourier_transform_->GetFftLength());
+  real_part_output->resize(convolution_length);
+  imag_part_output->resize(convolution_length);
+
+  double* x(&((*real_part_output)[0]));
+  double* y(&((*imag_part_output)[0]));
+
+  // Multiply chirp sequence.
+  for (int n(0); n < fft_length_; ++n) {
+    const double wx(chirp_real_part_[n]);
+    const double wy(chirp_imag_part_[n]);
+    x[n] = real_part_input[n] * wx - imag_part_input[n] * wy;
+    y[n] = real_part_input[n] * wy + imag_part_input[n] * wx;
+  }
+  for (int n(fft_length_); n < convolution_length; ++n) {
+    x[n] = 0.0;
+    y[n] = 0.0;
+  }
+
+  // Perform circular convolution with conjugate chirp sequence. The inverse
+  // FFT is computed by the forward FFT of the conjugate spectrum.
+  if (!fast_fourier_transform_->Run(real_part_output, imag_part_output)) {
+    return false;
+  }
+  for (int k(0); k < convolution_length; ++k) {
+    const double bx(chirp_spectrum_real_part_[k]);
+    const double by(chirp_spectrum_imag_part_[k]);
+    const double tx(x[k] * bx - y[k] * by);
+    const double ty(x[k] * by + y[k] * bx);
+    x[k] = tx;
+    y[k] = -ty;
+  }
+  if (!fast_fourier_transform_->Run(real_part_output, imag_part_output)) {
+    return false;
+  }
+
+  // Multiply chirp sequence again.
+  const double inverse_convolution_length(1.0 / convolution_length);
+  for (int k(0); k < fft_length_; ++k) {
+    const double wx(chirp_real_part_[k]);
+    const double wy(chirp_imag_part_[k]);
+    const double tx(x[k] * inverse_convolution_length);
+    const double ty(-y[k] * inverse_convolution_length);
+    x[k] = tx * wx - ty * wy;
+    y[k] = tx * wy + ty * wx;
+  }
+
+  real_part_output->resize(fft_length_);
+  imag_part_output->resize(fft_length_);
+
+  return true;
+}
+
+}  // namespace sptk
@@ -44,21 +44,290 @@
 
 #include "SPTK/math/principal_component_analysis.h"
 
-#include <algorithm>  // std::sort, std::swap
+#include <algorithm>  // std::copy, std::fill, std::max, std::min, etc.
 #include <cmath>      // std::fabs, std::sqrt
 #include <cstddef>    // std::size_t
+#include <limits>     // std::numeric_limits
 #include <numeric>    // std::iota
+#include <random>     // std::mt19937, std::normal_distribution
+
+namespace {
+
+// Number of vectors passed to the accumulator at once.
+const int kNumVectorInBlock(4096);
+
+// Number of extra basis vectors in the subspace iteration.
+const int kNumOversampling(8);
+
+// Seed of the random initial basis in the subspace iteration.
+const int kSeed(1);
+
+// Reduces the symmetric matrix v to a tridiagonal matrix by Householder
+// transformations. On return, v holds the orthogonal transformation matrix
+// whose columns are the basis, d the diagonal elements, and e the
+// subdiagonal elements in e[1..n-1].
+void ReduceToTridiagonalMatrix(int n, sptk::Matrix* v, double* d, double* e) {
+  sptk::Matrix& a(*v);
+  for (int j(0); j < n; ++j) {
+    d[j] = a[n - 1][j];
+  }
+
+  for (int i(n - 1); 0 < i; --i) {
+    double scale(0.0);
+    double h(0.0);
+    for (int k(0); k < i; ++k) {
+      scale += std::fabs(d[k]);
+    }
+    if (0.0 == scale) {
+      e[i] = d[i - 1];
+      for (int j(0); j < i; ++j) {
+        d[j] = a[i - 1][j];
+        a[i][j] = 0.0;
+        a[j][i] = 0.0;
+      }
+    } else {
+      // generate Householder vector
+      for (int k(0); k < i; ++k) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      double f(d[i - 1]);
+      double g(0.0 < f ? -std::sqrt(h) : std::sqrt(h));
+      e[i] = scale * g;
+      h -= f * g;
+      d[i - 1] = f - g;
+      for (int j(0); j < i; ++j) {
+        e[j] = 0.0;
+      }
+
+      // apply similarity transformation to remaining columns
+      for (int j(0); j < i; ++j) {
+        f = d[j];
+        a[j][i] = f;
+        g = e[j] + a[j][j] * f;
+        for (int k(j + 1); k < i; ++k) {
+          g += a[k][j] * d[k];
+          e[k] += a[k][j] * f;
+        }
+        e[j] = g;
+      }
+      f = 0.0;
+      for (int j(0); j < i; ++j) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      const double hh(f / (h + h));
+      for (int j(0); j < i; ++j) {
+        e[j] -= hh * d[j];
+      }
+      for (int j(0); j < i; ++j) {
+        f = d[j];
+        g = e[j];
+        for (int k(j); k < i; ++k) {
+          a[k][j] -= (f * e[k] + g * d[k]);
+        }
+        d[j] = a[i - 1][j];
+        a[i][j] = 0.0;
+      }
+    }
+    d[i] = h;
+  }
+
+  // accumulate transformations
+  for (int i(0); i < n - 1; ++i) {
+    a[n - 1][i] = a[i][i];
+    a[i][i] = 1.0;
+    const double h(d[i + 1]);
+    if (0.0 != h) {
+      for (int k(0); k <= i; ++k) {
+        d[k] = a[k][i + 1] / h;
+      }
+      for (int j(0); j <= i; ++j) {
+        double g(0.0);
+        for (int k(0); k <= i; ++k) {
+          g += a[k][i + 1] * a[k][j];
+        }
+        for (int k(0); k <= i; ++k) {
+          a[k][j] -= g * d[k];
+        }
+      }
+    }
+    for (int k(0); k <= i; ++k) {
+      a[k][i + 1] = 0.0;
+    }
+  }
+  for (int j(0); j < n; ++j) {
+    d[j] = a[n - 1][j];
+    a[n - 1][j] = 0.0;
+  }
+  a[n - 1][n - 1] = 1.0;
+  e[0] = 0.0;
+}
+
+// Diagonalizes the symmetric tridiagonal matrix given by d and e by the
+// implicit QL method with Wilkinson shifts. The rows of w are rotated along
+// with the matrix. On return, d holds the eigenvalues and the rows of w the
+// corresponding eigenvectors if w is initialized with the transpose of the
+// output of ReduceToTridiagonalMatrix.
+bool DiagonalizeTridiagonalMatrix(int n, int num_iteration, double* d,
+                                  double* e, sptk::Matrix* w) {
+  for (int i(1); i < n; ++i) {
+    e[i - 1] = e[i];
+  }
+  e[n - 1] = 0.0;
+
+  const double epsilon(std::numeric_limits<double>::epsilon());
+  double f(0.0);
+  double tst1(0.0);
+  for (int l(0); l < n; ++l) {
+    // find small subdiagonal element
+    tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+    int m(l);
+    while (m < n - 1 && epsilon * tst1 < std::fabs(e[m])) {
+      ++m;
+    }
+
+    // iterate until the eigenvalue is isolated
+    for (int iteration(0); l < m && epsilon * tst1 < std::fabs(e[l]);
+         ++iteration) {
+      if (num_iteration <= iteration) {
+        return false;
+      }
+
+      // compute implicit shift
+      double g(d[l]);
+      double p((d[l + 1] - g) / (2.0 * e[l]));
+      double r(std::sqrt(p * p + 1.0));
+      if (p < 0.0) r = -r;
+      d[l] = e[l] / (p + r);
+      d[l + 1] = e[l] * (p + r);
+      const double dl1(d[l + 1]);
+      double h(g - d[l]);
+      for (int i(l + 2); i < n; ++i) {
+        d[i] -= h;
+      }
+      f += h;
+
+      // implicit QL transformation
+      p = d[m];
+      double c(1.0);
+      double c2(c);
+      double c3(c);
+      const double el1(e[l + 1]);
+      double s(0.0);
+      double s2(0.0);
+      for (int i(m - 1); l <= i; --i) {
+        c3 = c2;
+        c2 = c;
+        s2 = s;
+        g = c * e[i];
+        h = c * p;
+        r = std::sqrt(p * p + e[i] * e[i]);
+        e[i + 1] = s * r;
+        s = e[i] / r;
+        c = p / r;
+        p = c * d[i] - s * g;
+        d[i + 1] = h + s * (c * g + s * d[i]);
+
+        // accumulate transformation
+        double* w0((*w)[i]);
+        double* w1((*w)[i + 1]);
+        for (int k(0); k < n; ++k) {
+          h = w1[k];
+          w1[k] = s * w0[k] + c * h;
+          w0[k] = c * w0[k] - s * h;
+        }
+      }
+      p = -s * s2 * c3 * el1 * e[l] / dl1;
+      e[l] = s * p;
+      d[l] = c * p;
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+
+  return true;
+}
+
+// Calculates all eigenpairs of the symmetric matrix a, which is destroyed. The
+// eigenvectors are stored in the rows of w.
+bool CalculateEigenpairs(int n, int num_iteration, sptk::Matrix* a,
+                         double* eigenvalues, double* work, sptk::Matrix* w) {
+  ReduceToTridiagonalMatrix(n, a, eigenvalues, work);
+  for (int i(0); i < n; ++i) {
+    for (int j(0); j < n; ++j) {
+      (*w)[i][j] = (*a)[j][i];
+    }
+  }
+  return DiagonalizeTridiagonalMatrix(n, num_iteration, eigenvalues, work, w);
+}
+
+// Orthonormalizes the rows of q by the modified Gram-Schmidt process. A row
+// that is linearly dependent on the preceding ones is replaced with a random
+// vector.
+void Orthonormalize(int num_row, int num_column, std::mt19937* generator,
+                    sptk::Matrix* q) {
+  std::normal_distribution<double> distribution;
+  for (int i(0); i < num_row; ++i) {
+    double* x((*q)[i]);
+    for (int trial(0); trial < 2; ++trial) {
+      double original_norm(0.0);
+      for (int k(0); k < num_column; ++k) {
+        original_norm += x[k] * x[k];
+      }
+      original_norm = std::sqrt(original_norm);
+
+      // The projection is repeated for numerical stability.
+      for (int repetition(0); repetition < 2; ++repetition) {
+        for (int j(0); j < i; ++j) {
+          const double* y((*q)[j]);
+          double dot(0.0);
+          for (int k(0); k < num_column; ++k) {
+            dot += x[k] * y[k];
+          }
+          for (int k(0); k < num_column; ++k) {
+            x[k] -= dot * y[k];
+          }
+        }
+      }
+
+      double norm(0.0);
+      for (int k(0); k < num_column; ++k) {
+        norm += x[k] * x[k];
+      }
+      norm = std::sqrt(norm);
+      if (1e-8 * original_norm < norm) {
+        for (int k(0); k < num_column; ++k) {
+          x[k] /= norm;
+        }
+        break;
+      }
+      for (int k(0); k < num_column; ++k) {
+        x[k] = distribution(*generator);
+      }
+    }
+  }
+}
+
+}  // namespace
 
 namespace sptk {
 
 PrincipalComponentAnalysis::PrincipalComponentAnalysis(
-    int num_order, int num_iteration, double convergence_threshold)
+    int num_order, int num_iteration, double convergence_threshold,
+    Algorithms algorithm, int num_principal_component)
     : num_order_(num_order),
       num_iteration_(num_iteration),
       convergence_threshold_(convergence_threshold),
+      algorithm_(algorithm),
+      num_principal_component_(num_principal_component),
       accumulator_(num_order, 2),
       is_valid_(true) {
   if (num_order_ < 0 || num_iteration_ <= 0 || convergence_threshold_ < 0.0 ||
+      algorithm_ < kJacobi || kNumAlgorithms <= algorithm_ ||
+      (kSubspaceIteration == algorithm_ &&
+       (num_principal_component_ <= 0 ||
+        num_order_ + 1 < num_principal_component_)) ||
       !accumulator_.IsValid()) {
     is_valid_ = false;
   }
@@ -88,9 +357,25 @@ bool PrincipalComponentAnalysis::Run(
   }
 
   // calculate statistics
+  // The input vectors are copied block by block to use the batched update.
   accumulator_.Clear(&buffer->accumulator_buffer_);
-  for (std::vector<double> input_vector : input_vectors) {
-    if (!accumulator_.Run(input_vector, &buffer->accumulator_buffer_)) {
+  const int num_input_vector(static_cast<int>(input_vectors.size()));
+  for (int n(0); n < num_input_vector; n += kNumVectorInBlock) {
+    const int num_vector(std::min(kNumVectorInBlock, num_input_vector - n));
+    if (buffer->input_vectors_.GetNumRow() != num_vector ||
+        buffer->input_vectors_.GetNumColumn() != length) {
+      buffer->input_vectors_.Resize(num_vector, length);
+    }
+    for (int k(0); k < num_vector; ++k) {
+      const std::vector<double>& input_vector(input_vectors[n + k]);
+      if (input_vector.size() != static_cast<std::size_t>(length)) {
+        return false;
+      }
+      std::copy(input_vector.begin(), input_vector.end(),
+                buffer->input_vectors_[k]);
+    }
+    if (!accumulator_.Run(buffer->input_vectors_,
+                          &buffer->accumulator_buffer_)) {
       return false;
     }
   }
@@ -102,6 +387,73 @@ bool PrincipalComponentAnalysis::Run(
     return false;
   }
 
+  // diagonalize covariance matrix
+  switch (algorithm_) {
+    case kJacobi: {
+      if (!RunJacobi(eigenvalues, eigenvector_matrix, buffer)) {
+        return false;
+      }
+      break;
+    }
+    case kHouseholderQr: {
+      if (!RunHouseholderQr(eigenvalues, eigenvector_matrix, buffer)) {
+        return false;
+      }
+      break;
+    }
+    case kSubspaceIteration: {
+      if (!RunSubspaceIteration(eigenvalues, eigenvector_matrix, buffer)) {
+        return false;
+      }
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+
+  // sort eigenvalues in descending order
+  std::iota(buffer->eigenvalue_order_.begin(), buffer->eigenvalue_order_.end(),
+            0);
+  buffer->diagonal_elements_ = *eigenvalues;
+  const std::vector<double>& unsorted_eigenvalues(buffer->diagonal_elements_);
+  std::stable_sort(buffer->eigenvalue_order_.begin(),
+                   buffer->eigenvalue_order_.end(),
+                   [&unsorted_eigenvalues](int i, int j) {
+                     return unsorted_eigenvalues[j] < unsorted_eigenvalues[i];
+                   });
+  for (int i(0); i < length; ++i) {
+    (*eigenvalues)[i] = unsorted_eigenvalues[buffer->eigenvalue_order_[i]];
+  }
+
+  // swap eigenvectors
+  for (int i(0); i < num_order_; ++i) {
+    int index(i);
+    while (index < length) {
+      if (buffer->eigenvalue_order_[index] == i) {
+        buffer->eigenvalue_order_[index] = buffer->eigenvalue_order_[i];
+        break;
+      }
+      ++index;
+    }
+
+    const int j(buffer->eigenvalue_order_[index]);
+    if (j != i) {
+      for (int k(0); k < length; ++k) {
+        std::swap((*eigenvector_matrix)[j][k], (*eigenvector_matrix)[i][k]);
+      }
+    }
+  }
+
+  return true;
+}
+
+
+bool PrincipalComponentAnalysis::RunJacobi(
+    std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  const int length(num_order_ + 1);
+
   // initialize with identity matrix
   for (int i(0); i < length; ++i) {
     for (int j(0); j < length; ++j) {
@@ -167,37 +519,193 @@ bool PrincipalComponentAnalysis::Run(
     buffer->a_[p][q] = 0.0;
   }
 
-  // sort eigenvalues in descending order
-  std::iota(buffer->eigenvalue_order_.begin(), buffer->eigenvalue_order_.end(),
-            0);
-  std::sort(
-      buffer->eigenvalue_order_.begin(), buffer->eigenvalue_order_.end(),
-      [&buffer](int i, int j) { return buffer->a_[j][j] < buffer->a_[i][i]; });
   for (int i(0); i < length; ++i) {
-    (*eigenvalues)[i] =
-        buffer->a_[buffer->eigenvalue_order_[i]][buffer->eigenvalue_order_[i]];
+    (*eigenvalues)[i] = buffer->a_[i][i];
   }
 
-  // swap eigenvectors
-  for (int i(0); i < num_order_; ++i) {
-    int index(i);
-    while (index < length) {
-      if (buffer->eigenvalue_order_[index] == i) {
-        buffer->eigenvalue_order_[index] = buffer->eigenvalue_order_[i];
-        break;
+  return true;
+}
+
+bool PrincipalComponentAnalysis::RunHouseholderQr(
+    std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  const int length(num_order_ + 1);
+  if (buffer->covariance_.GetNumRow() != length ||
+      buffer->covariance_.GetNumColumn() != length) {
+    buffer->covariance_.Resize(length, length);
+  }
+  if (buffer->off_diagonal_elements_.size() !=
+      static_cast<std::size_t>(length)) {
+    buffer->off_diagonal_elements_.resize(length);
+  }
+
+  for (int i(0); i < length; ++i) {
+    for (int j(0); j < length; ++j) {
+      buffer->covariance_[i][j] = buffer->a_[i][j];
+    }
+  }
+  return CalculateEigenpairs(length, num_iteration_, &buffer->covariance_,
+                             &((*eigenvalues)[0]),
+                             &(buffer->off_diagonal_elements_[0]),
+                             eigenvector_matrix);
+}
+
+bool PrincipalComponentAnalysis::RunSubspaceIteration(
+    std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  const int length(num_order_ + 1);
+  const int num_basis(
+      std::min(length, num_principal_component_ + kNumOversampling));
+  if (buffer->covariance_.GetNumRow() != length ||
+      buffer->covariance_.GetNumColumn() != length) {
+    buffer->covariance_.Resize(length, length);
+  }
+  if (buffer->basis_.GetNumRow() != num_basis ||
+      buffer->basis_.GetNumColumn() != length) {
+    buffer->basis_.Resize(num_basis, length);
+  }
+  if (buffer->product_.GetNumRow() != num_basis ||
+      buffer->product_.GetNumColumn() != length) {
+    buffer->product_.Resize(num_basis, length);
+  }
+  if (buffer->projected_covariance_.GetNumRow() != num_basis ||
+      buffer->projected_covariance_.GetNumColumn() != num_basis) {
+    buffer->projected_covariance_.Resize(num_basis, num_basis);
+  }
+  if (buffer->rotation_.GetNumRow() != num_basis ||
+      buffer->rotation_.GetNumColumn() != num_basis) {
+    buffer->rotation_.Resize(num_basis, num_basis);
+  }
+  if (buffer->diagonal_elements_.size() !=
+      static_cast<std::size_t>(num_basis)) {
+    buffer->diagonal_elements_.resize(num_basis);
+  }
+  if (buffer->off_diagonal_elements_.size() !=
+      static_cast<std::size_t>(num_basis)) {
+    buffer->off_diagonal_elements_.resize(num_basis);
+  }
+
+  // A full copy of the covariance allows contiguous access to rows.
+  Matrix& covariance(buffer->covariance_);
+  double trace(0.0);
+  for (int i(0); i < length; ++i) {
+    for (int j(0); j < length; ++j) {
+      covariance[i][j] = buffer->a_[i][j];
+    }
+    trace += covariance[i][i];
+  }
+
+  // initialize with random basis
+  std::mt19937 generator(kSeed);
+  std::normal_distribution<double> distribution;
+  Matrix& basis(buffer->basis_);
+  for (int i(0); i < num_basis; ++i) {
+    for (int j(0); j < length; ++j) {
+      basis[i][j] = distribution(generator);
+    }
+  }
+  Orthonormalize(num_basis, length, &generator, &basis);
+
+  Matrix& product(buffer->product_);
+  Matrix& projected_covariance(buffer->projected_covariance_);
+  Matrix& rotation(buffer->rotation_);
+  double* ritz_values(&(buffer->diagonal_elements_[0]));
+  std::vector<int>& order(buffer->eigenvalue_order_);
+  for (int n(0); n < num_iteration_; ++n) {
+    // multiply basis by covariance
+    for (int b(0); b < num_basis; ++b) {
+      const double* q(basis[b]);
+      double* z(product[b]);
+      for (int i(0); i < length; ++i) {
+        const double* c(covariance[i]);
+        double sum(0.0);
+        for (int j(0); j < length; ++j) {
+          sum += c[j] * q[j];
+        }
+        z[i] = sum;
       }
-      ++index;
     }
 
-    const int j(buffer->eigenvalue_order_[index]);
-    if (j != i) {
-      for (int k(0); k < length; ++k) {
-        std::swap((*eigenvector_matrix)[j][k], (*eigenvector_matrix)[i][k]);
+    // solve projected eigenvalue problem (Rayleigh-Ritz procedure)
+    for (int a(0); a < num_basis; ++a) {
+      for (int b(0); b <= a; ++b) {
+        const double* q(basis[a]);
+        const double* z(product[b]);
+        double sum(0.0);
+        for (int j(0); j < length; ++j) {
+          sum += q[j] * z[j];
+        }
+        projected_covariance[a][b] = sum;
+        projected_covariance[b][a] = sum;
+      }
+    }
+    if (!CalculateEigenpairs(num_basis, num_iteration_, &projected_covariance,
+                             ritz_values, &(buffer->off_diagonal_elements_[0]),
+                             &rotation)) {
+      return false;
+    }
+    std::iota(order.begin(), order.begin() + num_basis, 0);
+    std::stable_sort(order.begin(), order.begin() + num_basis,
+                     [ritz_values](int i, int j) {
+                       return ritz_values[j] < ritz_values[i];
+                     });
+
+    // check residuals of leading Ritz pairs
+    bool is_converged(true);
+    const double threshold(convergence_threshold_ *
+                           std::fabs(ritz_values[order[0]]));
+    for (int r(0); r < num_principal_component_ && is_converged; ++r) {
+      const double* u(rotation[order[r]]);
+      const double theta(ritz_values[order[r]]);
+      double norm(0.0);
+      for (int j(0); j < length; ++j) {
+        double residual(0.0);
+        for (int b(0); b < num_basis; ++b) {
+          residual += u[b] * (product[b][j] - theta * basis[b][j]);
+        }
+        norm += residual * residual;
+      }
+      if (threshold < std::sqrt(norm)) {
+        is_converged = false;
       }
     }
+    if (is_converged || num_iteration_ - 1 == n) {
+      break;
+    }
+
+    // update basis
+    std::swap(basis, product);
+    Orthonormalize(num_basis, length, &generator, &basis);
+  }
+
+  // calculate Ritz vectors
+  double sum_of_leading_eigenvalues(0.0);
+  for (int r(0); r < num_principal_component_; ++r) {
+    const double* u(rotation[order[r]]);
+    double* x((*eigenvector_matrix)[r]);
+    for (int j(0); j < length; ++j) {
+      double sum(0.0);
+      for (int b(0); b < num_basis; ++b) {
+        sum += u[b] * basis[b][j];
+      }
+      x[j] = sum;
+    }
+    (*eigenvalues)[r] = ritz_values[order[r]];
+    sum_of_leading_eigenvalues += ritz_values[order[r]];
+  }
+
+  // fill remaining eigenpairs
+  if (num_principal_component_ < length) {
+    std::fill(eigenvalues->begin() + num_principal_component_,
+              eigenvalues->end(),
+              (trace - sum_of_leading_eigenvalues) /
+                  (length - num_principal_component_));
+    for (int r(num_principal_component_); r < length; ++r) {
+      std::fill((*eigenvector_matrix)[r], (*eigenvector_matrix)[r] + length,
+                0.0);
+    }
   }
 
   return true;
 }
-
 }  // namespace sptk
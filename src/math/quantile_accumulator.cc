@@ -0,0 +1,309 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/math/quantile_accumulator.h"
+
+#include <algorithm>  // std::inplace_merge, std::max, std::min, std::sort
+#include <cmath>      // std::asin, std::sin
+#include <cstddef>    // std::size_t
+#include <utility>    // std::make_pair
+
+namespace {
+
+// The unmerged data are merged into the centroids when their number exceeds
+// this factor times the compression.
+const int kNumUnmergedDataFactor(5);
+
+const double kPi(3.141592653589793);
+
+// Scale function k(q) = compression / (2 pi) * asin(2q - 1).
+double ConvertProbabilityToScale(double probability, double compression) {
+  const double x(std::min(1.0, std::max(-1.0, 2.0 * probability - 1.0)));
+  return compression / (2.0 * kPi) * std::asin(x);
+}
+
+// Inverse of the scale function.
+double ConvertScaleToProbability(double scale, double compression) {
+  const double angle(std::min(0.5 * kPi, 2.0 * kPi * scale / compression));
+  return 0.5 * (std::sin(angle) + 1.0);
+}
+
+double Interpolate(double a, double b, double fraction) {
+  return 0.0 == fraction ? a : (1.0 - fraction) * a + fraction * b;
+}
+
+}  // namespace
+
+namespace sptk {
+
+QuantileAccumulator::QuantileAccumulator(int num_order, int compression)
+    : num_order_(num_order), compression_(compression), is_valid_(true) {
+  if (num_order_ < 0 || compression_ <= 0) {
+    is_valid_ = false;
+  }
+}
+
+bool QuantileAccumulator::GetNumData(const QuantileAccumulator::Buffer& buffer,
+                                     int* num_data) const {
+  if (!is_valid_ || NULL == num_data) {
+    return false;
+  }
+
+  *num_data = buffer.num_data_;
+
+  return true;
+}
+
+bool QuantileAccumulator::GetQuantile(const QuantileAccumulator::Buffer& buffer,
+                                      double probability,
+                                      std::vector<double>* quantile) const {
+  if (!is_valid_ || buffer.num_data_ <= 0 || probability < 0.0 ||
+      1.0 < probability || NULL == quantile) {
+    return false;
+  }
+
+  // prepare memory
+  const int length(num_order_ + 1);
+  if (quantile->size() != static_cast<std::size_t>(length)) {
+    quantile->resize(length);
+  }
+
+  // The position is measured in the unit of data as in the exact calculation,
+  // i.e., the j-th smallest data is located at j (0-based). A centroid is
+  // located at the center of the data it represents.
+  const double target(probability * (buffer.num_data_ - 1));
+  std::vector<std::pair<double, double> > centroids;
+  for (int i(0); i < length; ++i) {
+    centroids = buffer.centroids_[i];
+    for (std::vector<double>::const_iterator itr(
+             buffer.unmerged_data_[i].begin());
+         itr != buffer.unmerged_data_[i].end(); ++itr) {
+      centroids.push_back(std::make_pair(*itr, 1.0));
+    }
+    std::sort(centroids.begin(), centroids.end());
+
+    double previous_position(0.0);
+    double previous_value(buffer.minimum_[i]);
+    double next_position(buffer.num_data_ - 1);
+    double next_value(buffer.maximum_[i]);
+    double cumulative_weight(0.0);
+    for (std::vector<std::pair<double, double> >::const_iterator itr(
+             centroids.begin());
+         itr != centroids.end(); ++itr) {
+      const double position(cumulative_weight + 0.5 * (itr->second - 1.0));
+      if (target < position) {
+        next_position = position;
+        next_value = itr->first;
+        break;
+      }
+      previous_position = position;
+      previous_value = itr->first;
+      cumulative_weight += itr->second;
+    }
+
+    (*quantile)[i] =
+        next_position <= previous_position
+            ? previous_value
+            : Interpolate(previous_value, next_value,
+                          (target - previous_position) /
+                              (next_position - previous_position));
+  }
+
+  return true;
+}
+
+void QuantileAccumulator::Clear(QuantileAccumulator::Buffer* buffer) const {
+  if (NULL != buffer) buffer->Clear();
+}
+
+bool QuantileAccumulator::Run(const std::vector<double>& data,
+                              QuantileAccumulator::Buffer* buffer) const {
+  // check inputs
+  const int length(num_order_ + 1);
+  if (!is_valid_ || data.size() != static_cast<std::size_t>(length) ||
+      NULL == buffer) {
+    return false;
+  }
+
+  // prepare buffer
+  if (0 == buffer->num_data_) {
+    buffer->centroids_.resize(length);
+    buffer->unmerged_data_.resize(length);
+    buffer->minimum_ = data;
+    buffer->maximum_ = data;
+  }
+
+  const std::size_t max_num_unmerged_data(kNumUnmergedDataFactor *
+                                          compression_);
+  for (int i(0); i < length; ++i) {
+    buffer->minimum_[i] = std::min(buffer->minimum_[i], data[i]);
+    buffer->maximum_[i] = std::max(buffer->maximum_[i], data[i]);
+    buffer->unmerged_data_[i].push_back(data[i]);
+    if (max_num_unmerged_data <= buffer->unmerged_data_[i].size()) {
+      MergeUnmergedData(&buffer->unmerged_data_[i], &buffer->centroids_[i]);
+    }
+  }
+  ++(buffer->num_data_);
+
+  return true;
+}
+
+bool QuantileAccumulator::Merge(
+    const QuantileAccumulator::Buffer& buffer,
+    QuantileAccumulator::Buffer* merged_buffer) const {
+  // check inputs
+  const int length(num_order_ + 1);
+  if (!is_valid_ || NULL == merged_buffer || &buffer == merged_buffer) {
+    return false;
+  }
+  if (0 == buffer.num_data_) {
+    return true;
+  }
+  if (buffer.centroids_.size() != static_cast<std::size_t>(length)) {
+    return false;
+  }
+
+  // prepare buffer
+  if (0 == merged_buffer->num_data_) {
+    merged_buffer->centroids_.resize(length);
+    merged_buffer->unmerged_data_.resize(length);
+    merged_buffer->minimum_ = buffer.minimum_;
+    merged_buffer->maximum_ = buffer.maximum_;
+  }
+
+  const std::size_t max_num_unmerged_data(kNumUnmergedDataFactor *
+                                          compression_);
+  for (int i(0); i < length; ++i) {
+    merged_buffer->minimum_[i] =
+        std::min(merged_buffer->minimum_[i], buffer.minimum_[i]);
+    merged_buffer->maximum_[i] =
+        std::max(merged_buffer->maximum_[i], buffer.maximum_[i]);
+
+    // Both sets of centroids are sorted, so they are merged without sorting.
+    std::vector<std::pair<double, double> >& centroids(
+        merged_buffer->centroids_[i]);
+    if (!buffer.centroids_[i].empty()) {
+      const std::size_t num_centroid(centroids.size());
+      centroids.insert(centroids.end(), buffer.centroids_[i].begin(),
+                       buffer.centroids_[i].end());
+      std::inplace_merge(centroids.begin(), centroids.begin() + num_centroid,
+                         centroids.end());
+      Compress(&centroids);
+    }
+
+    // The unmerged data are kept as they are unless they are too many.
+    std::vector<double>& unmerged_data(merged_buffer->unmerged_data_[i]);
+    unmerged_data.insert(unmerged_data.end(),
+                         buffer.unmerged_data_[i].begin(),
+                         buffer.unmerged_data_[i].end());
+    if (max_num_unmerged_data <= unmerged_data.size()) {
+      MergeUnmergedData(&unmerged_data, &centroids);
+    }
+  }
+  merged_buffer->num_data_ += buffer.num_data_;
+
+  return true;
+}
+
+void QuantileAccumulator::MergeUnmergedData(
+    std::vector<double>* unmerged_data,
+    std::vector<std::pair<double, double> >* centroids) const {
+  // The centroids are already sorted, so only the new data are sorted.
+  const std::size_t num_centroid(centroids->size());
+  std::sort(unmerged_data->begin(), unmerged_data->end());
+  for (std::vector<double>::const_iterator itr(unmerged_data->begin());
+       itr != unmerged_data->end(); ++itr) {
+    centroids->push_back(std::make_pair(*itr, 1.0));
+  }
+  std::inplace_merge(centroids->begin(), centroids->begin() + num_centroid,
+                     centroids->end());
+  unmerged_data->clear();
+  Compress(centroids);
+}
+
+// The centroids must be sorted in ascending order of mean.
+void QuantileAccumulator::Compress(
+    std::vector<std::pair<double, double> >* centroids) const {
+  if (centroids->empty()) return;
+
+  double total_weight(0.0);
+  for (std::vector<std::pair<double, double> >::const_iterator itr(
+           centroids->begin());
+       itr != centroids->end(); ++itr) {
+    total_weight += itr->second;
+  }
+
+  // Adjacent centroids are merged as long as the merged one spans less than
+  // one in the scale function.
+  const double inverse_total_weight(1.0 / total_weight);
+  std::vector<std::pair<double, double> >& c(*centroids);
+  const int num_centroid(static_cast<int>(c.size()));
+  int num_output(0);
+  std::pair<double, double> current(c[0]);
+  double lower_probability(0.0);
+  double upper_probability(ConvertScaleToProbability(
+      ConvertProbabilityToScale(lower_probability, compression_) + 1.0,
+      compression_));
+  for (int i(1); i < num_centroid; ++i) {
+    const double probability(lower_probability +
+                             (current.second + c[i].second) *
+                                 inverse_total_weight);
+    if (probability <= upper_probability) {
+      current.second += c[i].second;
+      current.first += (c[i].first - current.first) * c[i].second /
+                       current.second;
+    } else {
+      lower_probability += current.second * inverse_total_weight;
+      upper_probability = ConvertScaleToProbability(
+          ConvertProbabilityToScale(lower_probability, compression_) + 1.0,
+          compression_);
+      c[num_output++] = current;
+      current = c[i];
+    }
+  }
+  c[num_output++] = current;
+  c.resize(num_output);
+}
+
+}  // namespace sptk
@@ -50,12 +50,15 @@
 
 namespace sptk {
 
-RealValuedFastFourierTransform::RealValuedFastFourierTransform(int fft_length)
-    : RealValuedFastFourierTransform(fft_length - 1, fft_length) {
+template <typename T>
+RealValuedFastFourierTransformBase<T>::RealValuedFastFourierTransformBase(
+    int fft_length)
+    : RealValuedFastFourierTransformBase(fft_length - 1, fft_length) {
 }
 
-RealValuedFastFourierTransform::RealValuedFastFourierTransform(int num_order,
-                                                               int fft_length)
+template <typename T>
+RealValuedFastFourierTransformBase<T>::RealValuedFastFourierTransformBase(
+    int num_order, int fft_length)
     : num_order_(num_order),
       fft_length_(fft_length),
       half_fft_length_(fft_length_ / 2),
@@ -71,82 +74,122 @@ RealValuedFastFourierTransform::RealValuedFastFourierTransform(int num_order,
   const double argument(sptk::kPi / fft_length_ * 2);
   sine_table_.resize(table_size);
   for (int i(0); i < table_size; ++i) {
-    sine_table_[i] = std::sin(argument * i);
+    sine_table_[i] = static_cast<T>(std::sin(argument * i));
   }
   sine_table_[fft_length_ / 2] = 0.0;
 }
 
-bool RealValuedFastFourierTransform::Run(
-    const std::vector<double>& real_part_input,
-    std::vector<double>* real_part_output,
-    std::vector<double>* imag_part_output,
-    RealValuedFastFourierTransform::Buffer* buffer) const {
+template <typename T>
+bool RealValuedFastFourierTransformBase<T>::Run(
+    const std::vector<T>& real_part_input, std::vector<T>* real_part_output,
+    std::vector<T>* imag_part_output,
+    RealValuedFastFourierTransformBase::Buffer* buffer) const {
   // Check inputs.
-  const int input_length(num_order_ + 1);
   if (!is_valid_ ||
-      real_part_input.size() != static_cast<std::size_t>(input_length) ||
-      NULL == real_part_output || NULL == imag_part_output || NULL == buffer) {
+      real_part_input.size() != static_cast<std::size_t>(num_order_ + 1) ||
+      NULL == real_part_output || NULL == imag_part_output || NULL == buffer ||
+      &real_part_input == imag_part_output) {
     return false;
   }
 
-  // Prepare memories.
-  if (buffer->real_part_input_.size() !=
-      static_cast<std::size_t>(half_fft_length_)) {
-    buffer->real_part_input_.resize(half_fft_length_);
+  // Prepare memories. Note that the real part of input may be identical to
+  // the real part of output.
+  if (real_part_output->size() != static_cast<std::size_t>(fft_length_)) {
+    real_part_output->resize(fft_length_);
+  }
+  if (imag_part_output->size() != static_cast<std::size_t>(fft_length_)) {
+    imag_part_output->resize(fft_length_);
+  }
+
+  Transform(&(real_part_input[0]), &((*real_part_output)[0]),
+            &((*imag_part_output)[0]));
+
+  return true;
+}
+
+template <typename T>
+bool RealValuedFastFourierTransformBase<T>::Run(
+    std::vector<T>* real_part, std::vector<T>* imag_part,
+    RealValuedFastFourierTransformBase::Buffer* buffer) const {
+  if (NULL == real_part) return false;
+  return Run(*real_part, real_part, imag_part, buffer);
+}
+
+template <>
+bool RealValuedFastFourierTransformBase<double>::Run(
+    const Matrix& real_part_input, Matrix* real_part_output,
+    Matrix* imag_part_output,
+    RealValuedFastFourierTransformBase<double>::Buffer* buffer) const {
+  // Check inputs.
+  const int num_frame(real_part_input.GetNumRow());
+  if (!is_valid_ || real_part_input.GetNumColumn() != num_order_ + 1 ||
+      NULL == real_part_output || NULL == imag_part_output || NULL == buffer ||
+      &real_part_input == imag_part_output ||
+      (&real_part_input == real_part_output && num_order_ + 1 != fft_length_)) {
+    return false;
   }
-  if (buffer->imag_part_input_.size() !=
-      static_cast<std::size_t>(half_fft_length_)) {
-    buffer->imag_part_input_.resize(half_fft_length_);
+
+  // Prepare memories.
+  if (real_part_output->GetNumRow() != num_frame ||
+      real_part_output->GetNumColumn() != fft_length_) {
+    real_part_output->Resize(num_frame, fft_length_);
   }
-  if (real_part_output->capacity() < static_cast<std::size_t>(fft_length_)) {
-    real_part_output->reserve(fft_length_);
+  if (imag_part_output->GetNumRow() != num_frame ||
+      imag_part_output->GetNumColumn() != fft_length_) {
+    imag_part_output->Resize(num_frame, fft_length_);
   }
-  if (imag_part_output->capacity() < static_cast<std::size_t>(fft_length_)) {
-    imag_part_output->reserve(fft_length_);
+
+  for (int n(0); n < num_frame; ++n) {
+    Transform(real_part_input[n], (*real_part_output)[n],
+              (*imag_part_output)[n]);
   }
 
-  // Copy input and fill zero.
-  for (int i(0), j(0); i < input_length; ++j) {
-    buffer->real_part_input_[j] = real_part_input[i++];
-    if (input_length <= i) break;
-    buffer->imag_part_input_[j] = real_part_input[i++];
+  return true;
+}
+
+template <typename T>
+void RealValuedFastFourierTransformBase<T>::Transform(const T* input, T* x,
+                                                      T* y) const {
+  // Pack even and odd samples into real and imaginary parts. Since the j-th
+  // output is written after the 2j-th input is read, this can be done in place.
+  const int input_length(num_order_ + 1);
+  const int half_input_length(input_length / 2);
+  for (int j(0); j < half_input_length; ++j) {
+    const T even(input[2 * j]);
+    y[j] = input[2 * j + 1];
+    x[j] = even;
   }
-  std::fill(buffer->real_part_input_.begin() + (input_length + 1) / 2,
-            buffer->real_part_input_.end(), 0.0);
-  std::fill(buffer->imag_part_input_.begin() + input_length / 2,
-            buffer->imag_part_input_.end(), 0.0);
-
-  // Run fast Fourier transform.
-  if (!fast_fourier_transform_.Run(buffer->real_part_input_,
-                                   buffer->imag_part_input_, real_part_output,
-                                   imag_part_output)) {
-    return false;
+  if (input_length % 2) {
+    x[half_input_length] = input[input_length - 1];
   }
-  real_part_output->resize(fft_length_);
-  imag_part_output->resize(fft_length_);
-
-  double* x(&((*real_part_output)[0]));
-  double* y(&((*imag_part_output)[0]));
-  double* xp(x);
-  double* yp(y);
-  double* xq(xp + fft_length_);
-  double* yq(yp + fft_length_);
+  std::fill(x + (input_length + 1) / 2, x + half_fft_length_, 0.0);
+  std::fill(y + half_input_length, y + half_fft_length_, 0.0);
+
+  // Run fast Fourier transform in place.
+  fast_fourier_transform_.RunInPlace(x, y);
+
+  // Unpack the spectrum of the real-valued sequence.
+  T* xp(x);
+  T* yp(y);
+  T* xq(xp + fft_length_);
+  T* yq(yp + fft_length_);
   *(xp + half_fft_length_) = *xp - *yp;
   *xp = *xp + *yp;
   *(yp + half_fft_length_) = 0.0;
   *yp = 0.0;
 
-  const double* sinp(&(sine_table_[0]));
-  const double* cosp(&(sine_table_[0]) + fft_length_ / 4);
+  const T half(0.5);
+  const T* sinp(&(sine_table_[0]));
+  const T* cosp(&(sine_table_[0]) + fft_length_ / 4);
   for (int i(1), j(half_fft_length_ - 2); i < half_fft_length_; ++i, j -= 2) {
     ++xp;
     ++yp;
     ++sinp;
     ++cosp;
-    const double xt(*xp - *(xp + j));
-    const double yt(*yp + *(yp + j));
-    *(--xq) = (*xp + *(xp + j) + *cosp * yt - *sinp * xt) * 0.5;
-    *(--yq) = (-*yp + *(yp + j) + *sinp * yt + *cosp * xt) * 0.5;
+    const T xt(*xp - *(xp + j));
+    const T yt(*yp + *(yp + j));
+    *(--xq) = (*xp + *(xp + j) + *cosp * yt - *sinp * xt) * half;
+    *(--yq) = (-*yp + *(yp + j) + *sinp * yt + *cosp * xt) * half;
   }
 
   xp = x + 1;
@@ -157,15 +200,9 @@ bool RealValuedFastFourierTransform::Run(
     *xp++ = *(--xq);
     *yp++ = -(*(--yq));
   }
-
-  return true;
 }
 
-bool RealValuedFastFourierTransform::Run(
-    std::vector<double>* real_part, std::vector<double>* imag_part,
-    RealValuedFastFourierTransform::Buffer* buffer) const {
-  if (NULL == real_part) return false;
-  return Run(*real_part, real_part, imag_part, buffer);
-}
+template class RealValuedFastFourierTransformBase<float>;
+template class RealValuedFastFourierTransformBase<double>;
 
 }  // namespace sptk
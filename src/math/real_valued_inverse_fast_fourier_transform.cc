@@ -48,21 +48,23 @@
 
 namespace sptk {
 
-RealValuedInverseFastFourierTransform::RealValuedInverseFastFourierTransform(
+template <typename T>
+RealValuedInverseFastFourierTransformBase<T>::RealValuedInverseFastFourierTransformBase(
     int fft_length)
-    : RealValuedInverseFastFourierTransform(fft_length - 1, fft_length) {
+    : RealValuedInverseFastFourierTransformBase(fft_length - 1, fft_length) {
 }
 
-RealValuedInverseFastFourierTransform::RealValuedInverseFastFourierTransform(
+template <typename T>
+RealValuedInverseFastFourierTransformBase<T>::RealValuedInverseFastFourierTransformBase(
     int num_order, int fft_length)
     : fast_fourier_transform_(num_order, fft_length) {
 }
 
-bool RealValuedInverseFastFourierTransform::Run(
-    const std::vector<double>& real_part_input,
-    std::vector<double>* real_part_output,
-    std::vector<double>* imag_part_output,
-    RealValuedInverseFastFourierTransform::Buffer* buffer) const {
+template <typename T>
+bool RealValuedInverseFastFourierTransformBase<T>::Run(
+    const std::vector<T>& real_part_input, std::vector<T>* real_part_output,
+    std::vector<T>* imag_part_output,
+    RealValuedInverseFastFourierTransformBase::Buffer* buffer) const {
   if (NULL == buffer) {
     return false;
   }
@@ -74,22 +76,54 @@ bool RealValuedInverseFastFourierTransform::Run(
   }
 
   const int fft_length(fast_fourier_transform_.GetFftLength());
-  const double z(1.0 / fft_length);
+  const T z(static_cast<T>(1.0 / fft_length));
   std::transform(real_part_output->begin(),
                  real_part_output->begin() + fft_length,
-                 real_part_output->begin(), [z](double x) { return x * z; });
+                 real_part_output->begin(), [z](T x) { return x * z; });
   std::transform(imag_part_output->begin(),
                  imag_part_output->begin() + fft_length,
-                 imag_part_output->begin(), [z](double x) { return x * z; });
+                 imag_part_output->begin(), [z](T x) { return x * z; });
 
   return true;
 }
 
-bool RealValuedInverseFastFourierTransform::Run(
-    std::vector<double>* real_part, std::vector<double>* imag_part,
-    RealValuedInverseFastFourierTransform::Buffer* buffer) const {
+template <typename T>
+bool RealValuedInverseFastFourierTransformBase<T>::Run(
+    std::vector<T>* real_part, std::vector<T>* imag_part,
+    RealValuedInverseFastFourierTransformBase::Buffer* buffer) const {
   if (NULL == real_part) return false;
   return Run(*real_part, real_part, imag_part, buffer);
 }
 
+template <>
+bool RealValuedInverseFastFourierTransformBase<double>::Run(
+    const Matrix& real_part_input, Matrix* real_part_output,
+    Matrix* imag_part_output,
+    RealValuedInverseFastFourierTransformBase<double>::Buffer* buffer) const {
+  if (NULL == buffer) {
+    return false;
+  }
+
+  if (!fast_fourier_transform_.Run(real_part_input, real_part_output,
+                                   imag_part_output,
+                                   &buffer->fast_fourier_transform_buffer_)) {
+    return false;
+  }
+
+  const int num_frame(real_part_output->GetNumRow());
+  const int fft_length(fast_fourier_transform_.GetFftLength());
+  const double z(1.0 / fft_length);
+  for (int n(0); n < num_frame; ++n) {
+    double* xr((*real_part_output)[n]);
+    double* xi((*imag_part_output)[n]);
+    std::transform(xr, xr + fft_length, xr, [z](double x) { return x * z; });
+    std::transform(xi, xi + fft_length, xi, [z](double x) { return x * z; });
+  }
+
+  return true;
+}
+
+template class RealValuedInverseFastFourierTransformBase<float>;
+template class RealValuedInverseFastFourierTransformBase<double>;
+
 }  // namespace sptk
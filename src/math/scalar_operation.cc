@@ -44,16 +44,95 @@
 
 #include "SPTK/math/scalar_operation.h"
 
+#include <algorithm>  // std::fill, std::find, std::min
+#include <cfloat>     // DBL_MAX, DBL_MIN
 #include <cmath>  // std::atan, std::ceil, std::cos, std::exp, std::fabs, std::floor, std::log, std::pow, std::round, std::sin, std::sqrt, std::tan, std::trunc
 
+#include "SPTK/utils/simd.h"
+#include "SPTK/utils/simd_math.h"
+
 namespace {
 
+using sptk::simd::Add;
+using sptk::simd::ApplyApproximation;
+using sptk::simd::ApplyToEachNumber;
+using sptk::simd::ApproximateExponential;
+using sptk::simd::ApproximateNaturalLogarithm;
+using sptk::simd::Broadcast;
+using sptk::simd::Divide;
+using sptk::simd::kVectorLength;
+using sptk::simd::Load;
+using sptk::simd::Maximum;
+using sptk::simd::Minimum;
+using sptk::simd::Multiply;
+using sptk::simd::Round;
+using sptk::simd::Store;
+using sptk::simd::Subtract;
+using sptk::simd::Vector;
+
+// Number of data passed through all modules at once. The intermediate results
+// stay in the L1 cache.
+const int kNumDataInTile(512);
+
+// Upper bound of the magnitude of the input of the approximated exponential.
+// The result is a normal number.
+const double kMaximumExponent(708.0);
+
+// Upper bound of the magnitude of the input of the approximated sine and
+// cosine. The range reduction is accurate below this.
+const double kMaximumPhase(1.0e+5);
+
+// Approximates sin(x) if offset is 0, or cos(x) if offset is 0.5, for
+// |x| <= kMaximumPhase. The absolute error is less than 1e-9.
+Vector ApproximateSine(Vector x, double offset) {
+  // Reduce x to r in [-pi / 2, pi / 2], where x = r + pi * k and k - offset is
+  // an integer. Then, sin(x + pi * offset) = (-1)^(k + offset) * sin(r). The
+  // constant pi is split into three parts so that k * pi is calculated
+  // exactly.
+  const Vector k(Add(Round(Subtract(Multiply(x, Broadcast(1.0 / sptk::kPi)),
+                                    Broadcast(offset))),
+                     Broadcast(offset)));
+  Vector r(Subtract(x, Multiply(k, Broadcast(3.14159265346825122833e+00))));
+  r = Subtract(r, Multiply(k, Broadcast(1.21542010126079319532e-10)));
+  r = Subtract(r, Multiply(k, Broadcast(4.04453249742233291160e-21)));
+
+  // Taylor series of sin(r).
+  const Vector r2(Multiply(r, r));
+  Vector y(Broadcast(1.0 / 6227020800.0));
+  y = Add(Multiply(y, r2), Broadcast(-1.0 / 39916800.0));
+  y = Add(Multiply(y, r2), Broadcast(1.0 / 362880.0));
+  y = Add(Multiply(y, r2), Broadcast(-1.0 / 5040.0));
+  y = Add(Multiply(y, r2), Broadcast(1.0 / 120.0));
+  y = Add(Multiply(y, r2), Broadcast(-1.0 / 6.0));
+  // Multiply r at the end to keep the sign of zero.
+  y = Multiply(r, Add(Broadcast(1.0), Multiply(y, r2)));
+
+  // The sign is 1 - 2 * (j mod 2), where j = k + offset.
+  const Vector j(Add(k, Broadcast(offset)));
+  const Vector half(
+      Round(Subtract(Multiply(j, Broadcast(0.5)), Broadcast(0.25))));
+  const Vector sign(Subtract(
+      Broadcast(1.0), Multiply(Broadcast(2.0), Subtract(j, Add(half, half)))));
+  return Multiply(sign, y);
+}
+
 class OperationInterface {
  public:
   virtual ~OperationInterface() {
   }
 
   virtual bool Run(double* number) const = 0;
+
+  // Applies the operation to each of the given numbers.
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      if (!Run(&numbers[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 
 class OperationPerformer : public sptk::ScalarOperation::ModuleInterface {
@@ -73,6 +152,24 @@ class OperationPerformer : public sptk::ScalarOperation::ModuleInterface {
     return operation_->Run(number);
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation, double* numbers,
+                   bool* is_magic_number) const {
+    // Apply the operation to each run of numbers which are not magic numbers.
+    const bool* const first(is_magic_number);
+    const bool* const last(is_magic_number + num_data);
+    const bool* begin(std::find(first, last, false));
+    while (begin != last) {
+      const bool* end(std::find(begin, last, true));
+      if (!operation_->Run(static_cast<int>(end - begin),
+                           uses_fast_approximation,
+                           numbers + (begin - first))) {
+        return false;
+      }
+      begin = std::find(end, last, false);
+    }
+    return true;
+  }
+
  private:
   const OperationInterface* operation_;
   DISALLOW_COPY_AND_ASSIGN(OperationPerformer);
@@ -88,6 +185,14 @@ class Addition : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector addend(Broadcast(addend_));
+    ApplyToEachNumber([&](Vector x) { return Add(x, addend); }, num_data,
+                      numbers);
+    return true;
+  }
+
  private:
   const double addend_;
   DISALLOW_COPY_AND_ASSIGN(Addition);
@@ -103,6 +208,14 @@ class Subtraction : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector subtrahend(Broadcast(subtrahend_));
+    ApplyToEachNumber([&](Vector x) { return Subtract(x, subtrahend); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   const double subtrahend_;
   DISALLOW_COPY_AND_ASSIGN(Subtraction);
@@ -118,6 +231,14 @@ class Multiplication : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector multiplier(Broadcast(multiplier_));
+    ApplyToEachNumber([&](Vector x) { return Multiply(x, multiplier); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   const double multiplier_;
   DISALLOW_COPY_AND_ASSIGN(Multiplication);
@@ -133,6 +254,14 @@ class Division : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector multiplier(Broadcast(multiplier_));
+    ApplyToEachNumber([&](Vector x) { return Multiply(x, multiplier); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   const double multiplier_;
   DISALLOW_COPY_AND_ASSIGN(Division);
@@ -178,6 +307,14 @@ class LowerBounding : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector lower_bound(Broadcast(lower_bound_));
+    ApplyToEachNumber([&](Vector x) { return Maximum(lower_bound, x); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   const double lower_bound_;
   DISALLOW_COPY_AND_ASSIGN(LowerBounding);
@@ -193,6 +330,14 @@ class UpperBounding : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector upper_bound(Broadcast(upper_bound_));
+    ApplyToEachNumber([&](Vector x) { return Minimum(upper_bound, x); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   const double upper_bound_;
   DISALLOW_COPY_AND_ASSIGN(UpperBounding);
@@ -208,6 +353,13 @@ class Absolute : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    ApplyToEachNumber([](Vector x) { return sptk::simd::Absolute(x); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Absolute);
 };
@@ -222,6 +374,14 @@ class Reciprocal : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    const Vector one(Broadcast(1.0));
+    ApplyToEachNumber([&](Vector x) { return Divide(one, x); }, num_data,
+                      numbers);
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Reciprocal);
 };
@@ -236,6 +396,13 @@ class Square : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    ApplyToEachNumber([](Vector x) { return Multiply(x, x); }, num_data,
+                      numbers);
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Square);
 };
@@ -250,6 +417,13 @@ class SquareRoot : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    ApplyToEachNumber([](Vector x) { return sptk::simd::SquareRoot(x); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(SquareRoot);
 };
@@ -264,6 +438,18 @@ class NaturalLogarithm : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    if (uses_fast_approximation) {
+      ApplyApproximation(ApproximateNaturalLogarithm,
+                         [](double x) { return std::log(x); }, DBL_MIN,
+                         DBL_MAX, num_data, numbers);
+    } else {
+      for (int i(0); i < num_data; ++i) numbers[i] = std::log(numbers[i]);
+    }
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(NaturalLogarithm);
 };
@@ -278,6 +464,21 @@ class Logarithm : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    if (uses_fast_approximation) {
+      ApplyApproximation(ApproximateNaturalLogarithm,
+                         [](double x) { return std::log(x); }, DBL_MIN,
+                         DBL_MAX, num_data, numbers);
+    } else {
+      for (int i(0); i < num_data; ++i) numbers[i] = std::log(numbers[i]);
+    }
+    const Vector multiplier(Broadcast(multiplier_));
+    ApplyToEachNumber([&](Vector x) { return Multiply(x, multiplier); },
+                      num_data, numbers);
+    return true;
+  }
+
  private:
   const double multiplier_;
   DISALLOW_COPY_AND_ASSIGN(Logarithm);
@@ -293,6 +494,19 @@ class NaturalExponential : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    if (uses_fast_approximation) {
+      ApplyApproximation(ApproximateExponential,
+                         [](double x) { return std::exp(x); },
+                         -kMaximumExponent, kMaximumExponent, num_data,
+                         numbers);
+    } else {
+      for (int i(0); i < num_data; ++i) numbers[i] = std::exp(numbers[i]);
+    }
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(NaturalExponential);
 };
@@ -307,6 +521,25 @@ class Exponential : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    if (uses_fast_approximation && 0.0 < base_) {
+      // b^x = exp(x * ln(b)).
+      const Vector multiplier(Broadcast(std::log(base_)));
+      ApplyToEachNumber([&](Vector x) { return Multiply(x, multiplier); },
+                        num_data, numbers);
+      ApplyApproximation(ApproximateExponential,
+                         [](double x) { return std::exp(x); },
+                         -kMaximumExponent, kMaximumExponent, num_data,
+                         numbers);
+    } else {
+      for (int i(0); i < num_data; ++i) {
+        numbers[i] = std::pow(base_, numbers[i]);
+      }
+    }
+    return true;
+  }
+
  private:
   const double base_;
   DISALLOW_COPY_AND_ASSIGN(Exponential);
@@ -420,6 +653,18 @@ class Sine : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    if (uses_fast_approximation) {
+      ApplyApproximation([](Vector x) { return ApproximateSine(x, 0.0); },
+                         [](double x) { return std::sin(x); }, -kMaximumPhase,
+                         kMaximumPhase, num_data, numbers);
+    } else {
+      for (int i(0); i < num_data; ++i) numbers[i] = std::sin(numbers[i]);
+    }
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Sine);
 };
@@ -434,6 +679,18 @@ class Cosine : public OperationInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation,
+                   double* numbers) const {
+    if (uses_fast_approximation) {
+      ApplyApproximation([](Vector x) { return ApproximateSine(x, 0.5); },
+                         [](double x) { return std::cos(x); }, -kMaximumPhase,
+                         kMaximumPhase, num_data, numbers);
+    } else {
+      for (int i(0); i < num_data; ++i) numbers[i] = std::cos(numbers[i]);
+    }
+    return true;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Cosine);
 };
@@ -482,6 +739,17 @@ class MagicNumberRemover : public sptk::ScalarOperation::ModuleInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation, double* numbers,
+                   bool* is_magic_number) const {
+    for (int i(0); i < num_data; ++i) {
+      if (is_magic_number[i]) {
+        return false;
+      }
+      is_magic_number[i] = (magic_number_ == numbers[i]);
+    }
+    return true;
+  }
+
  private:
   const double magic_number_;
   DISALLOW_COPY_AND_ASSIGN(MagicNumberRemover);
@@ -501,6 +769,17 @@ class MagicNumberReplacer : public sptk::ScalarOperation::ModuleInterface {
     return true;
   }
 
+  virtual bool Run(int num_data, bool uses_fast_approximation, double* numbers,
+                   bool* is_magic_number) const {
+    for (int i(0); i < num_data; ++i) {
+      if (is_magic_number[i]) {
+        numbers[i] = replacement_number_;
+        is_magic_number[i] = false;
+      }
+    }
+    return true;
+  }
+
  private:
   const double replacement_number_;
   DISALLOW_COPY_AND_ASSIGN(MagicNumberReplacer);
@@ -679,4 +958,28 @@ bool ScalarOperation::Run(double* number, bool* is_magic_number) const {
   return true;
 }
 
+bool ScalarOperation::Run(int num_data, bool uses_fast_approximation,
+                          double* numbers, bool* is_magic_number) const {
+  if (num_data < 0 || NULL == numbers || NULL == is_magic_number) {
+    return false;
+  }
+
+  std::fill(is_magic_number, is_magic_number + num_data, false);
+
+  // Pass each tile through all modules before moving on to the next one.
+  for (int begin(0); begin < num_data; begin += kNumDataInTile) {
+    const int tile_size(std::min(kNumDataInTile, num_data - begin));
+    for (std::vector<ScalarOperation::ModuleInterface*>::const_iterator itr(
+             modules_.begin());
+         itr != modules_.end(); ++itr) {
+      if (!(*itr)->Run(tile_size, uses_fast_approximation, numbers + begin,
+                       is_magic_number + begin)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 }  // namespace sptk
@@ -44,11 +44,72 @@
 
 #include "SPTK/math/statistics_accumulator.h"
 
-#include <algorithm>   // std::copy, std::transform
+#include <algorithm>   // std::copy, std::fill, std::min, std::transform
 #include <cmath>       // std::sqrt
 #include <cstddef>     // std::size_t
 #include <functional>  // std::bind1st, std::multiplies, std::plus, std::ptr_fun
 
+#include "SPTK/utils/simd.h"
+
+namespace {
+
+using sptk::simd::Add;
+using sptk::simd::Broadcast;
+using sptk::simd::kVectorLength;
+using sptk::simd::Load;
+using sptk::simd::Multiply;
+using sptk::simd::Store;
+using sptk::simd::Vector;
+
+// Number of vectors processed at once in the batched update.
+const int kNumVectorInBlock(256);
+
+// Size of a tile of the covariance matrix kept in registers.
+const int kNumRowInTile(4);
+const int kNumColumnInTile(2 * kVectorLength);
+
+// The length of vectors is rounded up to a multiple of this number.
+const int kNumPaddingUnit(kNumRowInTile < kNumColumnInTile ? kNumColumnInTile
+                                                           : kNumRowInTile);
+
+// Calculates a tile of sum_k c_k c_k^T, where c_k is the k-th row of the
+// centered data, and stores the elements in the lower triangle. Each element
+// is summed up in the order of k regardless of the vector length.
+void UpdateTile(const double* centered_data, int num_vector, int stride,
+                int first_row, int first_column, int length,
+                sptk::SymmetricMatrix* second_order_statistics) {
+  Vector sum[kNumRowInTile][2];
+  for (int r(0); r < kNumRowInTile; ++r) {
+    sum[r][0] = Broadcast(0.0);
+    sum[r][1] = Broadcast(0.0);
+  }
+
+  for (int k(0); k < num_vector; ++k) {
+    const double* c(centered_data + k * stride);
+    const Vector c0(Load(c + first_column));
+    const Vector c1(Load(c + first_column + kVectorLength));
+    for (int r(0); r < kNumRowInTile; ++r) {
+      const Vector a(Broadcast(c[first_row + r]));
+      sum[r][0] = Add(sum[r][0], Multiply(a, c0));
+      sum[r][1] = Add(sum[r][1], Multiply(a, c1));
+    }
+  }
+
+  double tile[kNumRowInTile][kNumColumnInTile];
+  for (int r(0); r < kNumRowInTile; ++r) {
+    Store(sum[r][0], tile[r]);
+    Store(sum[r][1], tile[r] + kVectorLength);
+  }
+  for (int r(0); r < kNumRowInTile && first_row + r < length; ++r) {
+    const int i(first_row + r);
+    for (int c(0); c < kNumColumnInTile && first_column + c <= i; ++c) {
+      (*second_order_statistics)[i][first_column + c] = tile[r][c];
+    }
+  }
+}
+
+}  // namespace
+
 namespace sptk {
 
 StatisticsAccumulator::StatisticsAccumulator(int num_order,
@@ -120,17 +181,10 @@ bool StatisticsAccumulator::GetDiagonalCovariance(
     diagonal_covariance->resize(num_order_ + 1);
   }
 
-  std::vector<double> mean;
-  if (!GetMean(buffer, &mean)) {
-    return false;
-  }
-
   const double inverse_num_data(1.0 / buffer.zeroth_order_statistics_);
-  const double* mu(&(mean[0]));
   double* variance(&((*diagonal_covariance)[0]));
   for (int i(0); i <= num_order_; ++i) {
-    variance[i] = inverse_num_data * buffer.second_order_statistics_[i][i] -
-                  mu[i] * mu[i];
+    variance[i] = inverse_num_data * buffer.second_order_statistics_[i][i];
   }
 
   return true;
@@ -166,18 +220,11 @@ bool StatisticsAccumulator::GetFullCovariance(
     full_covariance->Resize(num_order_ + 1);
   }
 
-  std::vector<double> mean;
-  if (!GetMean(buffer, &mean)) {
-    return false;
-  }
-
   const double inverse_num_data(1.0 / buffer.zeroth_order_statistics_);
-  const double* mu(&(mean[0]));
   for (int i(0); i <= num_order_; ++i) {
     for (int j(0); j <= i; ++j) {
       (*full_covariance)[i][j] =
-          inverse_num_data * buffer.second_order_statistics_[i][j] -
-          mu[i] * mu[j];
+          inverse_num_data * buffer.second_order_statistics_[i][j];
     }
   }
 
@@ -233,8 +280,30 @@ bool StatisticsAccumulator::Run(const std::vector<double>& data,
     buffer->second_order_statistics_.Resize(length);
   }
 
-  // 0th order
-  ++(buffer->zeroth_order_statistics_);
+  // 2nd order
+  // The sum of squared deviations is updated with the deviation from the mean
+  // of the preceding data:
+  //   S_n = S_{n-1} + (n-1)/n (x_n - m_{n-1}) (x_n - m_{n-1})^T.
+  if (2 <= num_statistics_order_ && 0 < buffer->zeroth_order_statistics_) {
+    if (buffer->deviation_.size() != static_cast<std::size_t>(length)) {
+      buffer->deviation_.resize(length);
+    }
+    const int num_data(buffer->zeroth_order_statistics_);
+    const double inverse_num_data(1.0 / num_data);
+    const double weight(static_cast<double>(num_data) / (num_data + 1));
+    const double* sum(&(buffer->first_order_statistics_[0]));
+    double* deviation(&(buffer->deviation_[0]));
+    for (int i(0); i < length; ++i) {
+      deviation[i] = data[i] - sum[i] * inverse_num_data;
+    }
+    for (int i(0); i < length; ++i) {
+      const double weighted_deviation(weight * deviation[i]);
+      for (int j(0); j <= i; ++j) {
+        buffer->second_order_statistics_[i][j] +=
+            weighted_deviation * deviation[j];
+      }
+    }
+  }
 
   // 1st order
   if (1 <= num_statistics_order_) {
@@ -243,15 +312,182 @@ bool StatisticsAccumulator::Run(const std::vector<double>& data,
         buffer->first_order_statistics_.begin(), std::plus<double>());
   }
 
+  // 0th order
+  ++(buffer->zeroth_order_statistics_);
+
+  return true;
+}
+
+bool StatisticsAccumulator::Run(const std::vector<float>& data,
+                                StatisticsAccumulator::Buffer* buffer) const {
+  // check inputs
+  if (NULL == buffer) {
+    return false;
+  }
+
+  buffer->data_in_double_.assign(data.begin(), data.end());
+  return Run(buffer->data_in_double_, buffer);
+}
+
+bool StatisticsAccumulator::Run(const Matrix& data,
+                                StatisticsAccumulator::Buffer* buffer) const {
+  // check inputs
+  const int length(num_order_ + 1);
+  if (!is_valid_ || data.GetNumColumn() != length || NULL == buffer) {
+    return false;
+  }
+
+  // The 0th and 1st order statistics are cheap enough.
+  const int num_data(data.GetNumRow());
+  if (num_statistics_order_ < 2) {
+    std::vector<double> vector(length);
+    for (int n(0); n < num_data; ++n) {
+      std::copy(data[n], data[n] + length, vector.begin());
+      if (!Run(vector, buffer)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // prepare buffer
+  const int padded_length(
+      (length + kNumPaddingUnit - 1) / kNumPaddingUnit * kNumPaddingUnit);
+  if (buffer->block_sum_.size() != static_cast<std::size_t>(length)) {
+    buffer->block_sum_.resize(length);
+  }
+  if (buffer->block_second_order_statistics_.GetNumDimension() != length) {
+    buffer->block_second_order_statistics_.Resize(length);
+  }
+  if (buffer->centered_data_.size() !=
+      static_cast<std::size_t>(kNumVectorInBlock * padded_length)) {
+    buffer->centered_data_.resize(kNumVectorInBlock * padded_length);
+  }
+
+  for (int n(0); n < num_data; n += kNumVectorInBlock) {
+    const int num_vector(std::min(kNumVectorInBlock, num_data - n));
+
+    // Calculate the mean of the block.
+    double* block_sum(&(buffer->block_sum_[0]));
+    std::fill(block_sum, block_sum + length, 0.0);
+    for (int k(0); k < num_vector; ++k) {
+      const double* x(data[n + k]);
+      for (int i(0); i < length; ++i) {
+        block_sum[i] += x[i];
+      }
+    }
+
+    // Subtract the mean. The padded elements are kept zero.
+    const double inverse_num_vector(1.0 / num_vector);
+    double* centered_data(&(buffer->centered_data_[0]));
+    for (int k(0); k < num_vector; ++k) {
+      const double* x(data[n + k]);
+      double* c(centered_data + k * padded_length);
+      for (int i(0); i < length; ++i) {
+        c[i] = x[i] - block_sum[i] * inverse_num_vector;
+      }
+      std::fill(c + length, c + padded_length, 0.0);
+    }
+
+    // Perform the rank-k update of the lower triangle tile by tile.
+    for (int i(0); i < padded_length; i += kNumRowInTile) {
+      for (int j(0); j <= i + kNumRowInTile - 1 && j < padded_length;
+           j += kNumColumnInTile) {
+        UpdateTile(centered_data, num_vector, padded_length, i, j, length,
+                   &buffer->block_second_order_statistics_);
+      }
+    }
+
+    if (!Merge(num_vector, buffer->block_sum_,
+               buffer->block_second_order_statistics_, buffer)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool StatisticsAccumulator::Merge(
+    const StatisticsAccumulator::Buffer& buffer,
+    StatisticsAccumulator::Buffer* merged_buffer) const {
+  // check inputs
+  const int length(num_order_ + 1);
+  if (!is_valid_ || NULL == merged_buffer || &buffer == merged_buffer) {
+    return false;
+  }
+  if (0 == buffer.zeroth_order_statistics_) {
+    return true;
+  }
+  if ((1 <= num_statistics_order_ &&
+       buffer.first_order_statistics_.size() !=
+           static_cast<std::size_t>(length)) ||
+      (2 <= num_statistics_order_ &&
+       buffer.second_order_statistics_.GetNumDimension() != length)) {
+    return false;
+  }
+
+  return Merge(buffer.zeroth_order_statistics_, buffer.first_order_statistics_,
+               buffer.second_order_statistics_, merged_buffer);
+}
+
+bool StatisticsAccumulator::Merge(
+    int num_data, const std::vector<double>& sum,
+    const SymmetricMatrix& second_order_statistics,
+    StatisticsAccumulator::Buffer* merged_buffer) const {
+  const int length(num_order_ + 1);
+
+  // prepare buffer
+  if (1 <= num_statistics_order_ &&
+      merged_buffer->first_order_statistics_.size() !=
+          static_cast<std::size_t>(length)) {
+    merged_buffer->first_order_statistics_.resize(length);
+  }
+  if (2 <= num_statistics_order_ &&
+      merged_buffer->second_order_statistics_.GetNumDimension() != length) {
+    merged_buffer->second_order_statistics_.Resize(length);
+  }
+
   // 2nd order
+  // The deviation between the two means is added as in Chan et al.'s method:
+  //   S = S_a + S_b + n_a n_b / (n_a + n_b) (m_a - m_b) (m_a - m_b)^T.
   if (2 <= num_statistics_order_) {
+    const int num_data_a(num_data);
+    const int num_data_b(merged_buffer->zeroth_order_statistics_);
+    if (merged_buffer->deviation_.size() != static_cast<std::size_t>(length)) {
+      merged_buffer->deviation_.resize(length);
+    }
+    const double* sum_a(&(sum[0]));
+    const double* sum_b(&(merged_buffer->first_order_statistics_[0]));
+    double* deviation(&(merged_buffer->deviation_[0]));
+    if (0 < num_data_b) {
+      for (int i(0); i < length; ++i) {
+        deviation[i] = sum_a[i] / num_data_a - sum_b[i] / num_data_b;
+      }
+    } else {
+      std::fill(deviation, deviation + length, 0.0);
+    }
+    const double weight(static_cast<double>(num_data_a) * num_data_b /
+                        (num_data_a + num_data_b));
     for (int i(0); i < length; ++i) {
+      const double weighted_deviation(weight * deviation[i]);
       for (int j(0); j <= i; ++j) {
-        buffer->second_order_statistics_[i][j] += data[i] * data[j];
+        merged_buffer->second_order_statistics_[i][j] +=
+            second_order_statistics[i][j] + weighted_deviation * deviation[j];
       }
     }
   }
 
+  // 1st order
+  if (1 <= num_statistics_order_) {
+    std::transform(sum.begin(), sum.end(),
+                   merged_buffer->first_order_statistics_.begin(),
+                   merged_buffer->first_order_statistics_.begin(),
+                   std::plus<double>());
+  }
+
+  // 0th order
+  merged_buffer->zeroth_order_statistics_ += num_data;
+
   return true;
 }
 
@@ -103,4 +103,114 @@ bool MultistageVectorQuantization::Run(
   return true;
 }
 
+bool MultistageVectorQuantization::Run(
+    const std::vector<double>& input_vector,
+    const std::vector<std::vector<std::vector<double> > >& codebook_vectors,
+    const std::vector<const NearestCodewordSearch*>& nearest_codeword_searches,
+    std::vector<int>* codebook_index,
+    MultistageVectorQuantization::Buffer* buffer) const {
+  if (!is_valid_ ||
+      input_vector.size() != static_cast<std::size_t>(num_order_ + 1) ||
+      !CheckSearches(codebook_vectors, nearest_codeword_searches) ||
+      NULL == codebook_index || NULL == buffer) {
+    return false;
+  }
+
+  if (codebook_index->size() != static_cast<std::size_t>(num_stage_)) {
+    codebook_index->resize(num_stage_);
+  }
+  if (buffer->quantization_error_.size() !=
+      static_cast<std::size_t>(num_order_ + 1)) {
+    buffer->quantization_error_.resize(num_order_ + 1);
+  }
+
+  int* stored_codebook_index(&((*codebook_index)[0]));
+
+  std::copy(input_vector.begin(), input_vector.end(),
+            buffer->quantization_error_.begin());
+
+  for (int stage(0); stage < num_stage_; ++stage) {
+    int index;
+    double distance;
+    if (!nearest_codeword_searches[stage]->Run(buffer->quantization_error_, 0,
+                                               &index, &distance)) {
+      return false;
+    }
+    stored_codebook_index[stage] = index;
+
+    std::transform(buffer->quantization_error_.begin(),
+                   buffer->quantization_error_.end(),
+                   codebook_vectors[stage][index].begin(),
+                   buffer->quantization_error_.begin(), std::minus<double>());
+  }
+
+  return true;
+}
+
+bool MultistageVectorQuantization::Run(
+    const std::vector<std::vector<double> >& input_vectors,
+    const std::vector<std::vector<std::vector<double> > >& codebook_vectors,
+    const std::vector<const NearestCodewordSearch*>& nearest_codeword_searches,
+    std::vector<std::vector<int> >* codebook_indices,
+    MultistageVectorQuantization::Buffer* buffer) const {
+  if (!is_valid_ ||
+      !CheckSearches(codebook_vectors, nearest_codeword_searches) ||
+      NULL == codebook_indices || NULL == buffer) {
+    return false;
+  }
+
+  const int num_input_vector(input_vectors.size());
+  if (codebook_indices->size() != static_cast<std::size_t>(num_input_vector)) {
+    codebook_indices->resize(num_input_vector);
+  }
+  for (int i(0); i < num_input_vector; ++i) {
+    if ((*codebook_indices)[i].size() != static_cast<std::size_t>(num_stage_)) {
+      (*codebook_indices)[i].resize(num_stage_);
+    }
+  }
+  buffer->quantization_errors_ = input_vectors;
+
+  for (int stage(0); stage < num_stage_; ++stage) {
+    if (!nearest_codeword_searches[stage]->Run(
+            buffer->quantization_errors_, &buffer->stage_codebook_indices_,
+            &buffer->distances_)) {
+      return false;
+    }
+
+    for (int i(0); i < num_input_vector; ++i) {
+      const int index(buffer->stage_codebook_indices_[i]);
+      (*codebook_indices)[i][stage] = index;
+
+      std::transform(buffer->quantization_errors_[i].begin(),
+                     buffer->quantization_errors_[i].end(),
+                     codebook_vectors[stage][index].begin(),
+                     buffer->quantization_errors_[i].begin(),
+                     std::minus<double>());
+    }
+  }
+
+  return true;
+}
+
+bool MultistageVectorQuantization::CheckSearches(
+    const std::vector<std::vector<std::vector<double> > >& codebook_vectors,
+    const std::vector<const NearestCodewordSearch*>& nearest_codeword_searches)
+    const {
+  if (codebook_vectors.size() != static_cast<std::size_t>(num_stage_) ||
+      nearest_codeword_searches.size() !=
+          static_cast<std::size_t>(num_stage_)) {
+    return false;
+  }
+  for (int stage(0); stage < num_stage_; ++stage) {
+    if (NULL == nearest_codeword_searches[stage] ||
+        nearest_codeword_searches[stage]->GetNumOrder() != num_order_ ||
+        codebook_vectors[stage].size() !=
+            static_cast<std::size_t>(
+                nearest_codeword_searches[stage]->GetCodebookSize())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace sptk
@@ -0,0 +1,297 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/quantizer/nearest_codeword_search.h"
+
+#include <algorithm>  // std::copy, std::fill, std::min
+#include <cfloat>     // DBL_MAX
+#include <cmath>      // std::sqrt
+#include <cstddef>    // std::size_t
+
+#include "SPTK/utils/simd.h"
+
+namespace {
+
+using sptk::simd::Add;
+using sptk::simd::Broadcast;
+using sptk::simd::kVectorLength;
+using sptk::simd::LessEqualMask;
+using sptk::simd::Load;
+using sptk::simd::Multiply;
+using sptk::simd::Store;
+using sptk::simd::Subtract;
+using sptk::simd::Vector;
+
+// Relative margin for the triangle inequality test to absorb rounding errors.
+const double kMargin(1e-8);
+
+// Number of dimensions processed between checks of partial distance.
+const int kCheckInterval(8);
+
+// Returns c + (a - b)^2. Each lane holds the distance to a different codeword
+// and accumulates it in the same order as the scalar code, so the result does
+// not depend on the instruction set.
+inline Vector AddSquaredDifference(Vector a, Vector b, Vector c) {
+  const Vector diff(Subtract(a, b));
+  return Add(c, Multiply(diff, diff));
+}
+
+// Number of codewords processed at once. Four vectors are used to hide the
+// latency of addition.
+const int kGroupSize(4 * kVectorLength);
+
+// Calculates squared distances between an input vector and a group of
+// interleaved codewords. Returns false without storing the distances if all of
+// them are found to exceed the upper bound.
+inline bool CalculateGroupDistances(const double* input_vector,
+                                    const double* group, int length,
+                                    double upper_bound, double* distances) {
+  const Vector bound(Broadcast(upper_bound));
+  Vector sum0(Broadcast(0.0));
+  Vector sum1(Broadcast(0.0));
+  Vector sum2(Broadcast(0.0));
+  Vector sum3(Broadcast(0.0));
+  for (int m(0); m < length;) {
+    const int end(std::min(m + kCheckInterval, length));
+    for (; m < end; ++m) {
+      const Vector x(Broadcast(input_vector[m]));
+      const double* y(group + m * kGroupSize);
+      sum0 = AddSquaredDifference(x, Load(y), sum0);
+      sum1 = AddSquaredDifference(x, Load(y + kVectorLength), sum1);
+      sum2 = AddSquaredDifference(x, Load(y + 2 * kVectorLength), sum2);
+      sum3 = AddSquaredDifference(x, Load(y + 3 * kVectorLength), sum3);
+    }
+    // The partial sums never decrease.
+    if (0 == (LessEqualMask(sum0, bound) | LessEqualMask(sum1, bound) |
+              LessEqualMask(sum2, bound) | LessEqualMask(sum3, bound))) {
+      return false;
+    }
+  }
+  Store(sum0, distances);
+  Store(sum1, distances + kVectorLength);
+  Store(sum2, distances + 2 * kVectorLength);
+  Store(sum3, distances + 3 * kVectorLength);
+  return true;
+}
+
+}  // namespace
+
+namespace sptk {
+
+NearestCodewordSearch::NearestCodewordSearch(int num_order)
+    : num_order_(num_order), codebook_size_(0), is_valid_(true) {
+  if (num_order_ < 0) {
+    is_valid_ = false;
+  }
+}
+
+bool NearestCodewordSearch::SetCodebook(
+    const std::vector<std::vector<double> >& codebook_vectors) {
+  // Check inputs.
+  const int length(num_order_ + 1);
+  if (!is_valid_ || codebook_vectors.empty()) {
+    return false;
+  }
+
+  // Prepare memories.
+  codebook_size_ = codebook_vectors.size();
+  const int num_group((codebook_size_ + kGroupSize - 1) / kGroupSize);
+  codebook_.resize(codebook_size_ * length);
+  grouped_codebook_.resize(num_group * kGroupSize * length);
+  radius_.resize(codebook_size_);
+
+  // Unused lanes are filled with values far from any input.
+  std::fill(grouped_codebook_.begin(), grouped_codebook_.end(), DBL_MAX);
+  for (int i(0); i < codebook_size_; ++i) {
+    if (codebook_vectors[i].size() != static_cast<std::size_t>(length)) {
+      codebook_size_ = 0;
+      return false;
+    }
+    std::copy(codebook_vectors[i].begin(), codebook_vectors[i].end(),
+              codebook_.begin() + i * length);
+    double* group(&(grouped_codebook_[(i / kGroupSize) * kGroupSize * length]));
+    for (int m(0); m < length; ++m) {
+      group[m * kGroupSize + i % kGroupSize] = codebook_vectors[i][m];
+    }
+  }
+
+  // Find the nearest other codeword of each codeword.
+  const double* grouped_codebook(&(grouped_codebook_[0]));
+  double distances[kGroupSize];
+  for (int i(0); i < codebook_size_; ++i) {
+    const double* x(&(codebook_[i * length]));
+    double minimum_distance(DBL_MAX);
+    for (int g(0); g < num_group; ++g) {
+      if (!CalculateGroupDistances(x,
+                                   grouped_codebook + g * kGroupSize * length,
+                                   length, minimum_distance, distances)) {
+        continue;
+      }
+      for (int k(0); k < kGroupSize; ++k) {
+        const int j(g * kGroupSize + k);
+        if (j != i && j < codebook_size_ && distances[k] < minimum_distance) {
+          minimum_distance = distances[k];
+        }
+      }
+    }
+    radius_[i] = 0.5 * std::sqrt(minimum_distance) * (1.0 - kMargin);
+  }
+
+  return true;
+}
+
+bool NearestCodewordSearch::Run(const std::vector<double>& input_vector,
+                                int initial_codebook_index, int* codebook_index,
+                                double* distance) const {
+  // Check inputs.
+  if (!is_valid_ || 0 == codebook_size_ ||
+      input_vector.size() != static_cast<std::size_t>(num_order_ + 1) ||
+      NULL == codebook_index || NULL == distance) {
+    return false;
+  }
+
+  const double* x(&(input_vector[0]));
+  int best_index(
+      (0 <= initial_codebook_index && initial_codebook_index < codebook_size_)
+          ? initial_codebook_index
+          : 0);
+  double best_distance(CalculateDistance(x, best_index));
+
+  if (best_distance < DBL_MAX) {
+    // If the input is within half the distance to the nearest other codeword,
+    // no other codeword can be nearer.
+    if (std::sqrt(best_distance) < radius_[best_index]) {
+      *codebook_index = best_index;
+      *distance = best_distance;
+      return true;
+    }
+  } else {
+    // Follow the behavior of exhaustive search for unusual inputs.
+    best_index = -1;
+    best_distance = DBL_MAX;
+  }
+
+  Search(x, &best_index, &best_distance);
+
+  if (best_index < 0) {
+    *codebook_index = 0;
+    *distance = CalculateDistance(x, 0);
+  } else {
+    *codebook_index = best_index;
+    *distance = best_distance;
+  }
+
+  return true;
+}
+
+bool NearestCodewordSearch::Run(
+    const std::vector<std::vector<double> >& input_vectors,
+    std::vector<int>* codebook_indices, std::vector<double>* distances) const {
+  // Check inputs.
+  if (NULL == codebook_indices || NULL == distances) {
+    return false;
+  }
+
+  // Prepare memories.
+  const int num_input_vector(input_vectors.size());
+  if (codebook_indices->size() != static_cast<std::size_t>(num_input_vector)) {
+    codebook_indices->resize(num_input_vector);
+  }
+  if (distances->size() != static_cast<std::size_t>(num_input_vector)) {
+    distances->resize(num_input_vector);
+  }
+
+  int index(0);
+  for (int i(0); i < num_input_vector; ++i) {
+    if (!Run(input_vectors[i], index, &index, &((*distances)[i]))) {
+      return false;
+    }
+    (*codebook_indices)[i] = index;
+  }
+
+  return true;
+}
+
+double NearestCodewordSearch::CalculateDistance(const double* input_vector,
+                                                int codebook_index) const {
+  const double* y(&(codebook_[codebook_index * (num_order_ + 1)]));
+  double sum(0.0);
+  for (int m(0); m <= num_order_; ++m) {
+    const double diff(input_vector[m] - y[m]);
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+void NearestCodewordSearch::Search(const double* input_vector,
+                                   int* codebook_index,
+                                   double* distance) const {
+  const int length(num_order_ + 1);
+  const int num_group((codebook_size_ + kGroupSize - 1) / kGroupSize);
+  const double* grouped_codebook(&(grouped_codebook_[0]));
+  double distances[kGroupSize];
+
+  int best_index(*codebook_index);
+  double best_distance(*distance);
+  for (int g(0); g < num_group; ++g) {
+    if (!CalculateGroupDistances(input_vector,
+                                 grouped_codebook + g * kGroupSize * length,
+                                 length, best_distance, distances)) {
+      continue;
+    }
+    const int num_lane(std::min(kGroupSize, codebook_size_ - g * kGroupSize));
+    for (int k(0); k < num_lane; ++k) {
+      const int i(g * kGroupSize + k);
+      if (distances[k] < best_distance ||
+          (distances[k] == best_distance && i < best_index)) {
+        best_index = i;
+        best_distance = distances[k];
+      }
+    }
+  }
+  *codebook_index = best_index;
+  *distance = best_distance;
+}
+
+}  // namespace sptk
@@ -0,0 +1,275 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/utils/binary_stream_buffer.h"
+
+#include <unistd.h>   // read, write, STDIN_FILENO, STDOUT_FILENO
+#include <algorithm>  // std::min, std::reverse
+#include <cerrno>     // errno, EINTR
+#include <cstddef>    // std::size_t
+#include <cstring>    // std::memcpy, std::memmove
+
+namespace {
+
+const int kDefaultBufferSize(1 << 20);
+
+void SwapBytes(int byte_swap_size, std::size_t size, char* data) {
+  char* end(data + size);
+  for (char* p(data); p < end; p += byte_swap_size) {
+    std::reverse(p, p + byte_swap_size);
+  }
+}
+
+std::streamsize ReadSome(int file_descriptor, char* data, std::size_t size) {
+  for (;;) {
+    const ssize_t num_bytes(read(file_descriptor, data, size));
+    if (num_bytes < 0 && EINTR == errno) continue;
+    return num_bytes;
+  }
+}
+
+bool WriteAll(int file_descriptor, const char* data, std::size_t size) {
+  while (0 < size) {
+    const ssize_t num_bytes(write(file_descriptor, data, size));
+    if (num_bytes < 0) {
+      if (EINTR == errno) continue;
+      return false;
+    }
+    data += num_bytes;
+    size -= num_bytes;
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace sptk {
+
+BinaryStreamBuffer::BinaryStreamBuffer(int file_descriptor,
+                                       OpenMode open_mode, int buffer_size,
+                                       int byte_swap_size)
+    : file_descriptor_(file_descriptor),
+      open_mode_(open_mode),
+      buffer_size_(buffer_size),
+      byte_swap_size_(byte_swap_size),
+      is_valid_(true),
+      num_pending_bytes_(0) {
+  if (file_descriptor_ < 0 || buffer_size_ <= 0 || byte_swap_size_ < 0 ||
+      buffer_size_ < byte_swap_size_) {
+    is_valid_ = false;
+    return;
+  }
+
+  buffer_.resize(buffer_size_);
+  if (kWrite == open_mode_) {
+    setp(&(buffer_[0]), &(buffer_[0]) + buffer_size_);
+  }
+}
+
+BinaryStreamBuffer::~BinaryStreamBuffer() {
+  if (is_valid_ && kWrite == open_mode_ && Flush()) {
+    // Write an incomplete element as it is.
+    WriteAll(file_descriptor_, pbase(), pptr() - pbase());
+  }
+}
+
+BinaryStreamBuffer::int_type BinaryStreamBuffer::underflow() {
+  if (!is_valid_ || kRead != open_mode_) {
+    return traits_type::eof();
+  }
+
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+
+  // Move the incomplete element to the beginning of the buffer.
+  char* begin(&(buffer_[0]));
+  if (0 < num_pending_bytes_) {
+    std::memmove(begin, egptr(), num_pending_bytes_);
+  }
+  int num_bytes(num_pending_bytes_);
+  num_pending_bytes_ = 0;
+
+  const int element_size(0 < byte_swap_size_ ? byte_swap_size_ : 1);
+  for (;;) {
+    const std::streamsize num_read_bytes(ReadSome(
+        file_descriptor_, begin + num_bytes, buffer_size_ - num_bytes));
+    if (num_read_bytes <= 0) break;
+    num_bytes += static_cast<int>(num_read_bytes);
+
+    const int num_complete_bytes(num_bytes - num_bytes % element_size);
+    if (0 < num_complete_bytes) {
+      if (0 < byte_swap_size_) {
+        SwapBytes(byte_swap_size_, num_complete_bytes, begin);
+      }
+      num_pending_bytes_ = num_bytes - num_complete_bytes;
+      setg(begin, begin, begin + num_complete_bytes);
+      return traits_type::to_int_type(*gptr());
+    }
+  }
+
+  // Reached the end of file.
+  setg(begin, begin, begin + num_bytes);
+  return (0 == num_bytes) ? traits_type::eof()
+                          : traits_type::to_int_type(*gptr());
+}
+
+std::streamsize BinaryStreamBuffer::xsgetn(char_type* s, std::streamsize n) {
+  if (0 < byte_swap_size_) {
+    return std::streambuf::xsgetn(s, n);
+  }
+
+  std::streamsize num_read_bytes(0);
+  while (num_read_bytes < n) {
+    if (gptr() < egptr()) {
+      const std::streamsize num_copied_bytes(
+          std::min<std::streamsize>(egptr() - gptr(), n - num_read_bytes));
+      std::memcpy(s + num_read_bytes, gptr(), num_copied_bytes);
+      gbump(static_cast<int>(num_copied_bytes));
+      num_read_bytes += num_copied_bytes;
+    } else if (!is_valid_ || kRead != open_mode_) {
+      break;
+    } else if (buffer_size_ <= n - num_read_bytes) {
+      // Read directly without copying via the internal buffer.
+      const std::streamsize num_direct_bytes(ReadSome(
+          file_descriptor_, s + num_read_bytes, n - num_read_bytes));
+      if (num_direct_bytes <= 0) break;
+      num_read_bytes += num_direct_bytes;
+    } else if (traits_type::eq_int_type(underflow(), traits_type::eof())) {
+      break;
+    }
+  }
+
+  return num_read_bytes;
+}
+
+BinaryStreamBuffer::int_type BinaryStreamBuffer::overflow(int_type c) {
+  if (!is_valid_ || kWrite != open_mode_ || !Flush()) {
+    return traits_type::eof();
+  }
+
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+std::streamsize BinaryStreamBuffer::xsputn(const char_type* s,
+                                           std::streamsize n) {
+  if (0 < byte_swap_size_ || !is_valid_ || kWrite != open_mode_) {
+    return std::streambuf::xsputn(s, n);
+  }
+
+  if (n <= epptr() - pptr()) {
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+  }
+
+  if (!Flush()) {
+    return 0;
+  }
+
+  if (n < buffer_size_) {
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+  }
+
+  // Write directly without copying via the internal buffer.
+  return WriteAll(file_descriptor_, s, n) ? n : 0;
+}
+
+int BinaryStreamBuffer::sync() {
+  if (is_valid_ && kWrite == open_mode_) {
+    return Flush() ? 0 : -1;
+  }
+  return 0;
+}
+
+bool BinaryStreamBuffer::Flush() {
+  char* begin(pbase());
+  const int num_bytes(static_cast<int>(pptr() - pbase()));
+  const int element_size(0 < byte_swap_size_ ? byte_swap_size_ : 1);
+  const int num_complete_bytes(num_bytes - num_bytes % element_size);
+
+  if (0 < byte_swap_size_) {
+    SwapBytes(byte_swap_size_, num_complete_bytes, begin);
+  }
+  if (!WriteAll(file_descriptor_, begin, num_complete_bytes)) {
+    return false;
+  }
+
+  // Keep the incomplete element for the next flush.
+  const int num_remained_bytes(num_bytes - num_complete_bytes);
+  if (0 < num_remained_bytes) {
+    std::memmove(begin, begin + num_complete_bytes, num_remained_bytes);
+  }
+  setp(begin, begin + buffer_size_);
+  pbump(num_remained_bytes);
+
+  return true;
+}
+
+BufferedStandardStreams::BufferedStandardStreams()
+    : input_buffer_(STDIN_FILENO, BinaryStreamBuffer::kRead,
+                    kDefaultBufferSize, 0),
+      output_buffer_(STDOUT_FILENO, BinaryStreamBuffer::kWrite,
+                     kDefaultBufferSize, 0) {
+  std::cout.flush();
+  original_input_buffer_ = std::cin.rdbuf(&input_buffer_);
+  original_output_buffer_ = std::cout.rdbuf(&output_buffer_);
+  original_tie_ = std::cin.tie(NULL);
+}
+
+BufferedStandardStreams::~BufferedStandardStreams() {
+  std::cout.flush();
+  std::cin.tie(original_tie_);
+  std::cin.rdbuf(original_input_buffer_);
+  std::cout.rdbuf(original_output_buffer_);
+}
+
+}  // namespace sptk
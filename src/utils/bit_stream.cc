@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/utils/bit_stream.h"
+
+#include <cstring>  // std::memmove
+
+namespace {
+
+const int kBufferSize(1 << 16);
+
+}  // namespace
+
+namespace sptk {
+
+BitStreamWriter::BitStreamWriter(std::ostream* output_stream, bool is_packed)
+    : output_stream_(output_stream),
+      is_packed_(is_packed),
+      is_valid_(true),
+      bits_(0),
+      num_bits_(0),
+      buffer_(kBufferSize),
+      buffer_size_(0) {
+  if (NULL == output_stream_) {
+    is_valid_ = false;
+    return;
+  }
+}
+
+bool BitStreamWriter::Finish() {
+  if (!is_valid_) {
+    return false;
+  }
+
+  if (is_packed_) {
+    // Pad the last byte.
+    bits_ = (bits_ << 1) | 1;
+    ++num_bits_;
+    const int num_zeros((8 - num_bits_ % 8) % 8);
+    bits_ <<= num_zeros;
+    num_bits_ += num_zeros;
+  }
+  if (!Drain()) {
+    return false;
+  }
+
+  if (0 < buffer_size_) {
+    if (!output_stream_->write(&(buffer_[0]), buffer_size_)) {
+      is_valid_ = false;
+      return false;
+    }
+    buffer_size_ = 0;
+  }
+  return output_stream_->flush().good();
+}
+
+bool BitStreamWriter::Drain() {
+  // Make sure that the buffer has room for all bits.
+  if (kBufferSize - 64 < buffer_size_) {
+    if (!output_stream_->write(&(buffer_[0]), buffer_size_)) {
+      is_valid_ = false;
+      return false;
+    }
+    buffer_size_ = 0;
+  }
+
+  if (is_packed_) {
+    for (; 8 <= num_bits_; num_bits_ -= 8) {
+      buffer_[buffer_size_++] = static_cast<char>(bits_ >> (num_bits_ - 8));
+    }
+  } else {
+    for (; 0 < num_bits_; --num_bits_) {
+      buffer_[buffer_size_++] =
+          static_cast<char>((bits_ >> (num_bits_ - 1)) & 1);
+    }
+  }
+  return true;
+}
+
+BitStreamReader::BitStreamReader(std::istream* input_stream, bool is_packed)
+    : input_stream_(input_stream),
+      is_packed_(is_packed),
+      is_valid_(true),
+      bits_(0),
+      num_bits_(0),
+      buffer_(kBufferSize),
+      buffer_size_(0),
+      position_(0),
+      is_end_of_stream_(false) {
+  if (NULL == input_stream_) {
+    is_valid_ = false;
+    is_end_of_stream_ = true;
+    return;
+  }
+}
+
+void BitStreamReader::Fill() {
+  while (num_bits_ <= 56) {
+    // The last byte is kept in the buffer until the end of the stream is
+    // found, because the padding of the packed format must be removed.
+    if (!is_end_of_stream_ && buffer_size_ - position_ <= 1) {
+      const int num_remaining_bytes(buffer_size_ - position_);
+      if (0 < num_remaining_bytes) {
+        std::memmove(&(buffer_[0]), &(buffer_[position_]),
+                     num_remaining_bytes);
+      }
+      input_stream_->read(&(buffer_[num_remaining_bytes]),
+                          kBufferSize - num_remaining_bytes);
+      const int num_read_bytes(static_cast<int>(input_stream_->gcount()));
+      buffer_size_ = num_remaining_bytes + num_read_bytes;
+      position_ = 0;
+      if (num_read_bytes < kBufferSize - num_remaining_bytes) {
+        is_end_of_stream_ = true;
+      }
+      continue;
+    }
+    if (buffer_size_ == position_) {
+      return;
+    }
+
+    const unsigned char byte(buffer_[position_++]);
+    if (!is_packed_) {
+      bits_ = (bits_ << 1) | (0 == byte ? 0 : 1);
+      ++num_bits_;
+    } else if (is_end_of_stream_ && buffer_size_ == position_) {
+      // Remove a one followed by zeros.
+      if (0 == byte) return;
+      int num_padding_bits(1);
+      while (0 == ((byte >> (num_padding_bits - 1)) & 1)) ++num_padding_bits;
+      bits_ = (bits_ << (8 - num_padding_bits)) | (byte >> num_padding_bits);
+      num_bits_ += 8 - num_padding_bits;
+    } else {
+      bits_ = (bits_ << 8) | byte;
+      num_bits_ += 8;
+    }
+  }
+}
+
+}  // namespace sptk
@@ -0,0 +1,285 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/utils/frame_parallel_driver.h"
+
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // std::size_t
+#include <deque>               // std::deque
+#include <mutex>               // std::mutex, std::unique_lock
+#include <thread>              // std::thread
+
+namespace {
+
+// Number of frames handed to a worker thread at once.
+const int kNumFrameInChunk(64);
+
+// Number of chunks in flight per worker thread. Reading of the next chunks
+// overlaps with processing of the current ones.
+const int kNumChunkPerThread(2);
+
+struct Chunk {
+  Chunk()
+      : inputs(kNumFrameInChunk),
+        outputs(kNumFrameInChunk),
+        messages(kNumFrameInChunk),
+        is_succeeded(kNumFrameInChunk),
+        first_frame_index(0),
+        num_frame(0),
+        is_processed(false) {
+  }
+
+  std::vector<std::vector<double> > inputs;
+  std::vector<std::vector<double> > outputs;
+  std::vector<std::string> messages;
+  std::vector<bool> is_succeeded;
+  int first_frame_index;
+  int num_frame;
+  bool is_processed;
+};
+
+// State shared by the calling thread and the worker threads.
+struct SharedState {
+  SharedState() : is_finished(false) {
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition_for_worker;
+  std::condition_variable condition_for_writer;
+  std::deque<Chunk*> queue;
+  bool is_finished;
+};
+
+void ProcessChunks(
+    sptk::FrameParallelDriver::FrameProcessorInterface* frame_processor,
+    SharedState* state) {
+  std::ostringstream message;
+  for (;;) {
+    Chunk* chunk;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      while (state->queue.empty() && !state->is_finished) {
+        state->condition_for_worker.wait(lock);
+      }
+      if (state->queue.empty()) return;
+      chunk = state->queue.front();
+      state->queue.pop_front();
+    }
+
+    if (frame_processor->RunChunk(chunk->inputs, chunk->num_frame,
+                                  &chunk->outputs)) {
+      for (int i(0); i < chunk->num_frame; ++i) {
+        chunk->messages[i].clear();
+        chunk->is_succeeded[i] = true;
+      }
+    } else {
+      for (int i(0); i < chunk->num_frame; ++i) {
+        message.str("");
+        const bool is_succeeded(frame_processor->Run(
+            chunk->first_frame_index + i, chunk->inputs[i],
+            &chunk->outputs[i], &message));
+        chunk->messages[i] = message.str();
+        chunk->is_succeeded[i] = is_succeeded;
+        if (!is_succeeded) {
+          // The following frames are never written.
+          chunk->num_frame = i + 1;
+          break;
+        }
+      }
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      chunk->is_processed = true;
+    }
+    state->condition_for_writer.notify_one();
+  }
+}
+
+}  // namespace
+
+namespace sptk {
+
+bool FrameParallelDriver::Run(
+    const std::vector<FrameProcessorInterface*>& frame_processors,
+    InputSourceInterface* input_source, std::ostream* output_stream) const {
+  // Check inputs.
+  if (frame_processors.empty() || NULL == input_source ||
+      !input_source->IsValid() || NULL == output_stream) {
+    return false;
+  }
+  for (std::vector<FrameProcessorInterface*>::const_iterator itr(
+           frame_processors.begin());
+       itr != frame_processors.end(); ++itr) {
+    if (NULL == *itr) {
+      return false;
+    }
+  }
+
+  const int num_thread(static_cast<int>(frame_processors.size()));
+  if (1 == num_thread) {
+    return RunSequentially(frame_processors[0], input_source, output_stream);
+  }
+
+  // Prepare memories.
+  std::vector<Chunk> chunks(num_thread * kNumChunkPerThread);
+  std::vector<Chunk*> free_chunks;
+  for (std::vector<Chunk>::iterator itr(chunks.begin()); itr != chunks.end();
+       ++itr) {
+    free_chunks.push_back(&(*itr));
+  }
+  std::deque<Chunk*> pending_chunks;
+  SharedState state;
+
+  std::vector<std::thread> threads;
+  for (int i(0); i < num_thread; ++i) {
+    threads.push_back(std::thread(ProcessChunks, frame_processors[i], &state));
+  }
+
+  bool is_succeeded(true);
+  bool is_end_of_input(false);
+  int frame_index(0);
+  while (is_succeeded) {
+    // Read as many chunks as possible.
+    while (!is_end_of_input && !free_chunks.empty()) {
+      Chunk* chunk(free_chunks.back());
+      chunk->first_frame_index = frame_index;
+      chunk->num_frame = 0;
+      while (chunk->num_frame < kNumFrameInChunk) {
+        if (!input_source->Get(&chunk->inputs[chunk->num_frame])) {
+          is_end_of_input = true;
+          break;
+        }
+        ++chunk->num_frame;
+      }
+      if (0 == chunk->num_frame) break;
+      frame_index += chunk->num_frame;
+
+      free_chunks.pop_back();
+      pending_chunks.push_back(chunk);
+      {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.queue.push_back(chunk);
+      }
+      state.condition_for_worker.notify_one();
+    }
+
+    if (pending_chunks.empty()) break;
+
+    // Write the oldest chunk.
+    Chunk* chunk(pending_chunks.front());
+    {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      while (!chunk->is_processed) {
+        state.condition_for_writer.wait(lock);
+      }
+    }
+    pending_chunks.pop_front();
+
+    for (int i(0); i < chunk->num_frame; ++i) {
+      if (!Write(chunk->messages[i], chunk->is_succeeded[i], chunk->outputs[i],
+                 output_stream)) {
+        is_succeeded = false;
+        break;
+      }
+    }
+    chunk->is_processed = false;
+    free_chunks.push_back(chunk);
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.queue.clear();
+    state.is_finished = true;
+  }
+  state.condition_for_worker.notify_all();
+  for (std::vector<std::thread>::iterator itr(threads.begin());
+       itr != threads.end(); ++itr) {
+    itr->join();
+  }
+
+  return is_succeeded;
+}
+
+bool FrameParallelDriver::RunSequentially(
+    FrameProcessorInterface* frame_processor,
+    InputSourceInterface* input_source, std::ostream* output_stream) const {
+  std::vector<double> input;
+  std::vector<double> output;
+  std::ostringstream message;
+  for (int frame_index(0); input_source->Get(&input); ++frame_index) {
+    message.str("");
+    const bool is_succeeded(
+        frame_processor->Run(frame_index, input, &output, &message));
+    if (!Write(message.str(), is_succeeded, output, output_stream)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FrameParallelDriver::Write(const std::string& message, bool is_succeeded,
+                                const std::vector<double>& output,
+                                std::ostream* output_stream) const {
+  if (!message.empty()) {
+    std::ostringstream error_message;
+    error_message << message;
+    PrintErrorMessage(program_name_, error_message);
+  }
+  if (!is_succeeded) {
+    return false;
+  }
+
+  if (!output.empty() &&
+      !WriteStream(0, static_cast<int>(output.size()), output, output_stream,
+                   NULL)) {
+    std::ostringstream error_message;
+    error_message << write_error_message_;
+    PrintErrorMessage(program_name_, error_message);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace sptk
@@ -0,0 +1,118 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2020  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/utils/mapped_matrix.h"
+
+#include <fcntl.h>     // open, O_RDONLY
+#include <sys/mman.h>  // madvise, mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include <climits>     // INT_MAX
+
+namespace sptk {
+
+template <typename T>
+MappedMatrix<T>::MappedMatrix(const char* file_name, int num_column)
+    : num_column_(num_column),
+      num_row_(0),
+      num_element_(0),
+      mapped_address_(MAP_FAILED),
+      mapped_size_(0),
+      data_(NULL),
+      is_valid_(true) {
+  if (NULL == file_name || num_column_ <= 0) {
+    is_valid_ = false;
+    return;
+  }
+
+  const int file_descriptor(open(file_name, O_RDONLY));
+  if (file_descriptor < 0) {
+    is_valid_ = false;
+    return;
+  }
+
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) < 0 ||
+      !S_ISREG(file_status.st_mode)) {
+    close(file_descriptor);
+    is_valid_ = false;
+    return;
+  }
+
+  mapped_size_ = static_cast<std::size_t>(file_status.st_size);
+  if (0 < mapped_size_) {
+    mapped_address_ = mmap(NULL, mapped_size_, PROT_READ, MAP_PRIVATE,
+                           file_descriptor, 0);
+  }
+  close(file_descriptor);
+
+  if (0 < mapped_size_) {
+    if (MAP_FAILED == mapped_address_) {
+      is_valid_ = false;
+      return;
+    }
+    madvise(mapped_address_, mapped_size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const T*>(mapped_address_);
+  }
+
+  num_element_ = mapped_size_ / sizeof(T);
+  const std::size_t num_row(num_element_ / num_column_);
+  if (static_cast<std::size_t>(INT_MAX) < num_row) {
+    is_valid_ = false;
+    return;
+  }
+  num_row_ = static_cast<int>(num_row);
+}
+
+template <typename T>
+MappedMatrix<T>::~MappedMatrix() {
+  if (MAP_FAILED != mapped_address_) {
+    munmap(mapped_address_, mapped_size_);
+  }
+}
+
+template class MappedMatrix<float>;
+template class MappedMatrix<double>;
+
+}  // namespace sptk
@@ -54,6 +54,7 @@
 #include <cstdlib>    // std::strtod, std::strtol
 #include <iomanip>    // std::setw
 #include <iostream>   // std::cerr, std::endl, std::left
+#include <streambuf>  // std::streambuf
 
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/uint24_t.h"
@@ -63,27 +64,56 @@ namespace {
 // 34 is a reasonable number near log(1e-15)
 static const double kThresholdOfInformationLossInLogSpace(-34.0);
 
+// Read bytes directly from the stream buffer. Unlike std::istream::read, this
+// does not construct a sentry, which flushes the tied stream on every call.
+int ReadBytes(int num_bytes, char* data, std::istream* input_stream) {
+  std::streambuf* stream_buffer(input_stream->rdbuf());
+  const int num_read_bytes(
+      NULL == stream_buffer
+          ? 0
+          : static_cast<int>(stream_buffer->sgetn(data, num_bytes)));
+  if (num_read_bytes != num_bytes) {
+    input_stream->setstate(std::ios::eofbit | std::ios::failbit);
+  }
+  return num_read_bytes;
+}
+
+// Write bytes directly to the stream buffer.
+bool WriteBytes(std::size_t num_bytes, const char* data,
+                std::ostream* output_stream) {
+  if (!output_stream->good()) {
+    return false;
+  }
+  std::streambuf* stream_buffer(output_stream->rdbuf());
+  if (NULL == stream_buffer ||
+      stream_buffer->sputn(data, num_bytes) !=
+          static_cast<std::streamsize>(num_bytes)) {
+    output_stream->setstate(std::ios::badbit);
+    return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 namespace sptk {
 
 template <typename T>
 bool ReadStream(T* data_to_read, std::istream* input_stream) {
-  if (NULL == data_to_read || NULL == input_stream || input_stream->eof()) {
+  if (NULL == data_to_read || NULL == input_stream || !input_stream->good()) {
     return false;
   }
 
   const int type_byte(sizeof(*data_to_read));
-  input_stream->read(reinterpret_cast<char*>(data_to_read), type_byte);
-
-  return (type_byte == input_stream->gcount()) ? !input_stream->fail() : false;
+  return ReadBytes(type_byte, reinterpret_cast<char*>(data_to_read),
+                   input_stream) == type_byte;
 }
 
 template <>
 bool ReadStream(sptk::Matrix* matrix_to_read, std::istream* input_stream) {
   if (NULL == matrix_to_read || 0 == matrix_to_read->GetNumRow() ||
       0 == matrix_to_read->GetNumColumn() || NULL == input_stream ||
-      input_stream->eof()) {
+      !input_stream->good()) {
     return false;
   }
 
@@ -91,11 +121,9 @@ bool ReadStream(sptk::Matrix* matrix_to_read, std::istream* input_stream) {
 
   const int num_read_bytes(type_byte * matrix_to_read->GetNumRow() *
                            matrix_to_read->GetNumColumn());
-  input_stream->read(reinterpret_cast<char*>(&((*matrix_to_read)[0][0])),
-                     num_read_bytes);
-
-  return (num_read_bytes == input_stream->gcount()) ? !input_stream->fail()
-                                                    : false;
+  return ReadBytes(num_read_bytes,
+                   reinterpret_cast<char*>(&((*matrix_to_read)[0][0])),
+                   input_stream) == num_read_bytes;
 }
 
 template <typename T>
@@ -103,7 +131,8 @@ bool ReadStream(bool zero_padding, int stream_skip, int read_point,
                 int read_size, std::vector<T>* sequence_to_read,
                 std::istream* input_stream, int* actual_read_size) {
   if (stream_skip < 0 || read_point < 0 || read_size <= 0 ||
-      NULL == sequence_to_read || NULL == input_stream || input_stream->eof()) {
+      NULL == sequence_to_read || NULL == input_stream ||
+      !input_stream->good()) {
     return false;
   }
 
@@ -120,17 +149,16 @@ bool ReadStream(bool zero_padding, int stream_skip, int read_point,
   }
 
   const int num_read_bytes(type_byte * read_size);
-  input_stream->read(
+  const int gcount(ReadBytes(
+      num_read_bytes,
       reinterpret_cast<char*>(&((*sequence_to_read)[0]) + read_point),
-      num_read_bytes);
-
-  const int gcount(input_stream->gcount());
+      input_stream));
   if (NULL != actual_read_size) {
     *actual_read_size = gcount / type_byte;
   }
 
   if (num_read_bytes == gcount) {
-    return !input_stream->fail();
+    return true;
   } else if (zero_padding && 0 < gcount) {
     // Use std::ceil to zero incomplete data
     // as gcount may not be a multiple of sizeof(double).
@@ -154,10 +182,9 @@ bool WriteStream(T data_to_write, std::ostream* output_stream) {
     return false;
   }
 
-  output_stream->write(reinterpret_cast<const char*>(&data_to_write),
-                       sizeof(data_to_write));
-
-  return !output_stream->fail();
+  return WriteBytes(sizeof(data_to_write),
+                    reinterpret_cast<const char*>(&data_to_write),
+                    output_stream);
 }
 
 bool WriteStream(const sptk::Matrix& matrix_to_write,
@@ -167,12 +194,11 @@ bool WriteStream(const sptk::Matrix& matrix_to_write,
     return false;
   }
 
-  output_stream->write(reinterpret_cast<const char*>(&(matrix_to_write[0][0])),
-                       sizeof(matrix_to_write[0][0]) *
-                           matrix_to_write.GetNumRow() *
-                           matrix_to_write.GetNumColumn());
-
-  return !output_stream->fail();
+  return WriteBytes(sizeof(matrix_to_write[0][0]) *
+                        matrix_to_write.GetNumRow() *
+                        matrix_to_write.GetNumColumn(),
+                    reinterpret_cast<const char*>(&(matrix_to_write[0][0])),
+                    output_stream);
 }
 
 template <typename T>
@@ -192,9 +218,12 @@ bool WriteStream(int write_point, int write_size,
                        ? 0
                        : static_cast<int>(output_stream->tellp()));
 
-  output_stream->write(
-      reinterpret_cast<const char*>(&(sequence_to_write[0]) + write_point),
-      sizeof(sequence_to_write[0]) * write_size);
+  if (!WriteBytes(
+          sizeof(sequence_to_write[0]) * write_size,
+          reinterpret_cast<const char*>(&(sequence_to_write[0]) + write_point),
+          output_stream)) {
+    return false;
+  }
 
   // When output_stream is cout, actual_write_size is always zero.
   if (NULL != actual_write_size) {
@@ -235,6 +264,40 @@ bool WriteStream(int write_point, int write_size,
   return !output_stream->fail();
 }
 
+// Read a stream block by block, process each block in place, and write it.
+template <typename T>
+bool ProcessStreamInBlocks(int block_size,
+                           const std::function<bool(std::vector<T>*)>& process,
+                           std::istream* input_stream,
+                           std::ostream* output_stream) {
+  if (block_size <= 0 || !process || NULL == input_stream ||
+      NULL == output_stream) {
+    return false;
+  }
+
+  std::vector<T> block(block_size);
+  int num_read;
+  while (ReadStream(true, 0, 0, block_size, &block, input_stream, &num_read)) {
+    block.resize(num_read);
+    if (!process(&block)) {
+      return false;
+    }
+    if (!WriteStream(0, num_read, block, output_stream, NULL)) {
+      return false;
+    }
+    block.resize(block_size);
+  }
+
+  return true;
+}
+
+// The input stream is expected to have been asked for two frames already, as
+// sptk::InputSourceInterpolation does on construction. Unlike comparing the
+// file size with the frame size, this also works on pipes and stdin.
+bool IsExhaustedAfterFirstFrame(const std::istream& input_stream) {
+  return !input_stream.good();
+}
+
 template <typename T>
 bool SnPrintf(T data, const std::string& print_format, std::size_t buffer_size,
               char* buffer) {
@@ -653,6 +716,8 @@ template bool WriteStream<uint64_t>(int, int, const std::vector<uint64_t>&, std:
 template bool WriteStream<float>(int, int, const std::vector<float>&, std::ostream*, int*);              // NOLINT
 template bool WriteStream<double>(int, int, const std::vector<double>&, std::ostream*, int*);            // NOLINT
 template bool WriteStream<long double>(int, int, const std::vector<long double>&, std::ostream*, int*);  // NOLINT
+template bool ProcessStreamInBlocks<float>(int, const std::function<bool(std::vector<float>*)>&, std::istream*, std::ostream*);    // NOLINT
+template bool ProcessStreamInBlocks<double>(int, const std::function<bool(std::vector<double>*)>&, std::istream*, std::ostream*);  // NOLINT
 template bool SnPrintf(int8_t, const std::string&, std::size_t, char*);
 template bool SnPrintf(int16_t, const std::string&, std::size_t, char*);
 template bool SnPrintf(int32_t, const std::string&, std::size_t, char*);
@@ -61,6 +61,14 @@ teardown() {
    [ "$status" -eq 0 ]
 }
 
+@test "c2acr: multithreading" {
+   $sptk3/nrand -l 2000 > tmp/1
+   $sptk4/c2acr -m 9 -M 4 -l 16 tmp/1 > tmp/2
+   $sptk4/c2acr -m 9 -M 4 -l 16 -j 4 tmp/1 > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
 @test "c2acr: valgrind" {
    $sptk3/nrand -l 20 > tmp/1
    run valgrind $sptk4/c2acr -m 9 -M 4 -l 16 tmp/1 > /dev/null
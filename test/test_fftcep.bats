@@ -68,6 +68,22 @@ teardown() {
    [ "$status" -eq 0 ]
 }
 
+@test "fftcep: multithreading" {
+   $sptk3/nrand -l 32000 > tmp/1
+   $sptk4/fftcep -l 16 -m 4 -i 3 tmp/1 > tmp/2
+   $sptk4/fftcep -l 16 -m 4 -i 3 -j 4 tmp/1 > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
+@test "fftcep: multithreading (power spectrum input)" {
+   $sptk3/nrand -l 18000 | $sptk3/sopr -ABS -a 0.01 > tmp/1
+   $sptk4/fftcep -l 16 -m 4 -q 3 tmp/1 > tmp/2
+   $sptk4/fftcep -l 16 -m 4 -q 3 -j 4 tmp/1 > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
 @test "fftcep: valgrind" {
    $sptk3/nrand -l 32 > tmp/1
    run valgrind $sptk4/fftcep -l 16 -m 4 -i 3 tmp/1 > /dev/null
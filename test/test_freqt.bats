@@ -76,6 +76,14 @@ teardown() {
    [ "$status" -eq 0 ]
 }
 
+@test "freqt: multithreading" {
+   $sptk3/nrand -l 2000 > tmp/1
+   $sptk4/freqt -m 9 -M 19 -A 0.42 tmp/1 > tmp/2
+   $sptk4/freqt -m 9 -M 19 -A 0.42 -j 4 tmp/1 > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
 @test "freqt: valgrind" {
    $sptk3/nrand -l 20 > tmp/1
    run valgrind $sptk4/freqt -m 9 -M 9 tmp/1 > /dev/null
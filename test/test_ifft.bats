@@ -71,6 +71,16 @@ teardown() {
    [ "$status" -eq 0 ]
 }
 
+@test "ifft: single precision" {
+   $sptk3/nrand -l 4096 | $sptk3/x2x +df > tmp/1
+   for o in `seq 0 2`; do
+      $sptk3/x2x +fd tmp/1 | $sptk4/ifft -l 64 -o $o > tmp/2
+      $sptk4/ifft -l 64 -o $o +f tmp/1 | $sptk3/x2x +fd > tmp/3
+      run $sptk4/aeq -t 1e-5 tmp/2 tmp/3
+      [ "$status" -eq 0 ]
+   done
+}
+
 @test "ifft: valgrind" {
    $sptk3/nrand -l 32 > tmp/1
    run valgrind $sptk4/ifft -l 8 tmp/1 > /dev/null
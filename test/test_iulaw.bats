@@ -45,6 +45,7 @@
 
 sptk3=tools/sptk/bin
 sptk4=bin
+data=asset/data.short
 
 setup() {
    mkdir -p tmp
@@ -75,6 +76,24 @@ teardown() {
    [ "$status" -eq 0 ]
 }
 
+@test "iulaw: byte codes" {
+   $sptk4/ulaw -q 1 -o 1 $data > tmp/1
+   $sptk4/iulaw -q 1 -o 1 tmp/1 > tmp/2
+   $sptk3/x2x +Ci tmp/1 | $sptk4/dequantize | $sptk4/iulaw |
+      $sptk3/x2x +ds -r > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
+@test "iulaw: fast approximation" {
+   # The error is less than 1e-9 * v.
+   $sptk3/nrand -l 20000 | $sptk3/sopr -m 10000 > tmp/1
+   $sptk4/iulaw tmp/1 > tmp/2
+   $sptk4/iulaw -f tmp/1 > tmp/3
+   run $sptk4/aeq -t 3.2768e-5 tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
 @test "iulaw: valgrind" {
    $sptk3/nrand -l 20 > tmp/1
    run valgrind $sptk4/iulaw tmp/1 > /dev/null
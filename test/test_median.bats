@@ -0,0 +1,102 @@
+#!/usr/bin/env bats
+# ----------------------------------------------------------------- #
+#             The Speech Signal Processing Toolkit (SPTK)           #
+#             developed by SPTK Working Group                       #
+#             http://sp-tk.sourceforge.net/                         #
+# ----------------------------------------------------------------- #
+#                                                                   #
+#  Copyright (c) 1984-2007  Tokyo Institute of Technology           #
+#                           Interdisciplinary Graduate School of    #
+#                           Science and Engineering                 #
+#                                                                   #
+#                1996-2020  Nagoya Institute of Technology          #
+#                           Department of Computer Science          #
+#                                                                   #
+# All rights reserved.                                              #
+#                                                                   #
+# Redistribution and use in source and binary forms, with or        #
+# without modification, are permitted provided that the following   #
+# conditions are met:                                               #
+#                                                                   #
+# - Redistributions of source code must retain the above copyright  #
+#   notice, this list of conditions and the following disclaimer.   #
+# - Redistributions in binary form must reproduce the above         #
+#   copyright notice, this list of conditions and the following     #
+#   disclaimer in the documentation and/or other materials provided #
+#   with the distribution.                                          #
+# - Neither the name of the SPTK working group nor the names of its #
+#   contributors may be used to endorse or promote products derived #
+#   from this software without specific prior written permission.   #
+#                                                                   #
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            #
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       #
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          #
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          #
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS #
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          #
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   #
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     #
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON #
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   #
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    #
+# OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           #
+# POSSIBILITY OF SUCH DAMAGE.                                       #
+# ----------------------------------------------------------------- #
+
+sptk3=tools/sptk/bin
+sptk4=bin
+
+setup() {
+   mkdir -p tmp
+}
+
+teardown() {
+   rm -rf tmp
+}
+
+@test "median: p = 50" {
+   $sptk3/ramp -l 4 | $sptk4/median > tmp/1
+   echo 1.5 | $sptk3/x2x +ad > tmp/2
+   run cmp tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+
+   $sptk3/ramp -l 5 | $sptk4/median -p 50 > tmp/1
+   echo 2 | $sptk3/x2x +ad > tmp/2
+   run cmp tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+
+   $sptk3/nrand -l 8000 > tmp/1
+   $sptk4/median -l 8 tmp/1 > tmp/2
+   $sptk4/median -l 8 -p 50 tmp/1 > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
+@test "median: multithreading" {
+   $sptk3/nrand -l 8000 > tmp/1
+   for opt in "" "-s 10"; do
+      $sptk4/median -l 8 -p 10 $opt tmp/1 > tmp/2
+      $sptk4/median -l 8 -p 10 $opt -j 4 tmp/1 > tmp/3
+      run cmp tmp/2 tmp/3
+      [ "$status" -eq 0 ]
+   done
+}
+
+@test "median: streaming sketch" {
+   # The sketch is exact while the number of data is less than 5 * s.
+   $sptk3/nrand -l 400 > tmp/1
+   for p in 1 50 99; do
+      $sptk4/median -p $p tmp/1 > tmp/2
+      $sptk4/median -p $p -s 100 tmp/1 > tmp/3
+      run cmp tmp/2 tmp/3
+      [ "$status" -eq 0 ]
+   done
+
+   $sptk3/nrand -l 20000 > tmp/1
+   for p in 1 50 99; do
+      $sptk4/median -p $p tmp/1 > tmp/2
+      $sptk4/median -p $p -s 100 tmp/1 > tmp/3
+      run $sptk4/aeq -t 0.1 tmp/2 tmp/3
+      [ "$status" -eq 0 ]
+   done
+}
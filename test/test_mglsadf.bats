@@ -0,0 +1,82 @@
+#!/usr/bin/env bats
+# ----------------------------------------------------------------- #
+#             The Speech Signal Processing Toolkit (SPTK)           #
+#             developed by SPTK Working Group                       #
+#             http://sp-tk.sourceforge.net/                         #
+# ----------------------------------------------------------------- #
+#                                                                   #
+#  Copyright (c) 1984-2007  Tokyo Institute of Technology           #
+#                           Interdisciplinary Graduate School of    #
+#                           Science and Engineering                 #
+#                                                                   #
+#                1996-2020  Nagoya Institute of Technology          #
+#                           Department of Computer Science          #
+#                                                                   #
+# All rights reserved.                                              #
+#                                                                   #
+# Redistribution and use in source and binary forms, with or        #
+# without modification, are permitted provided that the following   #
+# conditions are met:                                               #
+#                                                                   #
+# - Redistributions of source code must retain the above copyright  #
+#   notice, this list of conditions and the following disclaimer.   #
+# - Redistributions in binary form must reproduce the above         #
+#   copyright notice, this list of conditions and the following     #
+#   disclaimer in the documentation and/or other materials provided #
+#   with the distribution.                                          #
+# - Neither the name of the SPTK working group nor the names of its #
+#   contributors may be used to endorse or promote products derived #
+#   from this software without specific prior written permission.   #
+#                                                                   #
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            #
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       #
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          #
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          #
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS #
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          #
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   #
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     #
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON #
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   #
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    #
+# OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           #
+# POSSIBILITY OF SUCH DAMAGE.                                       #
+# ----------------------------------------------------------------- #
+
+sptk3=tools/sptk/bin
+sptk4=bin
+data=asset/data.short
+
+setup() {
+   mkdir -p tmp
+}
+
+teardown() {
+   rm -rf tmp
+}
+
+@test "mglsadf: time-invariant filter (MLSA)" {
+   $sptk3/x2x +sd $data | $sptk3/bcut -s 4000 -e 4511 | \
+      $sptk3/window -l 512 | $sptk4/mgcep -l 512 -m 10 -a 0.42 > tmp/1
+   cat tmp/1 tmp/1 > tmp/2
+   $sptk3/nrand -l 20000 > tmp/3
+   for opt in "" "-t" "-k"; do
+      $sptk4/mglsadf -m 10 -a 0.42 $opt tmp/1 tmp/3 > tmp/4
+      $sptk4/mglsadf -m 10 -a 0.42 $opt tmp/2 tmp/3 > tmp/5
+      run cmp tmp/4 tmp/5
+      [ "$status" -eq 0 ]
+   done
+}
+
+@test "mglsadf: time-invariant filter (MGLSA)" {
+   $sptk3/x2x +sd $data | $sptk3/bcut -s 4000 -e 4511 | \
+      $sptk3/window -l 512 | $sptk4/mgcep -l 512 -m 10 -a 0.42 -c 2 > tmp/1
+   cat tmp/1 tmp/1 > tmp/2
+   $sptk3/nrand -l 20000 > tmp/3
+   for opt in "" "-t" "-k"; do
+      $sptk4/mglsadf -m 10 -a 0.42 -c 2 $opt tmp/1 tmp/3 > tmp/4
+      $sptk4/mglsadf -m 10 -a 0.42 -c 2 $opt tmp/2 tmp/3 > tmp/5
+      run cmp tmp/4 tmp/5
+      [ "$status" -eq 0 ]
+   done
+}
@@ -65,6 +65,31 @@ teardown() {
    done
 }
 
+@test "pitch: multithreading" {
+   $sptk3/x2x +sd $data > tmp/1
+   $sptk3/bcut +d -e 7999 tmp/1 > tmp/2
+   for a in `seq 0 3`; do
+      cat <($sptk4/pitch -a $a tmp/1) <($sptk4/pitch -a $a tmp/2) \
+          <($sptk4/pitch -a $a tmp/1) > tmp/3
+      $sptk4/pitch -a $a -j 2 tmp/1 tmp/2 tmp/1 > tmp/4
+      run cmp tmp/3 tmp/4
+      [ "$status" -eq 0 ]
+   done
+}
+
+@test "pitch: streaming" {
+   $sptk3/x2x +sd $data > tmp/1
+   $sptk4/pitch -a 0 tmp/1 > tmp/2
+   $sptk4/pitch -a 0 -streaming < tmp/1 > tmp/3
+   run cmp tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+
+   $sptk4/pitch -a 3 -o 1 tmp/1 > tmp/2
+   $sptk4/pitch -a 3 -o 1 -streaming < tmp/1 > tmp/3
+   run $sptk4/aeq -t 1e-4 tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
 @test "pitch: valgrind" {
    $sptk3/x2x +sd $data > tmp/1
    for a in `seq 0 3`; do
@@ -100,3 +100,30 @@ teardown() {
    run valgrind $sptk4/poledf -m 1 -i 0 -p 1 tmp/1 tmp/2 > /dev/null
    [ $(echo "${lines[-1]}" | sed -r 's/.*SUMMARY: ([0-9]*) .*/\1/') -eq 0 ]
 }
+
+@test "poledf: time-invariant filter" {
+   $sptk3/x2x +sd $data | $sptk3/bcut -s 4000 -e 4399 | \
+      $sptk3/window -l 400 | $sptk4/lpc -l 400 -m 10 > tmp/1
+   cat tmp/1 tmp/1 > tmp/2
+   $sptk3/nrand -l 20000 > tmp/3
+   for opt in "" "-t" "-k"; do
+      $sptk4/poledf -m 10 $opt tmp/1 tmp/3 > tmp/4
+      $sptk4/poledf -m 10 $opt tmp/2 tmp/3 > tmp/5
+      run cmp tmp/4 tmp/5
+      [ "$status" -eq 0 ]
+   done
+}
+
+@test "poledf: single precision" {
+   $sptk3/x2x +sd $data | $sptk3/bcut -e 16399 | \
+      $sptk3/window -l 400 | $sptk4/lpc -l 400 -m 10 > tmp/1
+   $sptk3/nrand -l 4096 | $sptk3/x2x +df > tmp/2
+   $sptk3/x2x +fd tmp/2 > tmp/3
+   # The gain is excluded to keep the absolute error comparable.
+   for opt in "-k" "-k -t"; do
+      $sptk4/poledf -m 10 -p 100 $opt tmp/1 tmp/3 > tmp/4
+      $sptk4/poledf -m 10 -p 100 $opt +f tmp/1 tmp/2 | $sptk3/x2x +fd > tmp/5
+      run $sptk4/aeq -t 1e-2 tmp/4 tmp/5
+      [ "$status" -eq 0 ]
+   done
+}
@@ -0,0 +1,114 @@
+#!/usr/bin/env bats
+# ----------------------------------------------------------------- #
+#             The Speech Signal Processing Toolkit (SPTK)           #
+#             developed by SPTK Working Group                       #
+#             http://sp-tk.sourceforge.net/                         #
+# ----------------------------------------------------------------- #
+#                                                                   #
+#  Copyright (c) 1984-2007  Tokyo Institute of Technology           #
+#                           Interdisciplinary Graduate School of    #
+#                           Science and Engineering                 #
+#                                                                   #
+#                1996-2020  Nagoya Institute of Technology          #
+#                           Department of Computer Science          #
+#                                                                   #
+# All rights reserved.                                              #
+#                                                                   #
+# Redistribution and use in source and binary forms, with or        #
+# without modification, are permitted provided that the following   #
+# conditions are met:                                               #
+#                                                                   #
+# - Redistributions of source code must retain the above copyright  #
+#   notice, this list of conditions and the following disclaimer.   #
+# - Redistributions in binary form must reproduce the above         #
+#   copyright notice, this list of conditions and the following     #
+#   disclaimer in the documentation and/or other materials provided #
+#   with the distribution.                                          #
+# - Neither the name of the SPTK working group nor the names of its #
+#   contributors may be used to endorse or promote products derived #
+#   from this software without specific prior written permission.   #
+#                                                                   #
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            #
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       #
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          #
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          #
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS #
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          #
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   #
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     #
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON #
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   #
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    #
+# OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           #
+# POSSIBILITY OF SUCH DAMAGE.                                       #
+# ----------------------------------------------------------------- #
+
+sptk3=tools/sptk/bin
+sptk4=bin
+
+setup() {
+   mkdir -p tmp
+}
+
+teardown() {
+   rm -rf tmp
+}
+
+@test "resample: output length" {
+   # N inputs give ceil(N * L / M) outputs.
+   for rates in "48 16 1001 334" "44.1 16 1000 363" "16 48 100 300" \
+      "16 44.1 101 279"; do
+      set -- $rates
+      $sptk3/nrand -l $3 > tmp/1
+      $sptk4/resample -s $1 -r $2 tmp/1 > tmp/2
+      $sptk4/resample -s $1 -r $2 < tmp/1 > tmp/3
+      [ $(wc -c < tmp/2) -eq $(($4 * 8)) ]
+      [ $(wc -c < tmp/3) -eq $(($4 * 8)) ]
+   done
+}
+
+@test "resample: passband and stopband" {
+   # A 1 kHz tone passes and a 12 kHz tone is attenuated by 80 dB.
+   $sptk3/sin -l 1600 -p 16 | $sptk3/bcut -s 200 -e 1399 > tmp/1
+   $sptk3/sin -l 4800 -p 48 | $sptk4/resample -s 48 -r 16 |
+      $sptk3/bcut -s 200 -e 1399 > tmp/2
+   run $sptk4/aeq -t 1e-4 tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+
+   $sptk3/sin -l 4800 -p 4 | $sptk4/resample -s 48 -r 16 |
+      $sptk3/bcut -s 200 -e 1399 > tmp/2
+   $sptk3/sopr -m 0 tmp/2 > tmp/3
+   run $sptk4/aeq -t 1e-4 tmp/2 tmp/3
+   [ "$status" -eq 0 ]
+}
+
+@test "resample: decimate and interpolate" {
+   $sptk3/sin -l 1600 -p 16 | $sptk3/bcut -s 200 -e 1399 > tmp/1
+   $sptk3/sin -l 4800 -p 48 | $sptk4/decimate -p 3 -f |
+      $sptk3/bcut -s 200 -e 1399 > tmp/2
+   run $sptk4/aeq -t 1e-4 tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+
+   $sptk3/sin -l 4800 -p 48 | $sptk3/bcut -s 600 -e 4199 > tmp/1
+   $sptk3/sin -l 1600 -p 16 | $sptk4/interpolate -p 3 -o 2 |
+      $sptk3/bcut -s 600 -e 4199 > tmp/2
+   run $sptk4/aeq -t 1e-4 tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+}
+
+@test "resample: decimate and interpolate without filtering" {
+   $sptk3/ramp -l 20 | $sptk4/decimate -p 3 > tmp/1
+   $sptk3/ramp -l 7 | $sptk3/sopr -m 3 > tmp/2
+   run cmp tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+
+   $sptk3/ramp -l 4 | $sptk4/interpolate -p 3 > tmp/1
+   echo 0 0 0 1 0 0 2 0 0 3 0 0 | $sptk3/x2x +ad > tmp/2
+   run cmp tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+
+   $sptk3/ramp -l 4 | $sptk4/interpolate -p 3 -o 1 > tmp/1
+   echo 0 0 0 1 1 1 2 2 2 3 3 3 | $sptk3/x2x +ad > tmp/2
+   run cmp tmp/1 tmp/2
+   [ "$status" -eq 0 ]
+}
@@ -101,6 +101,20 @@ teardown() {
    [ "$status" -eq 0 ]
 }
 
+@test "zerodf: single precision" {
+   $sptk3/nrand -l 4096 | $sptk3/x2x +df > tmp/1
+   $sptk3/x2x +fd tmp/1 > tmp/2
+   # The first filter is time-invariant and the second is time-varying.
+   $sptk3/nrand -s 2 -l 256 | $sptk3/sopr -d 16 > tmp/3
+   $sptk3/nrand -s 2 -l 1040 | $sptk3/sopr -d 8 > tmp/4
+   for opt in "-m 255 tmp/3" "-m 25 -p 100 tmp/4"; do
+      $sptk4/zerodf $opt tmp/2 > tmp/5
+      $sptk4/zerodf $opt +f tmp/1 | $sptk3/x2x +fd > tmp/6
+      run $sptk4/aeq -t 1e-5 tmp/5 tmp/6
+      [ "$status" -eq 0 ]
+   done
+}
+
 @test "zerodf: valgrind" {
    $sptk3/nrand -l 10 > tmp/1
    $sptk3/nrand -l 10 > tmp/2
@@ -47,7 +47,12 @@ namespace snack {
 
 int	    debug_level = 0;
 
+#if 0
 void free_dp_f0();
+#else
+typedef struct dp_f0_state Dp_f0_state;
+void free_dp_f0(Dp_f0_state *st);
+#endif
 #if 0
 static int check_f0_params();
 #else
@@ -344,14 +349,49 @@ static int lc_lin_fir(), downsamp();
 static void get_cand(Cross *cross, float *peak, int *loc, int nlags, int *ncand,
                      float cand_thresh);
 static void peak(float *y, float *xp, float *yp);
-static void do_ffir(float *buf, int in_samps, float *bufo, int *out_samps,
-                    int idx, int ncoef, float *fc, int invert, int skip,
-                    int init);
+static void do_ffir(Dp_f0_state *st, float *buf, int in_samps, float *bufo,
+                    int *out_samps, int idx, int ncoef, float *fc, int invert,
+                    int skip, int init);
 static int lc_lin_fir(float fc, int *nf, float *coef);
-static int downsamp(float *in, float *out, int samples, int *outsamps,
-                    int state_idx, int decimate, int ncoef, float fc[],
-                    int init);
+static int downsamp(Dp_f0_state *st, float *in, float *out, int samples,
+                    int *outsamps, int state_idx, int decimate, int ncoef,
+                    float fc[], int init);
+#if 0
 static float *foutput = NULL, *co = NULL, *mem2 = NULL;
+#else
+/*
+ * Variables which are static in the original code.  Each extraction has
+ * its own copy, which is set up by init_dp_f0(), passed to every function
+ * below that needs it, and released by free_dp_f0().
+ */
+struct dp_f0_state {
+  float *foutput, *co, *mem2;
+  /* downsample() and do_ffir() */
+  float downsample_b[2048];
+  int downsample_ncoeff, downsample_ncoefft;
+  float ffir_state[1000];
+  int ffir_fsize, ffir_resid;
+  /* circular DP buffer */
+  Frame *headF, *tailF, *cmpthF;
+  int *pcands;
+  int cir_buff_growth_count;
+  int size_cir_buffer, size_frame_hist, size_frame_out, num_active_frames,
+      output_buf_size;
+  /* DP parameters */
+  float tcost, tfact_a, tfact_s, frame_int, vbias, fdouble, wdur, ln2,
+        freqwt, lagwt;
+  int step, size, nlags, start, stop, ncomp, *locs;
+  short maxpeaks;
+  int wReuse;
+  Windstat *windstat;
+  float *f0p, *vuvp, *rms_speech, *acpkp, *peaks;
+  int first_time, pad;
+  /* get_stationarity() */
+  Stat *stat;
+  float *mem;
+  int stationarity_nframes_old, stationarity_memsize;
+};
+#endif
 #endif
 
 /* ----------------------------------------------------------------------- */
@@ -451,16 +491,27 @@ float *downsample(input,samsin,state_idx,freq,samsout,decimate, first_time, last
      float *input;
       int samsin, *samsout, decimate, state_idx, first_time, last_time;
 #else
-float *downsample(float *input, int samsin, int state_idx, double freq,
-                  int *samsout, int decimate, int first_time, int last_time)
+float *downsample(Dp_f0_state *st, float *input, int samsin, int state_idx,
+                  double freq, int *samsout, int decimate, int first_time,
+                  int last_time)
 #endif
 {
+#if 0
   static float	b[2048];
+#else
+  float (&b)[2048] = st->downsample_b;
+#endif
 #if 0
   static float *foutput = NULL;
+#else
+  float *&foutput = st->foutput;
 #endif
   float	beta = 0.0f;
+#if 0
   static int	ncoeff = 127, ncoefft = 0;
+#else
+  int &ncoeff = st->downsample_ncoeff, &ncoefft = st->downsample_ncoefft;
+#endif
   int init;
 
   if(input && (samsin > 0) && (decimate > 0) && *samsout) {
@@ -490,7 +541,7 @@ float *downsample(float *input, int samsin, int state_idx, double freq,
     else if (last_time) init = 2;
     else init = 0;
     
-    if(downsamp(input,foutput,samsin,samsout,state_idx,decimate,ncoefft,b,init)) {
+    if(downsamp(st,input,foutput,samsin,samsout,state_idx,decimate,ncoefft,b,init)) {
       return(foutput);
     } else
       Fprintf(stderr,"Problems in downsamp() in downsample()\n");
@@ -564,13 +615,13 @@ static int downsamp(in, out, samples, outsamps, state_idx, decimate, ncoef, fc,
      float fc[];
      int init;
 #else
-static int downsamp(float *in, float *out, int samples, int *outsamps,
-                    int state_idx, int decimate, int ncoef, float fc[],
-                    int init)
+static int downsamp(Dp_f0_state *st, float *in, float *out, int samples,
+                    int *outsamps, int state_idx, int decimate, int ncoef,
+                    float fc[], int init)
 #endif
 {
   if(in && out) {
-    do_ffir(in, samples, out, outsamps, state_idx, ncoef, fc, 0, decimate, init);
+    do_ffir(st, in, samples, out, outsamps, state_idx, ncoef, fc, 0, decimate, init);
     return(TRUE);
   } else
     printf("Bad signal(s) passed to downsamp()\n");
@@ -591,19 +642,21 @@ float *fc;
 register int in_samps, ncoef, invert, skip, init, *out_samps;
 int idx;
 #else
-static void do_ffir(float *buf, int in_samps, float *bufo, int *out_samps,
-                    int idx, int ncoef, float *fc, int invert, int skip,
-                    int init)
+static void do_ffir(Dp_f0_state *st, float *buf, int in_samps, float *bufo,
+                    int *out_samps, int idx, int ncoef, float *fc, int invert,
+                    int skip, int init)
 #endif
 {
   register float *dp1, *dp2, *dp3, sum, integral;
 #if 0
   static float *co=NULL, *mem=NULL;
-#else
-  static float *mem=NULL;
-#endif
   static float state[1000];
   static int fsize=0, resid=0;
+#else
+  float *&co = st->co, *&mem = st->mem2;
+  float (&state)[1000] = st->ffir_state;
+  int &fsize = st->ffir_fsize, &resid = st->ffir_resid;
+#endif
   register int i, j, k, l;
   register float *sp;
   register float *buf1;
@@ -617,9 +670,6 @@ static void do_ffir(float *buf, int in_samps, float *bufo, int *out_samps,
       return;
     }
     fsize = ncoef;
-#if 1
-    mem2 = mem;
-#endif
   }
 
   /* fill 2nd half with data */
@@ -827,6 +877,7 @@ static void peak(float *y, float *xp, float *yp)
  * cmpthF points to starting frame of converged path to backtrack
  */
 
+#if 0
 static Frame *headF = NULL, *tailF = NULL, *cmpthF = NULL;
 
 static  int *pcands = NULL;	/* array for backtracking in convergence check */
@@ -852,6 +903,7 @@ static Windstat *windstat = NULL;
 static float *f0p = NULL, *vuvp = NULL, *rms_speech = NULL, 
              *acpkp = NULL, *peaks = NULL;
 static int first_time = 1, pad;
+#endif
 
 
 /*--------------------------------------------------------------------*/
@@ -879,12 +931,39 @@ init_dp_f0(freq, par, buffsize, sdstep)
     F0_params	*par;
     long	*buffsize, *sdstep;
 #else
-init_dp_f0(double freq, F0_params *par, long *buffsize, long *sdstep)
+init_dp_f0(Dp_f0_state *st, double freq, F0_params *par, long *buffsize,
+           long *sdstep)
 #endif
 {
   int nframes;
   int i;
   int stat_wsize, agap, ind, downpatch;
+#if 1
+  Frame *&headF = st->headF, *&tailF = st->tailF;
+  int *&pcands = st->pcands;
+  int &size_cir_buffer = st->size_cir_buffer,
+      &size_frame_hist = st->size_frame_hist,
+      &size_frame_out = st->size_frame_out,
+      &num_active_frames = st->num_active_frames,
+      &output_buf_size = st->output_buf_size;
+  float &tcost = st->tcost, &tfact_a = st->tfact_a, &tfact_s = st->tfact_s,
+        &frame_int = st->frame_int, &vbias = st->vbias,
+        &fdouble = st->fdouble, &wdur = st->wdur, &ln2 = st->ln2,
+        &freqwt = st->freqwt, &lagwt = st->lagwt;
+  int &step = st->step, &size = st->size, &nlags = st->nlags,
+      &start = st->start, &stop = st->stop, &ncomp = st->ncomp;
+  int *&locs = st->locs;
+  short &maxpeaks = st->maxpeaks;
+  int &wReuse = st->wReuse;
+  Windstat *&windstat = st->windstat;
+  float *&f0p = st->f0p, *&vuvp = st->vuvp, *&rms_speech = st->rms_speech,
+        *&acpkp = st->acpkp, *&peaks = st->peaks;
+  int &first_time = st->first_time, &pad = st->pad;
+
+  /* Start from the initial values of the static variables. */
+  memset(st, 0, sizeof(*st));
+  st->downsample_ncoeff = 127;
+#endif
 /*
  * reassigning some constants 
  */
@@ -1029,8 +1108,9 @@ init_dp_f0(double freq, F0_params *par, long *buffsize, long *sdstep)
 #if 0
 static Stat *get_stationarity();
 #else
-static Stat *get_stationarity(float *fdata, double freq, int buff_size,
-                              int nframes, int frame_step, int first_time);
+static Stat *get_stationarity(Dp_f0_state *st, float *fdata, double freq,
+                              int buff_size, int nframes, int frame_step,
+                              int first_time);
 #endif
 
 /*--------------------------------------------------------------------*/
@@ -1045,17 +1125,35 @@ dp_f0(fdata, buff_size, sdstep, freq,
     float	**f0p_pt, **vuvp_pt, **rms_speech_pt, **acpkp_pt;
     int		*vecsize, last_time;
 #else
-dp_f0(float *fdata, int buff_size, int sdstep, double freq, F0_params *par,
-      float **f0p_pt, float **vuvp_pt, float **rms_speech_pt, float **acpkp_pt,
-      int *vecsize, int last_time)
+dp_f0(Dp_f0_state *st, float *fdata, int buff_size, int sdstep, double freq,
+      F0_params *par, float **f0p_pt, float **vuvp_pt, float **rms_speech_pt,
+      float **acpkp_pt, int *vecsize, int last_time)
 #endif
 {
 #if 0
   float  maxval, engref, *sta, *rms_ratio, *dsdata, *downsample();
 #else
   float  maxval, engref, *sta, *rms_ratio, *dsdata;
-  float  *downsample(float *input, int samsin, int state_idx, double freq,
-                     int *samsout, int decimate, int first_time, int last_time);
+  float  *downsample(Dp_f0_state *st, float *input, int samsin, int state_idx,
+                     double freq, int *samsout, int decimate, int first_time,
+                     int last_time);
+  Frame *&headF = st->headF, *&tailF = st->tailF, *&cmpthF = st->cmpthF;
+  int *&pcands = st->pcands;
+  int &cir_buff_growth_count = st->cir_buff_growth_count;
+  int &size_cir_buffer = st->size_cir_buffer,
+      &size_frame_hist = st->size_frame_hist,
+      &size_frame_out = st->size_frame_out,
+      &num_active_frames = st->num_active_frames,
+      &output_buf_size = st->output_buf_size;
+  float &tcost = st->tcost, &tfact_a = st->tfact_a, &tfact_s = st->tfact_s,
+        &vbias = st->vbias, &fdouble = st->fdouble, &ln2 = st->ln2,
+        &freqwt = st->freqwt, &lagwt = st->lagwt;
+  int &step = st->step, &size = st->size, &nlags = st->nlags,
+      &start = st->start, &stop = st->stop, &ncomp = st->ncomp;
+  int *&locs = st->locs;
+  float *&f0p = st->f0p, *&vuvp = st->vuvp, *&rms_speech = st->rms_speech,
+        *&acpkp = st->acpkp, *&peaks = st->peaks;
+  int &first_time = st->first_time, &pad = st->pad;
 #endif
   register float ttemp, ftemp, ft1, ferr, err, errmin;
   register int  i, j, k, loc1, loc2;
@@ -1081,7 +1179,7 @@ dp_f0(float *fdata, int buff_size, int sdstep, double freq, F0_params *par,
     if (samsds < 1)
       return 1;                     /* skip final frame if it is too small */
 #endif
-    dsdata = downsample(fdata, buff_size, sdstep, freq, &samsds, decimate, 
+    dsdata = downsample(st, fdata, buff_size, sdstep, freq, &samsds, decimate, 
 			first_time, last_time);
     if (!dsdata) {
       Fprintf(stderr, "can't get downsampled data.\n");
@@ -1091,7 +1189,7 @@ dp_f0(float *fdata, int buff_size, int sdstep, double freq, F0_params *par,
 
   /* Get a function of the "stationarity" of the speech signal. */
 
-  stat = get_stationarity(fdata, freq, buff_size, nframes, step, first_time);
+  stat = get_stationarity(st, fdata, freq, buff_size, nframes, step, first_time);
   if (!stat) { 
     Fprintf(stderr, "can't get stationarity\n");
     return(1);
@@ -1439,10 +1537,14 @@ save_windstat(rho, order, err, rms)
     float   err;
     float   rms;
 #else
-save_windstat(float *rho, int order, float err, float rms)
+save_windstat(Dp_f0_state *st, float *rho, int order, float err, float rms)
 #endif
 {
     int i,j;
+#if 1
+    int &wReuse = st->wReuse;
+    Windstat *&windstat = st->windstat;
+#endif
 
     if(wReuse > 1){               /* push down the stack */
 	for(j=1; j<wReuse; j++){
@@ -1473,11 +1575,16 @@ retrieve_windstat(rho, order, err, rms)
     float   *err;
     float   *rms;
 #else
-retrieve_windstat(float *rho, int order, float *err, float *rms)
+retrieve_windstat(Dp_f0_state *st, float *rho, int order, float *err,
+                  float *rms)
 #endif
 {
     Windstat wstat;
     int i;
+#if 1
+    int &wReuse = st->wReuse;
+    Windstat *&windstat = st->windstat;
+#endif
 	
     if(wReuse){
 	wstat = windstat[0];
@@ -1500,8 +1607,9 @@ get_similarity(order, size, pdata, cdata,
     float   *rmsa, *rms_ratio, pre, stab;
     int     w_type, init;
 #else
-get_similarity(int order, int size, float *pdata, float *cdata, float *rmsa,
-	       float *rms_ratio, float pre, float stab, int w_type, int init)
+get_similarity(Dp_f0_state *st, int order, int size, float *pdata,
+	       float *cdata, float *rmsa, float *rms_ratio, float pre,
+	       float stab, int w_type, int init)
 #endif
 {
   float rho3[BIGSORD+1], err3, rms3, rmsd3, b0, t, a2[BIGSORD+1], 
@@ -1531,7 +1639,7 @@ get_similarity(int order, int size, float *pdata, float *cdata, float *rmsa,
   
   if(!init) {
       /* get previous window stat */
-      if( !retrieve_windstat(rho1, order, &err1, &rms1)){
+      if( !retrieve_windstat(st, rho1, order, &err1, &rms1)){
 	  xlpc(order, stab, size-1, pdata,
 	      a1, rho1, (float *) NULL, &err1, &rmsd1, pre, w_type);
 	  rms1 = wind_energy(pdata, size, w_type);
@@ -1550,7 +1658,7 @@ get_similarity(int order, int size, float *pdata, float *cdata, float *rmsa,
       t = 10.0;
   }
   *rmsa = rms3;
-  save_windstat( rho3, order, err3, rms3);
+  save_windstat(st, rho3, order, err3, rms3);
   return((float)(0.2/t));
 }
 
@@ -1586,8 +1694,10 @@ get_similarity(int order, int size, float *pdata, float *cdata, float *rmsa,
    
 */
 
+#if 0
 static Stat *stat = NULL;
 static float *mem = NULL;
+#endif
 
 static Stat*
 #if 0
@@ -1596,11 +1706,18 @@ get_stationarity(fdata, freq, buff_size, nframes, frame_step, first_time)
     double  freq;
     int     buff_size, nframes, frame_step, first_time;
 #else
-get_stationarity(float *fdata, double freq, int buff_size, int nframes,
-                 int frame_step, int first_time)
+get_stationarity(Dp_f0_state *st, float *fdata, double freq, int buff_size,
+                 int nframes, int frame_step, int first_time)
 #endif
 {
+#if 0
   static int nframes_old = 0, memsize;
+#else
+  int &nframes_old = st->stationarity_nframes_old,
+      &memsize = st->stationarity_memsize;
+  Stat *&stat = st->stat;
+  float *&mem = st->mem;
+#endif
   float preemp = 0.4f, stab = 30.0f;
   float *p, *q, *r, *datend;
   int ind, i, j, m, size, order, agap, w_type = 3;
@@ -1651,14 +1768,14 @@ get_stationarity(float *fdata, double freq, int buff_size, int nframes,
 
   for(j=0, p = q - agap; j < nframes; j++, p += frame_step, q += frame_step){
       if( (p >= fdata) && (q >= fdata) && ( q + size <= datend) )
-	  stat->stat[j] = get_similarity(order,size, p, q, 
+	  stat->stat[j] = get_similarity(st,order,size, p, q, 
 					     &(stat->rms[j]),
 					     &(stat->rms_ratio[j]),preemp,
 					     stab,w_type, 0);
       else {
 	  if(first_time) {
 	      if( (p < fdata) && (q >= fdata) && (q+size <=datend) )
-		  stat->stat[j] = get_similarity(order,size, NULL, q,
+		  stat->stat[j] = get_similarity(st,order,size, NULL, q,
 						     &(stat->rms[j]),
 						     &(stat->rms_ratio[j]),
 						     preemp,stab,w_type, 1);
@@ -1669,7 +1786,7 @@ get_stationarity(float *fdata, double freq, int buff_size, int nframes,
 	      }
 	  } else {
 	      if( (p<fdata) && (q+size <=datend) ){
-		  stat->stat[j] = get_similarity(order,size, mem, 
+		  stat->stat[j] = get_similarity(st,order,size, mem, 
 						     mem + (memsize/2) + ind,
 						     &(stat->rms[j]),
 						     &(stat->rms_ratio[j]),
@@ -1713,10 +1830,27 @@ eround(double flnum)
 }
 #endif
 
+#if 0
 void free_dp_f0()
+#else
+void free_dp_f0(Dp_f0_state *st)
+#endif
 {
   int i;
   Frame *frm, *next;
+#if 1
+  float *&foutput = st->foutput, *&co = st->co, *&mem2 = st->mem2;
+  Frame *&headF = st->headF, *&tailF = st->tailF;
+  int *&pcands = st->pcands;
+  int &size_cir_buffer = st->size_cir_buffer;
+  int *&locs = st->locs;
+  int &wReuse = st->wReuse;
+  Windstat *&windstat = st->windstat;
+  float *&f0p = st->f0p, *&vuvp = st->vuvp, *&rms_speech = st->rms_speech,
+        *&acpkp = st->acpkp, *&peaks = st->peaks;
+  Stat *&stat = st->stat;
+  float *&mem = st->mem;
+#endif
 
 #if 1
   ckfree((void *)foutput);
@@ -1773,9 +1907,18 @@ void free_dp_f0()
   headF = NULL;
   tailF = NULL;
   
+#if 0
   ckfree((void *)stat->stat);
   ckfree((void *)stat->rms);
   ckfree((void *)stat->rms_ratio);
+#else
+  /* A stream may be closed before any call of get_stationarity(). */
+  if (stat) {
+    ckfree((void *)stat->stat);
+    ckfree((void *)stat->rms);
+    ckfree((void *)stat->rms_ratio);
+  }
+#endif
 
   ckfree((void *)stat);
   stat = NULL;
@@ -1784,6 +1927,170 @@ void free_dp_f0()
   mem = NULL;
 }
 
+#if 1
+/*
+ * Streaming interface.
+ *
+ * dp_f0() is designed to be fed with overlapping buffers, so a stream just
+ * keeps the unprocessed samples and calls dp_f0() whenever a whole buffer is
+ * available. Since each stream has its own DP state, several streams can be
+ * processed alternately.
+ */
+
+struct f0_stream {
+  F0_params par;
+  double sf;
+  long buff_size, sdstep;
+  int latency;
+  sptk::NormalDistributedRandomValueGeneration *generator;
+  std::vector<float> data;	/* samples not yet passed over */
+  float *fdata;
+  long total_samps;
+  int stopped;
+  Dp_f0_state state;
+};
+
+/* Passes data[offset..offset+actsize) to dp_f0() and appends the output. */
+static int
+stream_dp_f0(F0_stream *stream, long offset, long actsize, int done,
+             std::vector<float> *f0)
+{
+  float *f0p, *vuvp, *rms_speech, *acpkp;
+  int i, vecsize;
+
+  for (i = 0; i < actsize; i++) {
+    stream->fdata[i] = stream->data[i + offset];
+  }
+  if (dp_f0(&stream->state, stream->fdata, (int) actsize, (int) stream->sdstep,
+            stream->sf, &stream->par, &f0p, &vuvp, &rms_speech, &acpkp,
+            &vecsize, done)) {
+    return 1;
+  }
+  for (i = vecsize - 1; i >= 0; i--) {
+    f0->push_back(f0p[i]);
+  }
+  return 0;
+}
+
+F0_stream *
+cGet_f0_open(int frame_shift, double sample_freq, double min_f0, double max_f0,
+             double voice_bias)
+{
+  F0_stream *stream;
+  F0_params *par;
+
+  stream = new F0_stream;
+  stream->generator = new sptk::NormalDistributedRandomValueGeneration(1);
+  stream->fdata = NULL;
+  stream->total_samps = 0;
+  stream->stopped = 0;
+  stream->sf = sample_freq;
+
+  /* The same parameters as cGet_f0(). */
+  par = &stream->par;
+  par->cand_thresh = 0.3f;
+  par->lag_weight = 0.3f;
+  par->freq_weight = 0.02f;
+  par->trans_cost = 0.005f;
+  par->trans_amp = 0.5f;
+  par->trans_spec = 0.5f;
+  par->voice_bias = voice_bias;
+  par->double_cost = 0.35f;
+  par->min_f0 = min_f0;
+  par->max_f0 = max_f0;
+  par->frame_step = (double) frame_shift / sample_freq;
+  par->wind_dur = 0.0075f;
+  par->n_cands = 20;
+  par->mean_f0 = 200;          /* unused */
+  par->mean_f0_weight = 0.0f;  /* unused */
+  par->conditioning = 0;       /* unused */
+
+  if (check_f0_params(par, stream->sf)) {
+    delete stream->generator;
+    delete stream;
+    return NULL;
+  }
+
+  if (init_dp_f0(&stream->state, stream->sf, par, &stream->buff_size,
+                 &stream->sdstep)
+      || stream->buff_size > INT_MAX || stream->sdstep > INT_MAX) {
+    free_dp_f0(&stream->state);
+    delete stream->generator;
+    delete stream;
+    return NULL;
+  }
+  /* A frame is output after its buffer is filled and the DP either converges
+     or is forced to output after size_frame_out frames. */
+  stream->latency = (int) (stream->buff_size + stream->sdstep +
+                           (long) stream->state.size_frame_out *
+                           stream->state.step);
+
+  stream->fdata = (float *) ckalloc(sizeof(float) *
+                                    std::max(stream->buff_size, stream->sdstep));
+  return stream;
+}
+
+int
+cGet_f0_latency(const F0_stream *stream)
+{
+  return stream->latency;
+}
+
+int
+cGet_f0_put(F0_stream *stream, const double *waveform, int length,
+            std::vector<float> *f0)
+{
+  double noise, noise_sdev = 50.0;
+  long ndone;
+  int i;
+
+  stream->total_samps += length;
+  if (stream->stopped) return 0;
+
+  for (i = 0; i < length; i++) {
+    if (!stream->generator->Get(&noise)) return 1;
+    stream->data.push_back(waveform[i] + noise * noise_sdev);
+  }
+
+  /* Only buffers followed by more samples are processed here since the last
+     buffer has to be marked as the last one. */
+  if ((long) stream->data.size() <= stream->buff_size) return 0;
+
+  ndone = 0;
+  while ((long) stream->data.size() - ndone > stream->buff_size) {
+    if (stream_dp_f0(stream, ndone, stream->buff_size, 0, f0)) {
+      /* cGet_f0() returns the frames obtained so far in this case. */
+      stream->stopped = 1;
+      stream->data.clear();
+      ndone = 0;
+      break;
+    }
+    ndone += stream->sdstep;
+  }
+  stream->data.erase(stream->data.begin(), stream->data.begin() + ndone);
+  return 0;
+}
+
+int
+cGet_f0_close(F0_stream *stream, std::vector<float> *f0)
+{
+  int result = 0;
+
+  if (stream->total_samps <
+      ((stream->par.frame_step * 2.0) + stream->par.wind_dur) * stream->sf) {
+    result = 1;
+  } else if (!stream->stopped) {
+    stream_dp_f0(stream, 0, (long) stream->data.size(), 1, f0);
+  }
+  free_dp_f0(&stream->state);
+
+  ckfree((void *)stream->fdata);
+  delete stream->generator;
+  delete stream;
+  return result;
+}
+#endif
+
 int
 #if 0
 cGet_f0(Sound *sound, Tcl_Interp *interp, float **outlist, int *length)
@@ -1803,10 +2110,13 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
 #if 0
   int init_dp_f0(), dp_f0();
 #else
-  int init_dp_f0(double freq, F0_params *par, long *buffsize, long *sdstep);
-  int dp_f0(float *fdata, int buff_size, int sdstep, double freq, F0_params *par,
-            float **f0p_pt, float **vuvp_pt, float **rms_speech_pt, float **acpkp_pt,
-            int *vecsize, int last_time);
+  int init_dp_f0(Dp_f0_state *st, double freq, F0_params *par,
+                 long *buffsize, long *sdstep);
+  int dp_f0(Dp_f0_state *st, float *fdata, int buff_size, int sdstep,
+            double freq, F0_params *par, float **f0p_pt, float **vuvp_pt,
+            float **rms_speech_pt, float **acpkp_pt, int *vecsize,
+            int last_time);
+  Dp_f0_state state;
 #endif
   static int framestep = -1;
   long sdstep = 0, total_samps;
@@ -1846,12 +2156,22 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
 
   /* Add noise to robustly estimate F0 values. */
   sptk::NormalDistributedRandomValueGeneration generator(1);
+  /* Every return below releases what has been allocated so far; otherwise
+     each rejected input leaks. */
   for (i = 0; i < sound_length; i++) {
-    if (!generator.Get(&noise)) return 1;
+    if (!generator.Get(&noise)) {
+      ckfree((void *)tmp);
+      ckfree((void *)buf);
+      return 1;
+    }
     buf[i] = waveform[i] + noise * noise_sdev;
   }
   for (i = sound_length; i < total_length; i++) {
-    if (!generator.Get(&noise)) return 1;
+    if (!generator.Get(&noise)) {
+      ckfree((void *)tmp);
+      ckfree((void *)buf);
+      return 1;
+    }
     buf[i] = noise * noise_sdev;
   }
 #endif
@@ -1893,7 +2213,14 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
 #else
   if (endpos >= (sound_length - 1) || endpos == -1)
     endpos = sound_length - 1;
-  if (startpos > endpos) return 0;
+  if (startpos > endpos) {
+    ckfree((void *)tmp);
+    ckfree((void *)buf);
+    ckfree((void *)par);
+    *outlist = NULL;
+    *length = 0;
+    return 0;
+  }
 
   sf = sample_freq;
 #endif
@@ -1908,6 +2235,9 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
   }
 #else
   if(check_f0_params(par, sf)){
+    ckfree((void *)tmp);
+    ckfree((void *)buf);
+    ckfree((void *)par);
     return 1;
   }
 #endif
@@ -1918,19 +2248,30 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
     Tcl_AppendResult(interp, "input range too small for analysis by get_f0.", NULL);
     return TCL_ERROR;
 #else
+    ckfree((void *)tmp);
+    ckfree((void *)buf);
+    ckfree((void *)par);
     return 1;
 #endif
   }
   /* Initialize variables in get_f0.c; allocate data structures;
    * determine length and overlap of input frames to read.
    */
+#if 0
   if (init_dp_f0(sf, par, &buff_size, &sdstep)
+#else
+  if (init_dp_f0(&state, sf, par, &buff_size, &sdstep)
+#endif
       || buff_size > INT_MAX || sdstep > INT_MAX)
   {
 #if 0
     Tcl_AppendResult(interp, "problem in init_dp_f0().", NULL);
     return TCL_ERROR;
 #else
+    ckfree((void *)tmp);
+    ckfree((void *)buf);
+    ckfree((void *)par);
+    free_dp_f0(&state);
     return 1;
 #endif
   }
@@ -1962,8 +2303,13 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
     }
 #endif
     /*if (sound->debug > 0) Snack_WriteLog("dp_f0...\n");*/
+#if 0
     if (dp_f0(fdata, (int) actsize, (int) sdstep, sf, par,
 	      &f0p, &vuvp, &rms_speech, &acpkp, &vecsize, done)) {
+#else
+    if (dp_f0(&state, fdata, (int) actsize, (int) sdstep, sf, par,
+	      &f0p, &vuvp, &rms_speech, &acpkp, &vecsize, done)) {
+#endif
 #if 0
       Tcl_AppendResult(interp, "problem in dp_f0().", NULL);
       return TCL_ERROR;
@@ -2006,7 +2352,11 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
 #if 1
   ckfree((void *)buf);
 #endif
+#if 0
   free_dp_f0();
+#else
+  free_dp_f0(&state);
+#endif
 
   *outlist = tmp;
   *length = count;  
@@ -140,6 +140,14 @@ void ckfree(void* ptr);
 int cGet_f0(const std::vector<double> &waveform, int frame_shift,
             double sample_freq, double min_f0, double max_f0, double voice_bias,
             float **outlist, int *length);
+
+typedef struct f0_stream F0_stream;
+F0_stream *cGet_f0_open(int frame_shift, double sample_freq, double min_f0,
+                        double max_f0, double voice_bias);
+int cGet_f0_latency(const F0_stream *stream);
+int cGet_f0_put(F0_stream *stream, const double *waveform, int length,
+                std::vector<float> *f0);
+int cGet_f0_close(F0_stream *stream, std::vector<float> *f0);
 #endif
 
 #if 1
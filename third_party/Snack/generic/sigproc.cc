@@ -46,8 +46,13 @@ int xget_window(dout, n, type)
 int xget_window(float *dout, int n, int type)
 #endif
 {
+#if 0
   static float *din = NULL;
   static int n0 = 0;
+#else
+  float *din = NULL;
+  int n0 = 0;
+#endif
   float preemp = 0.0;
 
   if(n > n0) {
@@ -68,8 +73,6 @@ int xget_window(float *dout, int n, int type)
 #else
   int result = window(din, dout, n, preemp, type);
   ckfree((void *)din);
-  din = NULL;
-  n0 = 0;
   return result;
 #endif
 }
@@ -111,8 +114,13 @@ void xcwindow(float *din, float *dout, int n, float preemp)
 {
   register int i;
   register float *p;
+#if 0
   static int wsize = 0;
   static float *wind=NULL;
+#else
+  int wsize = 0;
+  float *wind=NULL;
+#endif
   register float *q, co;
  
   if(wsize != n) {		/* Need to create a new cos**4 window? */
@@ -137,8 +145,6 @@ void xcwindow(float *din, float *dout, int n, float preemp)
   }
 #if 1
   ckfree((void *)wind);
-  wind = NULL;
-  wsize = 0;
 #endif
 }
 
@@ -155,8 +161,13 @@ void xhwindow(float *din, float *dout, int n, float preemp)
 {
   register int i;
   register float *p;
+#if 0
   static int wsize = 0;
   static float *wind=NULL;
+#else
+  int wsize = 0;
+  float *wind=NULL;
+#endif
   register float *q;
 
   if(wsize != n) {		/* Need to create a new Hamming window? */
@@ -179,8 +190,6 @@ void xhwindow(float *din, float *dout, int n, float preemp)
   }
 #if 1
   ckfree((void *)wind);
-  wind = NULL;
-  wsize = 0;
 #endif
 }
 
@@ -197,8 +206,13 @@ void xhnwindow(float *din, float *dout, int n, float preemp)
 {
   register int i;
   register float *p;
+#if 0
   static int wsize = 0;
   static float *wind=NULL;
+#else
+  int wsize = 0;
+  float *wind=NULL;
+#endif
   register float *q;
 
   if(wsize != n) {		/* Need to create a new Hanning window? */
@@ -221,8 +235,6 @@ void xhnwindow(float *din, float *dout, int n, float preemp)
   }
 #if 1
   ckfree((void *)wind);
-  wind = NULL;
-  wsize = 0;
 #endif
 }
 
@@ -409,8 +421,13 @@ float wind_energy(data,size,w_type)
 float wind_energy(float *data, int size, int w_type)
 #endif
 {
+#if 0
   static int nwind = 0;
   static float *dwind = NULL;
+#else
+  int nwind = 0;
+  float *dwind = NULL;
+#endif
   register float *dp, sum, f;
   register int i;
 
@@ -432,8 +449,6 @@ float wind_energy(float *data, int size, int w_type)
   }
 #if 1
   ckfree((void *)dwind);
-  dwind = NULL;
-  nwind = 0;
 #endif
   return((float)sqrt((double)(sum/size)));
 }
@@ -461,8 +476,13 @@ int xlpc(int lpc_ord, float lpc_stabl, int wsize, float *data, float *lpca,
          int type)
 #endif
 {
+#if 0
   static float *dwind=NULL;
   static int nwind=0;
+#else
+  float *dwind=NULL;
+  int nwind=0;
+#endif
   float rho[BIGSORD+1], k[BIGSORD], a[BIGSORD+1],*r,*kp,*ap,en,er,wfact=1.0;
 
   if((wsize <= 0) || (!data) || (lpc_ord > BIGSORD)) return(FALSE);
@@ -512,8 +532,6 @@ int xlpc(int lpc_ord, float lpc_stabl, int wsize, float *data, float *lpca,
   if(normerr) *normerr = er;
 #if 1
   ckfree((void *)dwind);
-  dwind = NULL;
-  nwind = 0;
 #endif
   return(TRUE);
 }
@@ -543,8 +561,13 @@ void crossf(float *data, int size, int start, int nlags, float *engref,
             int *maxloc, float *maxval, float *correl)
 #endif
 {
+#if 0
   static float *dbdata=NULL;
   static int dbsize = 0;
+#else
+  float *dbdata=NULL;
+  int dbsize = 0;
+#endif
   register float *dp, *ds, sum, st;
   register int j;
   register  float *dq, t, *p, engr, *dds, amax;
@@ -613,8 +636,6 @@ void crossf(float *data, int size, int start, int nlags, float *engref,
   }
 #if 1
   ckfree((void *)dbdata);
-  dbdata = NULL;
-  dbsize = 0;
 #endif
 }
 
@@ -651,8 +672,13 @@ void crossfi(float *data, int size, int start0, int nlags0, int nlags,
              int *locs, int nlocs)
 #endif
 {
+#if 0
   static float *dbdata=NULL;
   static int dbsize = 0;
+#else
+  float *dbdata=NULL;
+  int dbsize = 0;
+#endif
   register float *dp, *ds, sum, st;
   register int j;
   register  float *dq, t, *p, engr, *dds, amax;
@@ -733,14 +759,14 @@ void crossfi(float *data, int size, int start0, int nlags0, int nlags,
   }
 #if 1
   ckfree((void *)dbdata);
-  dbdata = NULL;
-  dbsize = 0;
 #endif
 }
 
 #if 1
 void *ckalloc(size_t size) {
-  return malloc(size);
+  /* Some buffers are read before being written, so they are zero-filled to
+     make the result independent of the heap state left by previous calls. */
+  return calloc(1, size);
 }
 
 void *ckrealloc(void *ptr, size_t size) {
@@ -0,0 +1,158 @@
+#!/bin/bash
+# ----------------------------------------------------------------- #
+#             The Speech Signal Processing Toolkit (SPTK)           #
+#             developed by SPTK Working Group                       #
+#             http://sp-tk.sourceforge.net/                         #
+# ----------------------------------------------------------------- #
+#                                                                   #
+#  Copyright (c) 1984-2007  Tokyo Institute of Technology           #
+#                           Interdisciplinary Graduate School of    #
+#                           Science and Engineering                 #
+#                                                                   #
+#                1996-2020  Nagoya Institute of Technology          #
+#                           Department of Computer Science          #
+#                                                                   #
+# All rights reserved.                                              #
+#                                                                   #
+# Redistribution and use in source and binary forms, with or        #
+# without modification, are permitted provided that the following   #
+# conditions are met:                                               #
+#                                                                   #
+# - Redistributions of source code must retain the above copyright  #
+#   notice, this list of conditions and the following disclaimer.   #
+# - Redistributions in binary form must reproduce the above         #
+#   copyright notice, this list of conditions and the following     #
+#   disclaimer in the documentation and/or other materials provided #
+#   with the distribution.                                          #
+# - Neither the name of the SPTK working group nor the names of its #
+#   contributors may be used to endorse or promote products derived #
+#   from this software without specific prior written permission.   #
+#                                                                   #
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            #
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       #
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          #
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          #
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS #
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          #
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   #
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     #
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON #
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   #
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    #
+# OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           #
+# POSSIBILITY OF SUCH DAMAGE.                                       #
+# ----------------------------------------------------------------- #
+
+# Measure the power-of-two FFTs built with each SIMD instruction set.
+#
+# usage: benchmark_fft.sh [ length ... ]
+#
+# A small driver is compiled together with the FFT sources, once with the
+# default flags and once with -mavx if the CPU supports AVX, and linked with
+# lib/libsptk.a, so the library has to be built beforehand and this script
+# has to be run at the top directory. For each length, the time per transform
+# of FastFourierTransform and that of RealValuedFastFourierTransform are
+# printed for each build. The outputs of the builds are also compared, since
+# the kernels never fuse multiplication and addition and are expected to give
+# identical results.
+
+set -e
+
+lengths=${@:-64 256 1024 4096 16384 65536}
+
+workdir=$(mktemp -d)
+trap 'rm -rf $workdir' EXIT
+
+cat > $workdir/benchmark.cc << 'END'
+#include <chrono>   // std::chrono
+#include <cstdio>   // std::FILE, std::fopen, std::fwrite, std::printf
+#include <cstdlib>  // std::atoi
+#include <random>   // std::mt19937
+#include <vector>   // std::vector
+
+#include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/math/real_valued_fast_fourier_transform.h"
+
+// Returns the time per call in seconds. Calls are repeated for at least
+// 0.2 seconds.
+template <class Function>
+double Measure(const Function& function) {
+  const auto start(std::chrono::steady_clock::now());
+  int num_call(0);
+  double elapsed(0.0);
+  do {
+    function();
+    ++num_call;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start).count();
+  } while (elapsed < 0.2);
+  return elapsed / num_call;
+}
+
+void Write(const std::vector<double>& x, std::FILE* fp) {
+  std::fwrite(&x[0], sizeof(x[0]), x.size(), fp);
+}
+
+int main(int argc, char* argv[]) {
+  std::FILE* fp(std::fopen(argv[1], "wb"));
+  if (NULL == fp) return 1;
+  std::mt19937 engine(1);
+  std::normal_distribution<double> distribution;
+  for (int i(2); i < argc; ++i) {
+    const int length(std::atoi(argv[i]));
+    std::vector<double> x(length), y(length);
+    for (int j(0); j < length; ++j) {
+      x[j] = distribution(engine);
+      y[j] = distribution(engine);
+    }
+    sptk::FastFourierTransform fft(length);
+    sptk::RealValuedFastFourierTransform rfft(length);
+    sptk::RealValuedFastFourierTransform::Buffer buffer;
+    if (!fft.IsValid() || !rfft.IsValid()) return 1;
+    std::vector<double> real1, imag1, real2, imag2;
+    const double fft_time(
+        Measure([&]() { fft.Run(x, y, &real1, &imag1); }));
+    const double rfft_time(
+        Measure([&]() { rfft.Run(x, &real2, &imag2, &buffer); }));
+    Write(real1, fp);
+    Write(imag1, fp);
+    Write(real2, fp);
+    Write(imag2, fp);
+    std::printf("%d %.2f %.2f\n", length, fft_time * 1e6, rfft_time * 1e6);
+  }
+  std::fclose(fp);
+  return 0;
+}
+END
+
+builds="default"
+if grep -qw avx /proc/cpuinfo 2> /dev/null; then
+   builds="$builds avx"
+fi
+
+for build in $builds; do
+   flags=""
+   [ "$build" = avx ] && flags="-mavx"
+   g++ -O2 -std=c++11 -pthread $flags -I include $workdir/benchmark.cc \
+      src/math/fast_fourier_transform.cc \
+      src/math/real_valued_fast_fourier_transform.cc lib/libsptk.a \
+      -o $workdir/benchmark_$build
+   $workdir/benchmark_$build $workdir/output_$build $lengths \
+      > $workdir/time_$build
+done
+
+printf "%-8s %8s %14s %14s\n" build length "FFT [us]" "real FFT [us]"
+for build in $builds; do
+   while read length fft_time rfft_time; do
+      printf "%-8s %8d %14.2f %14.2f\n" $build $length $fft_time $rfft_time
+   done < $workdir/time_$build
+done
+
+if [ -f $workdir/output_avx ]; then
+   if cmp -s $workdir/output_default $workdir/output_avx; then
+      echo "AVX outputs are identical to the default ones"
+   else
+      echo "AVX outputs differ from the default ones"
+      exit 1
+   fi
+fi
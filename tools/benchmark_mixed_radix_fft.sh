@@ -0,0 +1,127 @@
+#!/bin/bash
+# ----------------------------------------------------------------- #
+#             The Speech Signal Processing Toolkit (SPTK)           #
+#             developed by SPTK Working Group                       #
+#             http://sp-tk.sourceforge.net/                         #
+# ----------------------------------------------------------------- #
+#                                                                   #
+#  Copyright (c) 1984-2007  Tokyo Institute of Technology           #
+#                           Interdisciplinary Graduate School of    #
+#                           Science and Engineering                 #
+#                                                                   #
+#                1996-2020  Nagoya Institute of Technology          #
+#                           Department of Computer Science          #
+#                                                                   #
+# All rights reserved.                                              #
+#                                                                   #
+# Redistribution and use in source and binary forms, with or        #
+# without modification, are permitted provided that the following   #
+# conditions are met:                                               #
+#                                                                   #
+# - Redistributions of source code must retain the above copyright  #
+#   notice, this list of conditions and the following disclaimer.   #
+# - Redistributions in binary form must reproduce the above         #
+#   copyright notice, this list of conditions and the following     #
+#   disclaimer in the documentation and/or other materials provided #
+#   with the distribution.                                          #
+# - Neither the name of the SPTK working group nor the names of its #
+#   contributors may be used to endorse or promote products derived #
+#   from this software without specific prior written permission.   #
+#                                                                   #
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            #
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       #
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          #
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          #
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS #
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          #
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   #
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     #
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON #
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   #
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    #
+# OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           #
+# POSSIBILITY OF SUCH DAMAGE.                                       #
+# ----------------------------------------------------------------- #
+
+# Compare the mixed-radix FFT with the O(N^2) DFT for lengths which are not
+# powers of two.
+#
+# usage: benchmark_mixed_radix_fft.sh [ length ... ]
+#
+# A small driver is compiled against lib/libsptk.a, so the library has to be
+# built beforehand and this script has to be run at the top directory. For
+# each length, the time per transform of DiscreteFourierTransform and that
+# of MixedRadixFastFourierTransform are printed with the maximum absolute
+# difference of their outputs. Lengths with a prime factor above five are
+# computed by Bluestein's algorithm.
+
+set -e
+
+lengths=${@:-1200 2400 1201}
+
+workdir=$(mktemp -d)
+trap 'rm -rf $workdir' EXIT
+
+cat > $workdir/benchmark.cc << 'END'
+#include <algorithm>  // std::max
+#include <chrono>     // std::chrono
+#include <cmath>      // std::fabs
+#include <cstdio>     // std::printf
+#include <cstdlib>    // std::atoi
+#include <random>     // std::mt19937
+#include <vector>     // std::vector
+
+#include "SPTK/math/discrete_fourier_transform.h"
+#include "SPTK/math/mixed_radix_fast_fourier_transform.h"
+
+// Returns the time per call in seconds. Calls are repeated for at least
+// 0.2 seconds.
+template <class Transform>
+double Measure(const Transform& transform, const std::vector<double>& x,
+               const std::vector<double>& y, std::vector<double>* real,
+               std::vector<double>* imag) {
+  const auto start(std::chrono::steady_clock::now());
+  int num_call(0);
+  double elapsed(0.0);
+  do {
+    transform.Run(x, y, real, imag);
+    ++num_call;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start).count();
+  } while (elapsed < 0.2);
+  return elapsed / num_call;
+}
+
+int main(int argc, char* argv[]) {
+  std::printf("%8s %14s %14s %12s\n", "length", "DFT [us]", "FFT [us]",
+              "max diff");
+  std::mt19937 engine(1);
+  std::normal_distribution<double> distribution;
+  for (int i(1); i < argc; ++i) {
+    const int length(std::atoi(argv[i]));
+    std::vector<double> x(length), y(length);
+    for (int j(0); j < length; ++j) {
+      x[j] = distribution(engine);
+      y[j] = distribution(engine);
+    }
+    sptk::DiscreteFourierTransform dft(length);
+    sptk::MixedRadixFastFourierTransform fft(length);
+    if (!dft.IsValid() || !fft.IsValid()) return 1;
+    std::vector<double> real1, imag1, real2, imag2;
+    const double dft_time(Measure(dft, x, y, &real1, &imag1));
+    const double fft_time(Measure(fft, x, y, &real2, &imag2));
+    double max_diff(0.0);
+    for (int j(0); j < length; ++j) {
+      max_diff = std::max(max_diff, std::fabs(real1[j] - real2[j]));
+      max_diff = std::max(max_diff, std::fabs(imag1[j] - imag2[j]));
+    }
+    std::printf("%8d %14.1f %14.1f %12.2e\n", length, dft_time * 1e6,
+                fft_time * 1e6, max_diff);
+  }
+  return 0;
+}
+END
+
+g++ -O2 -std=c++11 -pthread -I include $workdir/benchmark.cc lib/libsptk.a \
+   -o $workdir/benchmark
+$workdir/benchmark $lengths
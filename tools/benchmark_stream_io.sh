@@ -0,0 +1,96 @@
+#!/bin/bash
+# ----------------------------------------------------------------- #
+#             The Speech Signal Processing Toolkit (SPTK)           #
+#             developed by SPTK Working Group                       #
+#             http://sp-tk.sourceforge.net/                         #
+# ----------------------------------------------------------------- #
+#                                                                   #
+#  Copyright (c) 1984-2007  Tokyo Institute of Technology           #
+#                           Interdisciplinary Graduate School of    #
+#                           Science and Engineering                 #
+#                                                                   #
+#                1996-2020  Nagoya Institute of Technology          #
+#                           Department of Computer Science          #
+#                                                                   #
+# All rights reserved.                                              #
+#                                                                   #
+# Redistribution and use in source and binary forms, with or        #
+# without modification, are permitted provided that the following   #
+# conditions are met:                                               #
+#                                                                   #
+# - Redistributions of source code must retain the above copyright  #
+#   notice, this list of conditions and the following disclaimer.   #
+# - Redistributions in binary form must reproduce the above         #
+#   copyright notice, this list of conditions and the following     #
+#   disclaimer in the documentation and/or other materials provided #
+#   with the distribution.                                          #
+# - Neither the name of the SPTK working group nor the names of its #
+#   contributors may be used to endorse or promote products derived #
+#   from this software without specific prior written permission.   #
+#                                                                   #
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            #
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       #
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          #
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          #
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS #
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          #
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   #
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     #
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON #
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   #
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    #
+# OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           #
+# POSSIBILITY OF SUCH DAMAGE.                                       #
+# ----------------------------------------------------------------- #
+
+# Measure the binary stream throughput of SPTK commands.
+#
+# usage: benchmark_stream_io.sh [ size_in_mb [ bindir [ refbindir ] ] ]
+#
+# A file of size_in_mb megabytes of doubles is generated in $TMPDIR, and
+# each command reads it from stdin and by path with its output discarded.
+# If refbindir is given, the same commands are also run with the binaries
+# in refbindir, e.g., those built from an older revision, and the outputs
+# of both are checked to be identical.
+
+set -e
+
+size_in_mb=${1:-1024}
+bindir=${2:-bin}
+refbindir=${3:-}
+
+workdir=$(mktemp -d)
+trap 'rm -rf $workdir' EXIT
+
+num_samples=$((size_in_mb * 1024 * 1024 / 8))
+$bindir/nrand -l $num_samples > $workdir/data
+
+commands=("x2x +dd" "x2x +df" "sopr -a 1" "clip -l -1 -u 1")
+
+TIMEFORMAT=%R
+
+measure() {
+   local dir=$1 cmd=$2 mode=$3
+   if [ "$mode" = stdin ]; then
+      { time $dir/$cmd < $workdir/data > /dev/null; } 2>&1
+   else
+      { time $dir/$cmd $workdir/data > /dev/null; } 2>&1
+   fi
+}
+
+echo "input: $size_in_mb MB of doubles"
+printf "%-15s %-6s %10s" command input "$bindir [s]"
+[ -n "$refbindir" ] && printf " %12s" "$refbindir [s]"
+echo
+for cmd in "${commands[@]}"; do
+   for mode in stdin file; do
+      printf "%-15s %-6s %10s" "$cmd" $mode "$(measure $bindir "$cmd" $mode)"
+      [ -n "$refbindir" ] && printf " %12s" "$(measure $refbindir "$cmd" $mode)"
+      echo
+   done
+   if [ -n "$refbindir" ]; then
+      $bindir/$cmd < $workdir/data > $workdir/out1
+      $refbindir/$cmd < $workdir/data > $workdir/out2
+      cmp $workdir/out1 $workdir/out2 || echo "$cmd: outputs differ"
+   fi
+done